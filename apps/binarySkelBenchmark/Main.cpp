@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+
+#include "dart/dart.h"
+#include "dart/utils/BinarySkel.h"
+
+using namespace dart;
+
+/// Average time in milliseconds of numLoads calls to load
+template <class Function>
+double measure(Function load, size_t numLoads)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for(size_t i=0; i<numLoads; ++i)
+    load();
+  const auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::milli>(end - start).count()
+      / numLoads;
+}
+
+int main(int argc, char* argv[])
+{
+  std::vector<std::string> fileNames;
+  for(int i=1; i<argc; ++i)
+    fileNames.push_back(argv[i]);
+
+  if(fileNames.empty())
+  {
+    fileNames = {
+      DART_DATA_PATH"skel/shapes.skel",
+      DART_DATA_PATH"skel/fullbody1.skel",
+      DART_DATA_PATH"skel/softBodies.skel",
+      DART_DATA_PATH"skel/test/planar_joint.skel",
+      DART_DATA_PATH"skel/test/joint_actuator_type_test.skel"
+    };
+  }
+
+  const size_t numLoads = 10u;
+  const std::string binaryFileName = "binarySkelBenchmark"
+      + utils::BinarySkel::Extension;
+
+  std::cout << "Average time of loading each world " << numLoads
+            << " times\n\n"
+            << std::setw(12) << "XML [ms]"
+            << std::setw(14) << "Binary [ms]" << "  File" << std::endl;
+
+  for(const std::string& fileName : fileNames)
+  {
+    const simulation::WorldPtr world = utils::SkelParser::readWorld(fileName);
+    if(!world || !utils::BinarySkel::writeWorld(world, binaryFileName))
+    {
+      std::cout << "Failed converting [" << fileName << "]" << std::endl;
+      continue;
+    }
+
+    const double xmlTime = measure(
+          [&]() { utils::SkelParser::readWorld(fileName); }, numLoads);
+    const double binaryTime = measure(
+          [&]() { utils::BinarySkel::readWorld(binaryFileName); }, numLoads);
+
+    std::cout << std::setw(12) << xmlTime
+              << std::setw(14) << binaryTime << "  " << fileName << std::endl;
+  }
+
+  std::remove(binaryFileName.c_str());
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include "dart/dart.h"
+
+using namespace dart::dynamics;
+using namespace dart::constraint;
+
+SkeletonPtr createBox(const std::string& name, const Eigen::Vector3d& size,
+                      const Eigen::Vector3d& position, bool fixed)
+{
+  SkeletonPtr skel = Skeleton::create(name);
+
+  BodyNode* bn;
+  if(fixed)
+    bn = skel->createJointAndBodyNodePair<WeldJoint>().second;
+  else
+    bn = skel->createJointAndBodyNodePair<FreeJoint>().second;
+
+  std::shared_ptr<BoxShape> box(new BoxShape(size));
+  bn->createShapeNodeWith<VisualAddon, CollisionAddon, DynamicsAddon>(box);
+
+  const double mass = 1.0;
+  Inertia inertia;
+  inertia.setMass(mass);
+  inertia.setMoment(box->computeInertia(mass));
+  bn->setInertia(inertia);
+
+  Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+  tf.translation() = position;
+  if(fixed)
+    bn->getParentJoint()->setTransformFromParentBodyNode(tf);
+  else
+    skel->setPositions(FreeJoint::convertToPositions(tf));
+
+  return skel;
+}
+
+/// A pile of side x side x layers boxes that are dropped onto the ground. The
+/// boxes are slightly rotated so that they settle into an irregular pile.
+dart::simulation::WorldPtr createPile(size_t side, size_t layers)
+{
+  dart::simulation::WorldPtr world(new dart::simulation::World);
+  world->setTimeStep(0.001);
+
+  const double size = 0.1;
+  const double spacing = 1.1 * size;
+  const double offset = 0.5 * spacing * (side - 1);
+  const double groundSize = 2.0 * spacing * side + 1.0;
+
+  world->addSkeleton(createBox(
+        "ground", Eigen::Vector3d(groundSize, groundSize, 0.2),
+        Eigen::Vector3d(0.0, 0.0, -0.1), true));
+
+  size_t count = 0;
+  for(size_t k=0; k<layers; ++k)
+  {
+    for(size_t i=0; i<side; ++i)
+    {
+      for(size_t j=0; j<side; ++j)
+      {
+        const Eigen::Vector3d position(
+              i*spacing - offset, j*spacing - offset, (k + 0.5)*spacing);
+        SkeletonPtr box = createBox(
+              "box " + std::to_string(count++),
+              Eigen::Vector3d::Constant(size), position, false);
+
+        Eigen::Vector6d positions = box->getPositions();
+        positions.head<3>() = 0.02 * Eigen::Vector3d::Random();
+        box->setPositions(positions);
+
+        world->addSkeleton(box);
+      }
+    }
+  }
+
+  return world;
+}
+
+struct Result
+{
+  double time;
+  double numContacts;
+  double penetration;
+  double kineticEnergy;
+  size_t numSleeping;
+};
+
+Result runScene(std::unique_ptr<LCPSolver> solver, size_t side,
+                size_t layers, size_t numSteps, bool sleeping)
+{
+  // Every solver gets the same initial pile
+  std::srand(0);
+  dart::simulation::WorldPtr world = createPile(side, layers);
+  world->getConstraintSolver()->setLCPSolver(std::move(solver));
+  world->getConstraintSolver()->setSleepingEnabled(sleeping);
+
+  dart::collision::CollisionDetector* detector
+      = world->getConstraintSolver()->getCollisionDetector();
+
+  Result result;
+  result.numContacts = 0.0;
+  result.penetration = 0.0;
+
+  std::chrono::duration<double> elapsed(0.0);
+  for(size_t i=0; i<numSteps; ++i)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    world->step();
+    elapsed += std::chrono::steady_clock::now() - start;
+
+    const size_t numContacts = detector->getNumContacts();
+    result.numContacts += numContacts;
+    for(size_t j=0; j<numContacts; ++j)
+    {
+      result.penetration = std::max(
+            result.penetration,
+            detector->getContactRecord(j).penetrationDepth);
+    }
+  }
+
+  result.time = elapsed.count();
+  result.numContacts /= numSteps;
+
+  result.kineticEnergy = 0.0;
+  for(size_t i=0; i<world->getNumSkeletons(); ++i)
+    result.kineticEnergy += world->getSkeleton(i)->getKineticEnergy();
+
+  result.numSleeping = world->getConstraintSolver()->getNumSleepingSkeletons();
+
+  return result;
+}
+
+void printResult(const std::string& name, const Result& result,
+                 size_t numSteps)
+{
+  std::cout << std::setw(10) << name
+            << std::setw(14) << result.time
+            << std::setw(14) << 1e3*result.time/numSteps
+            << std::setw(12) << result.numContacts
+            << std::setw(16) << result.penetration
+            << std::setw(16) << result.kineticEnergy
+            << std::setw(10) << result.numSleeping << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  size_t side = 4;
+  size_t layers = 4;
+  size_t numSteps = 1000;
+  bool sleeping = false;
+  for(int i=1; i<argc; ++i)
+  {
+    const std::string arg(argv[i]);
+    if(arg=="-z")
+      sleeping = true;
+    else if(arg=="-n" && i+1<argc)
+      side = std::atoi(argv[++i]);
+    else if(arg=="-l" && i+1<argc)
+      layers = std::atoi(argv[++i]);
+    else if(arg=="-s" && i+1<argc)
+      numSteps = std::atoi(argv[++i]);
+  }
+
+  std::cout << "Dropping a pile of " << side << "x" << side << "x" << layers
+            << " boxes for " << numSteps << " steps"
+            << (sleeping ? " with sleeping enabled" : "") << "\n\n";
+
+  std::cout << std::setw(10) << "Solver"
+            << std::setw(14) << "Total [s]"
+            << std::setw(14) << "Step [ms]"
+            << std::setw(12) << "Contacts"
+            << std::setw(16) << "Penetration"
+            << std::setw(16) << "Kinetic energy"
+            << std::setw(10) << "Sleeping" << std::endl;
+
+  const double timeStep = 0.001;
+
+  printResult("Dantzig", runScene(std::unique_ptr<LCPSolver>(
+      new DantzigLCPSolver(timeStep)), side, layers, numSteps, sleeping), numSteps);
+
+  printResult("PGS", runScene(std::unique_ptr<LCPSolver>(
+      new PGSLCPSolver(timeStep)), side, layers, numSteps, sleeping), numSteps);
+
+  printResult("APGD", runScene(std::unique_ptr<LCPSolver>(
+      new APGDLCPSolver(timeStep)), side, layers, numSteps, sleeping), numSteps);
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include "dart/dart.h"
+#include "dart/optimizer/GradientDescentSolver.h"
+#include "dart/optimizer/LbfgsbSolver.h"
+
+using namespace dart::dynamics;
+
+/// A chain of revolute joints that cycle through the x, y and z axes
+SkeletonPtr createSerialChain(size_t numLinks, double linkLength)
+{
+  SkeletonPtr robot = Skeleton::create("chain");
+
+  BodyNode* parent = nullptr;
+  for(size_t i=0; i<numLinks; ++i)
+  {
+    RevoluteJoint::Properties joint;
+    joint.mName = "joint" + std::to_string(i);
+    joint.mAxis = Eigen::Vector3d::Unit(i%3);
+    if(parent)
+      joint.mT_ParentBodyToJoint.translation()
+          = Eigen::Vector3d(0.0, 0.0, linkLength);
+
+    parent = robot->createJointAndBodyNodePair<RevoluteJoint>(
+          parent, joint, BodyNode::Properties(
+            std::string("link" + std::to_string(i)))).second;
+    parent->createShapeNodeWith<VisualAddon>(std::make_shared<BoxShape>(
+          Eigen::Vector3d(0.1, 0.1, linkLength)));
+  }
+
+  return robot;
+}
+
+struct Result
+{
+  size_t numSolved;
+  size_t numIterations;
+  double time;
+};
+
+/// Solves the IK of the last body node of the robot for every goal
+/// configuration, starting from the same initial configuration each time
+template <class SolverType>
+Result runSolver(const SkeletonPtr& robot,
+                 const std::shared_ptr<SolverType>& solver,
+                 const std::vector<Eigen::VectorXd>& goals, bool unclamped)
+{
+  BodyNode* ee = robot->getBodyNode(robot->getNumBodyNodes()-1);
+  const std::shared_ptr<InverseKinematics>& ik = ee->getIK(true);
+  ik->setSolver(solver);
+
+  // A line search needs the error and its gradient to agree with each other,
+  // which the clamps tuned for gradient descent break
+  ik->getErrorMethod().setErrorLengthClamp(
+        unclamped ? 1e10 : DefaultIKErrorClamp);
+  ik->getGradientMethod().setComponentWiseClamp(
+        unclamped ? 1e10 : DefaultIKGradientComponentClamp);
+  solver->setNumMaxIterations(1000);
+
+  Result result = {0u, 0u, 0.0};
+  std::chrono::duration<double> elapsed(0.0);
+  for(const Eigen::VectorXd& goal : goals)
+  {
+    robot->setPositions(goal);
+    ik->getTarget()->setTransform(ee->getWorldTransform());
+    robot->setPositions(Eigen::VectorXd::Constant(robot->getNumDofs(), 0.1));
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool solved = ik->solve();
+    elapsed += std::chrono::steady_clock::now() - start;
+
+    result.numIterations += solver->getLastNumIterations();
+    if(solved && ik->getTarget()->getTransform().isApprox(
+         ee->getWorldTransform(), 1e-5))
+      ++result.numSolved;
+  }
+
+  result.time = elapsed.count();
+
+  return result;
+}
+
+void printResult(const std::string& name, const Result& result,
+                 size_t numGoals)
+{
+  std::cout << std::setw(24) << name
+            << std::setw(10) << result.numSolved
+            << std::setw(14) << result.numIterations
+            << std::setw(14) << 1e3*result.time/numGoals << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  size_t numGoals = 200;
+  for(int i=1; i<argc; ++i)
+  {
+    const std::string arg(argv[i]);
+    if(arg=="-n" && i+1<argc)
+      numGoals = std::atoi(argv[++i]);
+  }
+
+  std::srand(0);
+
+  const std::vector<std::pair<size_t, double>> chains = {{7u, 0.4}, {20u, 0.2}};
+  for(const auto& chain : chains)
+  {
+    const SkeletonPtr robot = createSerialChain(chain.first, chain.second);
+
+    // Goals are generated from random configurations so that they are
+    // reachable
+    std::vector<Eigen::VectorXd> goals;
+    for(size_t i=0; i<numGoals; ++i)
+      goals.push_back(Eigen::VectorXd::Random(robot->getNumDofs()));
+
+    std::cout << "[" << robot->getNumDofs() << " dofs, " << numGoals
+              << " goals]\n"
+              << std::setw(24) << "Solver"
+              << std::setw(10) << "Solved"
+              << std::setw(14) << "Iterations"
+              << std::setw(14) << "Goal [ms]" << std::endl;
+
+    auto gradientDescent
+        = std::make_shared<dart::optimizer::GradientDescentSolver>();
+    gradientDescent->setStepSize(1.0);
+    printResult("GradientDescentSolver",
+                runSolver(robot, gradientDescent, goals, false), numGoals);
+
+    auto lbfgsb = std::make_shared<dart::optimizer::LbfgsbSolver>();
+    printResult("LbfgsbSolver",
+                runSolver(robot, lbfgsb, goals, true), numGoals);
+
+    std::cout << std::endl;
+  }
+}
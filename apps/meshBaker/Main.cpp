@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iostream>
+
+#include "dart/dart.h"
+
+using namespace dart::dynamics;
+
+int main(int argc, char* argv[])
+{
+  if(argc < 2)
+  {
+    std::cout << "Usage: " << argv[0] << " <mesh file> [output file]\n\n"
+              << "Imports a mesh with Assimp and writes it in DART's binary "
+              << "mesh format. The output\nfile defaults to the input file "
+              << "with the '" << BinaryMesh::Extension << "' extension "
+              << "appended, which is\nthe file that auto-baking looks for."
+              << std::endl;
+    return 1;
+  }
+
+  const std::string input = argv[1];
+  const std::string output
+      = argc > 2? argv[2] : BinaryMesh::getBakedFileName(input);
+
+  const aiScene* scene = MeshShape::loadMesh(input);
+  if(!scene)
+  {
+    std::cerr << "Failed to import [" << input << "]" << std::endl;
+    return 1;
+  }
+
+  // Record the source file so that the output can serve as an auto-baked file
+  const bool success = BinaryMesh::write(scene, output, input);
+  delete scene;
+
+  if(!success)
+    return 1;
+
+  std::cout << "Wrote [" << output << "]" << std::endl;
+  return 0;
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include "dart/dart.h"
+
+using namespace dart::dynamics;
+
+/// A stiff soft ellipsoid swinging on a revolute joint with a stiff spring and
+/// damper. The point masses start from a random deformation.
+dart::simulation::WorldPtr createPendulum(double edgeStiffness,
+                                          double timeStep, bool implicit)
+{
+  dart::simulation::WorldPtr world(new dart::simulation::World);
+  world->setTimeStep(timeStep);
+  world->setImplicitSpringIntegration(implicit);
+
+  SkeletonPtr skel = Skeleton::create("pendulum");
+
+  RevoluteJoint::Properties joint;
+  joint.mAxis = Eigen::Vector3d::UnitY();
+  joint.mSpringStiffness = 2000.0;
+  joint.mDampingCoefficient = 1.0;
+  joint.mT_ChildBodyToJoint.translation() = Eigen::Vector3d(0.0, 0.0, 0.5);
+
+  SoftBodyNode::Properties soft(
+        BodyNode::Properties(Entity::Properties("ellipsoid")),
+        SoftBodyNodeHelper::makeEllipsoidProperties(
+          Eigen::Vector3d::Constant(0.3), 8, 8, 1.0,
+          100.0, edgeStiffness, 0.01));
+
+  SoftBodyNode* bn = skel->createJointAndBodyNodePair<
+      RevoluteJoint, SoftBodyNode>(nullptr, joint, soft).second;
+
+  std::srand(0);
+  skel->setPosition(0, 0.5);
+  for(size_t i=0; i<bn->getNumPointMasses(); ++i)
+    bn->getPointMass(i)->setPositions(0.01 * Eigen::Vector3d::Random());
+
+  world->addSkeleton(skel);
+
+  return world;
+}
+
+/// Positions of the joint and all the point masses
+Eigen::VectorXd getState(const dart::simulation::WorldPtr& world)
+{
+  const SkeletonPtr skel = world->getSkeleton(0);
+  const SoftBodyNode* bn = skel->getSoftBodyNode(0);
+
+  Eigen::VectorXd state(1 + 3*bn->getNumPointMasses());
+  state[0] = skel->getPosition(0);
+  for(size_t i=0; i<bn->getNumPointMasses(); ++i)
+    state.segment<3>(1 + 3*i) = bn->getPointMass(i)->getPositions();
+
+  return state;
+}
+
+struct Result
+{
+  bool stable;
+  double time;
+  size_t numSteps;
+  Eigen::VectorXd state;
+};
+
+Result runScene(double edgeStiffness, double timeStep, bool implicit,
+                double duration)
+{
+  dart::simulation::WorldPtr world
+      = createPendulum(edgeStiffness, timeStep, implicit);
+
+  Result result;
+  result.stable = true;
+  result.numSteps = static_cast<size_t>(std::round(duration / timeStep));
+
+  std::chrono::duration<double> elapsed(0.0);
+  for(size_t i=0; i<result.numSteps; ++i)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    world->step();
+    elapsed += std::chrono::steady_clock::now() - start;
+
+    // Point masses that move farther than the size of the body have blown up
+    result.state = getState(world);
+    if(!result.state.allFinite()
+       || result.state.tail(result.state.size() - 1).cwiseAbs().maxCoeff()
+          > 0.3)
+    {
+      result.stable = false;
+      break;
+    }
+  }
+
+  result.time = elapsed.count();
+
+  return result;
+}
+
+void printResult(const std::string& name, double timeStep,
+                 const Result& result, const Eigen::VectorXd& reference)
+{
+  std::cout << std::setw(10) << name
+            << std::setw(12) << timeStep
+            << std::setw(10) << (result.stable ? "yes" : "no");
+
+  if(!result.stable)
+  {
+    std::cout << std::endl;
+    return;
+  }
+
+  const Eigen::VectorXd error = result.state - reference;
+  const double jointError = std::abs(error[0]);
+  const double pointMassError = error.tail(error.size() - 1).norm()
+      / std::sqrt(static_cast<double>(error.size() - 1));
+
+  std::cout << std::setw(14) << result.time
+            << std::setw(14) << 1e3*result.time/result.numSteps
+            << std::setw(14) << jointError
+            << std::setw(18) << pointMassError << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  double edgeStiffness = 1000.0;
+  double duration = 1.0;
+  for(int i=1; i<argc; ++i)
+  {
+    const std::string arg(argv[i]);
+    if(arg=="-k" && i+1<argc)
+      edgeStiffness = std::atof(argv[++i]);
+    else if(arg=="-t" && i+1<argc)
+      duration = std::atof(argv[++i]);
+  }
+
+  std::cout << "Swinging a soft ellipsoid with edge stiffness "
+            << edgeStiffness << " for " << duration << " s\n"
+            << "Errors are the differences of the joint position and the RMS "
+            << "differences of the point mass positions from a 1e-5 s "
+            << "semi-implicit reference\n\n";
+
+  const Eigen::VectorXd reference
+      = runScene(edgeStiffness, 1e-5, false, duration).state;
+
+  std::cout << std::setw(10) << "Mode"
+            << std::setw(12) << "Time step"
+            << std::setw(10) << "Stable"
+            << std::setw(14) << "Total [s]"
+            << std::setw(14) << "Step [ms]"
+            << std::setw(14) << "Joint error"
+            << std::setw(18) << "Point mass error" << std::endl;
+
+  for(const double timeStep : {5e-4, 1e-3, 2e-3, 5e-3, 1e-2})
+  {
+    printResult("Semi", timeStep,
+                runScene(edgeStiffness, timeStep, false, duration), reference);
+    printResult("Implicit", timeStep,
+                runScene(edgeStiffness, timeStep, true, duration), reference);
+  }
+}
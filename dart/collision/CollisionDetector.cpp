@@ -38,17 +38,160 @@
 #include "dart/collision/CollisionDetector.h"
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <vector>
 
 #include "dart/common/Console.h"
+#include "dart/math/Geometry.h"
 #include "dart/dynamics/BodyNode.h"
+#include "dart/dynamics/SoftBodyNode.h"
 #include "dart/dynamics/Skeleton.h"
+#include "dart/dynamics/Shape.h"
+#include "dart/dynamics/ShapeNode.h"
 #include "dart/collision/CollisionNode.h"
 
+#define DART_CCD_MAX_NUM_SAMPLES 100
+#define DART_CCD_NUM_BISECTIONS 10
+
 namespace dart {
 namespace collision {
 
+namespace {
+
+//==============================================================================
+/// Motion of a BodyNode over a time step, extrapolated from its current pose
+/// and velocity
+struct BodyMotion
+{
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  explicit BodyMotion(const dynamics::BodyNode* _bodyNode)
+    : mTransform(_bodyNode->getWorldTransform()),
+      mLinearVelocity(_bodyNode->getLinearVelocity()),
+      mAngularVelocity(_bodyNode->getAngularVelocity())
+  {
+    // Do nothing
+  }
+
+  /// World transform of the body after _time
+  Eigen::Isometry3d getTransform(double _time) const
+  {
+    Eigen::Isometry3d T = Eigen::Isometry3d::Identity();
+    T.linear() = math::expMapRot(mAngularVelocity * _time)
+                 * mTransform.linear();
+    T.translation() = mTransform.translation() + mLinearVelocity * _time;
+
+    return T;
+  }
+
+  /// Current velocity of the point of the body that is at _point
+  Eigen::Vector3d getPointVelocity(const Eigen::Vector3d& _point) const
+  {
+    return mLinearVelocity
+        + mAngularVelocity.cross(_point - mTransform.translation());
+  }
+
+  Eigen::Isometry3d mTransform;
+
+  Eigen::Vector3d mLinearVelocity;
+
+  Eigen::Vector3d mAngularVelocity;
+};
+
+//==============================================================================
+/// Compute the radius of a sphere about the origin of _bodyNode that bounds
+/// its collision shapes, and the smallest side of their bounding boxes. Planes
+/// are unbounded and do not count toward the thickness.
+void computeBodyExtents(dynamics::BodyNode* _bodyNode,
+                        double& _radius, double& _thickness)
+{
+  _radius = 0.0;
+  _thickness = std::numeric_limits<double>::infinity();
+
+  const Eigen::Isometry3d invT = _bodyNode->getWorldTransform().inverse();
+  const auto shapeNodes
+      = _bodyNode->getShapeNodesWith<dynamics::CollisionAddon>();
+  for (auto shapeNode : shapeNodes)
+  {
+    const dynamics::ShapePtr& shape = shapeNode->getShape();
+    if (shape->getShapeType() == dynamics::Shape::PLANE)
+    {
+      _radius = std::numeric_limits<double>::infinity();
+      continue;
+    }
+
+    const math::BoundingBox& box = shape->getBoundingBox();
+    const Eigen::Isometry3d T = invT * shapeNode->getWorldTransform();
+    _radius = std::max(_radius, (T * box.computeCenter()).norm()
+                                + box.computeHalfExtents().norm());
+    _thickness = std::min(_thickness, box.computeFullExtents().minCoeff());
+  }
+}
+
+//==============================================================================
+/// Return true if two spheres whose centers are _distance apart and move
+/// relative to each other with _velocity come closer than _radius within
+/// _timeStep
+bool isSweptSphereColliding(const Eigen::Vector3d& _distance,
+                            const Eigen::Vector3d& _velocity,
+                            double _radius, double _timeStep)
+{
+  if (std::isinf(_radius))
+    return true;
+
+  double time = 0.0;
+  const double speedSquared = _velocity.squaredNorm();
+  if (speedSquared > 0.0)
+  {
+    time = -_distance.dot(_velocity) / speedSquared;
+    time = std::min(std::max(time, 0.0), _timeStep);
+  }
+
+  return (_distance + time * _velocity).norm() <= _radius;
+}
+
+//==============================================================================
+/// Return true if one of the first _numContacts contacts is between _bodyNode1
+/// and _bodyNode2
+bool hasContact(const std::vector<ContactRecord>& _contacts,
+                size_t _numContacts,
+                const dynamics::BodyNode* _bodyNode1,
+                const dynamics::BodyNode* _bodyNode2)
+{
+  for (size_t i = 0; i < _numContacts; ++i)
+  {
+    const ContactRecord& contact = _contacts[i];
+    if ((contact.bodyNode1 == _bodyNode1 && contact.bodyNode2 == _bodyNode2)
+        || (contact.bodyNode1 == _bodyNode2 && contact.bodyNode2 == _bodyNode1))
+      return true;
+  }
+
+  return false;
+}
+
+}  // anonymous namespace
+
+//==============================================================================
+ContactRecord::ContactRecord()
+  : point(Eigen::Vector3d::Zero()),
+    normal(Eigen::Vector3d::Zero()),
+    force(Eigen::Vector3d::Zero()),
+    bodyNode1(nullptr),
+    bodyNode2(nullptr),
+    shapeNode1(nullptr),
+    shapeNode2(nullptr),
+    penetrationDepth(0.0),
+    timeOfImpact(0.0),
+    gap(0.0),
+    triID1(-1),
+    triID2(-1),
+    userData(nullptr)
+{
+  // Do nothing
+}
+
 CollisionDetector::CollisionDetector()
   : mNumMaxContacts(100) {
 }
@@ -85,6 +228,9 @@ void CollisionDetector::removeSkeleton(const dynamics::SkeletonPtr& _skeleton)
 
   if (containSkeleton(_skeleton))
   {
+    // The contact records would be left with dangling pointers
+    clearAllContacts();
+
     mSkeletons.erase(remove(mSkeletons.begin(), mSkeletons.end(), _skeleton),
                      mSkeletons.end());
     for (size_t i = 0; i < _skeleton->getNumBodyNodes(); ++i)
@@ -151,6 +297,8 @@ void CollisionDetector::removeCollisionSkeletonNode(
     return;
   }
 
+  clearAllContacts();
+
   // Update index of collision nodes.
   size_t iCollNode = collNode->getIndex();
   for (size_t i = iCollNode + 1; i < mCollisionNodes.size(); ++i)
@@ -190,15 +338,235 @@ bool CollisionDetector::detectCollision(dynamics::BodyNode* _node1,
                          _calculateContactPoints);
 }
 
+//==============================================================================
+bool CollisionDetector::detectContinuousCollision(double _timeStep)
+{
+  if (_timeStep <= 0.0)
+    return false;
+
+  std::vector<size_t> fastNodes;
+  for (size_t i = 0; i < mCollisionNodes.size(); ++i)
+  {
+    // The shapes of soft bodies deform during the step, so they are not swept
+    dynamics::BodyNode* bodyNode = mCollisionNodes[i]->getBodyNode();
+    if (bodyNode->isContinuousCollision()
+        && !dynamic_cast<dynamics::SoftBodyNode*>(bodyNode))
+      fastNodes.push_back(i);
+  }
+
+  if (fastNodes.empty())
+    return false;
+
+  const size_t numDiscreteContacts = mContactRecords.size();
+  std::vector<ContactRecord> contacts;
+  std::vector<ContactRecord> bisectionContacts;
+
+  for (size_t k = 0; k < fastNodes.size(); ++k)
+  {
+    for (size_t j = 0; j < mCollisionNodes.size(); ++j)
+    {
+      const size_t i = fastNodes[k];
+      if (i == j)
+        continue;
+
+      // Pairs of two fast bodies are only swept once
+      if (j < i
+          && std::binary_search(fastNodes.begin(), fastNodes.begin() + k, j))
+        continue;
+
+      if (dynamic_cast<dynamics::SoftBodyNode*>(
+            mCollisionNodes[j]->getBodyNode()))
+        continue;
+
+      CollisionNode* collNode1 = mCollisionNodes[std::min(i, j)];
+      CollisionNode* collNode2 = mCollisionNodes[std::max(i, j)];
+      dynamics::BodyNode* bodyNode1 = collNode1->getBodyNode();
+      dynamics::BodyNode* bodyNode2 = collNode2->getBodyNode();
+
+      if (!isCollidable(collNode1, collNode2))
+        continue;
+
+      // Bodies that are already in contact are handled by the discrete contacts
+      if (hasContact(mContactRecords, numDiscreteContacts,
+                     bodyNode1, bodyNode2))
+        continue;
+
+      const BodyMotion motion1(bodyNode1);
+      const BodyMotion motion2(bodyNode2);
+
+      double radius1;
+      double radius2;
+      double thickness1;
+      double thickness2;
+      computeBodyExtents(bodyNode1, radius1, thickness1);
+      computeBodyExtents(bodyNode2, radius2, thickness2);
+
+      const Eigen::Vector3d relativeVelocity
+          = motion1.mLinearVelocity - motion2.mLinearVelocity;
+      if (!isSweptSphereColliding(
+            motion1.mTransform.translation() - motion2.mTransform.translation(),
+            relativeVelocity, radius1 + radius2, _timeStep))
+        continue;
+
+      // Sample the motion so that no point of either body travels more than
+      // half of the thinnest shape between two samples
+      double travel = relativeVelocity.norm();
+      if (!std::isinf(radius1))
+        travel += motion1.mAngularVelocity.norm() * radius1;
+      if (!std::isinf(radius2))
+        travel += motion2.mAngularVelocity.norm() * radius2;
+      travel *= _timeStep;
+
+      const double thickness = std::min(thickness1, thickness2);
+      double numSamples = DART_CCD_MAX_NUM_SAMPLES;
+      if (std::isinf(thickness))
+        numSamples = 1.0;
+      else if (thickness > 0.0)
+        numSamples = std::ceil(travel / (0.5 * thickness));
+      numSamples = std::min(std::max(numSamples, 1.0),
+                            static_cast<double>(DART_CCD_MAX_NUM_SAMPLES));
+
+      double freeTime = 0.0;
+      double hitTime = -1.0;
+      for (double n = 1.0; n <= numSamples; n += 1.0)
+      {
+        const double time = _timeStep * n / numSamples;
+        contacts.clear();
+        if (collideAt(collNode1, motion1.getTransform(time),
+                      collNode2, motion2.getTransform(time), &contacts))
+        {
+          hitTime = time;
+          break;
+        }
+
+        freeTime = time;
+      }
+
+      if (hitTime < 0.0)
+        continue;
+
+      // Narrow down the first collision
+      for (size_t n = 0; n < DART_CCD_NUM_BISECTIONS; ++n)
+      {
+        const double time = 0.5 * (freeTime + hitTime);
+        bisectionContacts.clear();
+        if (collideAt(collNode1, motion1.getTransform(time),
+                      collNode2, motion2.getTransform(time),
+                      &bisectionContacts))
+        {
+          hitTime = time;
+          contacts.swap(bisectionContacts);
+        }
+        else
+        {
+          freeTime = time;
+        }
+      }
+
+      // The contact points lie on the bodies at the time of the collision.
+      // Move them back to the current pose of the fast body.
+      const BodyMotion& fastMotion
+          = bodyNode1->isContinuousCollision() ? motion1 : motion2;
+      const Eigen::Isometry3d backward
+          = fastMotion.mTransform * fastMotion.getTransform(hitTime).inverse();
+
+      for (ContactRecord& contact : contacts)
+      {
+        contact.point = backward * contact.point;
+
+        // Only the points that approach each other can collide
+        const double normalVelocity = contact.normal.dot(
+              motion1.getPointVelocity(contact.point)
+              - motion2.getPointVelocity(contact.point));
+        if (normalVelocity >= 0.0)
+          continue;
+
+        // Estimate when the points touch from their penetration at hitTime
+        contact.timeOfImpact = std::max(
+              freeTime, hitTime + contact.penetrationDepth / normalVelocity);
+        contact.gap = -normalVelocity * contact.timeOfImpact;
+        contact.penetrationDepth = 0.0;
+
+        mContactRecords.push_back(contact);
+      }
+    }
+  }
+
+  return mContactRecords.size() > numDiscreteContacts;
+}
+
+//==============================================================================
+bool CollisionDetector::collideAt(CollisionNode* /*_node1*/,
+                                  const Eigen::Isometry3d& /*_T1*/,
+                                  CollisionNode* /*_node2*/,
+                                  const Eigen::Isometry3d& /*_T2*/,
+                                  std::vector<ContactRecord>* /*_contacts*/)
+{
+  return false;
+}
+
 size_t CollisionDetector::getNumContacts() {
-  return mContacts.size();
+  return mContactRecords.size();
+}
+
+const Contact& CollisionDetector::getContact(int _idx) {
+  assert(0 <= _idx && static_cast<size_t>(_idx) < mContactRecords.size());
+
+  // The weak pointers of the views are only created when the first view of
+  // the current contacts is requested
+  if (mContacts.size() != mContactRecords.size())
+  {
+    mContacts.resize(mContactRecords.size());
+    for (size_t i = 0; i < mContactRecords.size(); ++i)
+    {
+      const ContactRecord& record = mContactRecords[i];
+      Contact& contact = mContacts[i];
+      contact.bodyNode1 = record.bodyNode1;
+      contact.bodyNode2 = record.bodyNode2;
+      contact.shape1 = record.shapeNode1 ? record.shapeNode1->getShape()
+                                         : nullptr;
+      contact.shape2 = record.shapeNode2 ? record.shapeNode2->getShape()
+                                         : nullptr;
+    }
+  }
+
+  // The remaining data is copied every time since the constraint solver keeps
+  // updating the force of the record
+  const ContactRecord& record = mContactRecords[_idx];
+  Contact& contact = mContacts[_idx];
+  contact.point = record.point;
+  contact.normal = record.normal;
+  contact.force = record.force;
+  contact.penetrationDepth = record.penetrationDepth;
+  contact.timeOfImpact = record.timeOfImpact;
+  contact.gap = record.gap;
+  contact.triID1 = record.triID1;
+  contact.triID2 = record.triID2;
+  contact.userData = record.userData;
+
+  return contact;
+}
+
+ContactRecord& CollisionDetector::getContactRecord(size_t _idx) {
+  assert(_idx < mContactRecords.size());
+  return mContactRecords[_idx];
 }
 
-Contact& CollisionDetector::getContact(int _idx) {
-  return mContacts[_idx];
+const ContactRecord& CollisionDetector::getContactRecord(size_t _idx) const {
+  assert(_idx < mContactRecords.size());
+  return mContactRecords[_idx];
 }
 
 void CollisionDetector::clearAllContacts() {
+  mContactRecords.clear();
+  mContacts.clear();
+}
+
+//==============================================================================
+void CollisionDetector::swapContactRecords(
+    std::vector<ContactRecord>& _records)
+{
+  mContactRecords.swap(_records);
   mContacts.clear();
 }
 
@@ -239,13 +607,25 @@ bool CollisionDetector::isCollidable(const CollisionNode* _node1,
   if (!bn1->isCollidable() || !bn2->isCollidable())
     return false;
 
-  if (bn1->getSkeleton() == bn2->getSkeleton())
+  // Sleeping skeletons only need to be checked against awake mobile skeletons,
+  // which can wake them up
+  const dynamics::SkeletonPtr skel1 = bn1->getSkeleton();
+  const dynamics::SkeletonPtr skel2 = bn2->getSkeleton();
+  if (skel1->isSleeping() || skel2->isSleeping())
+  {
+    const bool isAwake1 = skel1->isMobile() && !skel1->isSleeping();
+    const bool isAwake2 = skel2->isMobile() && !skel2->isSleeping();
+    if (!isAwake1 && !isAwake2)
+      return false;
+  }
+
+  if (skel1 == skel2)
   {
-    if (bn1->getSkeleton()->isEnabledSelfCollisionCheck())
+    if (skel1->isEnabledSelfCollisionCheck())
     {
       if (isAdjacentBodies(bn1, bn2))
       {
-        if (!bn1->getSkeleton()->isEnabledAdjacentBodyCheck())
+        if (!skel1->isEnabledAdjacentBodyCheck())
           return false;
       }
     }
@@ -81,6 +81,15 @@ struct Contact {
   /// Penetration depth
   double penetrationDepth;
 
+  /// Time from the beginning of the step at which the bodies are predicted to
+  /// touch, or zero for a contact that already exists. See
+  /// CollisionDetector::detectContinuousCollision().
+  double timeOfImpact;
+
+  /// Distance the bodies of a predicted contact close before they touch, or
+  /// zero for a contact that already exists
+  double gap;
+
   // TODO(JS): triID1 will be deprecated when we don't use fcl_mesh
   /// \brief
   int triID1;
@@ -94,6 +103,66 @@ struct Contact {
   void* userData;
 };
 
+/// Plain data version of Contact that the collision detectors and the
+/// constraint solver pass around within a time step. It refers to the bodies
+/// and shapes with raw pointers, so creating, copying and reading a record
+/// neither locks a BodyNodePtr nor changes any reference count.
+///
+/// The pointers are only valid until the next clearAllContacts() of the
+/// CollisionDetector that created the record. Removing a Skeleton from the
+/// detector clears the contacts as well, so a record never outlives the
+/// BodyNodes it refers to.
+struct ContactRecord {
+  // To get byte-aligned Eigen vectors
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  /// Constructor
+  ContactRecord();
+
+  /// Contact point w.r.t. the world frame
+  Eigen::Vector3d point;
+
+  /// Contact normal vector from bodyNode2 to bodyNode1 w.r.t. the world frame
+  Eigen::Vector3d normal;
+
+  /// Contact force acting on bodyNode1 w.r.t. the world frame
+  Eigen::Vector3d force;
+
+  /// First colliding body node
+  dynamics::BodyNode* bodyNode1;
+
+  /// Second colliding body node
+  dynamics::BodyNode* bodyNode2;
+
+  /// ShapeNode of the first colliding shape, or nullptr if the collision
+  /// detector does not resolve contacts down to shapes
+  dynamics::ShapeNode* shapeNode1;
+
+  /// ShapeNode of the second colliding shape, or nullptr if the collision
+  /// detector does not resolve contacts down to shapes
+  dynamics::ShapeNode* shapeNode2;
+
+  /// Penetration depth. It is zero for a predicted contact.
+  double penetrationDepth;
+
+  /// Time from the beginning of the step at which the bodies are predicted to
+  /// touch, or zero for a contact that already exists
+  double timeOfImpact;
+
+  /// Distance the bodies of a predicted contact close before they touch, or
+  /// zero for a contact that already exists
+  double gap;
+
+  /// Triangle index of the first shape, if it is a mesh
+  int triID1;
+
+  /// Triangle index of the second shape, if it is a mesh
+  int triID2;
+
+  /// User data
+  void* userData;
+};
+
 /// \brief class CollisionDetector
 class CollisionDetector
 {
@@ -138,6 +207,24 @@ public:
   virtual bool detectCollision(bool _checkAllCollisions,
                                bool _calculateContactPoints) = 0;
 
+  /// Append predicted contacts for the fast bodies to the contacts of the last
+  /// collision check. Every collidable pair that involves a BodyNode with
+  /// BodyNode::isContinuousCollision() set and that is not in contact yet is
+  /// swept along the current velocities of the two bodies over _timeStep. If
+  /// the bodies would touch during the step, the contacts at the time of
+  /// impact are moved back to the current poses of the bodies and appended
+  /// with the remaining distance between them as ContactRecord::gap, which
+  /// the constraint solver lets the bodies close but nothing more. Returns
+  /// true if any contact was added.
+  ///
+  /// The sweep samples the motion densely enough that neither body can skip
+  /// over half of the thinnest shape of the pair between two samples and
+  /// refines the first colliding sample by bisection. Soft bodies are not
+  /// swept. Collision detectors that do not implement collideAt() do not
+  /// predict any contacts.
+  /// \param[in] _timeStep Duration of the step to sweep over
+  bool detectContinuousCollision(double _timeStep);
+
   /// Return true if there exists contacts between two bodies
   /// \param[in] _calculateContactPoints True to get contact points
   bool detectCollision(dynamics::BodyNode* _node1, dynamics::BodyNode* _node2,
@@ -146,12 +233,27 @@ public:
   /// \brief
   size_t getNumContacts();
 
-  /// \brief
-  Contact& getContact(int _idx);
+  /// Get a contact of the last collision check. The returned Contact is a
+  /// read-only view of getContactRecord(_idx) that holds weak pointers to the
+  /// bodies, so a copy of it stays safe to use after the contacts have been
+  /// cleared. Use getContactRecord() to change a contact.
+  const Contact& getContact(int _idx);
+
+  /// Get a contact of the last collision check as plain data. This is what
+  /// the constraint solver works with.
+  ContactRecord& getContactRecord(size_t _idx);
+
+  /// Get a contact of the last collision check as plain data
+  const ContactRecord& getContactRecord(size_t _idx) const;
 
   /// \brief
   void clearAllContacts();
 
+  /// Exchange the contacts of the last collision check with _records. This
+  /// lets a caller run a collision check without losing the contacts that the
+  /// constraint solver has filled in, and put them back afterwards.
+  void swapContactRecords(std::vector<ContactRecord>& _records);
+
   /// \brief
   int getNumMaxContacts() const;
 
@@ -166,7 +268,21 @@ protected:
   virtual bool detectCollision(CollisionNode* _node1, CollisionNode* _node2,
                                bool _calculateContactPoints) = 0;
 
-  /// \brief
+  /// Collide the shapes of _node1 and _node2 as if their BodyNodes had the
+  /// world transforms _T1 and _T2 instead of their current ones, and append
+  /// the contacts to _contacts. This is what detectContinuousCollision() uses
+  /// to test the predicted poses of the bodies. Returns true if the shapes
+  /// collide. The default implementation does not support it and returns
+  /// false.
+  virtual bool collideAt(CollisionNode* _node1, const Eigen::Isometry3d& _T1,
+                         CollisionNode* _node2, const Eigen::Isometry3d& _T2,
+                         std::vector<ContactRecord>* _contacts);
+
+  /// Contacts found by the last collision check
+  std::vector<ContactRecord> mContactRecords;
+
+  /// Views of mContactRecords that are handed out by getContact(). They are
+  /// created on demand.
   std::vector<Contact> mContacts;
 
   /// \brief
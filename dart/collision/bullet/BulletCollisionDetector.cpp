@@ -173,14 +173,14 @@ bool BulletCollisionDetector::detectCollision(bool /*_checkAllCollisions*/,
 //  std::cout << "Number of collision objects: "
 //            << collWorld->getNumCollisionObjects() << std::endl;
 
-  // Clear mContacts which is the list of old contacts
+  // Clear the list of old contacts
   clearAllContacts();
 
   // Set all the body nodes are not in colliding
   for (size_t i = 0; i < mCollisionNodes.size(); i++)
     mCollisionNodes[i]->getBodyNode()->setColliding(false);
 
-  // Add all the contacts to mContacts
+  // Add all the contacts to mContactRecords
   int numManifolds = mBulletCollisionWorld->getDispatcher()->getNumManifolds();
   btDispatcher* dispatcher = mBulletCollisionWorld->getDispatcher();
   for (int i = 0; i < numManifolds; ++i)
@@ -202,23 +202,23 @@ bool BulletCollisionDetector::detectCollision(bool /*_checkAllCollisions*/,
     {
       btManifoldPoint& cp = contactManifold->getContactPoint(j);
 
-      Contact contactPair;
+      ContactRecord contactPair;
       contactPair.point            = convertVector3(cp.getPositionWorldOnA());
       contactPair.normal           = convertVector3(cp.m_normalWorldOnB);
       contactPair.penetrationDepth = -cp.m_distance1;
       contactPair.bodyNode1   = userDataA->btCollNode->getBodyNode();
       contactPair.bodyNode2   = userDataB->btCollNode->getBodyNode();
 
-      mContacts.push_back(contactPair);
+      mContactRecords.push_back(contactPair);
 
       // Set these two bodies are in colliding
-      contactPair.bodyNode1.lock()->setColliding(true);
-      contactPair.bodyNode2.lock()->setColliding(true);
+      contactPair.bodyNode1->setColliding(true);
+      contactPair.bodyNode2->setColliding(true);
     }
   }
 
   // Return true if there are contacts
-  return !mContacts.empty();
+  return !mContactRecords.empty();
 }
 
 //==============================================================================
@@ -419,7 +419,7 @@ got_answer:
 // fields.
 int dBoxBox(const dVector3 p1, const dMatrix3 R1, const dVector3 side1,
             const dVector3 p2, const dMatrix3 R2, const dVector3 side2,
-            std::vector<Contact>& result)
+            std::vector<ContactRecord>& result)
 {
   const double fudge_factor = 1.05;
   dVector3 p,pp,normalC = {0.0, 0.0, 0.0, 0.0};
@@ -582,7 +582,7 @@ int dBoxBox(const dVector3 p1, const dMatrix3 R1, const dVector3 side1,
       point_vec << 0.5*(pa[0]+pb[0]), 0.5*(pa[1]+pb[1]), 0.5*(pa[2]+pb[2]);
       penetration = -s;
 
-      Contact contact;
+      ContactRecord contact;
       contact.point = point_vec;
       contact.normal = normal;
       contact.penetrationDepth = penetration;
@@ -763,7 +763,7 @@ int dBoxBox(const dVector3 p1, const dMatrix3 R1, const dVector3 side1,
     {
       point_vec << point[j*3+0] + pa[0], point[j*3+1] + pa[1], point[j*3+2] + pa[2];
 
-      Contact contact;
+      ContactRecord contact;
       contact.point = point_vec;
       contact.normal = normal;
       contact.penetrationDepth = dep[j];
@@ -790,7 +790,7 @@ int dBoxBox(const dVector3 p1, const dMatrix3 R1, const dVector3 side1,
     {
       point_vec << point[iret[j]*3+0] + pa[0], point[iret[j]*3+1] + pa[1], point[iret[j]*3+2] + pa[2];
 
-      Contact contact;
+      ContactRecord contact;
       contact.point = point_vec;
       contact.normal = normal;
       contact.penetrationDepth = dep[iret[j]];
@@ -802,7 +802,7 @@ int dBoxBox(const dVector3 p1, const dMatrix3 R1, const dVector3 side1,
 
 int collideBoxBox(const Eigen::Vector3d& size0, const Eigen::Isometry3d& T0,
                   const Eigen::Vector3d& size1, const Eigen::Isometry3d& T1,
-                  std::vector<Contact>* result)
+                  std::vector<ContactRecord>* result)
 {
   dVector3 halfSize0;
   dVector3 halfSize1;
@@ -826,7 +826,7 @@ int collideBoxBox(const Eigen::Vector3d& size0, const Eigen::Isometry3d& T0,
 
 int	collideBoxSphere(const Eigen::Vector3d& size0, const Eigen::Isometry3d& T0,
                      const double& r1, const Eigen::Isometry3d& T1,
-                     std::vector<Contact>* result)
+                     std::vector<ContactRecord>* result)
 {
   Eigen::Vector3d halfSize = 0.5 * size0;
   bool inside_box = true;
@@ -873,7 +873,7 @@ int	collideBoxSphere(const Eigen::Vector3d& size0, const Eigen::Isometry3d& T0,
     normal = T0.linear() * normal;
     penetration = min + r1;
 
-    Contact contact;
+    ContactRecord contact;
     contact.point = c0;
     contact.normal = normal;
     contact.penetrationDepth = penetration;
@@ -896,7 +896,7 @@ int	collideBoxSphere(const Eigen::Vector3d& size0, const Eigen::Isometry3d& T0,
   {
     normal *= (1.0/mag);
 
-    Contact contact;
+    ContactRecord contact;
     contact.point = contactpt;
     contact.normal = normal;
     contact.penetrationDepth = penetration;
@@ -924,7 +924,7 @@ int	collideBoxSphere(const Eigen::Vector3d& size0, const Eigen::Isometry3d& T0,
     normal[idx] = (p[idx] > 0.0 ? -1.0 : 1.0);
     normal = T0.linear() * normal;
 
-    Contact contact;
+    ContactRecord contact;
     contact.point = contactpt;
     contact.normal = normal;
     contact.penetrationDepth = penetration;
@@ -935,7 +935,7 @@ int	collideBoxSphere(const Eigen::Vector3d& size0, const Eigen::Isometry3d& T0,
 
 int collideSphereBox(const double& r0, const Eigen::Isometry3d& T0,
                      const Eigen::Vector3d& size1, const Eigen::Isometry3d& T1,
-                     std::vector<Contact>* result)
+                     std::vector<ContactRecord>* result)
 {
   Eigen::Vector3d size = 0.5 * size1;
   bool inside_box = true;
@@ -980,7 +980,7 @@ int collideSphereBox(const double& r0, const Eigen::Isometry3d& T0,
     normal = T1.linear() * normal;
     penetration = min + r0;
 
-    Contact contact;
+    ContactRecord contact;
     contact.point = c0;
     contact.normal = normal;
     contact.penetrationDepth = penetration;
@@ -1003,7 +1003,7 @@ int collideSphereBox(const double& r0, const Eigen::Isometry3d& T0,
   {
     normal *= (1.0/mag);
 
-    Contact contact;
+    ContactRecord contact;
     contact.point = contactpt;
     contact.normal = normal;
     contact.penetrationDepth = penetration;
@@ -1029,7 +1029,7 @@ int collideSphereBox(const double& r0, const Eigen::Isometry3d& T0,
     normal[idx] = (p[idx] > 0.0 ? 1.0 : -1.0);
     normal = T1.linear() * normal;
 
-    Contact contact;
+    ContactRecord contact;
     contact.point = contactpt;
     contact.normal = normal;
     contact.penetrationDepth = penetration;
@@ -1040,7 +1040,7 @@ int collideSphereBox(const double& r0, const Eigen::Isometry3d& T0,
 
 int collideSphereSphere(const double& _r0, const Eigen::Isometry3d& c0,
                         const double& _r1, const Eigen::Isometry3d& c1,
-                        std::vector<Contact>* result)
+                        std::vector<ContactRecord>* result)
 {
   double r0 = _r0;
   double r1 = _r1;
@@ -1064,7 +1064,7 @@ int collideSphereSphere(const double& _r0, const Eigen::Isometry3d& c0,
     normal.setZero();
     penetration = rsum;
 
-    Contact contact;
+    ContactRecord contact;
     contact.point = point;
     contact.normal = normal;
     contact.penetrationDepth = penetration;
@@ -1076,7 +1076,7 @@ int collideSphereSphere(const double& _r0, const Eigen::Isometry3d& c0,
   normal *= (1.0/normal_sqr);
   penetration = rsum - normal_sqr;
 
-  Contact contact;
+  ContactRecord contact;
   contact.point = point;
   contact.normal = normal;
   contact.penetrationDepth = penetration;
@@ -1087,7 +1087,7 @@ int collideSphereSphere(const double& _r0, const Eigen::Isometry3d& c0,
 
 int collideCylinderSphere(const double& cyl_rad, const double& half_height, const Eigen::Isometry3d& T0,
                           const double& sphere_rad, const Eigen::Isometry3d& T1,
-                          std::vector<Contact>* result)
+                          std::vector<ContactRecord>* result)
 {
   Eigen::Vector3d center = T0.inverse() * T1.translation();
 
@@ -1095,7 +1095,7 @@ int collideCylinderSphere(const double& cyl_rad, const double& half_height, cons
 
   if ( dist < cyl_rad && std::abs(center[2]) < half_height + sphere_rad )
   {
-    Contact contact;
+    ContactRecord contact;
     contact.penetrationDepth = 0.5 * (half_height + sphere_rad - math::sign(center[2]) * center[2]);
     contact.point = T0 * Eigen::Vector3d(center[0], center[1], half_height - contact.penetrationDepth);
     contact.normal = T0.linear() * Eigen::Vector3d(0.0, 0.0, math::sign(center[2]));
@@ -1119,7 +1119,7 @@ int collideCylinderSphere(const double& cyl_rad, const double& half_height, cons
 
         if (penetration > 0.0)
         {
-          Contact contact;
+          ContactRecord contact;
           contact.point = point;
           contact.normal = normal;
           contact.penetrationDepth = penetration;
@@ -1135,7 +1135,7 @@ int collideCylinderSphere(const double& cyl_rad, const double& half_height, cons
         point[2] = center[2];
         point = T0 * point;
 
-        Contact contact;
+        ContactRecord contact;
         contact.point = point;
         contact.normal = normal;
         contact.penetrationDepth = penetration;
@@ -1149,7 +1149,7 @@ int collideCylinderSphere(const double& cyl_rad, const double& half_height, cons
 
 int collideCylinderPlane(const double& cyl_rad, const double& half_height, const Eigen::Isometry3d& T0,
                          const Eigen::Vector3d& plane_normal, const Eigen::Isometry3d& T1,
-                         std::vector<Contact>* result)
+                         std::vector<ContactRecord>* result)
 {
   Eigen::Vector3d normal = T1.linear() * plane_normal;
   Eigen::Vector3d Rx = T0.linear().rightCols(1);
@@ -1205,7 +1205,7 @@ int collideCylinderPlane(const double& cyl_rad, const double& half_height, const
 
   if (penetration > 0.0)
   {
-    Contact contact;
+    ContactRecord contact;
     contact.point = point;
     contact.normal = normal;
     contact.penetrationDepth = penetration;
@@ -1218,7 +1218,7 @@ int collideCylinderPlane(const double& cyl_rad, const double& half_height, const
 
 int collide(dynamics::ConstShapePtr _shape0, const Eigen::Isometry3d& _T0,
             dynamics::ConstShapePtr _shape1, const Eigen::Isometry3d& _T1,
-            std::vector<Contact>* _result)
+            std::vector<ContactRecord>* _result)
 {
   dynamics::Shape::ShapeType LeftType = _shape0->getShapeType();
   dynamics::Shape::ShapeType RightType = _shape1->getShapeType();
@@ -65,7 +65,7 @@ bool DARTCollisionDetector::detectCollision(bool /*_checkAllCollisions*/,
   for (size_t i = 0; i < mCollisionNodes.size(); i++)
     mCollisionNodes[i]->getBodyNode()->setColliding(false);
 
-  std::vector<Contact> contacts;
+  std::vector<ContactRecord> contacts;
 
   for (size_t i = 0; i < mCollisionNodes.size(); i++) {
     for (size_t j = i + 1; j < mCollisionNodes.size(); j++) {
@@ -83,7 +83,7 @@ bool DARTCollisionDetector::detectCollision(bool /*_checkAllCollisions*/,
         auto collShapeNodes2 = BodyNode2->getShapeNodesWith<dynamics::CollisionAddon>();
         for (auto shapeNode2 : collShapeNodes2)
         {
-          int currContactNum = mContacts.size();
+          int currContactNum = mContactRecords.size();
 
           contacts.clear();
           collide(shapeNode1->getShape(), shapeNode1->getWorldTransform(),
@@ -93,22 +93,24 @@ bool DARTCollisionDetector::detectCollision(bool /*_checkAllCollisions*/,
           size_t numContacts = contacts.size();
 
           for (unsigned int m = 0; m < numContacts; ++m) {
-            Contact contactPair;
+            ContactRecord contactPair;
             contactPair = contacts[m];
             contactPair.bodyNode1 = BodyNode1;
             contactPair.bodyNode2 = BodyNode2;
-            assert(contactPair.bodyNode1.lock() != nullptr);
-            assert(contactPair.bodyNode2.lock() != nullptr);
+            contactPair.shapeNode1 = shapeNode1;
+            contactPair.shapeNode2 = shapeNode2;
+            assert(contactPair.bodyNode1 != nullptr);
+            assert(contactPair.bodyNode2 != nullptr);
 
-            mContacts.push_back(contactPair);
+            mContactRecords.push_back(contactPair);
           }
 
           std::vector<bool> markForDeletion(numContacts, false);
           for (size_t m = 0; m < numContacts; m++) {
             for (size_t n = m + 1; n < numContacts; n++) {
               Eigen::Vector3d diff =
-                  mContacts[currContactNum + m].point -
-                  mContacts[currContactNum + n].point;
+                  mContactRecords[currContactNum + m].point -
+                  mContactRecords[currContactNum + n].point;
               if (diff.dot(diff) < 1e-6) {
                 markForDeletion[m] = true;
                 break;
@@ -119,27 +121,28 @@ bool DARTCollisionDetector::detectCollision(bool /*_checkAllCollisions*/,
           for (int m = numContacts - 1; m >= 0; m--)
           {
             if (markForDeletion[m])
-              mContacts.erase(mContacts.begin() + currContactNum + m);
+              mContactRecords.erase(
+                    mContactRecords.begin() + currContactNum + m);
           }
         }
       }
     }
   }
 
-  for (size_t i = 0; i < mContacts.size(); ++i)
+  for (size_t i = 0; i < mContactRecords.size(); ++i)
   {
     // Set these two bodies are in colliding
-    mContacts[i].bodyNode1.lock()->setColliding(true);
-    mContacts[i].bodyNode2.lock()->setColliding(true);
+    mContactRecords[i].bodyNode1->setColliding(true);
+    mContactRecords[i].bodyNode2->setColliding(true);
   }
 
-  return !mContacts.empty();
+  return !mContactRecords.empty();
 }
 
 bool DARTCollisionDetector::detectCollision(CollisionNode* _collNode1,
                                             CollisionNode* _collNode2,
                                             bool /*_calculateContactPoints*/) {
-  std::vector<Contact> contacts;
+  std::vector<ContactRecord> contacts;
   dynamics::BodyNode* BodyNode1 = _collNode1->getBodyNode();
   dynamics::BodyNode* BodyNode2 = _collNode2->getBodyNode();
 
@@ -168,5 +171,67 @@ bool DARTCollisionDetector::detectCollision(CollisionNode* _collNode1,
   return contacts.size() > 0 ? true : false;
 }
 
+//==============================================================================
+bool DARTCollisionDetector::collideAt(CollisionNode* _node1,
+                                      const Eigen::Isometry3d& _T1,
+                                      CollisionNode* _node2,
+                                      const Eigen::Isometry3d& _T2,
+                                      std::vector<ContactRecord>* _contacts)
+{
+  dynamics::BodyNode* bodyNode1 = _node1->getBodyNode();
+  dynamics::BodyNode* bodyNode2 = _node2->getBodyNode();
+
+  // Transforms that move the shapes from the current poses of the bodies to
+  // the given ones
+  const Eigen::Isometry3d move1
+      = _T1 * bodyNode1->getWorldTransform().inverse();
+  const Eigen::Isometry3d move2
+      = _T2 * bodyNode2->getWorldTransform().inverse();
+
+  const size_t numContacts = _contacts->size();
+  std::vector<ContactRecord> contacts;
+
+  const auto collShapeNodes1
+      = bodyNode1->getShapeNodesWith<dynamics::CollisionAddon>();
+  const auto collShapeNodes2
+      = bodyNode2->getShapeNodesWith<dynamics::CollisionAddon>();
+  for (auto shapeNode1 : collShapeNodes1)
+  {
+    for (auto shapeNode2 : collShapeNodes2)
+    {
+      contacts.clear();
+      collide(shapeNode1->getShape(), move1 * shapeNode1->getWorldTransform(),
+              shapeNode2->getShape(), move2 * shapeNode2->getWorldTransform(),
+              &contacts);
+
+      for (size_t m = 0; m < contacts.size(); ++m)
+      {
+        // Skip the points that are repeated later on, like detectCollision()
+        bool isRepeated = false;
+        for (size_t n = m + 1; n < contacts.size(); ++n)
+        {
+          if ((contacts[m].point - contacts[n].point).squaredNorm() < 1e-6)
+          {
+            isRepeated = true;
+            break;
+          }
+        }
+
+        if (isRepeated)
+          continue;
+
+        ContactRecord contact = contacts[m];
+        contact.bodyNode1 = bodyNode1;
+        contact.bodyNode2 = bodyNode2;
+        contact.shapeNode1 = shapeNode1;
+        contact.shapeNode2 = shapeNode2;
+        _contacts->push_back(contact);
+      }
+    }
+  }
+
+  return _contacts->size() > numContacts;
+}
+
 }  // namespace collision
 }  // namespace dart
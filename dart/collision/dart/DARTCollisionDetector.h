@@ -63,6 +63,11 @@ protected:
   virtual bool detectCollision(CollisionNode* _collNode1,
                                CollisionNode* _collNode2,
                                bool _calculateContactPoints);
+
+  // Documentation inherited
+  virtual bool collideAt(CollisionNode* _node1, const Eigen::Isometry3d& _T1,
+                         CollisionNode* _node2, const Eigen::Isometry3d& _T2,
+                         std::vector<ContactRecord>* _contacts);
 };
 
 }  // namespace collision
@@ -42,6 +42,7 @@
 #include "dart/dynamics/Shape.h"
 #include "dart/dynamics/BodyNode.h"
 #include "dart/dynamics/Skeleton.h"
+#include "dart/dynamics/ShapeNode.h"
 #include "dart/collision/fcl/FCLCollisionNode.h"
 #include "dart/collision/fcl/FCLTypes.h"
 
@@ -146,7 +147,7 @@ bool isClose(const Eigen::Vector3d& _point1, const Eigen::Vector3d& _point2)
 }
 
 //==============================================================================
-bool hasClosePoint(const std::vector<Contact>& _contacts,
+bool hasClosePoint(const std::vector<ContactRecord>& _contacts,
                    const Eigen::Vector3d& _point)
 {
   for (const auto& contact : _contacts)
@@ -192,10 +193,10 @@ bool FCLCollisionDetector::detectCollision(bool /*_checkAllCollisions*/,
 
     Eigen::Vector3d point = FCLTypes::convertVector3(contact.pos);
 
-    if (hasClosePoint(mContacts, point))
+    if (hasClosePoint(mContactRecords, point))
       continue;
 
-    Contact contactPair;
+    ContactRecord contactPair;
     contactPair.point = point;
     contactPair.normal = -FCLTypes::convertVector3(contact.normal);
     contactPair.bodyNode1 = findCollisionNode(contact.o1)->getBodyNode();
@@ -203,20 +204,20 @@ bool FCLCollisionDetector::detectCollision(bool /*_checkAllCollisions*/,
     contactPair.triID1 = contact.b1;
     contactPair.triID2 = contact.b2;
     contactPair.penetrationDepth = contact.penetration_depth;
-    assert(contactPair.bodyNode1.lock());
-    assert(contactPair.bodyNode2.lock());
+    assert(contactPair.bodyNode1);
+    assert(contactPair.bodyNode2);
 
-    mContacts.push_back(contactPair);
+    mContactRecords.push_back(contactPair);
   }
 
-  for (size_t i = 0; i < mContacts.size(); ++i)
+  for (size_t i = 0; i < mContactRecords.size(); ++i)
   {
     // Set these two bodies are in colliding
-    mContacts[i].bodyNode1.lock()->setColliding(true);
-    mContacts[i].bodyNode2.lock()->setColliding(true);
+    mContactRecords[i].bodyNode1->setColliding(true);
+    mContactRecords[i].bodyNode2->setColliding(true);
   }
 
-  return !mContacts.empty();
+  return !mContactRecords.empty();
 }
 
 //==============================================================================
@@ -229,6 +230,87 @@ bool FCLCollisionDetector::detectCollision(CollisionNode* /*_node1*/,
   return false;
 }
 
+//==============================================================================
+bool FCLCollisionDetector::collideAt(CollisionNode* _node1,
+                                     const Eigen::Isometry3d& _T1,
+                                     CollisionNode* _node2,
+                                     const Eigen::Isometry3d& _T2,
+                                     std::vector<ContactRecord>* _contacts)
+{
+  FCLCollisionNode* collNode1 = static_cast<FCLCollisionNode*>(_node1);
+  FCLCollisionNode* collNode2 = static_cast<FCLCollisionNode*>(_node2);
+  dynamics::BodyNode* bodyNode1 = collNode1->getBodyNode();
+  dynamics::BodyNode* bodyNode2 = collNode2->getBodyNode();
+
+  // Transforms that move the shapes from the current poses of the bodies to
+  // the given ones
+  const Eigen::Isometry3d move1
+      = _T1 * bodyNode1->getWorldTransform().inverse();
+  const Eigen::Isometry3d move2
+      = _T2 * bodyNode2->getWorldTransform().inverse();
+
+  fcl::CollisionRequest request;
+  request.enable_contact = true;
+  request.num_max_contacts = getNumMaxContacts();
+
+  const size_t numContacts = _contacts->size();
+
+  // The geometries are collided directly so that the collision objects and
+  // the broad-phase structure keep the current poses
+  for (size_t i = 0; i < collNode1->getNumCollisionObjects(); ++i)
+  {
+    fcl::CollisionObject* collObj1 = collNode1->getCollisionObject(i);
+    dynamics::ShapeNode* shapeNode1
+        = static_cast<FCLCollisionNode::FCLUserData*>(
+            collObj1->getUserData())->shapeNode.lock().get();
+    const fcl::Transform3f tf1
+        = FCLTypes::convertTransform(move1 * shapeNode1->getWorldTransform());
+#if FCL_VERSION_AT_LEAST(0,3,0)
+    const fcl::CollisionGeometry* geom1 = collObj1->collisionGeometry().get();
+#else
+    const fcl::CollisionGeometry* geom1 = collObj1->getCollisionGeometry();
+#endif
+
+    for (size_t j = 0; j < collNode2->getNumCollisionObjects(); ++j)
+    {
+      fcl::CollisionObject* collObj2 = collNode2->getCollisionObject(j);
+      dynamics::ShapeNode* shapeNode2
+          = static_cast<FCLCollisionNode::FCLUserData*>(
+              collObj2->getUserData())->shapeNode.lock().get();
+      const fcl::Transform3f tf2
+          = FCLTypes::convertTransform(move2 * shapeNode2->getWorldTransform());
+#if FCL_VERSION_AT_LEAST(0,3,0)
+      const fcl::CollisionGeometry* geom2 = collObj2->collisionGeometry().get();
+#else
+      const fcl::CollisionGeometry* geom2 = collObj2->getCollisionGeometry();
+#endif
+
+      fcl::CollisionResult result;
+      fcl::collide(geom1, tf1, geom2, tf2, request, result);
+
+      for (size_t m = 0; m < result.numContacts(); ++m)
+      {
+        const fcl::Contact& contact = result.getContact(m);
+
+        ContactRecord contactPair;
+        contactPair.point = FCLTypes::convertVector3(contact.pos);
+        contactPair.normal = -FCLTypes::convertVector3(contact.normal);
+        contactPair.bodyNode1 = bodyNode1;
+        contactPair.bodyNode2 = bodyNode2;
+        contactPair.shapeNode1 = shapeNode1;
+        contactPair.shapeNode2 = shapeNode2;
+        contactPair.triID1 = contact.b1;
+        contactPair.triID2 = contact.b2;
+        contactPair.penetrationDepth = contact.penetration_depth;
+
+        _contacts->push_back(contactPair);
+      }
+    }
+  }
+
+  return _contacts->size() > numContacts;
+}
+
 //==============================================================================
 CollisionNode* FCLCollisionDetector::findCollisionNode(
     const fcl::CollisionGeometry* _fclCollGeom) const
@@ -80,6 +80,11 @@ protected:
   virtual bool detectCollision(CollisionNode* _node1, CollisionNode* _node2,
                                bool _calculateContactPoints) override;
 
+  // Documentation inherited
+  virtual bool collideAt(CollisionNode* _node1, const Eigen::Isometry3d& _T1,
+                         CollisionNode* _node2, const Eigen::Isometry3d& _T2,
+                         std::vector<ContactRecord>* _contacts) override;
+
   /// Broad-phase collision checker of FCL
   fcl::DynamicAABBTreeCollisionManager* mBroadPhaseAlg;
 };
@@ -84,7 +84,7 @@ bool FCLMeshCollisionDetector::detectCollision(bool _checkAllCollisions,
     static_cast<FCLMeshCollisionNode*>(mCollisionNodes[i])->updateShape();
 
   // Clear previous contacts
-  mContacts.clear();
+  clearAllContacts();
 
   //----------------------------------------------------------------------------
   // Detect collisions
@@ -106,8 +106,8 @@ bool FCLMeshCollisionDetector::detectCollision(bool _checkAllCollisions,
       if (!isCollidable(FCLMeshCollisionNode1, FCLMeshCollisionNode2))
         continue;
 
-      std::vector<Contact>* contactPoints
-          = _calculateContactPoints ? &mContacts : nullptr;
+      std::vector<ContactRecord>* contactPoints
+          = _calculateContactPoints ? &mContactRecords : nullptr;
       if (FCLMeshCollisionNode1->detectCollision(FCLMeshCollisionNode2,
                                                  contactPoints,
                                                  mNumMaxContacts))
@@ -136,7 +136,7 @@ bool FCLMeshCollisionDetector::detectCollision(CollisionNode* _node1,
       static_cast<FCLMeshCollisionNode*>(_node2);
   return collisionNode1->detectCollision(
         collisionNode2,
-        _calculateContactPoints ? &mContacts : nullptr,
+        _calculateContactPoints ? &mContactRecords : nullptr,
         mNumMaxContacts);
 }
 
@@ -150,9 +150,10 @@ FCLMeshCollisionNode::~FCLMeshCollisionNode()
 }
 
 //==============================================================================
-bool FCLMeshCollisionNode::detectCollision(FCLMeshCollisionNode* _otherNode,
-                                           std::vector<Contact>* _contactPoints,
-                                           int _num_max_contact)
+bool FCLMeshCollisionNode::detectCollision(
+    FCLMeshCollisionNode* _otherNode,
+    std::vector<ContactRecord>* _contactPoints,
+    int _num_max_contact)
 {
   evalRT();
   _otherNode->evalRT();
@@ -197,13 +198,13 @@ bool FCLMeshCollisionNode::detectCollision(FCLMeshCollisionNode* _otherNode,
       int numNoContacts = 0;
       int numContacts = 0;
 
-      std::vector<Contact> unfilteredContactPoints;
+      std::vector<ContactRecord> unfilteredContactPoints;
       unfilteredContactPoints.reserve(res.numContacts());
 
       for (size_t k = 0; k < res.numContacts(); k++)
       {
         // for each pair of intersecting triangles, we create two contact points
-        Contact pair1, pair2;
+        ContactRecord pair1, pair2;
         //            pair1.bd1 = mBodyNode;
         //            pair1.bd2 = _otherNode->mBodyNode;
         //            pair1.bdID1 = this->mBodyNodeID;
@@ -214,8 +215,8 @@ bool FCLMeshCollisionNode::detectCollision(FCLMeshCollisionNode* _otherNode,
         pair1.triID1 = res.getContact(k).b1;
         pair1.triID2 = res.getContact(k).b2;
         pair1.penetrationDepth = res.getContact(k).penetration_depth;
-        pair1.shape1 = collShapeNodes1[i]->getShape();
-        pair1.shape2 = collShapeNodes2[j]->getShape();
+        pair1.shapeNode1 = collShapeNodes1[i];
+        pair1.shapeNode2 = collShapeNodes2[j];
         pair2 = pair1;
         int contactResult =
             evalContactPosition(res.getContact(k), mMeshes[i],
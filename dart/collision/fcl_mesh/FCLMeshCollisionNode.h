@@ -82,7 +82,7 @@ public:
 
   ///
   virtual bool detectCollision(FCLMeshCollisionNode* _otherNode,
-                               std::vector<Contact>* _contactPoints,
+                               std::vector<ContactRecord>* _contactPoints,
                                int _max_num_contact);
   ///
   void updateShape();
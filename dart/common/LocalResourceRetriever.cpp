@@ -40,10 +40,30 @@
 #include "dart/common/Uri.h"
 #include "LocalResourceRetriever.h"
 #include "LocalResource.h"
+#include "MemoryMappedResource.h"
 
 namespace dart {
 namespace common {
 
+//==============================================================================
+LocalResourceRetriever::LocalResourceRetriever(bool _memoryMapped)
+  : mMemoryMapped(_memoryMapped)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void LocalResourceRetriever::setMemoryMapped(bool _memoryMapped)
+{
+  mMemoryMapped = _memoryMapped;
+}
+
+//==============================================================================
+bool LocalResourceRetriever::isMemoryMapped() const
+{
+  return mMemoryMapped;
+}
+
 //==============================================================================
 bool LocalResourceRetriever::exists(const Uri& _uri)
 {
@@ -65,6 +85,17 @@ common::ResourcePtr LocalResourceRetriever::retrieve(const Uri& _uri)
   else if (!_uri.mPath)
     return nullptr;
 
+  if(mMemoryMapped)
+  {
+    const auto resource
+        = std::make_shared<MemoryMappedResource>(_uri.getFilesystemPath());
+
+    if(resource->isGood())
+      return resource;
+    else
+      return nullptr;
+  }
+
   const auto resource
       = std::make_shared<LocalResource>(_uri.getFilesystemPath());
 
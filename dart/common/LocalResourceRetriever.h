@@ -43,17 +43,32 @@ namespace dart {
 namespace common {
 
 /// LocalResourceRetriever provides access to local resources specified by
-/// file:// URIs by wrapping the standard C and C++ file manipulation routines.
+/// file:// URIs. By default the files are memory-mapped, so their content is
+/// available through Resource::getData() without being copied. Otherwise the
+/// standard C file manipulation routines are used.
 class LocalResourceRetriever : public virtual ResourceRetriever
 {
 public:
+  /// Constructor. Files are read through MemoryMappedResource if _memoryMapped
+  /// is true and through LocalResource otherwise.
+  explicit LocalResourceRetriever(bool _memoryMapped = true);
+
   virtual ~LocalResourceRetriever() = default;
 
+  /// Set whether the retrieved files are memory-mapped
+  void setMemoryMapped(bool _memoryMapped);
+
+  /// Get whether the retrieved files are memory-mapped
+  bool isMemoryMapped() const;
+
   // Documentation inherited.
   bool exists(const Uri& _uri) override;
 
   // Documentation inherited.
   ResourcePtr retrieve(const Uri& _uri) override;
+
+private:
+  bool mMemoryMapped;
 };
 
 using LocalResourceRetrieverPtr = std::shared_ptr<LocalResourceRetriever>;
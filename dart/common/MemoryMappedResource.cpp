@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/common/MemoryMappedResource.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include "dart/common/Console.h"
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace dart {
+namespace common {
+
+namespace {
+
+/// Target of getData() for empty files
+const char gEmptyData[1] = { '\0' };
+
+} // anonymous namespace
+
+//==============================================================================
+MemoryMappedResource::MemoryMappedResource(const std::string& _path)
+  : mData(gEmptyData),
+    mSize(0u),
+    mOffset(0u),
+    mIsMapped(false),
+    mIsGood(false)
+{
+#ifdef _WIN32
+  const HANDLE file = CreateFileA(
+        _path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(file == INVALID_HANDLE_VALUE)
+  {
+    dtwarn << "[MemoryMappedResource::constructor] Failed opening file '"
+           << _path << "' for reading: error code " << GetLastError() << ".\n";
+    return;
+  }
+
+  LARGE_INTEGER size;
+  if(!GetFileSizeEx(file, &size))
+  {
+    dtwarn << "[MemoryMappedResource::constructor] Failed getting the size of"
+           << " file '" << _path << "': error code " << GetLastError() << ".\n";
+    CloseHandle(file);
+    return;
+  }
+  mSize = static_cast<size_t>(size.QuadPart);
+
+  if(mSize > 0u)
+  {
+    // The view keeps the mapping object alive, so both handles can be closed
+    // right away
+    const HANDLE mapping
+        = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mapping)
+    {
+      mData = static_cast<const char*>(
+            MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+      CloseHandle(mapping);
+    }
+    else
+    {
+      mData = nullptr;
+    }
+
+    if(!mData)
+    {
+      dtwarn << "[MemoryMappedResource::constructor] Failed mapping file '"
+             << _path << "': error code " << GetLastError() << ".\n";
+      mData = gEmptyData;
+      mSize = 0u;
+      CloseHandle(file);
+      return;
+    }
+    mIsMapped = true;
+  }
+
+  CloseHandle(file);
+#else
+  const int file = open(_path.c_str(), O_RDONLY);
+  if(file == -1)
+  {
+    dtwarn << "[MemoryMappedResource::constructor] Failed opening file '"
+           << _path << "' for reading: " << std::strerror(errno) << "\n";
+    return;
+  }
+
+  struct stat info;
+  if(fstat(file, &info) != 0)
+  {
+    dtwarn << "[MemoryMappedResource::constructor] Failed getting the status of"
+           << " file '" << _path << "': " << std::strerror(errno) << "\n";
+    close(file);
+    return;
+  }
+  else if(!S_ISREG(info.st_mode))
+  {
+    dtwarn << "[MemoryMappedResource::constructor] Failed mapping '" << _path
+           << "': Not a regular file.\n";
+    close(file);
+    return;
+  }
+  mSize = static_cast<size_t>(info.st_size);
+
+  if(mSize > 0u)
+  {
+    void* data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, file, 0);
+    if(data == MAP_FAILED)
+    {
+      dtwarn << "[MemoryMappedResource::constructor] Failed mapping file '"
+             << _path << "': " << std::strerror(errno) << "\n";
+      mSize = 0u;
+      close(file);
+      return;
+    }
+    mData = static_cast<const char*>(data);
+    mIsMapped = true;
+  }
+
+  // The mapping remains valid after the file descriptor is closed
+  close(file);
+#endif
+
+  mIsGood = true;
+}
+
+//==============================================================================
+MemoryMappedResource::~MemoryMappedResource()
+{
+  if(!mIsMapped)
+    return;
+
+#ifdef _WIN32
+  if(!UnmapViewOfFile(mData))
+  {
+    dtwarn << "[MemoryMappedResource::destructor] Failed unmapping file: error"
+           << " code " << GetLastError() << ".\n";
+  }
+#else
+  if(munmap(const_cast<char*>(mData), mSize) != 0)
+  {
+    dtwarn << "[MemoryMappedResource::destructor] Failed unmapping file: "
+           << std::strerror(errno) << "\n";
+  }
+#endif
+}
+
+//==============================================================================
+bool MemoryMappedResource::isGood() const
+{
+  return mIsGood;
+}
+
+//==============================================================================
+size_t MemoryMappedResource::getSize()
+{
+  return mSize;
+}
+
+//==============================================================================
+size_t MemoryMappedResource::tell()
+{
+  return mOffset;
+}
+
+//==============================================================================
+bool MemoryMappedResource::seek(ptrdiff_t _offset, SeekType _mode)
+{
+  ptrdiff_t origin;
+  switch(_mode)
+  {
+  case Resource::SEEKTYPE_CUR:
+    origin = static_cast<ptrdiff_t>(mOffset);
+    break;
+
+  case Resource::SEEKTYPE_END:
+    origin = static_cast<ptrdiff_t>(mSize);
+    break;
+
+  case Resource::SEEKTYPE_SET:
+    origin = 0;
+    break;
+
+  default:
+    dtwarn << "[MemoryMappedResource::seek] Invalid origin. Expected"
+              " SEEKTYPE_CUR, SEEKTYPE_END, or SEEKTYPE_SET.\n";
+    return false;
+  }
+
+  // Like fseek, seeking past the end is allowed; reads there return nothing
+  const ptrdiff_t offset = origin + _offset;
+  if(offset < 0)
+  {
+    dtwarn << "[MemoryMappedResource::seek] Failed seeking: Offset is before"
+              " the beginning of the resource.\n";
+    return false;
+  }
+
+  mOffset = static_cast<size_t>(offset);
+  return true;
+}
+
+//==============================================================================
+size_t MemoryMappedResource::read(void* _buffer, size_t _size, size_t _count)
+{
+  if(_size == 0u || mOffset >= mSize)
+    return 0u;
+
+  // Only full blocks are read, as with fread
+  const size_t count = std::min(_count, (mSize - mOffset) / _size);
+  std::memcpy(_buffer, mData + mOffset, count * _size);
+  mOffset += count * _size;
+
+  return count;
+}
+
+//==============================================================================
+const void* MemoryMappedResource::getData()
+{
+  return mIsGood ? mData : nullptr;
+}
+
+} // namespace common
+} // namespace dart
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COMMON_MEMORYMAPPEDRESOURCE_H_
+#define DART_COMMON_MEMORYMAPPEDRESOURCE_H_
+
+#include <string>
+#include "dart/common/Resource.h"
+
+namespace dart {
+namespace common {
+
+/// MemoryMappedResource maps a local file into memory. The whole content is
+/// available through getData() without being copied, and read() is a plain
+/// memcpy from the mapping. Pages are loaded lazily by the operating system,
+/// so mapping a large file is cheap even if only part of it is accessed.
+class MemoryMappedResource : public virtual Resource
+{
+public:
+  explicit MemoryMappedResource(const std::string& _path);
+  virtual ~MemoryMappedResource();
+
+  MemoryMappedResource(const MemoryMappedResource& _other) = delete;
+  MemoryMappedResource& operator=(const MemoryMappedResource& _other) = delete;
+
+  /// Return if the file has been mapped successfully.
+  bool isGood() const;
+
+  // Documentation inherited.
+  size_t getSize() override;
+
+  // Documentation inherited.
+  size_t tell() override;
+
+  // Documentation inherited.
+  bool seek(ptrdiff_t _offset, SeekType _origin) override;
+
+  // Documentation inherited.
+  size_t read(void* _buffer, size_t _size, size_t _count) override;
+
+  // Documentation inherited.
+  const void* getData() override;
+
+private:
+  /// Start of the mapping. Points to a static empty buffer for empty files,
+  /// which cannot be mapped.
+  const char* mData;
+
+  /// Size of the file, in bytes
+  size_t mSize;
+
+  /// Current position indicator
+  size_t mOffset;
+
+  /// Whether mData refers to an actual mapping that must be released
+  bool mIsMapped;
+
+  /// Whether the file has been opened and mapped successfully
+  bool mIsGood;
+};
+
+} // namespace common
+} // namespace dart
+
+#endif // ifndef DART_COMMON_MEMORYMAPPEDRESOURCE_H_
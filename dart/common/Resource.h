@@ -80,6 +80,14 @@ public:
   /// \param[in] _count Number of elements, each of _size bytes.
   /// \note This method has the same API as the standard fread function.
   virtual size_t read(void *_buffer, size_t _size, size_t _count) = 0; 
+
+  /// \brief Return a pointer to the whole content of the resource.
+  ///
+  /// Resources that hold their content in memory, e.g. memory-mapped files,
+  /// return a direct view of it, which remains valid for the lifetime of the
+  /// Resource. The view is independent of the position indicator. All other
+  /// resources return nullptr and must be accessed through read().
+  virtual const void* getData() { return nullptr; }
 };
 
 using ResourcePtr = std::shared_ptr<Resource>;
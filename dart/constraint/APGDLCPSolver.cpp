@@ -0,0 +1,410 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/constraint/APGDLCPSolver.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#include <Eigen/Dense>
+
+#include "dart/constraint/ConstraintBase.h"
+#include "dart/constraint/ConstrainedGroup.h"
+#include "dart/lcpsolver/lcp.h"
+
+#define LCP_APGD_OPTION_DEFAULT_ITERMAX          100
+#define LCP_APGD_OPTION_DEFAULT_EPS_RESIDUAL     1e-6
+#define LCP_APGD_OPTION_DEFAULT_LIPSCHITZ_DECAY  0.9
+#define LCP_APGD_OPTION_DEFAULT_CIRCULAR_CONE    true
+
+namespace dart {
+namespace constraint {
+
+namespace {
+
+typedef Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic,
+                                       Eigen::RowMajor>,
+                   0, Eigen::OuterStride<> > ConstRowMajorMap;
+
+/// Problems with fewer rows are not worth the overhead of the threads
+const int parallelThreshold = 256;
+
+/// Maximum number of times the Lipschitz estimate is doubled in one iteration
+const int maxBacktracks = 50;
+
+//==============================================================================
+/// Rows of the LCP grouped by the row that bounds them. Every row with
+/// findex < 0 is a primary row, and the rows that refer to it through findex
+/// are stored in mRows[mBegin[c]] ... mRows[mBegin[c + 1] - 1].
+struct RowGroups
+{
+  std::vector<int> mPrimary;
+  std::vector<int> mBegin;
+  std::vector<int> mRows;
+
+  RowGroups(int _n, const int* _findex)
+  {
+    std::vector<int> group(_n, -1);
+    for (int i = 0; i < _n; ++i)
+    {
+      if (_findex[i] < 0)
+      {
+        group[i] = static_cast<int>(mPrimary.size());
+        mPrimary.push_back(i);
+      }
+    }
+
+    mBegin.assign(mPrimary.size() + 1, 0);
+    for (int i = 0; i < _n; ++i)
+    {
+      if (_findex[i] >= 0)
+        ++mBegin[group[_findex[i]] + 1];
+    }
+    for (size_t c = 0; c < mPrimary.size(); ++c)
+      mBegin[c + 1] += mBegin[c];
+
+    mRows.resize(mBegin.back());
+    std::vector<int> next(mBegin.begin(), mBegin.end() - 1);
+    for (int i = 0; i < _n; ++i)
+    {
+      if (_findex[i] >= 0)
+        mRows[next[group[_findex[i]]]++] = i;
+    }
+  }
+};
+
+//==============================================================================
+/// Project (_n, _t1, _t2) onto the cone ||(t1, t2)|| <= _mu * n
+void projectOntoCone(double _mu, double& _n, double& _t1, double& _t2)
+{
+  const double tn = std::sqrt(_t1 * _t1 + _t2 * _t2);
+
+  if (tn <= _mu * _n)
+    return;
+
+  if (_mu * tn <= -_n)
+  {
+    _n = 0.0;
+    _t1 = 0.0;
+    _t2 = 0.0;
+    return;
+  }
+
+  const double n = (_n + _mu * tn) / (1.0 + _mu * _mu);
+  const double scale = _mu * n / tn;
+  _n = n;
+  _t1 *= scale;
+  _t2 *= scale;
+}
+
+//==============================================================================
+/// Project _x onto the feasible set
+void project(const RowGroups& _groups, const double* _lo, const double* _hi,
+             bool _circularCone, Eigen::VectorXd& _x)
+{
+  const int numGroups = static_cast<int>(_groups.mPrimary.size());
+
+#if defined(_OPENMP)
+#pragma omp parallel for if (numGroups >= parallelThreshold)
+#endif
+  for (int c = 0; c < numGroups; ++c)
+  {
+    const int i = _groups.mPrimary[c];
+    const int begin = _groups.mBegin[c];
+    const int end = _groups.mBegin[c + 1];
+
+    if (_circularCone && end - begin == 2 && _lo[i] == 0.0)
+    {
+      const int j = _groups.mRows[begin];
+      const int k = _groups.mRows[begin + 1];
+      const double mu = std::abs(_hi[j]);
+
+      if (mu == std::abs(_hi[k]))
+      {
+        projectOntoCone(mu, _x[i], _x[j], _x[k]);
+
+        if (_x[i] > _hi[i])
+        {
+          const double scale = _hi[i] / _x[i];
+          _x[i] = _hi[i];
+          _x[j] *= scale;
+          _x[k] *= scale;
+        }
+
+        continue;
+      }
+    }
+
+    _x[i] = std::min(std::max(_x[i], _lo[i]), _hi[i]);
+
+    for (int r = begin; r < end; ++r)
+    {
+      const int j = _groups.mRows[r];
+      const double bound = std::abs(_hi[j] * _x[i]);
+      _x[j] = std::min(std::max(_x[j], -bound), bound);
+    }
+  }
+}
+
+//==============================================================================
+/// _y = _A * _x
+void multiply(const ConstRowMajorMap& _A, const Eigen::VectorXd& _x,
+              Eigen::VectorXd& _y)
+{
+  const int n = static_cast<int>(_A.rows());
+
+#if defined(_OPENMP)
+#pragma omp parallel for if (n >= parallelThreshold)
+#endif
+  for (int i = 0; i < n; ++i)
+    _y[i] = _A.row(i).dot(_x);
+}
+
+//==============================================================================
+/// Largest violation of the optimality conditions at _x, measured as the
+/// change of a projected gradient step of length 1 / _L scaled by _L
+double computeResidual(const RowGroups& _groups, const double* _lo,
+                       const double* _hi, bool _circularCone,
+                       const Eigen::VectorXd& _x, const Eigen::VectorXd& _Ax,
+                       const Eigen::Map<const Eigen::VectorXd>& _b, double _L,
+                       Eigen::VectorXd& _tmp)
+{
+  _tmp = _x - (_Ax - _b) / _L;
+  project(_groups, _lo, _hi, _circularCone, _tmp);
+
+  return _L * (_x - _tmp).lpNorm<Eigen::Infinity>();
+}
+
+} // anonymous namespace
+
+//==============================================================================
+APGDLCPSolver::APGDLCPSolver(double _timestep) : LCPSolver(_timestep)
+{
+  mOption.setDefault();
+
+  mStatistics.iterations = 0;
+  mStatistics.residual = 0.0;
+  mStatistics.converged = true;
+}
+
+//==============================================================================
+APGDLCPSolver::~APGDLCPSolver()
+{
+}
+
+//==============================================================================
+void APGDLCPSolver::solve(ConstrainedGroup* _group)
+{
+  // If there is no constraint, then just return.
+  size_t numConstraints = _group->getNumConstraints();
+  size_t n = _group->getTotalDimension();
+  if (0u == n)
+    return;
+
+  // Build LCP terms by aggregating them from constraints
+  int nSkip = dPAD(n);
+  mA.resize(n * nSkip);
+  mX.resize(n);
+  mB.resize(n);
+  mW.resize(n);
+  mLo.resize(n);
+  mHi.resize(n);
+  mFIndex.resize(n);
+  mOffset.resize(numConstraints);
+
+  double* A = mA.data();
+  double* x = mX.data();
+  double* b = mB.data();
+  double* w = mW.data();
+  double* lo = mLo.data();
+  double* hi = mHi.data();
+  int* findex = mFIndex.data();
+
+  // Set x and w to 0 and findex to -1
+  std::memset(x, 0, n * sizeof(double));
+  std::memset(w, 0, n * sizeof(double));
+  std::memset(findex, -1, n * sizeof(int));
+
+  size_t* offset = mOffset.data();
+  buildLCP(_group, nSkip, A, x, b, w, lo, hi, findex, offset);
+
+  solveAPGD(n, nSkip, A, x, b, lo, hi, findex, &mOption, &mStatistics);
+
+  // Apply constraint impulses
+  applyImpulses(_group, x, offset);
+}
+
+//==============================================================================
+void APGDLCPSolver::setOption(const APGDOption& _option)
+{
+  mOption = _option;
+}
+
+//==============================================================================
+const APGDOption& APGDLCPSolver::getOption() const
+{
+  return mOption;
+}
+
+//==============================================================================
+const APGDStatistics& APGDLCPSolver::getLastStatistics() const
+{
+  return mStatistics;
+}
+
+//==============================================================================
+bool solveAPGD(int n, int nskip, const double* A, double* x, const double* b,
+               const double* lo, const double* hi, const int* findex,
+               const APGDOption* option, APGDStatistics* statistics)
+{
+  assert(n > 0 && nskip >= n && A && x && b && lo && hi && findex && option);
+
+  const ConstRowMajorMap Amat(A, n, n, Eigen::OuterStride<>(nskip));
+  const Eigen::Map<const Eigen::VectorXd> bvec(b, n);
+  const RowGroups groups(n, findex);
+  const bool circularCone = option->circular_cone;
+
+  Eigen::VectorXd xk = Eigen::Map<Eigen::VectorXd>(x, n);
+  project(groups, lo, hi, circularCone, xk);
+
+  Eigen::VectorXd Axk(n);
+  multiply(Amat, xk, Axk);
+
+  Eigen::VectorXd yk = xk;
+  Eigen::VectorXd Ayk = Axk;
+  Eigen::VectorXd xn(n);
+  Eigen::VectorXd Axn(n);
+  Eigen::VectorXd g(n);
+  Eigen::VectorXd tmp(n);
+
+  // Initial estimate of the Lipschitz constant of the gradient, i.e., of the
+  // largest eigenvalue of A. Underestimates are corrected by backtracking.
+  tmp.setOnes();
+  multiply(Amat, tmp, g);
+  double L = g.norm() / tmp.norm();
+  if (!(L > 0.0) || !std::isfinite(L))
+    L = 1.0;
+
+  double theta = 1.0;
+
+  Eigen::VectorXd xBest = xk;
+  double residualBest = computeResidual(groups, lo, hi, circularCone, xk, Axk,
+                                        bvec, L, tmp);
+  bool converged = residualBest <= option->eps_res;
+
+  int iter = 0;
+  for (; iter < option->itermax && !converged; ++iter)
+  {
+    g = Ayk - bvec;
+
+    // Projected gradient step from yk with backtracking on L. Since the
+    // objective is quadratic, the sufficient decrease condition
+    //   f(xn) <= f(yk) + g^T d + 0.5 * L * d^T d,  d = xn - yk
+    // is equivalent to d^T A d <= L * d^T d, which is evaluated without the
+    // cancellation of comparing objective values near the solution.
+    for (int i = 0; i < maxBacktracks; ++i)
+    {
+      xn = yk - g / L;
+      project(groups, lo, hi, circularCone, xn);
+      multiply(Amat, xn, Axn);
+
+      tmp = xn - yk;
+      if (tmp.dot(Axn - Ayk) <= L * tmp.squaredNorm())
+        break;
+
+      L *= 2.0;
+    }
+
+    const double residual = computeResidual(groups, lo, hi, circularCone,
+                                            xn, Axn, bvec, L, tmp);
+    if (residual < residualBest)
+    {
+      residualBest = residual;
+      xBest = xn;
+    }
+
+    if (residual <= option->eps_res)
+    {
+      converged = true;
+      ++iter;
+      break;
+    }
+
+    // Nesterov's momentum, restarted when it points uphill
+    double thetaNext = 0.5 * theta * (std::sqrt(theta * theta + 4.0) - theta);
+    if (g.dot(xn - xk) > 0.0)
+    {
+      yk = xn;
+      Ayk = Axn;
+      thetaNext = 1.0;
+    }
+    else
+    {
+      const double beta = theta * (1.0 - theta)
+                          / (theta * theta + thetaNext);
+      yk = (1.0 + beta) * xn - beta * xk;
+      Ayk = (1.0 + beta) * Axn - beta * Axk;
+    }
+
+    theta = thetaNext;
+    xk.swap(xn);
+    Axk.swap(Axn);
+    L *= option->lipschitz_decay;
+  }
+
+  Eigen::Map<Eigen::VectorXd>(x, n) = xBest;
+
+  if (statistics)
+  {
+    statistics->iterations = iter;
+    statistics->residual = residualBest;
+    statistics->converged = converged;
+  }
+
+  return converged;
+}
+
+//==============================================================================
+void APGDOption::setDefault()
+{
+  itermax = LCP_APGD_OPTION_DEFAULT_ITERMAX;
+  eps_res = LCP_APGD_OPTION_DEFAULT_EPS_RESIDUAL;
+  lipschitz_decay = LCP_APGD_OPTION_DEFAULT_LIPSCHITZ_DECAY;
+  circular_cone = LCP_APGD_OPTION_DEFAULT_CIRCULAR_CONE;
+}
+
+}  // namespace constraint
+}  // namespace dart
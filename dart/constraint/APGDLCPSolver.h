@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_CONSTRAINT_APGDLCPSOLVER_H_
+#define DART_CONSTRAINT_APGDLCPSOLVER_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "dart/config.h"
+#include "dart/constraint/LCPSolver.h"
+
+namespace dart {
+namespace constraint {
+
+struct APGDOption
+{
+  /// Maximum number of iterations
+  int itermax;
+
+  /// The iteration stops once the residual falls below this value. The
+  /// residual is the largest violation of the optimality conditions in
+  /// velocity units, i.e., of A * x - b projected on the feasible set.
+  double eps_res;
+
+  /// Factor that the estimate of the Lipschitz constant of A is multiplied
+  /// by after each successful step. Values below 1 allow longer steps where
+  /// the problem is well conditioned.
+  double lipschitz_decay;
+
+  /// Project the two friction rows of a contact onto the circular Coulomb
+  /// cone instead of bounding them independently. This only applies to
+  /// contacts with exactly two friction rows that share the same friction
+  /// coefficient, i.e., the ContactConstraint::BOX model.
+  bool circular_cone;
+
+  void setDefault();
+};
+
+/// Information about the last run of solveAPGD()
+struct APGDStatistics
+{
+  /// Number of iterations that were performed
+  int iterations;
+
+  /// Residual of the returned solution
+  double residual;
+
+  /// Whether the residual fell below APGDOption::eps_res
+  bool converged;
+};
+
+/// APGDLCPSolver solves the constraint impulses with Nesterov's accelerated
+/// projected gradient method with adaptive restart and step size. Each
+/// iteration is a product of A with a vector followed by independent
+/// projections of the contacts. An iteration therefore costs O(n^2) for n
+/// rows, and both parts are parallelized with OpenMP when it is enabled.
+///
+/// The friction of BOX contacts is projected onto the circular Coulomb cone,
+/// which makes the problem a convex cone complementarity problem. Its
+/// solution slightly separates sliding contacts along the normal, in
+/// proportion to the friction coefficient and the sliding velocity.
+///
+/// APGD is not a faster replacement for DantzigLCPSolver or PGSLCPSolver. On
+/// small groups, such as a stack of a few boxes, it needs more iterations
+/// than PGS needs sweeps and is about half as fast as either of them. Choose
+/// it when the cost of a step has to be bounded for large groups, where the
+/// pivoting of Dantzig grows cubically and PGS stalls on poorly conditioned
+/// stacks, when OpenMP can parallelize its products of A, or when the
+/// isotropic friction of the circular cone is wanted.
+class APGDLCPSolver : public LCPSolver
+{
+public:
+  /// Constructor
+  explicit APGDLCPSolver(double _timestep);
+
+  /// Destructor
+  virtual ~APGDLCPSolver();
+
+  // Documentation inherited
+  virtual void solve(ConstrainedGroup* _group);
+
+  /// Set the iteration budget and the tolerances
+  void setOption(const APGDOption& _option);
+
+  /// Get the iteration budget and the tolerances
+  const APGDOption& getOption() const;
+
+  /// Get the statistics of the most recently solved ConstrainedGroup
+  const APGDStatistics& getLastStatistics() const;
+
+private:
+  /// Iteration budget and tolerances
+  APGDOption mOption;
+
+  /// Statistics of the last solve
+  APGDStatistics mStatistics;
+
+  /// Buffers of the problem that is assembled for each constrained group and
+  /// handed to solveAPGD(). They grow to the largest group and are not
+  /// shrunk, so a simulation stops allocating once its biggest island has
+  /// been solved.
+  std::vector<double> mA;
+  std::vector<double> mX;
+  std::vector<double> mB;
+  std::vector<double> mW;
+  std::vector<double> mLo;
+  std::vector<double> mHi;
+  std::vector<int> mFIndex;
+  std::vector<size_t> mOffset;
+};
+
+/// Minimize 0.5 * x^T * A * x - b^T * x over the set given by lo, hi and
+/// findex with the accelerated projected gradient method. The rows with
+/// findex[i] >= 0 are bounded by hi[i] * x[findex[i]] as in dSolveLCP(), so
+/// the solution satisfies A * x = b + w with the same conditions on w. x is
+/// used as the initial guess. A is n x n with leading dimension nskip and
+/// must be symmetric positive semidefinite. Returns true if the residual fell
+/// below option->eps_res.
+bool solveAPGD(int n, int nskip, const double* A, double* x, const double* b,
+               const double* lo, const double* hi, const int* findex,
+               const APGDOption* option,
+               APGDStatistics* statistics = nullptr);
+
+} // namespace constraint
+} // namespace dart
+
+#endif  // DART_CONSTRAINT_APGDLCPSOLVER_H_
@@ -98,6 +98,10 @@ protected:
   // Documentation inherited
   virtual dynamics::SkeletonPtr getRootSkeleton() const;
 
+  // Documentation inherited
+  virtual void getSkeletons(dynamics::Skeleton*& _skeleton1,
+                            dynamics::Skeleton*& _skeleton2) const;
+
   // Documentation inherited
   virtual void uniteSkeletons();
 
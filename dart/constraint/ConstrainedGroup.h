@@ -107,9 +107,6 @@ private:
 
   /// List of constraints
   std::vector<ConstraintBasePtr> mConstraints;
-
-  ///
-  std::shared_ptr<dynamics::Skeleton> mRootSkeleton;
 };
 
 }  // namespace constraint
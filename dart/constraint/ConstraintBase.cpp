@@ -63,6 +63,14 @@ size_t ConstraintBase::getDimension() const
   return mDim;
 }
 
+//==============================================================================
+void ConstraintBase::getSkeletons(dynamics::Skeleton*& _skeleton1,
+                                  dynamics::Skeleton*& _skeleton2) const
+{
+  _skeleton1 = getRootSkeleton().get();
+  _skeleton2 = nullptr;
+}
+
 //==============================================================================
 dynamics::SkeletonPtr ConstraintBase::compressPath(
     dynamics::SkeletonPtr _skeleton)
@@ -108,6 +108,14 @@ public:
   ///
   virtual dynamics::SkeletonPtr getRootSkeleton() const = 0;
 
+  /// Get the skeletons whose motions are coupled by this constraint.
+  /// _skeleton2 is set to nullptr if the constraint only acts on _skeleton1.
+  /// ConstraintSolver solves the constraints that share a skeleton together.
+  /// The default implementation returns the root skeleton as _skeleton1, so
+  /// constraints between two skeletons should override it.
+  virtual void getSkeletons(dynamics::Skeleton*& _skeleton1,
+                            dynamics::Skeleton*& _skeleton2) const;
+
   ///
   virtual void uniteSkeletons() {}
 
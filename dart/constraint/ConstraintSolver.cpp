@@ -36,6 +36,8 @@
 
 #include "dart/constraint/ConstraintSolver.h"
 
+#include <set>
+
 #include "dart/common/Console.h"
 #include "dart/dynamics/BodyNode.h"
 #include "dart/dynamics/SoftBodyNode.h"
@@ -57,6 +59,9 @@
 #include "dart/constraint/DantzigLCPSolver.h"
 #include "dart/constraint/PGSLCPSolver.h"
 
+#define DART_SLEEP_THRESHOLD     1e-4
+#define DART_NUM_STEPS_TO_SLEEP  100
+
 namespace dart {
 namespace constraint {
 
@@ -70,7 +75,11 @@ ConstraintSolver::ConstraintSolver(double _timeStep)
   : mCollisionDetector(new collision::FCLCollisionDetector),
 #endif
     mTimeStep(_timeStep),
-    mLCPSolver(new DantzigLCPSolver(mTimeStep))
+    mLCPSolver(new DantzigLCPSolver(mTimeStep)),
+    mIsSleepingEnabled(false),
+    mSleepThreshold(DART_SLEEP_THRESHOLD),
+    mNumStepsToSleep(DART_NUM_STEPS_TO_SLEEP),
+    mNextIsland(0u)
 {
   assert(_timeStep > 0.0);
 }
@@ -90,7 +99,7 @@ void ConstraintSolver::addSkeleton(const SkeletonPtr& _skeleton)
   {
     mSkeletons.push_back(_skeleton);
     mCollisionDetector->addSkeleton(_skeleton);
-    mConstrainedGroups.reserve(mSkeletons.size());
+    mIslandBuilder.setSkeletons(mSkeletons);
   }
   else
   {
@@ -124,7 +133,7 @@ void ConstraintSolver::addSkeletons(const std::vector<SkeletonPtr>& _skeletons)
     }
   }
 
-  mConstrainedGroups.reserve(mSkeletons.size());
+  mIslandBuilder.setSkeletons(mSkeletons);
 }
 
 //==============================================================================
@@ -139,7 +148,10 @@ void ConstraintSolver::removeSkeleton(
     mSkeletons.erase(remove(mSkeletons.begin(), mSkeletons.end(), _skeleton),
                      mSkeletons.end());
     mCollisionDetector->removeSkeleton(_skeleton);
-    mConstrainedGroups.reserve(mSkeletons.size());
+    removeContactFrictionModels(_skeleton.get());
+    mSleepStates.erase(_skeleton.get());
+    _skeleton->setSleeping(false);
+    mIslandBuilder.setSkeletons(mSkeletons);
   }
   else
   {
@@ -165,6 +177,9 @@ void ConstraintSolver::removeSkeletons(
       mSkeletons.erase(remove(mSkeletons.begin(), mSkeletons.end(), *it),
                        mSkeletons.end());
       mCollisionDetector->removeSkeleton(*it);
+      removeContactFrictionModels(it->get());
+      mSleepStates.erase(it->get());
+      (*it)->setSleeping(false);
 
       ++numRemovedSkeletons;
     }
@@ -175,14 +190,19 @@ void ConstraintSolver::removeSkeletons(
     }
   }
 
-  mConstrainedGroups.reserve(mSkeletons.size());
+  mIslandBuilder.setSkeletons(mSkeletons);
 }
 
 //==============================================================================
 void ConstraintSolver::removeAllSkeletons()
 {
+  wakeUpAll();
+  mSleepStates.clear();
+
   mCollisionDetector->removeAllSkeletons();
   mSkeletons.clear();
+  mContactFrictionModels.clear();
+  mIslandBuilder.setSkeletons(mSkeletons);
 }
 
 //==============================================================================
@@ -281,6 +301,203 @@ LCPSolver* ConstraintSolver::getLCPSolver() const
   return mLCPSolver.get();
 }
 
+//==============================================================================
+void ConstraintSolver::setContactFrictionModel(
+    const dynamics::BodyNode* _bodyNode1,
+    const dynamics::BodyNode* _bodyNode2,
+    ContactConstraint::FrictionModel _model,
+    size_t _numFrictionConeBases)
+{
+  assert(_bodyNode1 && _bodyNode2);
+
+  mContactFrictionModels[makeBodyNodePair(_bodyNode1, _bodyNode2)]
+      = FrictionSettings(_model, _numFrictionConeBases);
+}
+
+//==============================================================================
+void ConstraintSolver::removeContactFrictionModel(
+    const dynamics::BodyNode* _bodyNode1,
+    const dynamics::BodyNode* _bodyNode2)
+{
+  mContactFrictionModels.erase(makeBodyNodePair(_bodyNode1, _bodyNode2));
+}
+
+//==============================================================================
+void ConstraintSolver::removeAllContactFrictionModels()
+{
+  mContactFrictionModels.clear();
+}
+
+//==============================================================================
+void ConstraintSolver::removeContactFrictionModels(
+    const dynamics::Skeleton* _skeleton)
+{
+  if (mContactFrictionModels.empty())
+    return;
+
+  std::set<const dynamics::BodyNode*> bodyNodes;
+  for (size_t i = 0; i < _skeleton->getNumBodyNodes(); ++i)
+    bodyNodes.insert(_skeleton->getBodyNode(i));
+
+  for (auto it = mContactFrictionModels.begin();
+       it != mContactFrictionModels.end();)
+  {
+    if (bodyNodes.count(it->first.first) || bodyNodes.count(it->first.second))
+      it = mContactFrictionModels.erase(it);
+    else
+      ++it;
+  }
+}
+
+//==============================================================================
+void ConstraintSolver::setSleepingEnabled(bool _enabled)
+{
+  mIsSleepingEnabled = _enabled;
+
+  if (!mIsSleepingEnabled)
+    wakeUpAll();
+}
+
+//==============================================================================
+bool ConstraintSolver::isSleepingEnabled() const
+{
+  return mIsSleepingEnabled;
+}
+
+//==============================================================================
+void ConstraintSolver::setSleepThreshold(double _threshold)
+{
+  assert(_threshold >= 0.0);
+  mSleepThreshold = _threshold;
+}
+
+//==============================================================================
+double ConstraintSolver::getSleepThreshold() const
+{
+  return mSleepThreshold;
+}
+
+//==============================================================================
+void ConstraintSolver::setNumStepsToSleep(size_t _numSteps)
+{
+  mNumStepsToSleep = _numSteps;
+}
+
+//==============================================================================
+size_t ConstraintSolver::getNumStepsToSleep() const
+{
+  return mNumStepsToSleep;
+}
+
+//==============================================================================
+void ConstraintSolver::wakeUp(const SkeletonPtr& _skeleton)
+{
+  assert(_skeleton);
+
+  if (!_skeleton->isSleeping())
+    return;
+
+  const auto it = mSleepStates.find(_skeleton.get());
+  if (it == mSleepStates.end())
+  {
+    _skeleton->setSleeping(false);
+    return;
+  }
+
+  wakeUpIslands(std::vector<size_t>(1u, it->second.mIsland));
+}
+
+//==============================================================================
+void ConstraintSolver::wakeUpAll()
+{
+  for (const auto& skel : mSkeletons)
+    skel->setSleeping(false);
+
+  for (auto& sleepState : mSleepStates)
+    sleepState.second.mNumRestingSteps = 0u;
+}
+
+//==============================================================================
+size_t ConstraintSolver::getNumSleepingSkeletons() const
+{
+  size_t numSleepingSkeletons = 0u;
+  for (const auto& skel : mSkeletons)
+  {
+    if (skel->isSleeping())
+      ++numSleepingSkeletons;
+  }
+
+  return numSleepingSkeletons;
+}
+
+//==============================================================================
+void ConstraintSolver::wakeUpDisturbedIslands()
+{
+  if (!mIsSleepingEnabled)
+    return;
+
+  std::vector<size_t> islands;
+  for (const auto& skel : mSkeletons)
+  {
+    if (!skel->isSleeping())
+      continue;
+
+    const auto it = mSleepStates.find(skel.get());
+    if (it == mSleepStates.end())
+      skel->setSleeping(false);
+    else if (isDisturbed(skel.get(), it->second))
+      islands.push_back(it->second.mIsland);
+  }
+
+  if (!islands.empty())
+    wakeUpIslands(islands);
+}
+
+//==============================================================================
+void ConstraintSolver::updateSleepingIslands()
+{
+  if (!mIsSleepingEnabled)
+    return;
+
+  const size_t numIslands = mIslandBuilder.getNumIslands() + mSkeletons.size();
+  std::vector<bool> isIslandResting(numIslands, true);
+
+  for (size_t i = 0; i < mSkeletons.size(); ++i)
+  {
+    const SkeletonPtr& skel = mSkeletons[i];
+    if (!skel->isMobile() || skel->isSleeping())
+      continue;
+
+    SleepState& state = mSleepStates[skel.get()];
+    if (isResting(skel.get()))
+      ++state.mNumRestingSteps;
+    else
+      state.mNumRestingSteps = 0u;
+
+    if (state.mNumRestingSteps < mNumStepsToSleep)
+      isIslandResting[mIslandBuilder.getSkeletonIsland(i)] = false;
+  }
+
+  for (size_t i = 0; i < mSkeletons.size(); ++i)
+  {
+    const SkeletonPtr& skel = mSkeletons[i];
+    if (!skel->isMobile() || skel->isSleeping())
+      continue;
+
+    const size_t island = mIslandBuilder.getSkeletonIsland(i);
+    if (isIslandResting[island])
+      putToSleep(skel, mNextIsland + island);
+  }
+
+  mNextIsland += numIslands;
+}
+
+//==============================================================================
+const IslandBuilder::Statistics& ConstraintSolver::getIslandStatistics() const
+{
+  return mIslandBuilder.getStatistics();
+}
+
 //==============================================================================
 void ConstraintSolver::solve()
 {
@@ -290,6 +507,13 @@ void ConstraintSolver::solve()
   // Update constraints and collect active constraints
   updateConstraints();
 
+  // Wake up the sleeping skeletons that are touched by awake ones. The
+  // contacts between two sleeping skeletons were not detected, so the
+  // constraints are updated again to include the contacts of the woken
+  // islands, which may in turn touch other sleeping islands.
+  while (mIsSleepingEnabled && wakeUpTouchedIslands())
+    updateConstraints();
+
   // Build constrained groups
   buildConstrainedGroups();
 
@@ -318,6 +542,7 @@ bool ConstraintSolver::checkAndAddSkeleton(const SkeletonPtr& _skeleton)
   if (!containSkeleton(_skeleton))
   {
     mSkeletons.push_back(_skeleton);
+    mIslandBuilder.setSkeletons(mSkeletons);
     return true;
   }
   else
@@ -375,6 +600,7 @@ void ConstraintSolver::updateConstraints()
   //----------------------------------------------------------------------------
   mCollisionDetector->clearAllContacts();
   mCollisionDetector->detectCollision(true, true);
+  mCollisionDetector->detectContinuousCollision(mTimeStep);
 
   // Destroy previous contact constraints
   mContactConstraints.clear();
@@ -385,18 +611,35 @@ void ConstraintSolver::updateConstraints()
   // Create new contact constraints
   for (size_t i = 0; i < mCollisionDetector->getNumContacts(); ++i)
   {
-    collision::Contact& ct = mCollisionDetector->getContact(i);
+    collision::ContactRecord& ct = mCollisionDetector->getContactRecord(i);
 
     if (isSoftContact(ct))
     {
       mSoftContactConstraints.push_back(
             std::make_shared<SoftContactConstraint>(ct, mTimeStep));
     }
-    else
+    else if (mContactFrictionModels.empty())
     {
       mContactConstraints.push_back(
             std::make_shared<ContactConstraint>(ct, mTimeStep));
     }
+    else
+    {
+      const auto it = mContactFrictionModels.find(
+            makeBodyNodePair(ct.bodyNode1, ct.bodyNode2));
+
+      if (it == mContactFrictionModels.end())
+      {
+        mContactConstraints.push_back(
+              std::make_shared<ContactConstraint>(ct, mTimeStep));
+      }
+      else
+      {
+        mContactConstraints.push_back(
+              std::make_shared<ContactConstraint>(
+                ct, mTimeStep, it->second.first, it->second.second));
+      }
+    }
   }
 
   // Add the new contact constraints to dynamic constraint list
@@ -428,6 +671,9 @@ void ConstraintSolver::updateConstraints()
   // Create new joint constraints
   for (const auto& skel : mSkeletons)
   {
+    if (skel->isSleeping())
+      continue;
+
     const size_t numJoints = skel->getNumJoints();
     for (size_t i = 0; i < numJoints; i++)
     {
@@ -486,88 +732,196 @@ void ConstraintSolver::updateConstraints()
 //==============================================================================
 void ConstraintSolver::buildConstrainedGroups()
 {
-  // Clear constrained groups
-  mConstrainedGroups.clear();
+  // Find the islands of the active constraints
+  mIslandBuilder.build(mActiveConstraints);
 
-  // Exit if there is no active constraint
-  if (mActiveConstraints.empty())
-    return;
+  // Clear constrained groups while keeping the storage of the remaining ones
+  for (auto& constrainedGroup : mConstrainedGroups)
+    constrainedGroup.removeAllConstraints();
+  mConstrainedGroups.resize(mIslandBuilder.getNumIslands());
 
-  //----------------------------------------------------------------------------
-  // Unite skeletons according to constraints's relationships
-  //----------------------------------------------------------------------------
-  for (std::vector<ConstraintBasePtr>::iterator it = mActiveConstraints.begin();
-       it != mActiveConstraints.end(); ++it)
+  // Add active constraints to constrained groups
+  for (size_t i = 0; i < mActiveConstraints.size(); ++i)
   {
-    (*it)->uniteSkeletons();
+    mConstrainedGroups[mIslandBuilder.getConstraintIsland(i)].addConstraint(
+          mActiveConstraints[i]);
   }
+}
 
-  //----------------------------------------------------------------------------
-  // Build constraint groups
-  //----------------------------------------------------------------------------
-  for (std::vector<ConstraintBasePtr>::const_iterator it = mActiveConstraints.begin();
-       it != mActiveConstraints.end(); ++it)
+//==============================================================================
+void ConstraintSolver::solveConstrainedGroups()
+{
+  for (size_t i = 0; i < mConstrainedGroups.size(); ++i)
   {
-    bool found = false;
-    dynamics::SkeletonPtr skel = (*it)->getRootSkeleton();
+    // Groups that still contain a sleeping skeleton after
+    // wakeUpTouchedIslands() contain only sleeping skeletons
+    const dynamics::Skeleton* skel = mIslandBuilder.getIslandSkeleton(i);
+    if (skel && skel->isSleeping())
+      continue;
+
+    mLCPSolver->solve(&mConstrainedGroups[i]);
+  }
+}
+
+//==============================================================================
+bool ConstraintSolver::isResting(const dynamics::Skeleton* _skeleton) const
+{
+  // The state of the point masses is not tracked while sleeping
+  if (_skeleton->getNumSoftBodyNodes() > 0u)
+    return false;
+
+  const double mass = _skeleton->getMass();
+  if (mass <= 0.0)
+    return false;
+
+  return _skeleton->getKineticEnergy() < mSleepThreshold * mass;
+}
+
+//==============================================================================
+bool ConstraintSolver::isDisturbed(const dynamics::Skeleton* _skeleton,
+                                   const SleepState& _state) const
+{
+  const size_t numDofs = _skeleton->getNumDofs();
+  const size_t numBodyNodes = _skeleton->getNumBodyNodes();
+
+  if (static_cast<size_t>(_state.mPositions.size()) != numDofs
+      || static_cast<size_t>(_state.mExternalForces.size()) != 6u * numBodyNodes)
+  {
+    return true;
+  }
 
-    for (std::vector<ConstrainedGroup>::const_iterator itConstGroup
-         = mConstrainedGroups.begin();
-         itConstGroup != mConstrainedGroups.end(); ++itConstGroup)
+  for (size_t i = 0; i < numDofs; ++i)
+  {
+    if (_skeleton->getPosition(i) != _state.mPositions[i]
+        || _skeleton->getVelocity(i) != 0.0
+        || _skeleton->getForce(i) != _state.mForces[i]
+        || _skeleton->getCommand(i) != _state.mCommands[i])
     {
-      if ((*itConstGroup).mRootSkeleton == skel)
-      {
-        found = true;
-        break;
-      }
+      return true;
     }
+  }
 
-    if (found)
-      continue;
-
-    ConstrainedGroup newConstGroup;
-    newConstGroup.mRootSkeleton = skel;
-    skel->mUnionIndex = mConstrainedGroups.size();
-    mConstrainedGroups.push_back(newConstGroup);
+  for (size_t i = 0; i < numBodyNodes; ++i)
+  {
+    if (_skeleton->getBodyNode(i)->getExternalForceLocal()
+        != _state.mExternalForces.segment<6>(6 * i))
+    {
+      return true;
+    }
   }
 
-  // Add active constraints to constrained groups
-  for (std::vector<ConstraintBasePtr>::const_iterator it = mActiveConstraints.begin();
-       it != mActiveConstraints.end(); ++it)
+  return false;
+}
+
+//==============================================================================
+void ConstraintSolver::putToSleep(const dynamics::SkeletonPtr& _skeleton,
+                                  size_t _island)
+{
+  const size_t numDofs = _skeleton->getNumDofs();
+  const size_t numBodyNodes = _skeleton->getNumBodyNodes();
+
+  _skeleton->setVelocities(Eigen::VectorXd::Zero(numDofs));
+  _skeleton->setSleeping(true);
+
+  SleepState& state = mSleepStates[_skeleton.get()];
+  state.mIsland = _island;
+  state.mPositions = _skeleton->getPositions();
+  state.mForces = _skeleton->getForces();
+  state.mCommands = _skeleton->getCommands();
+  state.mExternalForces.resize(6 * numBodyNodes);
+  for (size_t i = 0; i < numBodyNodes; ++i)
   {
-    dynamics::SkeletonPtr skel = (*it)->getRootSkeleton();
-    mConstrainedGroups[skel->mUnionIndex].addConstraint(*it);
+    state.mExternalForces.segment<6>(6 * i)
+        = _skeleton->getBodyNode(i)->getExternalForceLocal();
   }
+}
 
-  //----------------------------------------------------------------------------
-  // Reset union since we don't need union information anymore.
-  //----------------------------------------------------------------------------
-  for (std::vector<dynamics::SkeletonPtr>::iterator it = mSkeletons.begin();
-       it != mSkeletons.end(); ++it)
+//==============================================================================
+void ConstraintSolver::wakeUpIslands(const std::vector<size_t>& _islands)
+{
+  for (const auto& skel : mSkeletons)
   {
-    (*it)->resetUnion();
+    if (!skel->isSleeping())
+      continue;
+
+    const auto it = mSleepStates.find(skel.get());
+    if (it != mSleepStates.end()
+        && std::find(_islands.begin(), _islands.end(), it->second.mIsland)
+           == _islands.end())
+    {
+      continue;
+    }
+
+    skel->setSleeping(false);
+
+    if (it != mSleepStates.end())
+      it->second.mNumRestingSteps = 0u;
   }
 }
 
 //==============================================================================
-void ConstraintSolver::solveConstrainedGroups()
+bool ConstraintSolver::wakeUpTouchedIslands()
 {
-  for (std::vector<ConstrainedGroup>::iterator it = mConstrainedGroups.begin();
-       it != mConstrainedGroups.end(); ++it)
+  bool isWoken = false;
+  std::vector<size_t> islands;
+  for (const auto& constraint : mActiveConstraints)
   {
-    mLCPSolver->solve(&(*it));
+    dynamics::Skeleton* skeletons[2];
+    constraint->getSkeletons(skeletons[0], skeletons[1]);
+    if (!skeletons[0] || !skeletons[1])
+      continue;
+
+    for (size_t i = 0; i < 2u; ++i)
+    {
+      dynamics::Skeleton* skel = skeletons[i];
+      const dynamics::Skeleton* other = skeletons[1u - i];
+      if (!skel->isSleeping() || !other->isMobile() || other->isSleeping())
+        continue;
+
+      const auto it = mSleepStates.find(skel);
+      if (it == mSleepStates.end())
+        skel->setSleeping(false);
+      else
+        islands.push_back(it->second.mIsland);
+
+      isWoken = true;
+    }
   }
+
+  if (!islands.empty())
+    wakeUpIslands(islands);
+
+  return isWoken;
 }
 
 //==============================================================================
-bool ConstraintSolver::isSoftContact(const collision::Contact& _contact) const
+bool ConstraintSolver::isSoftContact(
+    const collision::ContactRecord& _contact) const
 {
-  if (dynamic_cast<dynamics::SoftBodyNode*>(_contact.bodyNode1.lock().get())
-      || dynamic_cast<dynamics::SoftBodyNode*>(_contact.bodyNode2.lock().get()))
+  if (dynamic_cast<dynamics::SoftBodyNode*>(_contact.bodyNode1)
+      || dynamic_cast<dynamics::SoftBodyNode*>(_contact.bodyNode2))
     return true;
 
   return false;
 }
 
+//==============================================================================
+ConstraintSolver::SleepState::SleepState()
+  : mNumRestingSteps(0u),
+    mIsland(0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+ConstraintSolver::BodyNodePair ConstraintSolver::makeBodyNodePair(
+    const dynamics::BodyNode* _bodyNode1, const dynamics::BodyNode* _bodyNode2)
+{
+  if (_bodyNode2 < _bodyNode1)
+    return BodyNodePair(_bodyNode2, _bodyNode1);
+
+  return BodyNodePair(_bodyNode1, _bodyNode2);
+}
+
 }  // namespace constraint
 }  // namespace dart
@@ -37,6 +37,8 @@
 #ifndef DART_CONSTRAINT_CONSTRAINTSOVER_H_
 #define DART_CONSTRAINT_CONSTRAINTSOVER_H_
 
+#include <map>
+#include <utility>
 #include <vector>
 
 #include <Eigen/Dense>
@@ -44,6 +46,8 @@
 #include "dart/common/Deprecated.h"
 #include "dart/constraint/SmartPointer.h"
 #include "dart/constraint/ConstraintBase.h"
+#include "dart/constraint/ContactConstraint.h"
+#include "dart/constraint/IslandBuilder.h"
 #include "dart/collision/CollisionDetector.h"
 
 namespace dart {
@@ -121,10 +125,124 @@ public:
   /// Get LCP solver
   LCPSolver* getLCPSolver() const;
 
+  /// Use _model with _numFrictionConeBases bases for the contacts between
+  /// _bodyNode1 and _bodyNode2 instead of the default friction model of
+  /// ContactConstraint. The order of the body nodes does not matter.
+  /// _numFrictionConeBases is only used by ContactConstraint::PYRAMID. The
+  /// setting is dropped when the skeleton of either body node is removed.
+  void setContactFrictionModel(const dynamics::BodyNode* _bodyNode1,
+                               const dynamics::BodyNode* _bodyNode2,
+                               ContactConstraint::FrictionModel _model,
+                               size_t _numFrictionConeBases = 4);
+
+  /// Go back to the default friction model for the contacts between
+  /// _bodyNode1 and _bodyNode2
+  void removeContactFrictionModel(const dynamics::BodyNode* _bodyNode1,
+                                  const dynamics::BodyNode* _bodyNode2);
+
+  /// Go back to the default friction model for all the contacts
+  void removeAllContactFrictionModels();
+
+  /// Enable or disable sleeping. When it is enabled, an island of skeletons
+  /// that are connected by constraints is put to sleep once the kinetic energy
+  /// per unit mass of all its skeletons has stayed below the sleep threshold
+  /// for the given number of steps. Disabling sleeping wakes up all the
+  /// skeletons. Sleeping is disabled by default.
+  void setSleepingEnabled(bool _enabled);
+
+  /// Return true if sleeping is enabled
+  bool isSleepingEnabled() const;
+
+  /// Set the kinetic energy per unit mass [m^2/s^2] below which a skeleton is
+  /// considered to be resting
+  void setSleepThreshold(double _threshold);
+
+  /// Get the kinetic energy per unit mass below which a skeleton is considered
+  /// to be resting
+  double getSleepThreshold() const;
+
+  /// Set the number of consecutive resting steps after which an island is put
+  /// to sleep
+  void setNumStepsToSleep(size_t _numSteps);
+
+  /// Get the number of consecutive resting steps after which an island is put
+  /// to sleep
+  size_t getNumStepsToSleep() const;
+
+  /// Wake up _skeleton together with the skeletons it was put to sleep with
+  void wakeUp(const dynamics::SkeletonPtr& _skeleton);
+
+  /// Wake up all the skeletons
+  void wakeUpAll();
+
+  /// Return the number of sleeping skeletons
+  size_t getNumSleepingSkeletons() const;
+
+  /// Wake up the sleeping islands that have been disturbed since they were put
+  /// to sleep, that is, whose positions, velocities, forces, commands or
+  /// external forces have been changed. World::step calls this before the
+  /// forward dynamics.
+  ///
+  /// Sleeping islands are also woken up by solve() when an awake mobile
+  /// skeleton touches them. Immobile skeletons never wake them up, so call
+  /// wakeUp() after moving an immobile skeleton into a sleeping island.
+  void wakeUpDisturbedIslands();
+
+  /// Put the islands found by the last solve() to sleep if all their skeletons
+  /// have been resting for long enough. World::step calls this at the end of
+  /// the step.
+  void updateSleepingIslands();
+
+  /// Return the statistics of the constrained groups of the last solve()
+  const IslandBuilder::Statistics& getIslandStatistics() const;
+
   /// Solve constraint impulses and apply them to the skeletons
   void solve();
 
 private:
+  /// Sleeping state of a skeleton
+  struct SleepState
+  {
+    /// Constructor
+    SleepState();
+
+    /// Number of consecutive steps the skeleton has been resting
+    size_t mNumRestingSteps;
+
+    /// Index of the island the skeleton was put to sleep with
+    size_t mIsland;
+
+    /// Generalized positions when the skeleton was put to sleep
+    Eigen::VectorXd mPositions;
+
+    /// Generalized forces when the skeleton was put to sleep
+    Eigen::VectorXd mForces;
+
+    /// Commands when the skeleton was put to sleep
+    Eigen::VectorXd mCommands;
+
+    /// External forces of the body nodes when the skeleton was put to sleep
+    Eigen::VectorXd mExternalForces;
+  };
+
+  /// Return true if _skeleton has been at rest in the last step
+  bool isResting(const dynamics::Skeleton* _skeleton) const;
+
+  /// Return true if _skeleton has been disturbed since it was put to sleep
+  bool isDisturbed(const dynamics::Skeleton* _skeleton,
+                   const SleepState& _state) const;
+
+  /// Put _skeleton to sleep as a member of _island
+  void putToSleep(const dynamics::SkeletonPtr& _skeleton, size_t _island);
+
+  /// Wake up all the skeletons that were put to sleep with one of the given
+  /// islands
+  void wakeUpIslands(const std::vector<size_t>& _islands);
+
+  /// Wake up the sleeping islands that share an active constraint with an
+  /// awake mobile skeleton. Returns true if any skeleton was woken up.
+  bool wakeUpTouchedIslands();
+
   /// Check if the skeleton is contained in this solver
   bool containSkeleton(const dynamics::ConstSkeletonPtr& _skeleton) const;
 
@@ -147,7 +265,23 @@ private:
   void solveConstrainedGroups();
 
   /// Return true if at least one of colliding body is soft body
-  bool isSoftContact(const collision::Contact& _contact) const;
+  bool isSoftContact(const collision::ContactRecord& _contact) const;
+
+  typedef std::pair<const dynamics::BodyNode*, const dynamics::BodyNode*>
+      BodyNodePair;
+
+  /// Friction model and number of friction cone bases of a contact pair
+  typedef std::pair<ContactConstraint::FrictionModel, size_t> FrictionSettings;
+
+  /// Return the key of the pair of body nodes regardless of their order
+  static BodyNodePair makeBodyNodePair(const dynamics::BodyNode* _bodyNode1,
+                                       const dynamics::BodyNode* _bodyNode2);
+
+  /// Remove the friction models of the pairs that involve a body node of
+  /// _skeleton. The keys are raw pointers, so they must not outlive the body
+  /// nodes, or a body node created later at the same address would inherit
+  /// the friction model.
+  void removeContactFrictionModels(const dynamics::Skeleton* _skeleton);
 
   /// Collision detector
   std::unique_ptr<collision::CollisionDetector> mCollisionDetector;
@@ -184,6 +318,27 @@ private:
 
   /// Constraint group list
   std::vector<ConstrainedGroup> mConstrainedGroups;
+
+  /// Finds the constrained groups of the active constraints
+  IslandBuilder mIslandBuilder;
+
+  /// Friction models that override the default one for specific contact pairs
+  std::map<BodyNodePair, FrictionSettings> mContactFrictionModels;
+
+  /// Whether resting islands are put to sleep
+  bool mIsSleepingEnabled;
+
+  /// Kinetic energy per unit mass below which a skeleton is resting
+  double mSleepThreshold;
+
+  /// Number of consecutive resting steps after which an island falls asleep
+  size_t mNumStepsToSleep;
+
+  /// Sleeping states of the mobile skeletons
+  std::map<const dynamics::Skeleton*, SleepState> mSleepStates;
+
+  /// Offset that makes the islands of different steps distinct
+  size_t mNextIsland;
 };
 
 }  // namespace constraint
@@ -63,13 +63,28 @@ double ContactConstraint::mErrorAllowance            = DART_ERROR_ALLOWANCE;
 double ContactConstraint::mErrorReductionParameter   = DART_ERP;
 double ContactConstraint::mMaxErrorReductionVelocity = DART_MAX_ERV;
 double ContactConstraint::mConstraintForceMixing     = DART_CFM;
+ContactConstraint::FrictionModel ContactConstraint::mDefaultFrictionModel
+    = ContactConstraint::BOX;
+size_t ContactConstraint::mDefaultNumFrictionConeBases = 4;
 
 //==============================================================================
-ContactConstraint::ContactConstraint(collision::Contact& _contact,
+ContactConstraint::ContactConstraint(collision::ContactRecord& _contact,
                                      double _timeStep)
+  : ContactConstraint(_contact, _timeStep, mDefaultFrictionModel,
+                      mDefaultNumFrictionConeBases)
+{
+  // Do nothing
+}
+
+//==============================================================================
+ContactConstraint::ContactConstraint(collision::ContactRecord& _contact,
+                                     double _timeStep,
+                                     FrictionModel _frictionModel,
+                                     size_t _numFrictionConeBases)
   : ConstraintBase(),
     mTimeStep(_timeStep),
     mFirstFrictionalDirection(Eigen::Vector3d::UnitZ()),
+    mFrictionModel(_frictionModel),
     mIsFrictionOn(true),
     mAppliedImpulseIndex(-1),
     mIsBounceOn(false),
@@ -79,8 +94,8 @@ ContactConstraint::ContactConstraint(collision::Contact& _contact,
   mContacts.push_back(&_contact);
 
   // TODO(JS):
-  mBodyNode1 = _contact.bodyNode1.lock();
-  mBodyNode2 = _contact.bodyNode2.lock();
+  mBodyNode1 = _contact.bodyNode1;
+  mBodyNode2 = _contact.bodyNode2;
 
   //----------------------------------------------
   // Bounce
@@ -100,7 +115,33 @@ ContactConstraint::ContactConstraint(collision::Contact& _contact,
   // Update mFrictionalCoff
   mFrictionCoeff = std::min(mBodyNode1->getFrictionCoeff(),
                             mBodyNode2->getFrictionCoeff());
-  if (mFrictionCoeff > DART_FRICTION_COEFF_THRESHOLD)
+
+  switch (mFrictionModel)
+  {
+    case FRICTIONLESS:
+      mNumFrictionConeBases = 0;
+      mFrictionBound = 0.0;
+      break;
+    case BOX:
+      mNumFrictionConeBases = 2;
+      mFrictionBound = mFrictionCoeff;
+      break;
+    case PYRAMID:
+      if (_numFrictionConeBases < 2)
+      {
+        dtwarn << "[ContactConstraint::ContactConstraint] Number of friction "
+               << "cone bases [" << _numFrictionConeBases << "] is lower than "
+               << "2. It is set to 2." << std::endl;
+        _numFrictionConeBases = 2;
+      }
+      mNumFrictionConeBases = _numFrictionConeBases;
+      mFrictionBound = mFrictionCoeff * DART_PI_HALF
+                       / static_cast<double>(mNumFrictionConeBases);
+      break;
+  }
+
+  if (mFrictionCoeff > DART_FRICTION_COEFF_THRESHOLD
+      && mNumFrictionConeBases > 0)
   {
     mIsFrictionOn = true;
 
@@ -110,17 +151,16 @@ ContactConstraint::ContactConstraint(collision::Contact& _contact,
   else
   {
     mIsFrictionOn = false;
+    mNumFrictionConeBases = 0;
   }
 
   // Compute local contact Jacobians expressed in body frame
   if (mIsFrictionOn)
   {
-    // Set the dimension of this constraint. 1 is for Normal direction constraint.
+    // Set the dimension of this constraint. 1 is for Normal direction
+    // constraint.
     // TODO(JS): Assumed that the number of contact is not static.
-    // TODO(JS): Adjust following code once use of mNumFrictionConeBases is
-    //           implemented.
-    //  mDim = mContacts.size() * (1 + mNumFrictionConeBases);
-    mDim = mContacts.size() * 3;
+    mDim = mContacts.size() * (1 + mNumFrictionConeBases);
 
     mJacobians1.resize(mDim);
     mJacobians2.resize(mDim);
@@ -136,16 +176,16 @@ ContactConstraint::ContactConstraint(collision::Contact& _contact,
 
     for (size_t i = 0; i < mContacts.size(); ++i)
     {
-      collision::Contact* ct = mContacts[i];
+      collision::ContactRecord* ct = mContacts[i];
 
-      // TODO(JS): Assumed that the number of tangent basis is 2.
       Eigen::MatrixXd D = getTangentBasisMatrixODE(ct->normal);
 
-      assert(std::abs(ct->normal.dot(D.col(0))) < DART_EPSILON);
-      assert(std::abs(ct->normal.dot(D.col(1))) < DART_EPSILON);
-//      if (D.col(0).dot(D.col(1)) > 0.0)
-//        std::cout << "D.col(0).dot(D.col(1): " << D.col(0).dot(D.col(1)) << std::endl;
-      assert(std::abs(D.col(0).dot(D.col(1))) < DART_EPSILON);
+#ifndef NDEBUG
+      for (size_t j = 0; j < mNumFrictionConeBases; ++j)
+        assert(std::abs(ct->normal.dot(D.col(j))) < DART_EPSILON);
+#endif
+      assert(mNumFrictionConeBases != 2
+             || std::abs(D.col(0).dot(D.col(1))) < DART_EPSILON);
 
 //      std::cout << "D: " << std::endl << D << std::endl;
 
@@ -168,47 +208,22 @@ ContactConstraint::ContactConstraint(collision::Contact& _contact,
 
       ++idx;
 
-      // Jacobian for directional friction 1
-      bodyDirection1.noalias()
-          = mBodyNode1->getTransform().linear().transpose() * D.col(0);
-      bodyDirection2.noalias()
-          = mBodyNode2->getTransform().linear().transpose() * -D.col(0);
-
-//      bodyPoint1.noalias()
-//          = mBodyNode1->getWorldTransform().inverse() * ct->point;
-//      bodyPoint2.noalias()
-//          = mBodyNode2->getWorldTransform().inverse() * ct->point;
-
-//      std::cout << "bodyDirection2: " << std::endl << bodyDirection2 << std::endl;
-
-      mJacobians1[idx].head<3>() = bodyPoint1.cross(bodyDirection1);
-      mJacobians2[idx].head<3>() = bodyPoint2.cross(bodyDirection2);
-
-      mJacobians1[idx].tail<3>() = bodyDirection1;
-      mJacobians2[idx].tail<3>() = bodyDirection2;
-
-      ++idx;
-
-      // Jacobian for directional friction 2
-      bodyDirection1.noalias()
-          = mBodyNode1->getTransform().linear().transpose() * D.col(1);
-      bodyDirection2.noalias()
-          = mBodyNode2->getTransform().linear().transpose() * -D.col(1);
-
-//      bodyPoint1.noalias()
-//          = mBodyNode1->getWorldTransform().inverse() * ct->point;
-//      bodyPoint2.noalias()
-//          = mBodyNode2->getWorldTransform().inverse() * ct->point;
-
-//      std::cout << "bodyDirection2: " << std::endl << bodyDirection2 << std::endl;
+      // Jacobians for the friction directions
+      for (size_t j = 0; j < mNumFrictionConeBases; ++j)
+      {
+        bodyDirection1.noalias()
+            = mBodyNode1->getTransform().linear().transpose() * D.col(j);
+        bodyDirection2.noalias()
+            = mBodyNode2->getTransform().linear().transpose() * -D.col(j);
 
-      mJacobians1[idx].head<3>() = bodyPoint1.cross(bodyDirection1);
-      mJacobians2[idx].head<3>() = bodyPoint2.cross(bodyDirection2);
+        mJacobians1[idx].head<3>() = bodyPoint1.cross(bodyDirection1);
+        mJacobians2[idx].head<3>() = bodyPoint2.cross(bodyDirection2);
 
-      mJacobians1[idx].tail<3>() = bodyDirection1;
-      mJacobians2[idx].tail<3>() = bodyDirection2;
+        mJacobians1[idx].tail<3>() = bodyDirection1;
+        mJacobians2[idx].tail<3>() = bodyDirection2;
 
-      ++idx;
+        ++idx;
+      }
     }
   }
   else
@@ -227,7 +242,7 @@ ContactConstraint::ContactConstraint(collision::Contact& _contact,
 
     for (size_t i = 0; i < mContacts.size(); ++i)
     {
-      collision::Contact* ct = mContacts[i];
+      collision::ContactRecord* ct = mContacts[i];
 
       bodyDirection1.noalias()
           = mBodyNode1->getTransform().linear().transpose() * ct->normal;
@@ -365,6 +380,50 @@ const Eigen::Vector3d& ContactConstraint::getFrictionDirection1() const
   return mFirstFrictionalDirection;
 }
 
+//==============================================================================
+void ContactConstraint::setDefaultFrictionModel(FrictionModel _model)
+{
+  mDefaultFrictionModel = _model;
+}
+
+//==============================================================================
+ContactConstraint::FrictionModel ContactConstraint::getDefaultFrictionModel()
+{
+  return mDefaultFrictionModel;
+}
+
+//==============================================================================
+void ContactConstraint::setDefaultNumFrictionConeBases(size_t _numBases)
+{
+  if (_numBases < 2)
+  {
+    dtwarn << "Number of friction cone bases [" << _numBases
+           << "] is lower than 2. " << "It is set to 2." << std::endl;
+    mDefaultNumFrictionConeBases = 2;
+    return;
+  }
+
+  mDefaultNumFrictionConeBases = _numBases;
+}
+
+//==============================================================================
+size_t ContactConstraint::getDefaultNumFrictionConeBases()
+{
+  return mDefaultNumFrictionConeBases;
+}
+
+//==============================================================================
+ContactConstraint::FrictionModel ContactConstraint::getFrictionModel() const
+{
+  return mFrictionModel;
+}
+
+//==============================================================================
+size_t ContactConstraint::getNumFrictionConeBases() const
+{
+  return mNumFrictionConeBases;
+}
+
 //==============================================================================
 void ContactConstraint::update()
 {
@@ -389,24 +448,23 @@ void ContactConstraint::getInformation(ConstraintInfo* _info)
     for (size_t i = 0; i < mContacts.size(); ++i)
     {
       // Bias term, w, should be zero
-      assert(_info->w[index] == 0.0);
-      assert(_info->w[index + 1] == 0.0);
-      assert(_info->w[index + 2] == 0.0);
+#ifndef NDEBUG
+      for (size_t j = 0; j <= mNumFrictionConeBases; ++j)
+        assert(_info->w[index + j] == 0.0);
+#endif
 
       // Upper and lower bounds of normal impulsive force
       _info->lo[index] = 0.0;
       _info->hi[index] = dInfinity;
       assert(_info->findex[index] == -1);
 
-      // Upper and lower bounds of tangential direction-1 impulsive force
-      _info->lo[index + 1] = -mFrictionCoeff;
-      _info->hi[index + 1] =  mFrictionCoeff;
-      _info->findex[index + 1] = index;
-
-      // Upper and lower bounds of tangential direction-2 impulsive force
-      _info->lo[index + 2] = -mFrictionCoeff;
-      _info->hi[index + 2] =  mFrictionCoeff;
-      _info->findex[index + 2] = index;
+      // Upper and lower bounds of tangential impulsive forces
+      for (size_t j = 1; j <= mNumFrictionConeBases; ++j)
+      {
+        _info->lo[index + j] = -mFrictionBound;
+        _info->hi[index + j] =  mFrictionBound;
+        _info->findex[index + j] = index;
+      }
 
 //      std::cout << "_frictionalCoff: " << _frictionalCoff << std::endl;
 
@@ -419,7 +477,14 @@ void ContactConstraint::getInformation(ConstraintInfo* _info)
       // A. Penetration correction
       double bouncingVelocity = mContacts[i]->penetrationDepth
                                 - mErrorAllowance;
-      if (bouncingVelocity < 0.0)
+      if (mContacts[i]->timeOfImpact > 0.0)
+      {
+        // The contact is predicted by continuous collision detection. Unless
+        // they bounce, the bodies may close the gap between them within this
+        // step but not more.
+        bouncingVelocity = -mContacts[i]->gap * _info->invTimeStep;
+      }
+      else if (bouncingVelocity < 0.0)
       {
         bouncingVelocity = 0.0;
       }
@@ -430,7 +495,9 @@ void ContactConstraint::getInformation(ConstraintInfo* _info)
           bouncingVelocity = mMaxErrorReductionVelocity;
       }
 
-      // B. Restitution
+      // B. Restitution. Predicted contacts bounce within the step of the
+      // impact as well, otherwise a fast body would first be stopped at the
+      // time of impact and lose the velocity it should bounce back with.
       if (mIsBounceOn)
       {
         double& negativeRelativeVel = _info->b[index];
@@ -458,12 +525,11 @@ void ContactConstraint::getInformation(ConstraintInfo* _info)
 
       // TODO(JS): Initial guess
       // x
-      _info->x[index] = 0.0;
-      _info->x[index + 1] = 0.0;
-      _info->x[index + 2] = 0.0;
+      for (size_t j = 0; j <= mNumFrictionConeBases; ++j)
+        _info->x[index + j] = 0.0;
 
       // Increase index
-      index += 3;
+      index += 1 + mNumFrictionConeBases;
     }
   }
   //----------------------------------------------------------------------------
@@ -487,7 +553,14 @@ void ContactConstraint::getInformation(ConstraintInfo* _info)
       // A. Penetration correction
       double bouncingVelocity = mContacts[i]->penetrationDepth
                                 - DART_ERROR_ALLOWANCE;
-      if (bouncingVelocity < 0.0)
+      if (mContacts[i]->timeOfImpact > 0.0)
+      {
+        // The contact is predicted by continuous collision detection. Unless
+        // they bounce, the bodies may close the gap between them within this
+        // step but not more.
+        bouncingVelocity = -mContacts[i]->gap * _info->invTimeStep;
+      }
+      else if (bouncingVelocity < 0.0)
       {
         bouncingVelocity = 0.0;
       }
@@ -498,7 +571,9 @@ void ContactConstraint::getInformation(ConstraintInfo* _info)
           bouncingVelocity = mMaxErrorReductionVelocity;
       }
 
-      // B. Restitution
+      // B. Restitution. Predicted contacts bounce within the step of the
+      // impact as well, otherwise a fast body would first be stopped at the
+      // time of impact and lose the velocity it should bounce back with.
       if (mIsBounceOn)
       {
         double& negativeRelativeVel = _info->b[i];
@@ -683,34 +758,23 @@ void ContactConstraint::applyImpulse(double* _lambda)
 //      std::cout << "_lambda: " << _lambda[_idx] << std::endl;
       index++;
 
-      assert(!math::isNan(_lambda[index]));
-
-      // Add contact impulse (force) toward the tangential w.r.t. world frame
       Eigen::MatrixXd D = getTangentBasisMatrixODE(mContacts[i]->normal);
-      mContacts[i]->force += D.col(0) * _lambda[index] / mTimeStep;
-
-      // Tangential direction-1 impulsive force
-//      mContacts[i]->lambda[1] = _lambda[_idx];
-      if (mBodyNode1->isReactive())
-        mBodyNode1->addConstraintImpulse(mJacobians1[index] * _lambda[index]);
-      if (mBodyNode2->isReactive())
-        mBodyNode2->addConstraintImpulse(mJacobians2[index] * _lambda[index]);
-//      std::cout << "_lambda: " << _lambda[_idx] << std::endl;
-      index++;
-
-      assert(!math::isNan(_lambda[index]));
-
-      // Add contact impulse (force) toward the tangential w.r.t. world frame
-      mContacts[i]->force += D.col(1) * _lambda[index] / mTimeStep;
-
-      // Tangential direction-2 impulsive force
-//      mContacts[i]->lambda[2] = _lambda[_idx];
-      if (mBodyNode1->isReactive())
-        mBodyNode1->addConstraintImpulse(mJacobians1[index] * _lambda[index]);
-      if (mBodyNode2->isReactive())
-        mBodyNode2->addConstraintImpulse(mJacobians2[index] * _lambda[index]);
-//      std::cout << "_lambda: " << _lambda[_idx] << std::endl;
-      index++;
+      for (size_t j = 0; j < mNumFrictionConeBases; ++j)
+      {
+        assert(!math::isNan(_lambda[index]));
+
+        // Add contact impulse (force) toward the tangential w.r.t. world frame
+        mContacts[i]->force += D.col(j) * _lambda[index] / mTimeStep;
+
+        // Tangential impulsive force
+        if (mBodyNode1->isReactive())
+          mBodyNode1->addConstraintImpulse(
+                mJacobians1[index] * _lambda[index]);
+        if (mBodyNode2->isReactive())
+          mBodyNode2->addConstraintImpulse(
+                mJacobians2[index] * _lambda[index]);
+        index++;
+      }
     }
   }
   //----------------------------------------------------------------------------
@@ -770,6 +834,25 @@ dynamics::SkeletonPtr ContactConstraint::getRootSkeleton() const
     return mBodyNode2->getSkeleton()->mUnionRootSkeleton.lock();
 }
 
+//==============================================================================
+void ContactConstraint::getSkeletons(dynamics::Skeleton*& _skeleton1,
+                                     dynamics::Skeleton*& _skeleton2) const
+{
+  _skeleton1 = nullptr;
+  _skeleton2 = nullptr;
+
+  if (mBodyNode1->isReactive())
+    _skeleton1 = mBodyNode1->getSkeleton().get();
+
+  if (mBodyNode2->isReactive())
+  {
+    if (_skeleton1)
+      _skeleton2 = mBodyNode2->getSkeleton().get();
+    else
+      _skeleton1 = mBodyNode2->getSkeleton().get();
+  }
+}
+
 //==============================================================================
 void ContactConstraint::updateFirstFrictionalDirection()
 {
@@ -787,11 +870,7 @@ void ContactConstraint::updateFirstFrictionalDirection()
 Eigen::MatrixXd ContactConstraint::getTangentBasisMatrixODE(
     const Eigen::Vector3d& _n)
 {
-  // TODO(JS): Use mNumFrictionConeBases
-  // Check if the number of bases is even number.
-//  bool isEvenNumBases = mNumFrictionConeBases % 2 ? true : false;
-
-  Eigen::MatrixXd T(Eigen::MatrixXd::Zero(3, 2));
+  Eigen::MatrixXd T(Eigen::MatrixXd::Zero(3, mNumFrictionConeBases));
 
   // Pick an arbitrary vector to take the cross product of (in this case,
   // Z-axis)
@@ -805,12 +884,15 @@ Eigen::MatrixXd ContactConstraint::getTangentBasisMatrixODE(
 
   tangent.normalize();
 
-  // Rotate the tangent around the normal to compute bases.
-  // Note: a possible speedup is in place for mNumDir % 2 = 0
-  // Each basis and its opposite belong in the matrix, so we iterate half as
-  // many times
-  T.col(0) = tangent;
-  T.col(1) = Eigen::Quaterniond(Eigen::AngleAxisd(DART_PI_HALF, _n)) * tangent;
+  // Rotate the tangent around the normal to compute bases. The impulse along
+  // each basis can be negative, so the bases only need to cover half a turn.
+  for (size_t i = 0; i < mNumFrictionConeBases; ++i)
+  {
+    const double angle = DART_PI * static_cast<double>(i)
+                         / static_cast<double>(mNumFrictionConeBases);
+    T.col(i) = Eigen::AngleAxisd(angle, _n) * tangent;
+  }
+
   return T;
 }
 
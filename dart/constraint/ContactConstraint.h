@@ -55,8 +55,32 @@ namespace constraint {
 class ContactConstraint : public ConstraintBase
 {
 public:
-  /// Constructor
-  ContactConstraint(collision::Contact& _contact, double _timeStep);
+  /// Approximation of the Coulomb friction cone
+  enum FrictionModel
+  {
+    /// No friction. A contact adds a single row to the LCP.
+    FRICTIONLESS,
+
+    /// Two orthogonal friction directions that are bounded independently by
+    /// the friction coefficient, i.e., a box around the friction cone. A
+    /// contact adds three rows to the LCP. This is the default.
+    BOX,
+
+    /// N friction directions spread evenly around the contact normal. The
+    /// bound of each direction is the friction coefficient scaled by
+    /// pi / (2N), so the limit of the total friction force approaches the
+    /// circular cone as N grows. A contact adds 1 + N rows to the LCP.
+    PYRAMID
+  };
+
+  /// Constructor that uses the default friction model
+  ContactConstraint(collision::ContactRecord& _contact, double _timeStep);
+
+  /// Constructor. _numFrictionConeBases is the number of friction directions
+  /// of the PYRAMID model and is ignored by the other models.
+  ContactConstraint(collision::ContactRecord& _contact, double _timeStep,
+                    FrictionModel _frictionModel,
+                    size_t _numFrictionConeBases);
 
   /// Destructor
   virtual ~ContactConstraint();
@@ -95,6 +119,27 @@ public:
   /// Get first frictional direction
   const Eigen::Vector3d& getFrictionDirection1() const;
 
+  /// Set the friction model of the ContactConstraints that are created
+  /// without specifying one
+  static void setDefaultFrictionModel(FrictionModel _model);
+
+  /// Get the default friction model
+  static FrictionModel getDefaultFrictionModel();
+
+  /// Set the default number of friction directions of the PYRAMID model. It
+  /// must be at least 2.
+  static void setDefaultNumFrictionConeBases(size_t _numBases);
+
+  /// Get the default number of friction directions of the PYRAMID model
+  static size_t getDefaultNumFrictionConeBases();
+
+  /// Get the friction model of this constraint
+  FrictionModel getFrictionModel() const;
+
+  /// Get the number of friction directions per contact. This is 0 when the
+  /// friction is off.
+  size_t getNumFrictionConeBases() const;
+
   //----------------------------------------------------------------------------
   // Friendship
   //----------------------------------------------------------------------------
@@ -131,6 +176,10 @@ protected:
   // Documentation inherited
   virtual dynamics::SkeletonPtr getRootSkeleton() const;
 
+  // Documentation inherited
+  virtual void getSkeletons(dynamics::Skeleton*& _skeleton1,
+                            dynamics::Skeleton*& _skeleton2) const;
+
   // Documentation inherited
   virtual void uniteSkeletons();
 
@@ -160,7 +209,7 @@ private:
   dynamics::BodyNode* mBodyNode2;
 
   /// Contacts between mBodyNode1 and mBodyNode2
-  std::vector<collision::Contact*> mContacts;
+  std::vector<collision::ContactRecord*> mContacts;
 
   /// First frictional direction
   Eigen::Vector3d mFirstFrictionalDirection;
@@ -168,6 +217,16 @@ private:
   /// Coefficient of Friction
   double mFrictionCoeff;
 
+  /// Friction model
+  FrictionModel mFrictionModel;
+
+  /// Number of friction directions per contact
+  size_t mNumFrictionConeBases;
+
+  /// Bound of the impulse along each friction direction relative to the
+  /// normal impulse
+  double mFrictionBound;
+
   /// Coefficient of restitution
   double mRestitutionCoeff;
 
@@ -204,6 +263,14 @@ private:
   /// \sa http://www.ode.org/ode-latest-userguide.html#sec_3_8_0
   static double mConstraintForceMixing;
 
+  /// Friction model of the constraints that are created without specifying
+  /// one. The default is BOX.
+  static FrictionModel mDefaultFrictionModel;
+
+  /// Default number of friction directions of the PYRAMID model. The default
+  /// is 4.
+  static size_t mDefaultNumFrictionConeBases;
+
 public:
   // To get byte-aligned Eigen vectors
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -44,6 +44,7 @@
 #include "dart/common/Console.h"
 #include "dart/constraint/ConstraintBase.h"
 #include "dart/constraint/ConstrainedGroup.h"
+#include "dart/dynamics/Skeleton.h"
 #include "dart/lcpsolver/Lemke.h"
 #include "dart/lcpsolver/lcp.h"
 
@@ -51,7 +52,9 @@ namespace dart {
 namespace constraint {
 
 //==============================================================================
-DantzigLCPSolver::DantzigLCPSolver(double _timestep) : LCPSolver(_timestep)
+DantzigLCPSolver::DantzigLCPSolver(double _timestep)
+  : LCPSolver(_timestep),
+    mWorkspace(new dLCPWorkspace)
 {
 }
 
@@ -73,13 +76,22 @@ void DantzigLCPSolver::solve(ConstrainedGroup* _group)
     return;
 
   int nSkip = dPAD(n);
-  double* A = new double[n * nSkip];
-  double* x = new double[n];
-  double* b = new double[n];
-  double* w = new double[n];
-  double* lo = new double[n];
-  double* hi = new double[n];
-  int* findex = new int[n];
+  mA.resize(n * nSkip);
+  mX.resize(n);
+  mB.resize(n);
+  mW.resize(n);
+  mLo.resize(n);
+  mHi.resize(n);
+  mFIndex.resize(n);
+  mOffset.resize(numConstraints);
+
+  double* A = mA.data();
+  double* x = mX.data();
+  double* b = mB.data();
+  double* w = mW.data();
+  double* lo = mLo.data();
+  double* hi = mHi.data();
+  int* findex = mFIndex.data();
 
   // Set w to 0 and findex to -1
 #ifndef NDEBUG
@@ -88,73 +100,8 @@ void DantzigLCPSolver::solve(ConstrainedGroup* _group)
   std::memset(w, 0.0, n * sizeof(double));
   std::memset(findex, -1, n * sizeof(int));
 
-  // Compute offset indices
-  size_t* offset = new size_t[n];
-  offset[0] = 0;
-//  std::cout << "offset[" << 0 << "]: " << offset[0] << std::endl;
-  for (size_t i = 1; i < numConstraints; ++i)
-  {
-    const ConstraintBasePtr& constraint = _group->getConstraint(i - 1);
-    assert(constraint->getDimension() > 0);
-    offset[i] = offset[i - 1] + constraint->getDimension();
-//    std::cout << "offset[" << i << "]: " << offset[i] << std::endl;
-  }
-
-  // For each constraint
-  ConstraintInfo constInfo;
-  constInfo.invTimeStep = 1.0 / mTimeStep;
-  for (size_t i = 0; i < numConstraints; ++i)
-  {
-    const ConstraintBasePtr& constraint = _group->getConstraint(i);
-
-    constInfo.x      = x      + offset[i];
-    constInfo.lo     = lo     + offset[i];
-    constInfo.hi     = hi     + offset[i];
-    constInfo.b      = b      + offset[i];
-    constInfo.findex = findex + offset[i];
-    constInfo.w      = w      + offset[i];
-
-    // Fill vectors: lo, hi, b, w
-    constraint->getInformation(&constInfo);
-
-    // Fill a matrix by impulse tests: A
-    constraint->excite();
-    for (size_t j = 0; j < constraint->getDimension(); ++j)
-    {
-      // Adjust findex for global index
-      if (findex[offset[i] + j] >= 0)
-        findex[offset[i] + j] += offset[i];
-
-      // Apply impulse for mipulse test
-      constraint->applyUnitImpulse(j);
-
-      // Fill upper triangle blocks of A matrix
-      int index = nSkip * (offset[i] + j) + offset[i];
-      constraint->getVelocityChange(A + index, true);
-      for (size_t k = i + 1; k < numConstraints; ++k)
-      {
-        index = nSkip * (offset[i] + j) + offset[k];
-        _group->getConstraint(k)->getVelocityChange(A + index, false);
-      }
-
-      // Filling symmetric part of A matrix
-      for (size_t k = 0; k < i; ++k)
-      {
-        for (size_t l = 0; l < _group->getConstraint(k)->getDimension(); ++l)
-        {
-          int index1 = nSkip * (offset[i] + j) + offset[k] + l;
-          int index2 = nSkip * (offset[k] + l) + offset[i] + j;
-
-          A[index1] = A[index2];
-        }
-      }
-    }
-
-    assert(isSymmetric(n, A, offset[i],
-                       offset[i] + constraint->getDimension() - 1));
-
-    constraint->unexcite();
-  }
+  size_t* offset = mOffset.data();
+  buildLCP(_group, nSkip, A, x, b, w, lo, hi, findex, offset);
 
   assert(isSymmetric(n, A));
 
@@ -164,7 +111,17 @@ void DantzigLCPSolver::solve(ConstrainedGroup* _group)
 //  std::cout << std::endl;
 
   // Solve LCP using ODE's Dantzig algorithm
-  dSolveLCP(n, A, x, b, w, 0, lo, hi, findex);
+  if (mWorkspace->warmStart)
+  {
+    std::vector<int>& activeSet = getActiveSet(_group);
+    mWorkspace->activeSet.swap(activeSet);
+    dSolveLCP(n, A, x, b, w, 0, lo, hi, findex, mWorkspace.get());
+    mWorkspace->activeSet.swap(activeSet);
+  }
+  else
+  {
+    dSolveLCP(n, A, x, b, w, 0, lo, hi, findex, mWorkspace.get());
+  }
 
   // Print LCP formulation
 //  dtdbg << "After solve:" << std::endl;
@@ -172,22 +129,81 @@ void DantzigLCPSolver::solve(ConstrainedGroup* _group)
 //  std::cout << std::endl;
 
   // Apply constraint impulses
-  for (size_t i = 0; i < numConstraints; ++i)
+  applyImpulses(_group, x, offset);
+}
+
+//==============================================================================
+const dynamics::Skeleton* DantzigLCPSolver::getGroupKey(
+    const ConstrainedGroup* _group) const
+{
+  // The groups of a time step do not share any skeleton, so the skeleton with
+  // the lowest address identifies the group
+  const dynamics::Skeleton* key = nullptr;
+  for (size_t i = 0; i < _group->getNumConstraints(); ++i)
+  {
+    dynamics::Skeleton* skeletons[2];
+    _group->getConstraint(i)->getSkeletons(skeletons[0], skeletons[1]);
+    for (const dynamics::Skeleton* skeleton : skeletons)
+    {
+      if (skeleton && (!key || skeleton < key))
+        key = skeleton;
+    }
+  }
+
+  return key;
+}
+
+//==============================================================================
+std::vector<int>& DantzigLCPSolver::getActiveSet(
+    const ConstrainedGroup* _group)
+{
+  const dynamics::Skeleton* key = getGroupKey(_group);
+
+  auto it = mActiveSets.find(key);
+  if (it == mActiveSets.end())
+  {
+    // Forget the groups whose skeletons have been destroyed
+    for (auto expired = mActiveSets.begin(); expired != mActiveSets.end();)
+    {
+      if (expired->first && expired->second.mSkeleton.expired())
+        expired = mActiveSets.erase(expired);
+      else
+        ++expired;
+    }
+
+    it = mActiveSets.insert(std::make_pair(key, ActiveSet())).first;
+    if (key)
+      it->second.mSkeleton = key->getPtr();
+  }
+  else if (key && it->second.mSkeleton.lock().get() != key)
   {
-    const ConstraintBasePtr& constraint = _group->getConstraint(i);
-    constraint->applyImpulse(x + offset[i]);
-    constraint->excite();
+    // The entry belongs to a destroyed skeleton at the same address
+    it->second.mSkeleton = key->getPtr();
+    it->second.mRows.clear();
   }
 
-  delete[] offset;
+  return it->second.mRows;
+}
+
+//==============================================================================
+void DantzigLCPSolver::setWarmStartEnabled(bool _enabled)
+{
+  mWorkspace->warmStart = _enabled;
+
+  if (!_enabled)
+    mActiveSets.clear();
+}
 
-  delete[] A;
-  delete[] x;
-  delete[] b;
-  delete[] w;
-  delete[] lo;
-  delete[] hi;
-  delete[] findex;
+//==============================================================================
+bool DantzigLCPSolver::isWarmStartEnabled() const
+{
+  return mWorkspace->warmStart;
+}
+
+//==============================================================================
+int DantzigLCPSolver::getLastNumPivots() const
+{
+  return mWorkspace->numPivots;
 }
 
 //==============================================================================
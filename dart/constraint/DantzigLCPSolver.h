@@ -38,11 +38,20 @@
 #define DART_CONSTRAINT_DANTZIGLCPSOLVER_H_
 
 #include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
 
 #include "dart/config.h"
 #include "dart/constraint/LCPSolver.h"
 
+struct dLCPWorkspace;
+
 namespace dart {
+namespace dynamics {
+class Skeleton;
+}  // namespace dynamics
+
 namespace constraint {
 
 /// DantzigLCPSolver is a LCP solver that uses ODE's implementation of Dantzig
@@ -59,8 +68,70 @@ public:
   // Documentation inherited
   virtual void solve(ConstrainedGroup* _group);
 
-#ifndef NDEBUG
+  /// Start each solve from the set of clamped constraint rows of the last
+  /// solution of the same constrained group, i.e., the group of the same
+  /// skeletons, if it had the same dimension. This saves pivots when the
+  /// contacts change little between steps, e.g., for resting objects. A guess
+  /// that does not fit the new problem is discarded, so the solution does not
+  /// depend on this option. It is off by default.
+  void setWarmStartEnabled(bool _enabled);
+
+  /// Return true if the solver is warm started
+  bool isWarmStartEnabled() const;
+
+  /// Return the number of pivots of the last solve
+  int getLastNumPivots() const;
+
 private:
+  /// LCP matrix. The buffers are kept between calls to avoid reallocating
+  /// them for every constrained group.
+  std::vector<double> mA;
+
+  /// LCP solution
+  std::vector<double> mX;
+
+  /// LCP bias
+  std::vector<double> mB;
+
+  /// LCP slack
+  std::vector<double> mW;
+
+  /// Lower bounds
+  std::vector<double> mLo;
+
+  /// Upper bounds
+  std::vector<double> mHi;
+
+  /// Friction indices
+  std::vector<int> mFIndex;
+
+  /// Offsets of the constraints in the LCP
+  std::vector<size_t> mOffset;
+
+  /// Work arrays of the Dantzig solver
+  std::unique_ptr<dLCPWorkspace> mWorkspace;
+
+  struct ActiveSet
+  {
+    /// Skeleton of the key. A skeleton that is created at the address of an
+    /// expired one must not start from its active set.
+    std::weak_ptr<const dynamics::Skeleton> mSkeleton;
+
+    /// Clamped rows of the last solution
+    std::vector<int> mRows;
+  };
+
+  /// Active sets of the constrained groups, keyed by getGroupKey()
+  std::map<const dynamics::Skeleton*, ActiveSet> mActiveSets;
+
+  /// Return the skeleton that identifies _group across time steps
+  const dynamics::Skeleton* getGroupKey(const ConstrainedGroup* _group) const;
+
+  /// Return the active set of _group, which is empty if the group has not
+  /// been solved before
+  std::vector<int>& getActiveSet(const ConstrainedGroup* _group);
+
+#ifndef NDEBUG
   /// Return true if the matrix is symmetric
   bool isSymmetric(size_t _n, double* _A);
 
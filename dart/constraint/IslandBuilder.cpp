@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/constraint/IslandBuilder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <utility>
+
+#include "dart/dynamics/Skeleton.h"
+#include "dart/constraint/ConstraintBase.h"
+
+namespace dart {
+namespace constraint {
+
+namespace {
+
+const size_t invalidIndex = std::numeric_limits<size_t>::max();
+
+}  // anonymous namespace
+
+//==============================================================================
+IslandBuilder::IslandBuilder()
+  : mNumSkeletons(0u)
+{
+  mStatistics.mNumIslands = 0u;
+  mStatistics.mNumConstraints = 0u;
+  mStatistics.mNumConstrainedSkeletons = 0u;
+  mStatistics.mMaxNumIslandSkeletons = 0u;
+  mStatistics.mMaxNumIslandConstraints = 0u;
+}
+
+//==============================================================================
+void IslandBuilder::setSkeletons(
+    const std::vector<dynamics::SkeletonPtr>& _skeletons)
+{
+  mNodes.clear();
+  mSkeletons.clear();
+  mNumSkeletons = _skeletons.size();
+
+  for (const auto& skel : _skeletons)
+  {
+    mNodes[skel.get()] = mSkeletons.size();
+    mSkeletons.push_back(skel.get());
+  }
+
+  // Every skeleton is an island of its own until the next build
+  mIslandRoots.clear();
+  mConstraintIslands.clear();
+  mSkeletonIslands.resize(mNumSkeletons);
+  for (size_t i = 0; i < mNumSkeletons; ++i)
+    mSkeletonIslands[i] = i;
+}
+
+//==============================================================================
+size_t IslandBuilder::getNumSkeletons() const
+{
+  return mNumSkeletons;
+}
+
+//==============================================================================
+void IslandBuilder::build(const std::vector<ConstraintBasePtr>& _constraints)
+{
+  // Forget the skeletons that only took part in the previous build
+  for (size_t i = mNumSkeletons; i < mSkeletons.size(); ++i)
+    mNodes.erase(mSkeletons[i]);
+  mSkeletons.resize(mNumSkeletons);
+
+  mParents.resize(mNumSkeletons);
+  for (size_t i = 0; i < mNumSkeletons; ++i)
+    mParents[i] = i;
+  mSizes.assign(mNumSkeletons, 1u);
+
+  //----------------------------------------------------------------------------
+  // Unite the skeletons of each constraint. The node of the first skeleton is
+  // stored as the island of the constraint until the islands are numbered.
+  //----------------------------------------------------------------------------
+  mConstraintIslands.resize(_constraints.size());
+  for (size_t i = 0; i < _constraints.size(); ++i)
+  {
+    dynamics::Skeleton* skel1 = nullptr;
+    dynamics::Skeleton* skel2 = nullptr;
+    _constraints[i]->getSkeletons(skel1, skel2);
+    assert(skel1 != nullptr);
+
+    if (skel1 == nullptr)
+    {
+      mConstraintIslands[i] = invalidIndex;
+      continue;
+    }
+
+    const size_t node1 = getNode(skel1);
+    mConstraintIslands[i] = node1;
+
+    if (skel2 != nullptr && skel2 != skel1)
+      unite(node1, getNode(skel2));
+  }
+
+  //----------------------------------------------------------------------------
+  // Number the islands in the order of their first constraint
+  //----------------------------------------------------------------------------
+  mRootIslands.assign(mParents.size(), invalidIndex);
+  mIslandRoots.clear();
+  mIslandNumConstraints.clear();
+  for (size_t i = 0; i < _constraints.size(); ++i)
+  {
+    const size_t node = mConstraintIslands[i];
+    size_t island;
+
+    if (node == invalidIndex)
+    {
+      island = mIslandRoots.size();
+      mIslandRoots.push_back(invalidIndex);
+      mIslandNumConstraints.push_back(0u);
+    }
+    else
+    {
+      const size_t root = find(node);
+      island = mRootIslands[root];
+
+      if (island == invalidIndex)
+      {
+        island = mIslandRoots.size();
+        mRootIslands[root] = island;
+        mIslandRoots.push_back(root);
+        mIslandNumConstraints.push_back(0u);
+      }
+    }
+
+    mConstraintIslands[i] = island;
+    ++mIslandNumConstraints[island];
+  }
+
+  const size_t numIslands = mIslandRoots.size();
+
+  //----------------------------------------------------------------------------
+  // Find the island of each skeleton
+  //----------------------------------------------------------------------------
+  mIslandNumSkeletons.assign(numIslands, 0u);
+  for (size_t i = 0; i < mParents.size(); ++i)
+  {
+    const size_t island = mRootIslands[find(i)];
+    if (island != invalidIndex)
+      ++mIslandNumSkeletons[island];
+  }
+
+  mSkeletonIslands.resize(mNumSkeletons);
+  for (size_t i = 0; i < mNumSkeletons; ++i)
+  {
+    const size_t island = mRootIslands[find(i)];
+    mSkeletonIslands[i] = (island == invalidIndex) ? numIslands + i : island;
+  }
+
+  //----------------------------------------------------------------------------
+  // Statistics
+  //----------------------------------------------------------------------------
+  mStatistics.mNumIslands = numIslands;
+  mStatistics.mNumConstraints = _constraints.size();
+  mStatistics.mNumConstrainedSkeletons = 0u;
+  mStatistics.mMaxNumIslandSkeletons = 0u;
+  mStatistics.mMaxNumIslandConstraints = 0u;
+  for (size_t i = 0; i < numIslands; ++i)
+  {
+    mStatistics.mNumConstrainedSkeletons += mIslandNumSkeletons[i];
+    mStatistics.mMaxNumIslandSkeletons = std::max(
+          mStatistics.mMaxNumIslandSkeletons, mIslandNumSkeletons[i]);
+    mStatistics.mMaxNumIslandConstraints = std::max(
+          mStatistics.mMaxNumIslandConstraints, mIslandNumConstraints[i]);
+  }
+}
+
+//==============================================================================
+size_t IslandBuilder::getNumIslands() const
+{
+  return mIslandRoots.size();
+}
+
+//==============================================================================
+size_t IslandBuilder::getConstraintIsland(size_t _index) const
+{
+  assert(_index < mConstraintIslands.size());
+  return mConstraintIslands[_index];
+}
+
+//==============================================================================
+size_t IslandBuilder::getSkeletonIsland(size_t _index) const
+{
+  assert(_index < mSkeletonIslands.size());
+  return mSkeletonIslands[_index];
+}
+
+//==============================================================================
+dynamics::Skeleton* IslandBuilder::getIslandSkeleton(size_t _island) const
+{
+  assert(_island < mIslandRoots.size());
+
+  const size_t root = mIslandRoots[_island];
+  if (root == invalidIndex)
+    return nullptr;
+
+  return mSkeletons[root];
+}
+
+//==============================================================================
+const IslandBuilder::Statistics& IslandBuilder::getStatistics() const
+{
+  return mStatistics;
+}
+
+//==============================================================================
+size_t IslandBuilder::getNode(dynamics::Skeleton* _skeleton)
+{
+  const auto result = mNodes.insert(std::make_pair(_skeleton,
+                                                   mSkeletons.size()));
+
+  if (result.second)
+  {
+    mSkeletons.push_back(_skeleton);
+    mParents.push_back(mParents.size());
+    mSizes.push_back(1u);
+  }
+
+  return result.first->second;
+}
+
+//==============================================================================
+size_t IslandBuilder::find(size_t _node)
+{
+  while (mParents[_node] != _node)
+  {
+    mParents[_node] = mParents[mParents[_node]];
+    _node = mParents[_node];
+  }
+
+  return _node;
+}
+
+//==============================================================================
+void IslandBuilder::unite(size_t _node1, size_t _node2)
+{
+  size_t root1 = find(_node1);
+  size_t root2 = find(_node2);
+
+  if (root1 == root2)
+    return;
+
+  if (mSizes[root1] < mSizes[root2])
+    std::swap(root1, root2);
+
+  mParents[root2] = root1;
+  mSizes[root1] += mSizes[root2];
+}
+
+}  // namespace constraint
+}  // namespace dart
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_CONSTRAINT_ISLANDBUILDER_H_
+#define DART_CONSTRAINT_ISLANDBUILDER_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "dart/dynamics/SmartPointer.h"
+#include "dart/constraint/SmartPointer.h"
+
+namespace dart {
+namespace constraint {
+
+/// IslandBuilder partitions constraints into islands, which are the groups of
+/// constraints that have to be solved together because they act on common
+/// skeletons. The skeletons are the nodes of a disjoint-set forest with union
+/// by size and path halving, so building the islands takes nearly linear time
+/// in the number of constraints. The storage is kept across builds, so
+/// building the islands every time step does not allocate once the number of
+/// skeletons and constraints has settled.
+/// \sa ConstraintBase::getSkeletons()
+class IslandBuilder
+{
+public:
+  /// Statistics of the last build
+  struct Statistics
+  {
+    /// Number of islands that contain at least one constraint
+    size_t mNumIslands;
+
+    /// Number of constraints
+    size_t mNumConstraints;
+
+    /// Number of skeletons that belong to an island
+    size_t mNumConstrainedSkeletons;
+
+    /// Largest number of skeletons in an island
+    size_t mMaxNumIslandSkeletons;
+
+    /// Largest number of constraints in an island
+    size_t mMaxNumIslandConstraints;
+  };
+
+  /// Constructor
+  IslandBuilder();
+
+  /// Set the skeletons that the constraints act on. Constraints may also act
+  /// on skeletons that are not in this list. Those skeletons take part in the
+  /// build that they appear in but have no getSkeletonIsland().
+  void setSkeletons(const std::vector<dynamics::SkeletonPtr>& _skeletons);
+
+  /// Return the number of skeletons that have been set by setSkeletons()
+  size_t getNumSkeletons() const;
+
+  /// Build the islands of _constraints
+  void build(const std::vector<ConstraintBasePtr>& _constraints);
+
+  /// Return the number of islands that contain at least one constraint
+  size_t getNumIslands() const;
+
+  /// Return the island of the _index-th constraint of the last build. Islands
+  /// are numbered in the order of their first constraint.
+  size_t getConstraintIsland(size_t _index) const;
+
+  /// Return the island of the _index-th skeleton in the last build. A skeleton
+  /// that no constraint acts on forms an island of its own whose index is
+  /// getNumIslands() + _index.
+  size_t getSkeletonIsland(size_t _index) const;
+
+  /// Return one of the skeletons in _island, or nullptr if the constraints of
+  /// _island do not act on any skeleton
+  dynamics::Skeleton* getIslandSkeleton(size_t _island) const;
+
+  /// Return the statistics of the last build
+  const Statistics& getStatistics() const;
+
+private:
+  /// Return the node of _skeleton, creating it if needed
+  size_t getNode(dynamics::Skeleton* _skeleton);
+
+  /// Return the root of the tree that contains _node
+  size_t find(size_t _node);
+
+  /// Merge the trees that contain _node1 and _node2
+  void unite(size_t _node1, size_t _node2);
+
+  /// Node index of each skeleton
+  std::unordered_map<const dynamics::Skeleton*, size_t> mNodes;
+
+  /// Skeleton of each node. The first mNumSkeletons nodes are the skeletons
+  /// set by setSkeletons().
+  std::vector<dynamics::Skeleton*> mSkeletons;
+
+  /// Number of skeletons set by setSkeletons()
+  size_t mNumSkeletons;
+
+  /// Parent of each node
+  std::vector<size_t> mParents;
+
+  /// Size of the tree of each root node
+  std::vector<size_t> mSizes;
+
+  /// Island of each root node
+  std::vector<size_t> mRootIslands;
+
+  /// Island of each constraint
+  std::vector<size_t> mConstraintIslands;
+
+  /// Island of each skeleton set by setSkeletons()
+  std::vector<size_t> mSkeletonIslands;
+
+  /// Root node of each island
+  std::vector<size_t> mIslandRoots;
+
+  /// Number of constraints in each island
+  std::vector<size_t> mIslandNumConstraints;
+
+  /// Number of skeletons in each island
+  std::vector<size_t> mIslandNumSkeletons;
+
+  /// Statistics of the last build
+  Statistics mStatistics;
+};
+
+}  // namespace constraint
+}  // namespace dart
+
+#endif  // DART_CONSTRAINT_ISLANDBUILDER_H_
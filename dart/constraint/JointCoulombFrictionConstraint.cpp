@@ -278,6 +278,14 @@ dynamics::SkeletonPtr JointCoulombFrictionConstraint::getRootSkeleton() const
   return mJoint->getSkeleton()->mUnionRootSkeleton.lock();
 }
 
+//==============================================================================
+void JointCoulombFrictionConstraint::getSkeletons(dynamics::Skeleton*& _skeleton1,
+                                                  dynamics::Skeleton*& _skeleton2) const
+{
+  _skeleton1 = mJoint->getSkeleton().get();
+  _skeleton2 = nullptr;
+}
+
 //==============================================================================
 bool JointCoulombFrictionConstraint::isActive() const
 {
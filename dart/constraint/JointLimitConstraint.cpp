@@ -386,6 +386,14 @@ dynamics::SkeletonPtr JointLimitConstraint::getRootSkeleton() const
   return mJoint->getSkeleton()->mUnionRootSkeleton.lock();
 }
 
+//==============================================================================
+void JointLimitConstraint::getSkeletons(dynamics::Skeleton*& _skeleton1,
+                                        dynamics::Skeleton*& _skeleton2) const
+{
+  _skeleton1 = mJoint->getSkeleton().get();
+  _skeleton2 = nullptr;
+}
+
 //==============================================================================
 bool JointLimitConstraint::isActive() const
 {
@@ -123,6 +123,10 @@ protected:
   // Documentation inherited
   virtual dynamics::SkeletonPtr getRootSkeleton() const;
 
+  // Documentation inherited
+  virtual void getSkeletons(dynamics::Skeleton*& _skeleton1,
+                            dynamics::Skeleton*& _skeleton2) const;
+
   // Documentation inherited
   virtual bool isActive() const;
 
@@ -38,6 +38,9 @@
 
 #include <cassert>
 
+#include "dart/constraint/ConstraintBase.h"
+#include "dart/constraint/ConstrainedGroup.h"
+
 namespace dart {
 namespace constraint {
 
@@ -64,5 +67,87 @@ LCPSolver::~LCPSolver()
 {
 }
 
+//==============================================================================
+void LCPSolver::buildLCP(ConstrainedGroup* _group, int _nSkip, double* _A,
+                         double* _x, double* _b, double* _w, double* _lo,
+                         double* _hi, int* _findex, size_t* _offset) const
+{
+  const size_t numConstraints = _group->getNumConstraints();
+
+  // Compute offset indices
+  _offset[0] = 0;
+  for (size_t i = 1; i < numConstraints; ++i)
+  {
+    const ConstraintBasePtr& constraint = _group->getConstraint(i - 1);
+    assert(constraint->getDimension() > 0);
+    _offset[i] = _offset[i - 1] + constraint->getDimension();
+  }
+
+  // For each constraint
+  ConstraintInfo constInfo;
+  constInfo.invTimeStep = 1.0 / mTimeStep;
+  for (size_t i = 0; i < numConstraints; ++i)
+  {
+    const ConstraintBasePtr& constraint = _group->getConstraint(i);
+
+    constInfo.x      = _x      + _offset[i];
+    constInfo.lo     = _lo     + _offset[i];
+    constInfo.hi     = _hi     + _offset[i];
+    constInfo.b      = _b      + _offset[i];
+    constInfo.findex = _findex + _offset[i];
+    constInfo.w      = _w      + _offset[i];
+
+    // Fill vectors: lo, hi, b, w
+    constraint->getInformation(&constInfo);
+
+    // Fill a matrix by impulse tests: A
+    constraint->excite();
+    for (size_t j = 0; j < constraint->getDimension(); ++j)
+    {
+      // Adjust findex for global index
+      if (_findex[_offset[i] + j] >= 0)
+        _findex[_offset[i] + j] += _offset[i];
+
+      // Apply impulse for mipulse test
+      constraint->applyUnitImpulse(j);
+
+      // Fill upper triangle blocks of A matrix
+      int index = _nSkip * (_offset[i] + j) + _offset[i];
+      constraint->getVelocityChange(_A + index, true);
+      for (size_t k = i + 1; k < numConstraints; ++k)
+      {
+        index = _nSkip * (_offset[i] + j) + _offset[k];
+        _group->getConstraint(k)->getVelocityChange(_A + index, false);
+      }
+
+      // Filling symmetric part of A matrix
+      for (size_t k = 0; k < i; ++k)
+      {
+        for (size_t l = 0; l < _group->getConstraint(k)->getDimension(); ++l)
+        {
+          int index1 = _nSkip * (_offset[i] + j) + _offset[k] + l;
+          int index2 = _nSkip * (_offset[k] + l) + _offset[i] + j;
+
+          _A[index1] = _A[index2];
+        }
+      }
+    }
+
+    constraint->unexcite();
+  }
+}
+
+//==============================================================================
+void LCPSolver::applyImpulses(ConstrainedGroup* _group, double* _x,
+                              const size_t* _offset)
+{
+  for (size_t i = 0; i < _group->getNumConstraints(); ++i)
+  {
+    const ConstraintBasePtr& constraint = _group->getConstraint(i);
+    constraint->applyImpulse(_x + _offset[i]);
+    constraint->excite();
+  }
+}
+
 }  // namespace constraint
 }  // namespace dart
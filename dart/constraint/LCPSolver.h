@@ -37,6 +37,8 @@
 #ifndef DART_CONSTRAINT_LCPSOLVER_H_
 #define DART_CONSTRAINT_LCPSOLVER_H_
 
+#include <cstddef>
+
 namespace dart {
 namespace constraint {
 
@@ -62,6 +64,18 @@ protected:
   /// Constructor
   LCPSolver(double _timeStep);
 
+  /// Build the LCP of _group by impulse tests. A is filled with leading
+  /// dimension _nSkip, and b, lo, hi and findex are filled by the constraints.
+  /// x and w are handed to the constraints as well, so the caller initializes
+  /// them. The offset of every constraint in the LCP is returned in _offset.
+  void buildLCP(ConstrainedGroup* _group, int _nSkip, double* _A, double* _x,
+                double* _b, double* _w, double* _lo, double* _hi,
+                int* _findex, size_t* _offset) const;
+
+  /// Apply the constraint impulses _x, laid out as built by buildLCP()
+  static void applyImpulses(ConstrainedGroup* _group, double* _x,
+                            const size_t* _offset);
+
 protected:
   /// Simulation time step
   double mTimeStep;
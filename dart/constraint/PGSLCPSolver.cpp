@@ -41,11 +41,20 @@
 #include <iostream>
 #endif
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Dense>
+
 #include "dart/common/Console.h"
 #include "dart/constraint/ConstraintBase.h"
 #include "dart/constraint/ConstrainedGroup.h"
 #include "dart/lcpsolver/Lemke.h"
 #include "dart/lcpsolver/lcp.h"
+#include "dart/lcpsolver/misc.h"
 
 namespace dart {
 namespace constraint {
@@ -53,6 +62,12 @@ namespace constraint {
 //==============================================================================
 PGSLCPSolver::PGSLCPSolver(double _timestep) : LCPSolver(_timestep)
 {
+  mOption.setDefault();
+
+  mStatistics.iterations = 0;
+  mStatistics.residual = 0.0;
+  mStatistics.relative_change = 0.0;
+  mStatistics.converged = true;
 }
 
 //==============================================================================
@@ -83,76 +98,12 @@ void PGSLCPSolver::solve(ConstrainedGroup* _group)
 #ifndef NDEBUG
   std::memset(A, 0.0, n * nSkip * sizeof(double));
 #endif
+  std::memset(x, 0, n * sizeof(double));
   std::memset(w, 0.0, n * sizeof(double));
   std::memset(findex, -1, n * sizeof(int));
 
-  // Compute offset indices
-  size_t* offset = new size_t[n];
-  offset[0] = 0;
-  //  std::cout << "offset[" << 0 << "]: " << offset[0] << std::endl;
-  for (size_t i = 1; i < numConstraints; ++i)
-  {
-    const ConstraintBasePtr&  constraint = _group->getConstraint(i - 1);
-    assert(constraint->getDimension() > 0);
-    offset[i] = offset[i - 1] + constraint->getDimension();
-    //    std::cout << "offset[" << i << "]: " << offset[i] << std::endl;
-  }
-
-  // For each constraint
-  ConstraintInfo constInfo;
-  constInfo.invTimeStep = 1.0 / mTimeStep;
-  for (size_t i = 0; i < numConstraints; ++i)
-  {
-    const ConstraintBasePtr& constraint = _group->getConstraint(i);
-
-    constInfo.x      = x      + offset[i];
-    constInfo.lo     = lo     + offset[i];
-    constInfo.hi     = hi     + offset[i];
-    constInfo.b      = b      + offset[i];
-    constInfo.findex = findex + offset[i];
-    constInfo.w      = w      + offset[i];
-
-    // Fill vectors: lo, hi, b, w
-    constraint->getInformation(&constInfo);
-
-    // Fill a matrix by impulse tests: A
-    constraint->excite();
-    for (size_t j = 0; j < constraint->getDimension(); ++j)
-    {
-      // Adjust findex for global index
-      if (findex[offset[i] + j] >= 0)
-        findex[offset[i] + j] += offset[i];
-
-      // Apply impulse for mipulse test
-      constraint->applyUnitImpulse(j);
-
-      // Fill upper triangle blocks of A matrix
-      int index = nSkip * (offset[i] + j) + offset[i];
-      constraint->getVelocityChange(A + index, true);
-      for (size_t k = i + 1; k < numConstraints; ++k)
-      {
-        index = nSkip * (offset[i] + j) + offset[k];
-        _group->getConstraint(k)->getVelocityChange(A + index, false);
-      }
-
-      // Filling symmetric part of A matrix
-      for (size_t k = 0; k < i; ++k)
-      {
-        for (size_t l = 0; l < _group->getConstraint(k)->getDimension(); ++l)
-        {
-          int index1 = nSkip * (offset[i] + j) + offset[k] + l;
-          int index2 = nSkip * (offset[k] + l) + offset[i] + j;
-
-          A[index1] = A[index2];
-        }
-      }
-    }
-
-    assert(isSymmetric(n, A, offset[i],
-                       offset[i] + constraint->getDimension() - 1));
-
-    constraint->unexcite();
-  }
+  size_t* offset = new size_t[numConstraints];
+  buildLCP(_group, nSkip, A, x, b, w, lo, hi, findex, offset);
 
   assert(isSymmetric(n, A));
 
@@ -163,9 +114,7 @@ void PGSLCPSolver::solve(ConstrainedGroup* _group)
 
   // Solve LCP using ODE's Dantzig algorithm
 //  dSolveLCP(n, A, x, b, w, 0, lo, hi, findex);
-  PGSOption option;
-  option.setDefault();
-  solvePGS(n, nSkip, 0, A, x, b, lo, hi, findex, &option);
+  solvePGS(n, nSkip, 0, A, x, b, lo, hi, findex, &mOption, &mStatistics);
 
   // Print LCP formulation
   //  dtdbg << "After solve:" << std::endl;
@@ -173,12 +122,7 @@ void PGSLCPSolver::solve(ConstrainedGroup* _group)
   //  std::cout << std::endl;
 
   // Apply constraint impulses
-  for (size_t i = 0; i < numConstraints; ++i)
-  {
-    const ConstraintBasePtr& constraint = _group->getConstraint(i);
-    constraint->applyImpulse(x + offset[i]);
-    constraint->excite();
-  }
+  applyImpulses(_group, x, offset);
 
   delete[] offset;
 
@@ -191,6 +135,24 @@ void PGSLCPSolver::solve(ConstrainedGroup* _group)
   delete[] findex;
 }
 
+//==============================================================================
+void PGSLCPSolver::setOption(const PGSOption& _option)
+{
+  mOption = _option;
+}
+
+//==============================================================================
+const PGSOption& PGSLCPSolver::getOption() const
+{
+  return mOption;
+}
+
+//==============================================================================
+const PGSStatistics& PGSLCPSolver::getLastStatistics() const
+{
+  return mStatistics;
+}
+
 //==============================================================================
 #ifndef NDEBUG
 bool PGSLCPSolver::isSymmetric(size_t _n, double* _A)
@@ -344,8 +306,10 @@ void PGSLCPSolver::print(size_t _n, double* _A, double* _x,
 }
 #endif
 
+//==============================================================================
 bool solvePGS(int n, int nskip, int /*nub*/, double * A, double * x, double * b,
-              double * lo, double * hi, int * findex, PGSOption * option)
+              double * lo, double * hi, int * findex, PGSOption * option,
+              PGSStatistics* statistics)
 {
   // LDLT solver will work !!!
   //if (nub == n)
@@ -353,126 +317,100 @@ bool solvePGS(int n, int nskip, int /*nub*/, double * A, double * x, double * b,
   //	return LDLTSolver(n,nskip,A,x,b)
   //}
 
-  int i, j, iter, idx, n_new;
-  bool sentinel;
-  double old_x, new_x, hi_tmp, lo_tmp, dummy, ea;
-  double * A_ptr;
-  double one_minus_sor_w = 1.0 - (option->sor_w);
+  // A contact contributes one normal row followed by the friction rows that
+  // point to it
+  const int maxBlockSize = 3;
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 1, 0, maxBlockSize, 1>
+      BlockVector;
+  typedef Eigen::Map<const Eigen::Matrix<
+      double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>,
+      0, Eigen::OuterStride<>> RowBlock;
 
-  //--- ORDERING & SCALING & INITIAL LOOP & Test
-  int* order = new int[n];
+  const Eigen::Map<const Eigen::VectorXd> xVec(x, n);
 
-  n_new = 0;
-  sentinel = true;
-  for (i = 0 ; i < n ; i++)
+  //--- SCALING
+  for (int i = 0; i < n; ++i)
   {
-    // ORDERING
-    if ( A[nskip*i + i] < option->eps_div )
+    const double diag = A[nskip*i + i];
+    if (diag < option->eps_div)
     {
       x[i] = 0.0;
       continue;
     }
-    order[n_new++] = i;
-
-    // INITIAL LOOP
-    A_ptr = A + nskip*i;
-    new_x = b[i];
-    old_x = x[i];
-
-    for (j = 0 ; j < i ; j++)
-      new_x -= A_ptr[j]*x[j];
-    for (j = i + 1 ; j < n ; j++)
-      new_x -= A_ptr[j]*x[j];
-
-    new_x = new_x/A[nskip*i + i];
-
-    if (findex[i] >= 0)	// friction index
-    {
-      hi_tmp = hi[i] * x[findex[i]];
-      lo_tmp = -hi_tmp;
-
-      if (new_x > hi_tmp)
-        x[i] = hi_tmp;
-      else if (new_x < lo_tmp)
-        x[i] = lo_tmp;
-      else
-        x[i] = new_x;
-    }
-    else					// no friction index
-    {
-      if (new_x > hi[i])
-        x[i] = hi[i];
-      else if (new_x < lo[i])
-        x[i] = lo[i];
-      else
-        x[i] = new_x;
-    }
 
-    // TEST
-    if (sentinel)
-    {
-      ea = std::abs(x[i] - old_x);
-      if (ea > option->eps_res)
-        sentinel = false;
-    }
-  }
-  if (sentinel)
-  {
-    delete[] order;
-    return true;
+    const double invDiag = 1.0 / diag;
+    b[i] *= invDiag;
+    Eigen::Map<Eigen::VectorXd>(A + nskip*i, n) *= invDiag;
   }
 
-  // SCALING
-  for (i = 0 ; i < n_new ; i++)
+  //--- BLOCKS
+  // First row and number of rows of every block, in the order of the sweeps
+  std::vector<std::pair<int, int>> blocks;
+  blocks.reserve(n);
+  for (int i = 0; i < n; )
   {
-    idx = order[i];
+    int size = 1;
+    while (size < maxBlockSize && i + size < n && findex[i + size] == i)
+      ++size;
 
-    dummy = 1.0/A[nskip*idx + idx];  // diagonal element
-    b[idx] *= dummy;
-    for (j = 0 ; j < n ; j++)
-      A[nskip*idx + j] *= dummy;
+    blocks.push_back(std::make_pair(i, size));
+    i += size;
   }
 
   //--- ITERATION LOOP
-  for (iter = 1 ; iter < option->itermax ; iter++)
+  int iter = 0;
+  double maxDelta = 0.0;
+  double maxRelative = 0.0;
+  bool converged = false;
+  while (iter < option->itermax && !converged)
   {
+    // The first sweep is not relaxed
+    const double sor_w = (iter == 0) ? 1.0 : option->sor_w;
+
     //--- RANDOMLY_REORDER_CONSTRAINTS
-#if LCP_PGS_RANDOMLY_REORDER_CONSTRAINTS
-    if ((iter & 7)==0)
+    if (option->random_order && iter > 0 && (iter & 7) == 0)
     {
-      int tmp, swapi;
-      for (i = 1 ; i < n_new ; i++)
-      {
-        tmp = order[i];
-        swapi = dRandInt(i+1);
-        order[i] = order[swapi];
-        order[swapi] = tmp;
-      }
+      for (size_t j = 1; j < blocks.size(); ++j)
+        std::swap(blocks[j], blocks[dRandInt(static_cast<int>(j) + 1)]);
     }
-#endif
 
-    sentinel = true;
+    maxDelta = 0.0;
+    maxRelative = 0.0;
 
-    //-- ONE LOOP
-    for (i = 0 ; i < n_new ; i++)
+    for (const std::pair<int, int>& block : blocks)
     {
-      idx = order[i];
+      const int i = block.first;
+      const int size = block.second;
+
+      // Residuals of the block rows: b - A x
+      BlockVector r(size);
+      r.noalias() = -RowBlock(A + nskip*i, size, n,
+                              Eigen::OuterStride<>(nskip)) * xVec;
+      r += Eigen::Map<const Eigen::VectorXd>(b + i, size);
 
-      A_ptr = A + nskip*idx;
-      new_x = b[idx];
-      old_x = x[idx];
+      for (int k = 0; k < size; ++k)
+      {
+        const int idx = i + k;
 
-      for (j = 0 ; j < idx ; j++)
-        new_x -= A_ptr[j]*x[j];
-      for (j = idx + 1 ; j < n ; j++)
-        new_x -= A_ptr[j]*x[j];
+        // Rows that were not scaled are not solved
+        if (A[nskip*idx + idx] < option->eps_div)
+          continue;
 
-      new_x = (option->sor_w * new_x) + (one_minus_sor_w * old_x);
+        const double old_x = x[idx];
+        const double new_x = old_x + sor_w * r[k];
 
-      if (findex[idx] >= 0)	// friction index
-      {
-        hi_tmp = hi[idx] * x[findex[idx]];
-        lo_tmp = -hi_tmp;
+        double lo_tmp;
+        double hi_tmp;
+        if (findex[idx] >= 0)	// friction index
+        {
+          hi_tmp = hi[idx] * x[findex[idx]];
+          lo_tmp = -hi_tmp;
+        }
+        else					// no friction index
+        {
+          hi_tmp = hi[idx];
+          lo_tmp = lo[idx];
+        }
 
         if (new_x > hi_tmp)
           x[idx] = hi_tmp;
@@ -480,38 +418,43 @@ bool solvePGS(int n, int nskip, int /*nub*/, double * A, double * x, double * b,
           x[idx] = lo_tmp;
         else
           x[idx] = new_x;
-      }
-      else					// no friction index
-      {
-        if (new_x > hi[idx])
-          x[idx] = hi[idx];
-        else if (new_x < lo[idx])
-          x[idx] = lo[idx];
-        else
-          x[idx] = new_x;
-      }
 
-      if ( sentinel && std::abs(x[idx]) > option->eps_div)
-      {
-        ea = std::abs((x[idx] - old_x)/x[idx]);
-        if (ea > option->eps_ea)
-          sentinel = false;
+        const double delta = x[idx] - old_x;
+        if (delta == 0.0)
+          continue;
+
+        // Keep the residuals of the remaining rows of the block up to date
+        for (int m = k + 1; m < size; ++m)
+          r[m] -= A[nskip*(i + m) + idx] * delta;
+
+        maxDelta = std::max(maxDelta, std::abs(delta));
+        if (std::abs(x[idx]) > option->eps_div)
+          maxRelative = std::max(maxRelative, std::abs(delta / x[idx]));
       }
     }
 
-    if (sentinel)
-      break;
+    ++iter;
+
+    converged = maxDelta <= option->eps_res && maxRelative <= option->eps_ea;
   }
-  delete[] order;
-  return sentinel;
+
+  if (statistics)
+  {
+    statistics->iterations = iter;
+    statistics->residual = maxDelta;
+    statistics->relative_change = maxRelative;
+    statistics->converged = converged;
+  }
+
+  return converged;
 }
 
-#define LCP_PGS_RANDOMLY_REORDER_CONSTRAINTS		1
 #define LCP_PGS_OPTION_DEFAULT_ITERMAX				30
 #define LCP_PGS_OPTION_DEFAULT_SOR_W				0.9
 #define LCP_PGS_OPTION_DEFAULT_EPS_EA				1E-3
 #define LCP_PGS_OPTION_DEFAULT_EPS_RESIDUAL			1E-6
 #define LCP_PGS_OPTION_DEFAULT_EPS_DIVIDE			1E-9
+#define LCP_PGS_OPTION_DEFAULT_RANDOM_ORDER			false
 
 void PGSOption::setDefault()
 {
@@ -520,6 +463,7 @@ void PGSOption::setDefault()
   eps_ea = LCP_PGS_OPTION_DEFAULT_EPS_EA;
   eps_res = LCP_PGS_OPTION_DEFAULT_EPS_RESIDUAL;
   eps_div = LCP_PGS_OPTION_DEFAULT_EPS_DIVIDE;
+  random_order = LCP_PGS_OPTION_DEFAULT_RANDOM_ORDER;
 }
 
 }  // namespace constraint
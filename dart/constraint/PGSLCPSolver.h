@@ -45,6 +45,48 @@
 namespace dart {
 namespace constraint {
 
+struct PGSOption
+{
+  /// Maximum number of sweeps over all the rows
+  int itermax;
+
+  /// Successive over-relaxation factor
+  double sor_w;
+
+  /// The iteration stops once the largest relative change of x in a sweep
+  /// falls below this value and the absolute change falls below eps_res
+  double eps_ea;
+
+  /// The iteration stops once the largest absolute change of x in a sweep
+  /// falls below this value and the relative change falls below eps_ea
+  double eps_res;
+
+  /// Rows whose diagonal element of A is below this value are not solved
+  double eps_div;
+
+  /// Shuffle the order in which the contacts are swept every eight sweeps.
+  /// Disabled by default.
+  bool random_order;
+
+  void setDefault();
+};
+
+/// Information about the last run of solvePGS()
+struct PGSStatistics
+{
+  /// Number of sweeps that were performed
+  int iterations;
+
+  /// Largest absolute change of x in the last sweep
+  double residual;
+
+  /// Largest relative change of x in the last sweep
+  double relative_change;
+
+  /// Whether both tolerances of PGSOption were met
+  bool converged;
+};
+
 /// PGSLCPSolver
 class PGSLCPSolver : public LCPSolver
 {
@@ -58,8 +100,23 @@ public:
   // Documentation inherited
   virtual void solve(ConstrainedGroup* _group);
 
-#ifndef NDEBUG
+  /// Set the iteration budget and the tolerances
+  void setOption(const PGSOption& _option);
+
+  /// Get the iteration budget and the tolerances
+  const PGSOption& getOption() const;
+
+  /// Get the statistics of the most recently solved ConstrainedGroup
+  const PGSStatistics& getLastStatistics() const;
+
 private:
+  /// Iteration budget and tolerances
+  PGSOption mOption;
+
+  /// Statistics of the last solve
+  PGSStatistics mStatistics;
+
+#ifndef NDEBUG
   /// Return true if the matrix is symmetric
   bool isSymmetric(size_t _n, double* _A);
 
@@ -72,21 +129,15 @@ private:
 #endif
 };
 
-struct PGSOption
-{
-  int itermax;
-  double sor_w;
-  double eps_ea;
-  double eps_res;
-  double eps_div;
-
-  void setDefault();
-};
-
+/// Solve the LCP with projected Gauss-Seidel. The normal row of a contact and
+/// the friction rows that refer to it through findex are swept together as
+/// one block, so the products with x are computed for the whole block at
+/// once. The rows of A and b are scaled by the diagonal of A in place.
 bool solvePGS(int n, int nskip, int /*nub*/, double* A,
                             double* x, double * b,
                             double * lo, double * hi, int * findex,
-                            PGSOption * option);
+                            PGSOption * option,
+                            PGSStatistics* statistics = nullptr);
 
 
 } // namespace constraint
@@ -279,6 +279,14 @@ dynamics::SkeletonPtr ServoMotorConstraint::getRootSkeleton() const
   return mJoint->getSkeleton()->mUnionRootSkeleton.lock();
 }
 
+//==============================================================================
+void ServoMotorConstraint::getSkeletons(dynamics::Skeleton*& _skeleton1,
+                                        dynamics::Skeleton*& _skeleton2) const
+{
+  _skeleton1 = mJoint->getSkeleton().get();
+  _skeleton2 = nullptr;
+}
+
 //==============================================================================
 bool ServoMotorConstraint::isActive() const
 {
@@ -70,11 +70,11 @@ double SoftContactConstraint::mConstraintForceMixing     = DART_CFM;
 
 //==============================================================================
 SoftContactConstraint::SoftContactConstraint(
-    collision::Contact& _contact, double _timeStep)
+    collision::ContactRecord& _contact, double _timeStep)
   : ConstraintBase(),
     mTimeStep(_timeStep),
-    mBodyNode1(_contact.bodyNode1.lock()),
-    mBodyNode2(_contact.bodyNode2.lock()),
+    mBodyNode1(_contact.bodyNode1),
+    mBodyNode2(_contact.bodyNode2),
     mSoftBodyNode1(dynamic_cast<dynamics::SoftBodyNode*>(mBodyNode1)),
     mSoftBodyNode2(dynamic_cast<dynamics::SoftBodyNode*>(mBodyNode2)),
     mPointMass1(nullptr),
@@ -104,7 +104,9 @@ SoftContactConstraint::SoftContactConstraint(
   // Select colling point mass based on trimesh ID
   if (mSoftBodyNode1)
   {
-    if (_contact.shape1->getShapeType() == dynamics::Shape::SOFT_MESH)
+    if (_contact.shapeNode1
+        && _contact.shapeNode1->getShape()->getShapeType()
+           == dynamics::Shape::SOFT_MESH)
     {
       mPointMass1 = selectCollidingPointMass(mSoftBodyNode1, _contact.point,
                                              _contact.triID1);
@@ -112,7 +114,9 @@ SoftContactConstraint::SoftContactConstraint(
   }
   if (mSoftBodyNode2)
   {
-    if (_contact.shape2->getShapeType() == dynamics::Shape::SOFT_MESH)
+    if (_contact.shapeNode2
+        && _contact.shapeNode2->getShape()->getShapeType()
+           == dynamics::Shape::SOFT_MESH)
     {
       mPointMass2 = selectCollidingPointMass(mSoftBodyNode2, _contact.point,
                                              _contact.triID2);
@@ -173,7 +177,7 @@ SoftContactConstraint::SoftContactConstraint(
 
     for (size_t i = 0; i < mContacts.size(); ++i)
     {
-      collision::Contact* ct = mContacts[i];
+      collision::ContactRecord* ct = mContacts[i];
 
       // TODO(JS): Assumed that the number of tangent basis is 2.
       Eigen::MatrixXd D = getTangentBasisMatrixODE(ct->normal);
@@ -264,7 +268,7 @@ SoftContactConstraint::SoftContactConstraint(
 
     for (size_t i = 0; i < mContacts.size(); ++i)
     {
-      collision::Contact* ct = mContacts[i];
+      collision::ContactRecord* ct = mContacts[i];
 
       bodyDirection1.noalias()
           = mBodyNode1->getTransform().linear().transpose() * ct->normal;
@@ -925,6 +929,25 @@ dynamics::SkeletonPtr SoftContactConstraint::getRootSkeleton() const
     return mBodyNode2->getSkeleton()->mUnionRootSkeleton.lock();
 }
 
+//==============================================================================
+void SoftContactConstraint::getSkeletons(dynamics::Skeleton*& _skeleton1,
+                                         dynamics::Skeleton*& _skeleton2) const
+{
+  _skeleton1 = nullptr;
+  _skeleton2 = nullptr;
+
+  if (mSoftBodyNode1 || mBodyNode1->isReactive())
+    _skeleton1 = mBodyNode1->getSkeleton().get();
+
+  if (mSoftBodyNode2 || mBodyNode2->isReactive())
+  {
+    if (_skeleton1)
+      _skeleton2 = mBodyNode2->getSkeleton().get();
+    else
+      _skeleton1 = mBodyNode2->getSkeleton().get();
+  }
+}
+
 //==============================================================================
 void SoftContactConstraint::uniteSkeletons()
 {
@@ -62,7 +62,7 @@ class SoftContactConstraint : public ConstraintBase
 {
 public:
   /// Constructor
-  SoftContactConstraint(collision::Contact& _contact, double _timeStep);
+  SoftContactConstraint(collision::ContactRecord& _contact, double _timeStep);
 
   /// Destructor
   virtual ~SoftContactConstraint();
@@ -137,6 +137,10 @@ protected:
   // Documentation inherited
   virtual dynamics::SkeletonPtr getRootSkeleton() const;
 
+  // Documentation inherited
+  virtual void getSkeletons(dynamics::Skeleton*& _skeleton1,
+                            dynamics::Skeleton*& _skeleton2) const;
+
   // Documentation inherited
   virtual void uniteSkeletons();
 
@@ -194,7 +198,7 @@ private:
 
   // TODO(JS): For now, there is only one contact per contact constraint
   /// Contacts between mBodyNode1 and mBodyNode2
-  std::vector<collision::Contact*> mContacts;
+  std::vector<collision::ContactRecord*> mContacts;
 
   /// Soft collision information
   collision::SoftCollisionInfo* mSoftCollInfo;
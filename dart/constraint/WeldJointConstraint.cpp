@@ -360,6 +360,25 @@ dynamics::SkeletonPtr WeldJointConstraint::getRootSkeleton() const
   }
 }
 
+//==============================================================================
+void WeldJointConstraint::getSkeletons(dynamics::Skeleton*& _skeleton1,
+                                       dynamics::Skeleton*& _skeleton2) const
+{
+  _skeleton1 = nullptr;
+  _skeleton2 = nullptr;
+
+  if (mBodyNode1->isReactive())
+    _skeleton1 = mBodyNode1->getSkeleton().get();
+
+  if (mBodyNode2 && mBodyNode2->isReactive())
+  {
+    if (_skeleton1)
+      _skeleton2 = mBodyNode2->getSkeleton().get();
+    else
+      _skeleton1 = mBodyNode2->getSkeleton().get();
+  }
+}
+
 //==============================================================================
 void WeldJointConstraint::uniteSkeletons()
 {
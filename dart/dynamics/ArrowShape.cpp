@@ -60,7 +60,7 @@ ArrowShape::ArrowShape(const Eigen::Vector3d& _tail,
                        const Properties& _properties,
                        const Eigen::Vector4d& _color,
                        size_t _resolution)
-  : MeshShape(Eigen::Vector3d::Ones(), nullptr),
+  : MeshShape(Eigen::Vector3d::Ones(), std::shared_ptr<const aiScene>()),
     mTail(_tail),
     mHead(_head),
     mProperties(_properties)
@@ -368,6 +368,7 @@ void ArrowShape::instantiate(size_t resolution)
     face->mIndices[2] = 2*resolution;
   }
 
+  mSharedMesh.reset(scene);
   mMesh = scene;
 
   //setColor(mColor);
@@ -0,0 +1,656 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/dynamics/BinaryMesh.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+#ifdef _WIN32
+  #include <process.h>
+#else
+  #include <unistd.h>
+#endif
+
+#include <assimp/material.h>
+
+#include "dart/common/Console.h"
+#include "dart/common/MemoryMappedResource.h"
+#include "dart/common/Uri.h"
+#include "dart/dynamics/MeshShape.h"
+
+namespace dart {
+namespace dynamics {
+
+namespace {
+
+// File layout (all sections are aligned to 8 bytes):
+//
+//   header    : FileHeader
+//   materials : MaterialRecord[numMaterials]
+//   meshes    : MeshRecord[numMeshes]
+//   data      : vertices f32[3 * numVertices], normals f32[3 * numVertices],
+//               colors f32[4 * numVertices], indices u32[3 * numFaces] of each
+//               mesh. Offsets are relative to the beginning of the file, and
+//               an offset of zero means that the array is absent.
+
+const char FILE_MAGIC[8] = {'D', 'A', 'R', 'T', 'M', 'S', 'H', '\0'};
+const uint32_t FILE_VERSION = 1u;
+
+struct FileHeader
+{
+  char mMagic[8];
+  uint32_t mVersion;
+  uint32_t mNumMeshes;
+  uint32_t mNumMaterials;
+  uint32_t mReserved;
+  uint64_t mSourceSize;
+  int64_t mSourceTime;
+};
+
+struct MaterialRecord
+{
+  float mDiffuse[4];
+  float mAmbient[4];
+  float mSpecular[4];
+  float mEmissive[4];
+  float mShininess;
+  float mShininessStrength;
+  float mReserved[2];
+};
+
+struct MeshRecord
+{
+  uint32_t mMaterialIndex;
+  uint32_t mNumVertices;
+  uint32_t mNumFaces;
+  uint32_t mReserved;
+  uint64_t mVertices;
+  uint64_t mNormals;
+  uint64_t mColors;
+  uint64_t mIndices;
+};
+
+static_assert(sizeof(aiVector3D) == 3 * sizeof(float),
+              "The binary mesh format requires single precision aiVector3D");
+static_assert(sizeof(aiColor4D) == 4 * sizeof(float),
+              "The binary mesh format requires single precision aiColor4D");
+static_assert(sizeof(FileHeader) % 8 == 0, "Unexpected padding");
+static_assert(sizeof(MaterialRecord) % 8 == 0, "Unexpected padding");
+static_assert(sizeof(MeshRecord) % 8 == 0, "Unexpected padding");
+
+std::atomic<bool> gAutoBake(false);
+
+//==============================================================================
+template <typename T>
+void append(std::vector<uint8_t>& _buffer, const T& _value)
+{
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&_value);
+  _buffer.insert(_buffer.end(), bytes, bytes + sizeof(T));
+}
+
+//==============================================================================
+uint64_t appendArray(std::vector<uint8_t>& _buffer, const void* _data,
+                     size_t _size)
+{
+  _buffer.resize(_buffer.size() + (8u - _buffer.size() % 8u) % 8u, 0u);
+
+  const uint64_t offset = _buffer.size();
+  const uint8_t* bytes = static_cast<const uint8_t*>(_data);
+  _buffer.insert(_buffer.end(), bytes, bytes + _size);
+
+  return offset;
+}
+
+//==============================================================================
+bool getFileStamp(const std::string& _path, uint64_t& _size, int64_t& _time)
+{
+  struct stat info;
+  if(stat(_path.c_str(), &info) != 0)
+    return false;
+
+  _size = static_cast<uint64_t>(info.st_size);
+  _time = static_cast<int64_t>(info.st_mtime);
+  return true;
+}
+
+//==============================================================================
+/// A name next to _fileName that no other process, thread or call uses
+std::string getTempFileName(const std::string& _fileName)
+{
+  static std::atomic<unsigned int> counter(0u);
+
+#ifdef _WIN32
+  const int pid = _getpid();
+#else
+  const int pid = static_cast<int>(getpid());
+#endif
+
+  std::ostringstream name;
+  name << _fileName << "." << pid << "."
+       << std::hash<std::thread::id>()(std::this_thread::get_id()) << "."
+       << counter++ << ".tmp";
+  return name.str();
+}
+
+//==============================================================================
+void getMaterialColor(const aiMaterial* _material, const char* _key,
+                      unsigned int _type, unsigned int _index, float* _color)
+{
+  aiColor4D color(0.0f, 0.0f, 0.0f, 1.0f);
+  aiGetMaterialColor(_material, _key, _type, _index, &color);
+  _color[0] = color.r;
+  _color[1] = color.g;
+  _color[2] = color.b;
+  _color[3] = color.a;
+}
+
+//==============================================================================
+float getMaterialFloat(const aiMaterial* _material, const char* _key,
+                       unsigned int _type, unsigned int _index,
+                       float _default)
+{
+  float value = _default;
+  unsigned int max = 1;
+  aiGetMaterialFloatArray(_material, _key, _type, _index, &value, &max);
+  return value;
+}
+
+//==============================================================================
+void addMaterialColor(aiMaterial* _material, const float* _color,
+                      const char* _key, unsigned int _type, unsigned int _index)
+{
+  const aiColor4D color(_color[0], _color[1], _color[2], _color[3]);
+  _material->AddProperty(&color, 1, _key, _type, _index);
+}
+
+//==============================================================================
+/// Releases an aiScene whose vertices, normals and indices point into the
+/// memory that is kept alive by mStorage
+struct BorrowedSceneDeleter
+{
+  std::shared_ptr<const void> mStorage;
+
+  void operator()(const aiScene* _scene) const
+  {
+    for(size_t i=0; _scene->mMeshes && i < _scene->mNumMeshes; ++i)
+    {
+      aiMesh* mesh = _scene->mMeshes[i];
+      if(!mesh)
+        continue;
+
+      mesh->mVertices = nullptr;
+      mesh->mNormals = nullptr;
+      for(size_t j=0; j < mesh->mNumFaces; ++j)
+        mesh->mFaces[j].mIndices = nullptr;
+    }
+
+    delete _scene;
+  }
+};
+
+//==============================================================================
+bool isValidArray(uint64_t _offset, uint64_t _size, uint64_t _fileSize)
+{
+  return _offset % 4u == 0u && _offset <= _fileSize
+      && _size <= _fileSize - _offset;
+}
+
+//==============================================================================
+std::shared_ptr<const aiScene> readScene(
+    const std::shared_ptr<const void>& _storage, size_t _size,
+    const uint64_t* _sourceSize, const int64_t* _sourceTime)
+{
+  const uint8_t* data = static_cast<const uint8_t*>(_storage.get());
+
+  if(_size < sizeof(FileHeader))
+    return nullptr;
+
+  FileHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  if(std::memcmp(header.mMagic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+  {
+    dtwarn << "[BinaryMesh::read] The resource is not a binary mesh.\n";
+    return nullptr;
+  }
+
+  if(header.mVersion != FILE_VERSION)
+  {
+    dtwarn << "[BinaryMesh::read] Unsupported version ["
+           << header.mVersion << "].\n";
+    return nullptr;
+  }
+
+  // Stale auto-baked files are silently rejected
+  if(_sourceSize && (header.mSourceSize != *_sourceSize
+                     || header.mSourceTime != *_sourceTime))
+    return nullptr;
+
+  const uint64_t recordsSize
+      = static_cast<uint64_t>(header.mNumMaterials) * sizeof(MaterialRecord)
+      + static_cast<uint64_t>(header.mNumMeshes) * sizeof(MeshRecord);
+  if(recordsSize > _size - sizeof(FileHeader))
+  {
+    dtwarn << "[BinaryMesh::read] The binary mesh is truncated.\n";
+    return nullptr;
+  }
+
+  const MaterialRecord* materials = reinterpret_cast<const MaterialRecord*>(
+        data + sizeof(FileHeader));
+  const MeshRecord* meshes = reinterpret_cast<const MeshRecord*>(
+        materials + header.mNumMaterials);
+
+  // Validate everything before anything is allocated
+  for(size_t i=0; i < header.mNumMeshes; ++i)
+  {
+    const MeshRecord& record = meshes[i];
+    const uint64_t vectorsSize = 3u * sizeof(float) * record.mNumVertices;
+    const uint64_t colorsSize = 4u * sizeof(float) * record.mNumVertices;
+    const uint64_t indicesSize = 3u * sizeof(uint32_t) * record.mNumFaces;
+
+    bool valid = record.mMaterialIndex < std::max(header.mNumMaterials, 1u)
+        && isValidArray(record.mVertices, vectorsSize, _size)
+        && isValidArray(record.mIndices, indicesSize, _size)
+        && (!record.mNormals
+            || isValidArray(record.mNormals, vectorsSize, _size))
+        && (!record.mColors
+            || isValidArray(record.mColors, colorsSize, _size));
+
+    if(valid)
+    {
+      const uint32_t* indices
+          = reinterpret_cast<const uint32_t*>(data + record.mIndices);
+      for(size_t j=0; j < 3u * record.mNumFaces; ++j)
+        valid = valid && indices[j] < record.mNumVertices;
+    }
+
+    if(!valid)
+    {
+      dtwarn << "[BinaryMesh::read] Mesh [" << i << "] of the binary mesh is "
+             << "corrupt.\n";
+      return nullptr;
+    }
+  }
+
+  aiScene* scene = new aiScene;
+  std::shared_ptr<const aiScene> result(scene, BorrowedSceneDeleter{_storage});
+
+  // The scene has been pre-transformed, so all the meshes belong to the root
+  scene->mRootNode = new aiNode;
+  scene->mRootNode->mNumMeshes = header.mNumMeshes;
+  scene->mRootNode->mMeshes = new unsigned int[header.mNumMeshes];
+  for(size_t i=0; i < header.mNumMeshes; ++i)
+    scene->mRootNode->mMeshes[i] = static_cast<unsigned int>(i);
+
+  // Assimp always provides at least one material
+  scene->mNumMaterials = std::max(header.mNumMaterials, 1u);
+  scene->mMaterials = new aiMaterial*[scene->mNumMaterials];
+  for(size_t i=0; i < scene->mNumMaterials; ++i)
+  {
+    aiMaterial* material = new aiMaterial;
+    scene->mMaterials[i] = material;
+    if(i >= header.mNumMaterials)
+      continue;
+
+    const MaterialRecord& record = materials[i];
+    addMaterialColor(material, record.mDiffuse, AI_MATKEY_COLOR_DIFFUSE);
+    addMaterialColor(material, record.mAmbient, AI_MATKEY_COLOR_AMBIENT);
+    addMaterialColor(material, record.mSpecular, AI_MATKEY_COLOR_SPECULAR);
+    addMaterialColor(material, record.mEmissive, AI_MATKEY_COLOR_EMISSIVE);
+    material->AddProperty(&record.mShininess, 1, AI_MATKEY_SHININESS);
+    material->AddProperty(&record.mShininessStrength, 1,
+                          AI_MATKEY_SHININESS_STRENGTH);
+  }
+
+  scene->mMeshes = new aiMesh*[header.mNumMeshes];
+  std::fill(scene->mMeshes, scene->mMeshes + header.mNumMeshes, nullptr);
+  scene->mNumMeshes = header.mNumMeshes;
+  for(size_t i=0; i < header.mNumMeshes; ++i)
+  {
+    const MeshRecord& record = meshes[i];
+    aiMesh* mesh = new aiMesh;
+    scene->mMeshes[i] = mesh;
+
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mMaterialIndex = record.mMaterialIndex;
+
+    // The file is never written through these pointers: MeshShapes only
+    // modify the colors, which are copied below
+    mesh->mNumVertices = record.mNumVertices;
+    mesh->mVertices = reinterpret_cast<aiVector3D*>(
+          const_cast<uint8_t*>(data + record.mVertices));
+    if(record.mNormals)
+    {
+      mesh->mNormals = reinterpret_cast<aiVector3D*>(
+            const_cast<uint8_t*>(data + record.mNormals));
+    }
+
+    if(record.mColors)
+    {
+      const float* colors
+          = reinterpret_cast<const float*>(data + record.mColors);
+      mesh->mColors[0] = new aiColor4D[record.mNumVertices];
+      for(size_t j=0; j < record.mNumVertices; ++j)
+      {
+        mesh->mColors[0][j] = aiColor4D(colors[4*j], colors[4*j+1],
+                                        colors[4*j+2], colors[4*j+3]);
+      }
+    }
+
+    uint32_t* indices = reinterpret_cast<uint32_t*>(
+          const_cast<uint8_t*>(data + record.mIndices));
+    mesh->mNumFaces = record.mNumFaces;
+    mesh->mFaces = new aiFace[record.mNumFaces];
+    for(size_t j=0; j < record.mNumFaces; ++j)
+    {
+      mesh->mFaces[j].mNumIndices = 3u;
+      mesh->mFaces[j].mIndices = indices + 3u * j;
+    }
+  }
+
+  return result;
+}
+
+//==============================================================================
+std::shared_ptr<const aiScene> readResource(
+    const common::ResourcePtr& _resource, const uint64_t* _sourceSize,
+    const int64_t* _sourceTime)
+{
+  if(!_resource)
+    return nullptr;
+
+  const size_t size = _resource->getSize();
+
+  // Memory-mapped resources are used in place. The storage shares ownership
+  // of the resource so that the mapping outlives the scene.
+  if(const void* data = _resource->getData())
+  {
+    return readScene(std::shared_ptr<const void>(_resource, data), size,
+                     _sourceSize, _sourceTime);
+  }
+
+  std::shared_ptr<uint8_t> buffer(new uint8_t[std::max<size_t>(size, 1u)],
+                                  std::default_delete<uint8_t[]>());
+  if(!_resource->seek(0, common::Resource::SEEKTYPE_SET)
+     || _resource->read(buffer.get(), 1, size) != size)
+  {
+    dtwarn << "[BinaryMesh::read] Failed reading the resource.\n";
+    return nullptr;
+  }
+
+  return readScene(buffer, size, _sourceSize, _sourceTime);
+}
+
+//==============================================================================
+bool writeFile(const aiScene* _scene, const std::string& _fileName,
+               const std::string& _sourcePath, bool _warn)
+{
+  FileHeader header;
+  std::memcpy(header.mMagic, FILE_MAGIC, sizeof(FILE_MAGIC));
+  header.mVersion = FILE_VERSION;
+  header.mNumMeshes = _scene->mNumMeshes;
+  header.mNumMaterials = _scene->mNumMaterials;
+  header.mReserved = 0u;
+  header.mSourceSize = 0u;
+  header.mSourceTime = 0;
+  if(!_sourcePath.empty()
+     && !getFileStamp(_sourcePath, header.mSourceSize, header.mSourceTime))
+  {
+    if(_warn)
+    {
+      dtwarn << "[BinaryMesh::write] Failed reading the status of the source "
+             << "file [" << _sourcePath << "].\n";
+    }
+    return false;
+  }
+
+  std::vector<uint8_t> buffer;
+  append(buffer, header);
+
+  for(size_t i=0; i < _scene->mNumMaterials; ++i)
+  {
+    const aiMaterial* material = _scene->mMaterials[i];
+    MaterialRecord record;
+    getMaterialColor(material, AI_MATKEY_COLOR_DIFFUSE, record.mDiffuse);
+    getMaterialColor(material, AI_MATKEY_COLOR_AMBIENT, record.mAmbient);
+    getMaterialColor(material, AI_MATKEY_COLOR_SPECULAR, record.mSpecular);
+    getMaterialColor(material, AI_MATKEY_COLOR_EMISSIVE, record.mEmissive);
+    record.mShininess = getMaterialFloat(
+          material, AI_MATKEY_SHININESS, 0.0f);
+    record.mShininessStrength = getMaterialFloat(
+          material, AI_MATKEY_SHININESS_STRENGTH, 1.0f);
+    record.mReserved[0] = record.mReserved[1] = 0.0f;
+    append(buffer, record);
+  }
+
+  // The records are filled in once the offsets of the arrays are known
+  const size_t recordsOffset = buffer.size();
+  buffer.resize(buffer.size() + _scene->mNumMeshes * sizeof(MeshRecord), 0u);
+
+  std::vector<uint32_t> indices;
+  for(size_t i=0; i < _scene->mNumMeshes; ++i)
+  {
+    const aiMesh* mesh = _scene->mMeshes[i];
+
+    indices.clear();
+    indices.reserve(3u * mesh->mNumFaces);
+    for(size_t j=0; j < mesh->mNumFaces; ++j)
+    {
+      const aiFace& face = mesh->mFaces[j];
+
+      // Points and lines are removed by MeshShape::loadMesh()
+      if(face.mNumIndices != 3u)
+      {
+        if(_warn)
+        {
+          dtwarn << "[BinaryMesh::write] Mesh [" << i << "] contains a face "
+                 << "that is not a triangle. Only triangle meshes can be "
+                 << "written.\n";
+        }
+        return false;
+      }
+
+      indices.insert(indices.end(), face.mIndices, face.mIndices + 3);
+    }
+
+    MeshRecord record;
+    record.mMaterialIndex = mesh->mMaterialIndex;
+    record.mNumVertices = mesh->mNumVertices;
+    record.mNumFaces = static_cast<uint32_t>(indices.size() / 3u);
+    record.mReserved = 0u;
+    record.mVertices = appendArray(
+          buffer, mesh->mVertices, sizeof(aiVector3D) * mesh->mNumVertices);
+    record.mNormals = mesh->mNormals? appendArray(
+          buffer, mesh->mNormals, sizeof(aiVector3D) * mesh->mNumVertices)
+        : 0u;
+    record.mColors = mesh->mColors[0]? appendArray(
+          buffer, mesh->mColors[0], sizeof(aiColor4D) * mesh->mNumVertices)
+        : 0u;
+    record.mIndices = appendArray(
+          buffer, indices.data(), sizeof(uint32_t) * indices.size());
+
+    std::memcpy(buffer.data() + recordsOffset + i * sizeof(MeshRecord),
+                &record, sizeof(record));
+  }
+
+  // Write to a temporary file first so that concurrent readers never see a
+  // partially written file. Concurrent writers use different temporary files.
+  const std::string tempFileName = getTempFileName(_fileName);
+  {
+    std::ofstream file(tempFileName, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(buffer.data()),
+               static_cast<std::streamsize>(buffer.size()));
+    if(!file.good())
+    {
+      if(_warn)
+      {
+        dtwarn << "[BinaryMesh::write] Failed writing file [" << _fileName
+               << "].\n";
+      }
+      file.close();
+      std::remove(tempFileName.c_str());
+      return false;
+    }
+  }
+
+  std::remove(_fileName.c_str());
+  if(std::rename(tempFileName.c_str(), _fileName.c_str()) != 0)
+  {
+    if(_warn)
+    {
+      dtwarn << "[BinaryMesh::write] Failed renaming [" << tempFileName
+             << "] to [" << _fileName << "].\n";
+    }
+    std::remove(tempFileName.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+const std::string BinaryMesh::Extension = ".dartmesh";
+
+//==============================================================================
+bool BinaryMesh::isBinaryMeshUri(const std::string& _uri)
+{
+  return _uri.size() >= Extension.size()
+      && std::equal(Extension.rbegin(), Extension.rend(), _uri.rbegin(),
+                    [](char _a, char _b) { return _a == ::tolower(_b); });
+}
+
+//==============================================================================
+std::string BinaryMesh::getBakedFileName(const std::string& _path)
+{
+  return _path + Extension;
+}
+
+//==============================================================================
+bool BinaryMesh::write(const aiScene* _scene, const std::string& _fileName,
+                       const std::string& _sourcePath)
+{
+  if(!_scene)
+  {
+    dtwarn << "[BinaryMesh::write] Attempting to write a nullptr scene.\n";
+    return false;
+  }
+
+  return writeFile(_scene, _fileName, _sourcePath, true);
+}
+
+//==============================================================================
+std::shared_ptr<const aiScene> BinaryMesh::read(
+    const common::ResourcePtr& _resource)
+{
+  return readResource(_resource, nullptr, nullptr);
+}
+
+//==============================================================================
+std::shared_ptr<const aiScene> BinaryMesh::load(
+    const std::string& _uri, const common::ResourceRetrieverPtr& _retriever)
+{
+  if(isBinaryMeshUri(_uri))
+  {
+    const common::ResourcePtr resource = _retriever->retrieve(_uri);
+    if(!resource)
+    {
+      dtwarn << "[BinaryMesh::load] Failed retrieving [" << _uri << "].\n";
+      return nullptr;
+    }
+
+    return read(resource);
+  }
+
+  // Only local files can be baked, because the baked file is written next to
+  // the source file
+  common::Uri uri;
+  uint64_t sourceSize = 0u;
+  int64_t sourceTime = 0;
+  const bool bake = isAutoBakeEnabled() && uri.fromString(_uri)
+      && uri.mScheme.get_value_or("file") == "file" && uri.mPath
+      && getFileStamp(uri.mPath.get(), sourceSize, sourceTime);
+
+  std::string bakedFileName;
+  if(bake)
+  {
+    bakedFileName = getBakedFileName(uri.mPath.get());
+
+    uint64_t bakedSize;
+    int64_t bakedTime;
+    if(getFileStamp(bakedFileName, bakedSize, bakedTime))
+    {
+      const std::shared_ptr<const aiScene> scene = readResource(
+            std::make_shared<common::MemoryMappedResource>(bakedFileName),
+            &sourceSize, &sourceTime);
+      if(scene)
+        return scene;
+    }
+  }
+
+  const std::shared_ptr<const aiScene> scene(
+        MeshShape::loadMesh(_uri, _retriever));
+
+  // Failing to bake is not an error, e.g. the directory may be read-only
+  if(scene && bake)
+    writeFile(scene.get(), bakedFileName, uri.mPath.get(), false);
+
+  return scene;
+}
+
+//==============================================================================
+void BinaryMesh::setAutoBakeEnabled(bool _enabled)
+{
+  gAutoBake = _enabled;
+}
+
+//==============================================================================
+bool BinaryMesh::isAutoBakeEnabled()
+{
+  return gAutoBake;
+}
+
+}  // namespace dynamics
+}  // namespace dart
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_DYNAMICS_BINARYMESH_H_
+#define DART_DYNAMICS_BINARYMESH_H_
+
+#include <memory>
+#include <string>
+
+#include <assimp/scene.h>
+
+#include "dart/common/Resource.h"
+#include "dart/common/ResourceRetriever.h"
+
+namespace dart {
+namespace dynamics {
+
+/// BinaryMesh reads and writes meshes in DART's pre-baked binary mesh format
+/// (.dartmesh). The file stores the triangulated, pre-transformed output of
+/// MeshShape::loadMesh(): the vertices, normals and vertex colors of each
+/// submesh, its triangles, and the colors of the materials. Loading a
+/// .dartmesh file does not involve Assimp's importers or post-processing.
+///
+/// The arrays in the file are laid out so that the vertices, normals and
+/// triangle indices of the aiScene point directly into the loaded file instead
+/// of being copied out of it. Memory-mapped files are not copied at all. The
+/// vertex colors are copied, because MeshShape::notifyAlphaUpdate() writes
+/// into them.
+///
+/// When auto-baking is enabled, load() writes a .dartmesh file next to every
+/// local mesh file that it imports, and uses it on subsequent loads as long as
+/// the size and modification time of the source file have not changed.
+class BinaryMesh
+{
+public:
+  /// File extension of the binary mesh format
+  static const std::string Extension;
+
+  /// Returns true if _uri refers to a binary mesh file
+  static bool isBinaryMeshUri(const std::string& _uri);
+
+  /// Get the name of the file that caches the baked version of _path
+  static std::string getBakedFileName(const std::string& _path);
+
+  /// Write _scene to _fileName. If _sourcePath is given, the size and
+  /// modification time of that file are recorded so that stale auto-baked
+  /// files can be detected.
+  static bool write(const aiScene* _scene, const std::string& _fileName,
+                    const std::string& _sourcePath = "");
+
+  /// Read a binary mesh from _resource. Returns a nullptr on failure. If the
+  /// resource provides Resource::getData(), e.g. a memory-mapped file, the
+  /// scene refers to that memory and keeps _resource alive; otherwise the
+  /// resource is read into a buffer first.
+  static std::shared_ptr<const aiScene> read(
+      const common::ResourcePtr& _resource);
+
+  /// Load the mesh at _uri. Binary mesh files are read directly, and any other
+  /// file is imported with MeshShape::loadMesh() or taken from its auto-baked
+  /// file.
+  static std::shared_ptr<const aiScene> load(
+      const std::string& _uri, const common::ResourceRetrieverPtr& _retriever);
+
+  /// Set whether load() should write and use .dartmesh files next to local
+  /// mesh files. This is disabled by default.
+  static void setAutoBakeEnabled(bool _enabled);
+
+  /// Get whether load() writes and uses .dartmesh files
+  static bool isAutoBakeEnabled();
+};
+
+}  // namespace dynamics
+}  // namespace dart
+
+#endif  // DART_DYNAMICS_BINARYMESH_H_
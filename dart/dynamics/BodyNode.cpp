@@ -120,12 +120,13 @@ namespace detail {
 BodyNodeUniqueProperties::BodyNodeUniqueProperties(
     const Inertia& _inertia,
     bool _isCollidable, double _frictionCoeff,
-    double _restitutionCoeff, bool _gravityMode)
+    double _restitutionCoeff, bool _gravityMode, bool _continuousCollision)
   : mInertia(_inertia),
     mIsCollidable(_isCollidable),
     mFrictionCoeff(_frictionCoeff),
     mRestitutionCoeff(_restitutionCoeff),
-    mGravityMode(_gravityMode)
+    mGravityMode(_gravityMode),
+    mContinuousCollision(_continuousCollision)
 {
   // Do nothing
 }
@@ -250,6 +251,7 @@ void BodyNode::setProperties(const UniqueProperties& _properties)
   setGravityMode(_properties.mGravityMode);
   setFrictionCoeff(_properties.mFrictionCoeff);
   setRestitutionCoeff(_properties.mRestitutionCoeff);
+  setContinuousCollision(_properties.mContinuousCollision);
 
   mBodyP.mMarkerProperties = _properties.mMarkerProperties;
   // Remove current markers
@@ -424,6 +426,18 @@ void BodyNode::setCollidable(bool _isCollidable)
   mBodyP.mIsCollidable = _isCollidable;
 }
 
+//==============================================================================
+bool BodyNode::isContinuousCollision() const
+{
+  return mBodyP.mContinuousCollision;
+}
+
+//==============================================================================
+void BodyNode::setContinuousCollision(bool _continuous)
+{
+  mBodyP.mContinuousCollision = _continuous;
+}
+
 //==============================================================================
 void BodyNode::setMass(double _mass)
 {
@@ -1325,6 +1339,11 @@ void BodyNode::init(const SkeletonPtr& _skeleton)
 //==============================================================================
 void BodyNode::processNewEntity(Entity* _newChildEntity)
 {
+  // Renderers rely on the version of the Skeleton to notice that its tree of
+  // Frames has changed
+  if(const SkeletonPtr& skel = getSkeleton())
+    skel->incrementVersion();
+
   // If the Entity is a JacobianNode, add it to the list of JacobianNodes
   if(JacobianNode* node = dynamic_cast<JacobianNode*>(_newChildEntity))
     mChildJacobianNodes.insert(node);
@@ -1354,6 +1373,9 @@ void BodyNode::processNewEntity(Entity* _newChildEntity)
 //==============================================================================
 void BodyNode::processRemovedEntity(Entity* _oldChildEntity)
 {
+  if(const SkeletonPtr& skel = getSkeleton())
+    skel->incrementVersion();
+
   std::vector<BodyNode*>::iterator it = find(mChildBodyNodes.begin(),
                                              mChildBodyNodes.end(),
                                              _oldChildEntity);
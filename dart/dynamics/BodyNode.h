@@ -168,6 +168,18 @@ public:
   /// \param[in] _isCollidable True to enable collisions
   void setCollidable(bool _isCollidable);
 
+  /// Return true if the collisions of this body are detected continuously
+  bool isContinuousCollision() const;
+
+  /// Set whether the collisions of this body are detected continuously. The
+  /// collision detector then sweeps the body along its current velocity over
+  /// the next time step and reports time-of-impact contacts with the bodies it
+  /// would hit, so a fast body cannot pass through thin ones between two
+  /// steps. This costs a number of extra collision checks per step that grows
+  /// with the speed of the body.
+  /// \param[in] _continuous True to enable continuous collision detection
+  void setContinuousCollision(bool _continuous);
+
   /// Set the mass of the bodynode
   void setMass(double _mass);
 
@@ -60,6 +60,7 @@ void CylinderShape::setRadius(double _radius) {
   mRadius = _radius;
   _updateBoundingBoxDim();
   updateVolume();
+  incrementVersion();
 }
 
 double CylinderShape::getHeight() const {
@@ -71,6 +72,7 @@ void CylinderShape::setHeight(double _height) {
   mHeight = _height;
   _updateBoundingBoxDim();
   updateVolume();
+  incrementVersion();
 }
 
 //==============================================================================
@@ -58,6 +58,7 @@ void EllipsoidShape::setSize(const Eigen::Vector3d& _size) {
   mBoundingBox.setMin(-_size * 0.5);
   mBoundingBox.setMax(_size * 0.5);
   updateVolume();
+  incrementVersion();
 }
 
 const Eigen::Vector3d&EllipsoidShape::getSize() const {
@@ -89,10 +89,12 @@ void LineSegmentShape::setThickness(float _thickness)
     dtwarn << "[LineSegmentShape::setThickness] Attempting to set non-positive "
            << "thickness. We set the thickness to 1.0f instead." << std::endl;
     mThickness = 1.0f;
+    incrementVersion();
     return;
   }
 
   mThickness = _thickness;
+  incrementVersion();
 }
 
 //==============================================================================
@@ -109,6 +111,7 @@ size_t LineSegmentShape::addVertex(const Eigen::Vector3d& _v)
     return addVertex(_v, parent-1);
 
   mVertices.push_back(_v);
+  incrementVersion();
   return 0;
 }
 
@@ -137,6 +140,7 @@ size_t LineSegmentShape::addVertex(const Eigen::Vector3d& _v, size_t _parent)
     mConnections.push_back(Eigen::Vector2i(_parent, index));
   }
 
+  incrementVersion();
   return index;
 }
 
@@ -160,6 +164,7 @@ void LineSegmentShape::removeVertex(size_t _idx)
   }
 
   mVertices.erase(mVertices.begin()+_idx);
+  incrementVersion();
 }
 
 //==============================================================================
@@ -180,6 +185,7 @@ void LineSegmentShape::setVertex(size_t _idx, const Eigen::Vector3d& _v)
     return;
   }
   mVertices[_idx] = _v;
+  incrementVersion();
 }
 
 //==============================================================================
@@ -225,6 +231,7 @@ void LineSegmentShape::addConnection(size_t _idx1, size_t _idx2)
   }
 
   mConnections.push_back(Eigen::Vector2i(_idx1, _idx2));
+  incrementVersion();
 }
 
 //==============================================================================
@@ -245,6 +252,8 @@ void LineSegmentShape::removeConnection(size_t _vertexIdx1, size_t _vertexIdx2)
     else
       ++it;
   }
+
+  incrementVersion();
 }
 
 //==============================================================================
@@ -267,6 +276,7 @@ void LineSegmentShape::removeConnection(size_t _connectionIdx)
   }
 
   mConnections.erase(mConnections.begin()+_connectionIdx);
+  incrementVersion();
 }
 
 //==============================================================================
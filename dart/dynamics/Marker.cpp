@@ -196,6 +196,12 @@ Marker::ConstraintType Marker::getConstraintType() const
   return mProperties.mType;
 }
 
+//==============================================================================
+const Marker::Properties& Marker::getMarkerProperties() const
+{
+  return mProperties;
+}
+
 //==============================================================================
 Marker::Marker(const Properties& properties, BodyNode* parent)
   : mProperties(properties),
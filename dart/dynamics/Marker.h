@@ -137,6 +137,9 @@ public:
   /// Get constraint type. which will be useful for inverse kinematics
   ConstraintType getConstraintType() const;
 
+  /// Get the Properties of this marker
+  const Properties& getMarkerProperties() const;
+
   friend class Skeleton;
   friend class BodyNode;
 
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/dynamics/MeshCache.h"
+
+#include "dart/common/Uri.h"
+#include "dart/dynamics/BinaryMesh.h"
+
+namespace dart {
+namespace dynamics {
+
+//==============================================================================
+MeshCache::MeshCache()
+  : mNumHits(0u),
+    mNumMisses(0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+MeshCache& MeshCache::getDefault()
+{
+  static MeshCache cache;
+  return cache;
+}
+
+//==============================================================================
+std::shared_ptr<const aiScene> MeshCache::getMesh(
+    const std::string& _uri, const common::ResourceRetrieverPtr& _retriever)
+{
+  const Key key = makeKey(_uri, _retriever);
+
+  std::unique_lock<std::mutex> lock(mMutex);
+
+  const auto it = mMeshes.find(key);
+  if(it != mMeshes.end() && isAlive(it->first, it->second))
+  {
+    ScenePtr scene = it->second.mScene.lock();
+    if(scene)
+    {
+      ++mNumHits;
+      return scene;
+    }
+  }
+
+  const auto pending = mPending.find(key);
+  if(pending != mPending.end())
+  {
+    // Another thread is already importing this mesh, so wait for it
+    const std::shared_future<ScenePtr> future = pending->second;
+    ++mNumHits;
+    lock.unlock();
+    return future.get();
+  }
+
+  ++mNumMisses;
+  std::promise<ScenePtr> promise;
+  mPending[key] = promise.get_future().share();
+  lock.unlock();
+
+  // Import without holding the lock so that other meshes can be loaded
+  // concurrently
+  ScenePtr scene;
+  try
+  {
+    scene = BinaryMesh::load(_uri, _retriever);
+  }
+  catch(...)
+  {
+    // Pass the exception on to the threads that are waiting for this import
+    // and let the next request try again
+    lock.lock();
+    mPending.erase(key);
+    lock.unlock();
+
+    promise.set_exception(std::current_exception());
+    throw;
+  }
+
+  lock.lock();
+  mPending.erase(key);
+  if(scene)
+  {
+    removeExpired();
+    Entry& entry = mMeshes[key];
+    entry.mRetriever = _retriever;
+    entry.mScene = scene;
+  }
+  lock.unlock();
+
+  promise.set_value(scene);
+
+  return scene;
+}
+
+//==============================================================================
+void MeshCache::invalidate(const std::string& _uri)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  for(auto it = mMeshes.begin(); it != mMeshes.end(); )
+  {
+    if(it->first.second == _uri)
+      it = mMeshes.erase(it);
+    else
+      ++it;
+  }
+}
+
+//==============================================================================
+void MeshCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mMeshes.clear();
+  mNumHits = 0u;
+  mNumMisses = 0u;
+}
+
+//==============================================================================
+size_t MeshCache::getNumMeshes() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  size_t count = 0u;
+  for(const auto& entry : mMeshes)
+  {
+    if(isAlive(entry.first, entry.second))
+      ++count;
+  }
+
+  return count;
+}
+
+//==============================================================================
+size_t MeshCache::getNumHits() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mNumHits;
+}
+
+//==============================================================================
+size_t MeshCache::getNumMisses() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mNumMisses;
+}
+
+//==============================================================================
+MeshCache::Key MeshCache::makeKey(
+    const std::string& _uri, const common::ResourceRetrieverPtr& _retriever)
+{
+  common::Uri uri;
+  const bool isFile = uri.fromString(_uri) && uri.mScheme
+      && uri.mScheme.get() == "file";
+
+  return Key(isFile ? nullptr : _retriever.get(), _uri);
+}
+
+//==============================================================================
+bool MeshCache::isAlive(const Key& _key, const Entry& _entry)
+{
+  if(_entry.mScene.expired())
+    return false;
+
+  return !_key.first || !_entry.mRetriever.expired();
+}
+
+//==============================================================================
+void MeshCache::removeExpired()
+{
+  for(auto it = mMeshes.begin(); it != mMeshes.end(); )
+  {
+    if(!isAlive(it->first, it->second))
+      it = mMeshes.erase(it);
+    else
+      ++it;
+  }
+}
+
+}  // namespace dynamics
+}  // namespace dart
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_DYNAMICS_MESHCACHE_H_
+#define DART_DYNAMICS_MESHCACHE_H_
+
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <assimp/scene.h>
+
+#include "dart/common/ResourceRetriever.h"
+
+namespace dart {
+namespace dynamics {
+
+/// MeshCache shares imported meshes between all the MeshShapes that refer to
+/// the same URI, so that a world containing many copies of a robot imports
+/// each of its meshes only once.
+///
+/// The cache only holds weak references: a mesh is released as soon as the
+/// last MeshShape that uses it is destroyed, and it is imported again the next
+/// time it is requested. The scale of a MeshShape is applied on top of the
+/// unscaled mesh, so meshes are shared regardless of their scale.
+///
+/// A file:// URI is a location on its own, so its mesh is shared by all the
+/// ResourceRetrievers. Any other URI (e.g. package://) is resolved by the
+/// retriever, so its mesh is only shared between the requests that pass the
+/// same retriever. Call invalidate() or clear() when a file changes on disk.
+/// All the functions may be called from multiple threads. Concurrent requests
+/// for the same mesh wait for a single import instead of importing the file
+/// more than once.
+class MeshCache
+{
+public:
+  /// Constructor
+  MeshCache();
+
+  /// Get the process-wide cache that is used by the file parsers
+  static MeshCache& getDefault();
+
+  /// Get the mesh at _uri, loading it with BinaryMesh::load() if it is not
+  /// already in use. Returns a nullptr if the mesh could not be imported.
+  /// Failures are not cached. An exception thrown while importing is rethrown
+  /// to the caller as well as to all the requests that waited for the import.
+  std::shared_ptr<const aiScene> getMesh(
+      const std::string& _uri, const common::ResourceRetrieverPtr& _retriever);
+
+  /// Forget the meshes at _uri for all the retrievers. MeshShapes that
+  /// already use them keep their copy.
+  void invalidate(const std::string& _uri);
+
+  /// Forget all meshes and reset the statistics
+  void clear();
+
+  /// Number of meshes that are currently alive in the cache
+  size_t getNumMeshes() const;
+
+  /// Number of requests that were served without importing a file
+  size_t getNumHits() const;
+
+  /// Number of requests that imported a file
+  size_t getNumMisses() const;
+
+protected:
+  typedef std::shared_ptr<const aiScene> ScenePtr;
+
+  /// Retriever that resolves the URI, or nullptr for a file:// URI, and the
+  /// URI itself
+  typedef std::pair<const common::ResourceRetriever*, std::string> Key;
+
+  struct Entry
+  {
+    /// Retriever of the key. A retriever that is created at the address of an
+    /// expired one must not find its meshes.
+    std::weak_ptr<common::ResourceRetriever> mRetriever;
+
+    /// Imported mesh
+    std::weak_ptr<const aiScene> mScene;
+  };
+
+  /// Get the key of the mesh at _uri
+  static Key makeKey(const std::string& _uri,
+                     const common::ResourceRetrieverPtr& _retriever);
+
+  /// Return true if the mesh of _entry may still be handed out
+  static bool isAlive(const Key& _key, const Entry& _entry);
+
+  /// Remove the entries whose meshes or retrievers have been released
+  void removeExpired();
+
+  /// Protects all the data below
+  mutable std::mutex mMutex;
+
+  /// Meshes that have been imported
+  std::map<Key, Entry> mMeshes;
+
+  /// Imports that are in progress
+  std::map<Key, std::shared_future<ScenePtr>> mPending;
+
+  /// Number of requests that were served without importing a file
+  size_t mNumHits;
+
+  /// Number of requests that imported a file
+  size_t mNumMisses;
+};
+
+}  // namespace dynamics
+}  // namespace dart
+
+#endif  // DART_DYNAMICS_MESHCACHE_H_
@@ -43,6 +43,7 @@
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/cimport.h>
+#include <assimp/cexport.h>
 
 #include "dart/config.h"
 #include "dart/renderer/RenderInterface.h"
@@ -136,6 +137,27 @@ MeshShape::MeshShape(const Eigen::Vector3d& _scale, const aiScene* _mesh,
                      const std::string& _path,
                      const common::ResourceRetrieverPtr& _resourceRetriever)
   : Shape(MESH),
+    mMesh(nullptr),
+    mResourceRetriever(_resourceRetriever),
+    mDisplayList(0),
+    mColorMode(MATERIAL_COLOR),
+    mColorIndex(0)
+{
+  assert(_scale[0] > 0.0);
+  assert(_scale[1] > 0.0);
+  assert(_scale[2] > 0.0);
+
+  setMesh(_mesh, _path, _resourceRetriever);
+  setScale(_scale);
+}
+
+//==============================================================================
+MeshShape::MeshShape(const Eigen::Vector3d& _scale,
+                     const std::shared_ptr<const aiScene>& _mesh,
+                     const std::string& _path,
+                     const common::ResourceRetrieverPtr& _resourceRetriever)
+  : Shape(MESH),
+    mMesh(nullptr),
     mResourceRetriever(_resourceRetriever),
     mDisplayList(0),
     mColorMode(MATERIAL_COLOR),
@@ -150,13 +172,19 @@ MeshShape::MeshShape(const Eigen::Vector3d& _scale, const aiScene* _mesh,
 }
 
 MeshShape::~MeshShape() {
-  delete mMesh;
+  // mSharedMesh releases the mesh
 }
 
 const aiScene* MeshShape::getMesh() const {
   return mMesh;
 }
 
+//==============================================================================
+const std::shared_ptr<const aiScene>& MeshShape::getSharedMesh() const
+{
+  return mSharedMesh;
+}
+
 const std::string& MeshShape::getMeshUri() const
 {
   return mMeshUri;
@@ -170,12 +198,27 @@ void MeshShape::update()
 //==============================================================================
 void MeshShape::notifyAlphaUpdate(double alpha)
 {
+  // The colors are stored in the mesh itself, so make a private copy before
+  // changing them if other MeshShapes are using the same mesh
+  if(mSharedMesh.use_count() > 1)
+  {
+    aiScene* copy = nullptr;
+    aiCopyScene(mMesh, &copy);
+    mSharedMesh.reset(copy);
+    mMesh = copy;
+  }
+
   for(size_t i=0; i<mMesh->mNumMeshes; ++i)
   {
     aiMesh* mesh = mMesh->mMeshes[i];
+    if(!mesh->mColors[0])
+      continue;
+
     for(size_t j=0; j<mesh->mNumVertices; ++j)
       mesh->mColors[0][j][3] = alpha;
   }
+
+  incrementVersion();
 }
 
 const std::string& MeshShape::getMeshPath() const
@@ -187,7 +230,20 @@ void MeshShape::setMesh(
   const aiScene* _mesh, const std::string& _path,
   const common::ResourceRetrieverPtr& _resourceRetriever)
 {
-  mMesh = _mesh;
+  if(_mesh == mMesh && mSharedMesh)
+    setMesh(mSharedMesh, _path, _resourceRetriever);
+  else
+    setMesh(std::shared_ptr<const aiScene>(_mesh), _path, _resourceRetriever);
+}
+
+//==============================================================================
+void MeshShape::setMesh(
+  const std::shared_ptr<const aiScene>& _mesh, const std::string& _path,
+  const common::ResourceRetrieverPtr& _resourceRetriever)
+{
+  mSharedMesh = _mesh;
+  mMesh = _mesh.get();
+  incrementVersion();
 
   if(nullptr == _mesh) {
     mMeshPath = "";
@@ -224,6 +280,7 @@ void MeshShape::setScale(const Eigen::Vector3d& _scale) {
   mScale = _scale;
   updateVolume();
   _updateBoundingBoxDim();
+  incrementVersion();
 }
 
 const Eigen::Vector3d& MeshShape::getScale() const {
@@ -233,6 +290,7 @@ const Eigen::Vector3d& MeshShape::getScale() const {
 void MeshShape::setColorMode(ColorMode _mode)
 {
   mColorMode = _mode;
+  incrementVersion();
 }
 
 MeshShape::ColorMode MeshShape::getColorMode() const
@@ -243,6 +301,7 @@ MeshShape::ColorMode MeshShape::getColorMode() const
 void MeshShape::setColorIndex(int _index)
 {
   mColorIndex = _index;
+  incrementVersion();
 }
 
 int MeshShape::getColorIndex() const
@@ -266,7 +325,7 @@ void MeshShape::draw(renderer::RenderInterface* ri,
     return;
 
   ri->setPenColor(color);
-  ri->drawMesh(mScale, mMesh);
+  ri->drawMeshShape(this);
 }
 
 Eigen::Matrix3d MeshShape::computeInertia(double _mass) const {
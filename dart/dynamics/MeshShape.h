@@ -38,6 +38,7 @@
 #ifndef DART_DYNAMICS_MESHSHAPE_H_
 #define DART_DYNAMICS_MESHSHAPE_H_
 
+#include <memory>
 #include <string>
 
 #include <assimp/scene.h>
@@ -65,19 +66,30 @@ public:
     SHAPE_COLOR,        ///< Use the color specified by the Shape base class
   };
 
-  /// \brief Constructor.
+  /// \brief Constructor. The MeshShape takes ownership of _mesh.
   MeshShape(
     const Eigen::Vector3d& _scale,
     const aiScene* _mesh,
     const std::string& _path = "",
     const common::ResourceRetrieverPtr& _resourceRetriever = nullptr);
 
+  /// Constructor for a mesh that may be shared with other MeshShapes, e.g.
+  /// one that was obtained from a MeshCache
+  MeshShape(
+    const Eigen::Vector3d& _scale,
+    const std::shared_ptr<const aiScene>& _mesh,
+    const std::string& _path = "",
+    const common::ResourceRetrieverPtr& _resourceRetriever = nullptr);
+
   /// \brief Destructor.
   virtual ~MeshShape();
 
   /// \brief
   const aiScene* getMesh() const;
 
+  /// Get the shared ownership of the mesh
+  const std::shared_ptr<const aiScene>& getSharedMesh() const;
+
   /// Update positions of the vertices or the elements. By default, this does
   /// nothing; you must extend the MeshShape class and implement your own
   /// version of this function if you want the mesh data to get updated before
@@ -87,12 +99,18 @@ public:
   // Documentation inherited
   void notifyAlphaUpdate(double alpha) override;
 
-  /// \brief
+  /// Set the mesh. The MeshShape takes ownership of _mesh.
   void setMesh(
     const aiScene* _mesh,
     const std::string& path = "",
     const common::ResourceRetrieverPtr& _resourceRetriever = nullptr);
 
+  /// Set a mesh that may be shared with other MeshShapes
+  void setMesh(
+    const std::shared_ptr<const aiScene>& _mesh,
+    const std::string& path = "",
+    const common::ResourceRetrieverPtr& _resourceRetriever = nullptr);
+
   /// \brief URI to the mesh; an empty string if unavailable.
   const std::string &getMeshUri() const;
 
@@ -151,6 +169,9 @@ protected:
   /// \brief
   const aiScene* mMesh;
 
+  /// Owner of mMesh, which may be shared with other MeshShapes
+  std::shared_ptr<const aiScene> mSharedMesh;
+
   /// \brief URI the mesh, if available).
   std::string mMeshUri;
 
@@ -80,6 +80,7 @@ Eigen::Matrix3d PlaneShape::computeInertia(double /*mass*/) const
 void PlaneShape::setNormal(const Eigen::Vector3d& _normal)
 {
   mNormal = _normal.normalized();
+  incrementVersion();
 }
 
 //==============================================================================
@@ -92,6 +93,7 @@ const Eigen::Vector3d& PlaneShape::getNormal() const
 void PlaneShape::setOffset(double _offset)
 {
   mOffset = _offset;
+  incrementVersion();
 }
 
 //==============================================================================
@@ -47,6 +47,7 @@ Shape::Shape(ShapeType _type)
     mVolume(0.0),
     mID(mCounter++),
     mVariance(STATIC),
+    mVersion(0),
     mType(_type)
 {
 }
@@ -132,6 +133,18 @@ void Shape::notifyColorUpdate(const Eigen::Vector4d& /*color*/)
   // Do nothing
 }
 
+//==============================================================================
+size_t Shape::incrementVersion()
+{
+  return ++mVersion;
+}
+
+//==============================================================================
+size_t Shape::getVersion() const
+{
+  return mVersion;
+}
+
 //==============================================================================
 int Shape::mCounter = PRIMITIVE_MAGIC_NUMBER;
 
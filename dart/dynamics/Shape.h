@@ -45,6 +45,7 @@
 #include "dart/math/Geometry.h"
 #include "dart/common/Deprecated.h"
 #include "dart/common/Subject.h"
+#include "dart/common/VersionCounter.h"
 #include "dart/dynamics/SmartPointer.h"
 #include "dart/common/Deprecated.h"
 
@@ -57,7 +58,9 @@ class RenderInterface;
 namespace dart {
 namespace dynamics {
 /// \brief
-class Shape : public virtual common::Subject
+class Shape
+    : public virtual common::Subject,
+      public virtual common::VersionCounter
 {
 public:
   // TODO(JS): We should not use ShapeType because this is not extendable.
@@ -141,6 +144,14 @@ public:
   /// Notify that the color (rgba) of this shape has updated
   virtual void notifyColorUpdate(const Eigen::Vector4d& color);
 
+  /// Increment the version of this Shape. The setters of the Shape classes
+  /// call this whenever the data of the Shape changes, so that renderers can
+  /// skip the Shapes that did not change since they were last rendered.
+  size_t incrementVersion() override;
+
+  /// Get the version of this Shape
+  size_t getVersion() const override;
+
   /// \brief
   virtual void draw(
       renderer::RenderInterface* _ri = nullptr,
@@ -163,6 +174,9 @@ protected:
   /// The DataVariance of this Shape
   unsigned int mVariance;
 
+  /// Version of the data of this Shape
+  size_t mVersion;
+
   /// \brief
   static int mCounter;
 
@@ -171,14 +171,16 @@ Skeleton::Properties::Properties(
     double _timeStep,
     bool _enabledSelfCollisionCheck,
     bool _enableAdjacentBodyCheck,
-    size_t _version)
+    size_t _version,
+    bool _implicitSpringIntegration)
   : mName(_name),
     mIsMobile(_isMobile),
     mGravity(_gravity),
     mTimeStep(_timeStep),
     mEnabledSelfCollisionCheck(_enabledSelfCollisionCheck),
     mEnabledAdjacentBodyCheck(_enableAdjacentBodyCheck),
-    mVersion(_version)
+    mVersion(_version),
+    mImplicitSpringIntegration(_implicitSpringIntegration)
 {
   // Do nothing
 }
@@ -382,6 +384,7 @@ void Skeleton::setProperties(const Properties& _properties)
   setMobile(_properties.mIsMobile);
   setGravity(_properties.mGravity);
   setTimeStep(_properties.mTimeStep);
+  setImplicitSpringIntegration(_properties.mImplicitSpringIntegration);
 
   if(_properties.mEnabledSelfCollisionCheck)
     enableSelfCollision(_properties.mEnabledAdjacentBodyCheck);
@@ -522,6 +525,18 @@ bool Skeleton::isMobile() const
   return mSkeletonP.mIsMobile;
 }
 
+//==============================================================================
+void Skeleton::setSleeping(bool _isSleeping)
+{
+  mIsSleeping = _isSleeping;
+}
+
+//==============================================================================
+bool Skeleton::isSleeping() const
+{
+  return mIsSleeping;
+}
+
 //==============================================================================
 void Skeleton::setTimeStep(double _timeStep)
 {
@@ -538,6 +553,24 @@ double Skeleton::getTimeStep() const
   return mSkeletonP.mTimeStep;
 }
 
+//==============================================================================
+void Skeleton::setImplicitSpringIntegration(bool _implicit)
+{
+  if (mSkeletonP.mImplicitSpringIntegration == _implicit)
+    return;
+
+  mSkeletonP.mImplicitSpringIntegration = _implicit;
+
+  for(size_t i=0; i<mTreeCache.size(); ++i)
+    notifyArticulatedInertiaUpdate(i);
+}
+
+//==============================================================================
+bool Skeleton::isImplicitSpringIntegration() const
+{
+  return mSkeletonP.mImplicitSpringIntegration;
+}
+
 //==============================================================================
 void Skeleton::setGravity(const Eigen::Vector3d& _gravity)
 {
@@ -1808,6 +1841,7 @@ Skeleton::Skeleton(const Properties& _properties)
   : mSkeletonP(""),
     mTotalMass(0.0),
     mIsImpulseApplied(false),
+    mIsSleeping(false),
     mUnionSize(1)
 {
   setProperties(_properties);
@@ -1940,6 +1974,7 @@ void Skeleton::registerBodyNode(BodyNode* _newBodyNode)
   }
 #endif // ------- Debug mode
 
+  incrementVersion();
   _newBodyNode->mStructuralChangeSignal.raise(_newBodyNode);
 }
 
@@ -2103,6 +2138,8 @@ void Skeleton::unregisterBodyNode(BodyNode* _oldBodyNode)
                                      mSoftBodyNodes.end(), soft),
                          mSoftBodyNodes.end());
   }
+
+  incrementVersion();
 }
 
 //==============================================================================
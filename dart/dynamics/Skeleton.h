@@ -163,6 +163,12 @@ public:
     /// Property changes.
     size_t mVersion;
 
+    /// True if the edge springs between the point masses of soft bodies are
+    /// integrated with linearized backward Euler, like the joint springs and
+    /// damping. Otherwise they are explicit, which limits the time step for
+    /// stiff soft bodies.
+    bool mImplicitSpringIntegration;
+
     /// Default constructor
     Properties(
         const std::string& _name = "Skeleton",
@@ -171,7 +177,8 @@ public:
         double _timeStep = 0.001,
         bool _enabledSelfCollisionCheck = false,
         bool _enableAdjacentBodyCheck = false,
-        size_t _version = 0);
+        size_t _version = 0,
+        bool _implicitSpringIntegration = false);
   };
 
   using BodyNodeExtendedProperties = std::vector<detail::BodyNodeExtendedProperties>;
@@ -305,6 +312,16 @@ public:
   /// \return True if this skeleton is mobile.
   bool isMobile() const;
 
+  /// Set whether this skeleton is sleeping. A sleeping skeleton is skipped by
+  /// World::step and its collisions with other sleeping or immobile skeletons
+  /// are not checked. ConstraintSolver puts resting islands to sleep when
+  /// sleeping is enabled; use ConstraintSolver::wakeUp() to wake up a whole
+  /// island instead of a single skeleton.
+  void setSleeping(bool _isSleeping);
+
+  /// Return true if this skeleton is sleeping
+  bool isSleeping() const;
+
   /// Set time step. This timestep is used for implicit joint damping
   /// force.
   void setTimeStep(double _timeStep);
@@ -312,6 +329,17 @@ public:
   /// Get time step.
   double getTimeStep() const;
 
+  /// Set whether the edge springs of the soft bodies in this skeleton are
+  /// integrated implicitly. Joint springs and damping and the vertex springs
+  /// of point masses are always linearized backward Euler; enabling this
+  /// solves the coupled edge springs of each SoftBodyNode as well, which keeps
+  /// stiff soft bodies stable at much larger time steps at the cost of an
+  /// O(n^2) update per SoftBodyNode with n point masses.
+  void setImplicitSpringIntegration(bool _implicit);
+
+  /// Return true if the edge springs of soft bodies are integrated implicitly
+  bool isImplicitSpringIntegration() const;
+
   /// Set 3-dim gravitational acceleration. The gravity is used for
   /// calculating gravity force vector of the skeleton.
   void setGravity(const Eigen::Vector3d& _gravity);
@@ -1301,6 +1329,9 @@ protected:
   /// Flag for status of impulse testing.
   bool mIsImpulseApplied;
 
+  /// True if this skeleton is sleeping
+  bool mIsSleeping;
+
   mutable std::mutex mMutex;
 
 public:
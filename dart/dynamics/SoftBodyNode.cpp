@@ -45,7 +45,6 @@
 #include "dart/dynamics/Joint.h"
 #include "dart/dynamics/Shape.h"
 #include "dart/dynamics/Skeleton.h"
-#include "dart/renderer/LoadOpengl.h"
 #include "dart/renderer/RenderInterface.h"
 
 #include "dart/dynamics/PointMass.h"
@@ -603,11 +602,23 @@ void SoftBodyNode::updateArtInertia(double _timeStep) const
   }
 
   //
-  for (const auto& pointMass : mPointMasses)
+  if (hasImplicitSprings())
+  {
+    updateImplicitSpringMatrix(_timeStep);
+
+    for (const auto& pointMass : mPointMasses)
+      _addPiToArtInertia(pointMass->getLocalPosition(), pointMass->mPi);
+
+    _addImplicitSpringsToArtInertiaImplicit();
+  }
+  else
   {
-    _addPiToArtInertia(pointMass->getLocalPosition(), pointMass->mPi);
-    _addPiToArtInertiaImplicit(pointMass->getLocalPosition(),
-                               pointMass->mImplicitPi);
+    for (const auto& pointMass : mPointMasses)
+    {
+      _addPiToArtInertia(pointMass->getLocalPosition(), pointMass->mPi);
+      _addPiToArtInertiaImplicit(pointMass->getLocalPosition(),
+                                 pointMass->mImplicitPi);
+    }
   }
 
   // Verification
@@ -631,6 +642,9 @@ void SoftBodyNode::updateBiasForce(const Eigen::Vector3d& _gravity,
   for (auto& pointMass : mPointMasses)
     pointMass->updateBiasForceFD(_timeStep, _gravity);
 
+  if (hasImplicitSprings())
+    updateImplicitSpringBiasForce();
+
   // Gravity force
   if (mBodyP.mGravityMode == true)
     mFgravity.noalias() = mI * math::AdInvRLinear(getWorldTransform(),_gravity);
@@ -677,8 +691,15 @@ void SoftBodyNode::updateAccelerationFD()
 {
   BodyNode::updateAccelerationFD();
 
-  for (auto& pointMass : mPointMasses)
-    pointMass->updateAccelerationFD();
+  if (hasImplicitSprings())
+  {
+    updateImplicitSpringAccelerations();
+  }
+  else
+  {
+    for (auto& pointMass : mPointMasses)
+      pointMass->updateAccelerationFD();
+  }
 
   mNotifier->clearAccelerationNotice();
 }
@@ -1175,31 +1196,10 @@ void SoftBodyNode::draw(renderer::RenderInterface* _ri,
 //  _ri->setPenColor(fleshColor);
 //  if (_showMeshs)
   {
-    _ri->setPenColor(mSoftShapeNode.lock()->get<VisualAddon>()->getRGBA());
-    glEnable(GL_LIGHTING);
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-
-    Eigen::Vector3d pos;
-    Eigen::Vector3d pos_normalized;
-    for (size_t i = 0; i < mSoftP.mFaces.size(); ++i)
-    {
-      glEnable(GL_AUTO_NORMAL);
-      glBegin(GL_TRIANGLES);
-
-      pos = mPointMasses[mSoftP.mFaces[i](0)]->getLocalPosition();
-      pos_normalized = pos.normalized();
-      glNormal3f(pos_normalized(0), pos_normalized(1), pos_normalized(2));
-      glVertex3f(pos(0), pos(1), pos(2));
-      pos = mPointMasses[mSoftP.mFaces[i](1)]->getLocalPosition();
-      pos_normalized = pos.normalized();
-      glNormal3f(pos_normalized(0), pos_normalized(1), pos_normalized(2));
-      glVertex3f(pos(0), pos(1), pos(2));
-      pos = mPointMasses[mSoftP.mFaces[i](2)]->getLocalPosition();
-      pos_normalized = pos.normalized();
-      glNormal3f(pos_normalized(0), pos_normalized(1), pos_normalized(2));
-      glVertex3f(pos(0), pos(1), pos(2));
-      glEnd();
-    }
+    auto softShapeNode = mSoftShapeNode.lock();
+    _ri->setPenColor(softShapeNode->get<VisualAddon>()->getRGBA());
+    _ri->drawSoftMeshShape(
+          static_cast<const SoftMeshShape*>(softShapeNode->getShape().get()));
   }
 
   _ri->popName();
@@ -1244,6 +1244,165 @@ void SoftBodyNode::_addPiToArtInertiaImplicit(const Eigen::Vector3d& _p,
   mArtInertiaImplicit(5, 5) += _ImplicitPi;
 }
 
+//==============================================================================
+bool SoftBodyNode::hasImplicitSprings() const
+{
+  if (mPointMasses.empty())
+    return false;
+
+  const ConstSkeletonPtr skel = getSkeleton();
+
+  return skel && skel->isImplicitSpringIntegration();
+}
+
+//==============================================================================
+void SoftBodyNode::updateImplicitSpringMatrix(double _timeStep) const
+{
+  const size_t n = mPointMasses.size();
+  const double h = _timeStep;
+  const double kv = getVertexSpringStiffness();
+  const double ke = getEdgeSpringStiffness();
+  const double kd = getDampingCoefficient();
+
+  // Linearized backward Euler of all the springs and dampers gives
+  //   (M + h*kd*I + h^2*(kv*I + ke*L)) * ddq = alpha - M*J*a_parent
+  // which is the same for each of the three axes.
+  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(n, n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    const PointMass* pointMass = mPointMasses[i];
+    const size_t numConnected = pointMass->getNumConnectedPointMasses();
+
+    A(i, i) = pointMass->getMass() + h * kd + h * h * (kv + numConnected * ke);
+
+    for (size_t k = 0; k < numConnected; ++k)
+    {
+      const size_t j
+          = pointMass->getConnectedPointMass(k)->getIndexInSoftBodyNode();
+      A(i, j) -= h * h * ke;
+    }
+  }
+
+  if (A.rows() == mImplicitSpringMatrix.rows() && A == mImplicitSpringMatrix)
+    return;
+
+  mImplicitSpringMatrix = A;
+  mInvImplicitSpringMatrix = A.llt().solve(Eigen::MatrixXd::Identity(n, n));
+  assert(!math::isNan(mInvImplicitSpringMatrix));
+}
+
+//==============================================================================
+void SoftBodyNode::_addImplicitSpringsToArtInertiaImplicit() const
+{
+  // With P = inv(mImplicitSpringMatrix) and J_i the Jacobian that maps the
+  // spatial acceleration of this body to the acceleration of point mass i, the
+  // point masses add
+  //   sum_i m_i*J_i^T*J_i - sum_i sum_j m_i*m_j*P_ij*J_i^T*J_j
+  // to the implicit articulated inertia. Because J_i is linear in the position
+  // X_i, the double sum collapses into Y = diag(m)*P*diag(m)*X so that the
+  // cost is dominated by a single n x n times n x 3 product.
+  const size_t n = mPointMasses.size();
+  const Eigen::MatrixXd& P = mInvImplicitSpringMatrix;
+
+  Eigen::VectorXd masses(n);
+  mImplicitSpringRhs.resize(n, 3);
+  for (size_t i = 0; i < n; ++i)
+  {
+    masses[i] = mPointMasses[i]->getMass();
+    mImplicitSpringRhs.row(i)
+        = masses[i] * mPointMasses[i]->getLocalPosition().transpose();
+  }
+
+  const Eigen::MatrixXd Y = masses.asDiagonal() * (P * mImplicitSpringRhs);
+  const Eigen::VectorXd r = masses.asDiagonal() * (P * masses);
+
+  Eigen::Matrix3d topLeft = Eigen::Matrix3d::Zero();
+  Eigen::Vector3d moment = Eigen::Vector3d::Zero();
+  double sum = 0.0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    const Eigen::Vector3d& X = mPointMasses[i]->getLocalPosition();
+    const Eigen::Vector3d Z = mImplicitSpringRhs.row(i).transpose()
+                              - Y.row(i).transpose();
+    const double s = masses[i] - r[i];
+
+    topLeft -= math::makeSkewSymmetric(X) * math::makeSkewSymmetric(Z);
+    moment += s * X;
+    sum += s;
+  }
+
+  const Eigen::Matrix3d tmp = math::makeSkewSymmetric(moment);
+
+  mArtInertiaImplicit.topLeftCorner<3, 3>()    += topLeft;
+  mArtInertiaImplicit.topRightCorner<3, 3>()   += tmp;
+  mArtInertiaImplicit.bottomLeftCorner<3, 3>() -= tmp;
+
+  mArtInertiaImplicit(3, 3) += sum;
+  mArtInertiaImplicit(4, 4) += sum;
+  mArtInertiaImplicit(5, 5) += sum;
+}
+
+//==============================================================================
+void SoftBodyNode::updateImplicitSpringBiasForce()
+{
+  // beta_i = B_i + m_i*(eta_i + sum_j P_ij*alpha_j)
+  const size_t n = mPointMasses.size();
+
+  mImplicitSpringRhs.resize(n, 3);
+  for (size_t i = 0; i < n; ++i)
+    mImplicitSpringRhs.row(i) = mPointMasses[i]->mAlpha.transpose();
+
+  const Eigen::MatrixXd PAlpha = mInvImplicitSpringMatrix * mImplicitSpringRhs;
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    PointMass* pointMass = mPointMasses[i];
+
+    pointMass->mBeta = pointMass->mB;
+    pointMass->mBeta.noalias()
+        += pointMass->getMass() * (pointMass->getPartialAccelerations()
+                                   + PAlpha.row(i).transpose());
+    assert(!math::isNan(pointMass->mBeta));
+  }
+}
+
+//==============================================================================
+void SoftBodyNode::updateImplicitSpringAccelerations()
+{
+  // ddq = P*(alpha - M*(dw(parent) x X + dv(parent)))
+  const size_t n = mPointMasses.size();
+  const Eigen::Vector6d& a_parent = getSpatialAcceleration();
+
+  mImplicitSpringRhs.resize(n, 3);
+  for (size_t i = 0; i < n; ++i)
+  {
+    const PointMass* pointMass = mPointMasses[i];
+    const Eigen::Vector3d& X = pointMass->getLocalPosition();
+
+    mImplicitSpringRhs.row(i)
+        = (pointMass->mAlpha
+           - pointMass->getMass()
+             * (a_parent.head<3>().cross(X) + a_parent.tail<3>())).transpose();
+  }
+
+  const Eigen::MatrixXd ddq = mInvImplicitSpringMatrix * mImplicitSpringRhs;
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    PointMass* pointMass = mPointMasses[i];
+    const Eigen::Vector3d& X = pointMass->getLocalPosition();
+
+    pointMass->setAccelerations(ddq.row(i).transpose());
+    assert(!math::isNan(pointMass->getAccelerations()));
+
+    // dv = dw(parent) x mX + dv(parent) + eata + ddq
+    pointMass->mA = a_parent.head<3>().cross(X) + a_parent.tail<3>()
+                    + pointMass->getPartialAccelerations()
+                    + pointMass->getAccelerations();
+    assert(!math::isNan(pointMass->mA));
+  }
+}
+
 //==============================================================================
 void SoftBodyNode::updateInertiaWithPointMass()
 {
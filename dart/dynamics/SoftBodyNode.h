@@ -367,6 +367,19 @@ protected:
   ///
   math::Inertia mArtInertiaImplicit2;
 
+  /// Coefficient matrix of the implicit point mass equations,
+  /// diag(m) + h*kd*I + h^2*(kv*I + ke*L), where L is the graph Laplacian of
+  /// the edges between the point masses. Used only when the skeleton
+  /// integrates the edge springs implicitly.
+  mutable Eigen::MatrixXd mImplicitSpringMatrix;
+
+  /// Inverse of mImplicitSpringMatrix. It is recomputed only when the masses,
+  /// stiffnesses, damping coefficient or time step change.
+  mutable Eigen::MatrixXd mInvImplicitSpringMatrix;
+
+  /// Scratch matrix of per point mass vectors, one row per point mass
+  mutable Eigen::MatrixXd mImplicitSpringRhs;
+
 private:
   /// \brief
   void _addPiToArtInertia(const Eigen::Vector3d& _p, double _Pi) const;
@@ -375,6 +388,22 @@ private:
   void _addPiToArtInertiaImplicit(const Eigen::Vector3d& _p,
                                   double _ImplicitPi) const;
 
+  /// Return true if the edge springs are integrated implicitly
+  bool hasImplicitSprings() const;
+
+  /// Update mImplicitSpringMatrix and its inverse
+  void updateImplicitSpringMatrix(double _timeStep) const;
+
+  /// Add the coupled contribution of all the point masses to
+  /// mArtInertiaImplicit
+  void _addImplicitSpringsToArtInertiaImplicit() const;
+
+  /// Replace the decoupled bias forces of the point masses by the coupled ones
+  void updateImplicitSpringBiasForce();
+
+  /// Solve the coupled accelerations of the point masses
+  void updateImplicitSpringAccelerations();
+
   ///
   void updateInertiaWithPointMass();
 };
@@ -140,6 +140,7 @@ void SoftMeshShape::update()
     itAIVector3d.Set(vertex[0], vertex[1], vertex[2]);
     mAssimpMesh->mVertices[i] = itAIVector3d;
   }
+  incrementVersion();
 }
 
 }  // namespace dynamics
@@ -68,6 +68,10 @@ struct BodyNodeUniqueProperties
   /// Gravity will be applied if true
   bool mGravityMode;
 
+  /// True if collisions of this body are detected continuously over each time
+  /// step, which keeps a fast body from passing through thin ones
+  bool mContinuousCollision;
+
   /// Properties of the Markers belonging to this BodyNode
   std::vector<Marker::Properties> mMarkerProperties;
 
@@ -77,7 +81,8 @@ struct BodyNodeUniqueProperties
       bool _isCollidable = true,
       double _frictionCoeff = DART_DEFAULT_FRICTION_COEFF,
       double _restitutionCoeff = DART_DEFAULT_RESTITUTION_COEFF,
-      bool _gravityMode = true);
+      bool _gravityMode = true,
+      bool _continuousCollision = false);
 
   virtual ~BodyNodeUniqueProperties() = default;
 
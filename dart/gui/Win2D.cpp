@@ -143,6 +143,9 @@ void Win2D::render() {
     glEnd();
   }
 
+  if (mRI)
+    mRI->endFrame();
+
   if (mCapture)
     screenshot();
 
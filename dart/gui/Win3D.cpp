@@ -219,6 +219,9 @@ void Win3D::render() {
   if (mRotate && !mCapture)
     mTrackBall.draw(mWinWidth, mWinHeight);
 
+  if (mRI)
+    mRI->endFrame();
+
   glutSwapBuffers();
 
   if (mCapture)
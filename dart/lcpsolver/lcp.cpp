@@ -390,6 +390,8 @@ struct dLCP {
   void pN_plusequals_s_times_qN (dReal *p, dReal s, dReal *q);
   void solve1 (dReal *a, int i, int dir=1, int only_transfer=0);
   void unpermute();
+  void factorize_C (int nC);
+  int warm_start (int *guess);
 };
 
 
@@ -470,23 +472,7 @@ dLCP::dLCP (int _n, int _nskip, int _nub, dReal *_Adata, dReal *_x, dReal *_b, d
 
   // if there are unbounded variables at the start, factorize A up to that
   // point and solve for x. this puts all indexes 0..nub-1 into C.
-  if (m_nub > 0) {
-    const int nub = m_nub;
-    {
-      dReal *Lrow = m_L;
-      const int nskip = m_nskip;
-      for (int j=0; j<nub; Lrow+=nskip, ++j) memcpy(Lrow,AROW(j),(j+1)*sizeof(dReal));
-    }
-    dFactorLDLT (m_L,m_d,nub,m_nskip);
-    memcpy (m_x,m_b,nub*sizeof(dReal));
-    dSolveLDLT (m_L,m_d,m_x,nub,m_nskip);
-    dSetZero (m_w,nub);
-    {
-      int *C = m_C;
-      for (int k=0; k<nub; ++k) C[k] = k;
-    }
-    m_nC = nub;
-  }
+  if (m_nub > 0) factorize_C (m_nub);
 
   // permute the indexes > nub such that all findex variables are at the end
   if (m_findex) {
@@ -517,6 +503,71 @@ dLCP::dLCP (int _n, int _nskip, int _nub, dReal *_Adata, dReal *_x, dReal *_b, d
 }
 
 
+// factorize A up to nC and solve for x, putting indexes 0..nC-1 into C.
+
+void dLCP::factorize_C (int nC)
+{
+  {
+    dReal *Lrow = m_L;
+    const int nskip = m_nskip;
+    for (int j=0; j<nC; Lrow+=nskip, ++j) memcpy(Lrow,AROW(j),(j+1)*sizeof(dReal));
+  }
+  dFactorLDLT (m_L,m_d,nC,m_nskip);
+  memcpy (m_x,m_b,nC*sizeof(dReal));
+  dSolveLDLT (m_L,m_d,m_x,nC,m_nskip);
+  dSetZero (m_w,nC);
+  {
+    int *C = m_C;
+    for (int k=0; k<nC; ++k) C[k] = k;
+  }
+  m_nC = nC;
+}
+
+
+// move the indexes i with guess[p[i]] != 0 right after the unbounded ones and
+// put them into C with a single factorization. this is only valid if x(C)
+// ends up strictly within lo and hi, because then indexes 0..nC-1 satisfy the
+// LCP conditions of the sub-problem, which is all the driving loop needs. the
+// indexes that violate their bounds are dropped from the guess and the rest
+// is tried again a few times before C is reset to the unbounded indexes.
+// friction indexes are at the end and are never moved. returns the number of
+// indexes that were added to C.
+
+int dLCP::warm_start (int *guess)
+{
+  const int nub = m_nub;
+  const int max_attempts = 4;
+  for (int attempt=0; attempt<max_attempts; ++attempt) {
+    int num_guess = 0;
+    for (int k=nub; k<m_n; ++k) {
+      if (m_findex && m_findex[k] >= 0) break;
+      if (guess[m_p[k]]) {
+        swapProblem (m_A,m_x,m_b,m_w,m_lo,m_hi,m_p,m_state,m_findex,m_n,nub+num_guess,k,m_nskip,0);
+        num_guess++;
+      }
+    }
+    if (num_guess == 0) break;
+
+    factorize_C (nub+num_guess);
+
+    bool feasible = true;
+    for (int k=nub; k<m_nC; ++k) {
+      if (!(m_x[k] > m_lo[k] && m_x[k] < m_hi[k])) {
+        guess[m_p[k]] = 0;
+        feasible = false;
+      }
+    }
+    if (feasible) return num_guess;
+
+    dSetZero (m_x+nub,num_guess);
+  }
+
+  if (nub > 0) factorize_C (nub);
+  else m_nC = 0;
+  return 0;
+}
+
+
 void dLCP::transfer_i_to_C (int i)
 {
   {
@@ -777,8 +828,39 @@ void dLCP::unpermute()
 //***************************************************************************
 // an optimized Dantzig LCP driver routine for the lo-hi LCP problem.
 
+dLCPWorkspace::dLCPWorkspace()
+  : warmStart(false), numPivots(0), numWarmStarted(0), stateSize(0)
+{
+}
+
+
+void dLCPWorkspace::resize (int n)
+{
+  // vectors keep their capacity, so this only allocates when the problem
+  // grows beyond the largest one seen so far
+  const int nskip = dPAD(n);
+  L.resize (n*nskip);
+  d.resize (n);
+  w.resize (n);
+  delta_w.resize (n);
+  delta_x.resize (n);
+  Dell.resize (n);
+  ell.resize (n);
+#ifdef ROWPTRS
+  Arows.resize (n);
+#endif
+  p.resize (n);
+  C.resize (n);
+  if (stateSize < n) {
+    state.reset (new bool[n]);
+    stateSize = n;
+  }
+}
+
+
 void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
-                dReal *outer_w/*=nullptr*/, int nub, dReal *lo, dReal *hi, int *findex)
+                dReal *outer_w/*=nullptr*/, int nub, dReal *lo, dReal *hi, int *findex,
+                dLCPWorkspace *workspace/*=nullptr*/)
 {
   dAASSERT (n>0 && A && x && b && lo && hi && nub >= 0 && nub <= n);
 # ifndef dNODEBUG
@@ -788,11 +870,16 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
   }
 # endif
 
+  dLCPWorkspace local_workspace;
+  dLCPWorkspace &ws = workspace ? *workspace : local_workspace;
+  ws.resize (n);
+  ws.numPivots = 0;
+  ws.numWarmStarted = 0;
 
   // if all the variables are unbounded then we can just factor, solve,
   // and return
   if (nub >= n) {
-    dReal *d = new dReal[n];
+    dReal *d = ws.d.data();
     dSetZero (d, n);
 
     int nskip = dPAD(n);
@@ -800,34 +887,41 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
     dSolveLDLT (A, d, b, n, nskip);
     memcpy (x, b, n*sizeof(dReal));
 
+    ws.activeSet.assign (n, 1);
     return;
   }
 
   const int nskip = dPAD(n);
-  dReal *L = new dReal[ (n*nskip)];
-  dReal *d = new dReal[ (n)];
-  dReal *w = outer_w ? outer_w : (new dReal[n]);
-  dReal *delta_w = new dReal[ (n)];
-  dReal *delta_x = new dReal[ (n)];
-  dReal *Dell = new dReal[ (n)];
-  dReal *ell = new dReal[ (n)];
+  dReal *L = ws.L.data();
+  dReal *d = ws.d.data();
+  dReal *w = outer_w ? outer_w : ws.w.data();
+  dReal *delta_w = ws.delta_w.data();
+  dReal *delta_x = ws.delta_x.data();
+  dReal *Dell = ws.Dell.data();
+  dReal *ell = ws.ell.data();
 #ifdef ROWPTRS
-  dReal **Arows = new dReal* [n];
+  dReal **Arows = ws.Arows.data();
 #else
   dReal **Arows = nullptr;
 #endif
-  int *p = new int[n];
-  int *C = new int[n];
+  int *p = ws.p.data();
+  int *C = ws.C.data();
 
   // for i in N, state[i] is 0 if x(i)==lo(i) or 1 if x(i)==hi(i)
-  bool *state = new bool[n];
+  bool *state = ws.state.get();
 
   // create LCP object. note that tmp is set to delta_w to save space, this
   // optimization relies on knowledge of how tmp is used, so be careful!
   dLCP lcp(n,nskip,nub,A,x,b,w,lo,hi,L,d,Dell,ell,delta_w,state,findex,p,C,Arows);
   int adj_nub = lcp.getNub();
 
-  // loop over all indexes adj_nub..n-1. for index i, if x(i),w(i) satisfy the
+  // start with the indexes that were in C last time
+  if (ws.warmStart && static_cast<int>(ws.activeSet.size()) == n)
+    ws.numWarmStarted = lcp.warm_start (ws.activeSet.data());
+  const int first_i = lcp.numC();
+
+  // loop over all indexes first_i..n-1, where C holds the unbounded and the warm
+  // started indexes. for index i, if x(i),w(i) satisfy the
   // LCP conditions then i is added to the appropriate index set. otherwise
   // x(i),w(i) is driven either +ve or -ve to force it to the valid region.
   // as we drive x(i), x(C) is also adjusted to keep w(C) at zero.
@@ -837,7 +931,7 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
   // when that happens.
 
   bool hit_first_friction_index = false;
-  for (int i=adj_nub; i<n; ++i) {
+  for (int i=first_i; i<n; ++i) {
     bool s_error = false;
     // the index i is the driving index and indexes i+1..n-1 are "dont care",
     // i.e. when we make changes to the system those x's will be zero and we
@@ -901,6 +995,7 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
       // corresponding to set C is at least finite in extent, and we are on it.
       // NOTE: we must call lcp.solve1() before lcp.transfer_i_to_C()
       lcp.solve1 (delta_x,i,0,1);
+      ws.numPivots++;
 
       lcp.transfer_i_to_C (i);
     }
@@ -921,6 +1016,7 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
 
         // compute: delta_x(C) = -dir*A(C,C)\A(C,i)
         lcp.solve1 (delta_x,i,dir);
+        ws.numPivots++;
 
         // note that delta_x[i] = dirf, but we wont bother to set it
 
@@ -1061,25 +1157,13 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
     if (s_error) {
       break;
     }
-  } // for (int i=adj_nub; i<n; ++i)
-
-  lcp.unpermute();
+  } // for (int i=first_i; i<n; ++i)
 
-  if (!outer_w)
-	  delete[] w;
-  delete[] L;
-  delete[] d;
-  delete[] delta_w;
-  delete[] delta_x;
-  delete[] Dell;
-  delete[] ell;
-#ifdef ROWPTRS
-  delete[] Arows;
-#endif
-  delete[] p;
-  delete[] C;
+  // remember the index set C for the next call
+  ws.activeSet.assign (n, 0);
+  for (int k=0; k<lcp.numC(); ++k) ws.activeSet[p[k]] = 1;
 
-  delete[] state;
+  lcp.unpermute();
 }
 
 size_t dEstimateSolveLCPMemoryReq(int n, bool outer_w_avail)
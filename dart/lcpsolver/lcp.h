@@ -53,12 +53,57 @@ to be implemented. the first `nub' variables are assumed to have findex < 0.
 #include <stdlib.h>
 #include <stdio.h>
 #include <cassert>
+#include <memory>
+#include <vector>
 
 #include "dart/lcpsolver/odeconfig.h"
 #include "dart/lcpsolver/common.h"
 
+/*
+a dLCPWorkspace owns the work arrays of dSolveLCP. passing the same workspace
+to successive calls avoids allocating them for every problem.
+
+the workspace can also warm start the solver. after each call, activeSet[i]
+is nonzero if index i ended up in the clamped set C (lo < x(i) < hi, w(i)=0).
+if `warmStart' is set and activeSet has n entries, dSolveLCP moves the
+non-friction indexes that were in C to the front and factorizes them at once
+instead of adding them to C one pivot at a time. the guess is only used if
+the resulting x(C) lies strictly within lo and hi. indexes that violate
+their bounds are dropped from the guess and the rest is tried again a few
+times before the solver starts from scratch, so a stale guess costs a few
+factorizations but never changes the solution. friction indexes are never
+warm started because their bounds are only known once the normal forces are.
+*/
+
+struct dLCPWorkspace
+{
+  dLCPWorkspace();
+
+  // make the buffers large enough for an n*n problem
+  void resize (int n);
+
+  // start from activeSet if it has n entries
+  bool warmStart;
+
+  // indexes of the set C of the last solution. see above.
+  std::vector<int> activeSet;
+
+  // number of pivots (index set changes) of the last call
+  int numPivots;
+
+  // number of indexes that were taken from activeSet in the last call
+  int numWarmStarted;
+
+  std::vector<dReal> L, d, w, delta_w, delta_x, Dell, ell;
+  std::vector<dReal *> Arows;
+  std::vector<int> p, C;
+  std::unique_ptr<bool[]> state;
+  int stateSize;
+};
+
 void dSolveLCP (int n, dReal *A, dReal *x, dReal *b, dReal *w,
-	int nub, dReal *lo, dReal *hi, int *findex);
+	int nub, dReal *lo, dReal *hi, int *findex,
+	dLCPWorkspace *workspace = nullptr);
 
 size_t dEstimateSolveLCPMemoryReq(int n, bool outer_w_avail);
 
@@ -0,0 +1,656 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/optimizer/LbfgsbSolver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "dart/common/Console.h"
+#include "dart/math/Helpers.h"
+#include "dart/optimizer/Problem.h"
+
+namespace dart {
+namespace optimizer {
+
+namespace {
+
+/// Sufficient decrease parameter of the Armijo condition
+const double ARMIJO_FACTOR = 1e-4;
+
+/// Factor that the step length is multiplied by when the Armijo condition is
+/// not satisfied
+const double BACKTRACKING_FACTOR = 0.5;
+
+/// Maximum number of trial steps of the line search
+const size_t MAX_LINE_SEARCH_STEPS = 20;
+
+/// Correction pairs whose curvature is below this fraction of |y|^2 are
+/// skipped to keep the inverse Hessian approximation positive definite
+const double CURVATURE_EPSILON = 1e-10;
+
+} // anonymous namespace
+
+//==============================================================================
+const std::string LbfgsbSolver::Type = "LbfgsbSolver";
+
+//==============================================================================
+LbfgsbSolver::UniqueProperties::UniqueProperties(
+    size_t _historySize,
+    double _gradientTolerance,
+    size_t _maxAttempts,
+    size_t _maxOuterIterations,
+    double _initialPenalty,
+    double _penaltyFactor,
+    double _maxPenalty)
+  : mHistorySize(_historySize),
+    mGradientTolerance(_gradientTolerance),
+    mMaxAttempts(_maxAttempts),
+    mMaxOuterIterations(_maxOuterIterations),
+    mInitialPenalty(_initialPenalty),
+    mPenaltyFactor(_penaltyFactor),
+    mMaxPenalty(_maxPenalty)
+{
+  // Do nothing
+}
+
+//==============================================================================
+LbfgsbSolver::Properties::Properties(
+    const Solver::Properties& _solverProperties,
+    const UniqueProperties& _lbfgsbProperties)
+  : Solver::Properties(_solverProperties),
+    UniqueProperties(_lbfgsbProperties)
+{
+  // Do nothing
+}
+
+//==============================================================================
+LbfgsbSolver::LbfgsbSolver(const Properties& _properties)
+  : Solver(_properties),
+    mLbfgsbP(_properties),
+    mLastNumIterations(0),
+    mLastNumEvaluations(0),
+    mNumCorrections(0),
+    mNewestCorrection(0),
+    mPenalty(0.0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+LbfgsbSolver::LbfgsbSolver(std::shared_ptr<Problem> _problem)
+  : Solver(_problem),
+    mLastNumIterations(0),
+    mLastNumEvaluations(0),
+    mNumCorrections(0),
+    mNewestCorrection(0),
+    mPenalty(0.0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+LbfgsbSolver::~LbfgsbSolver()
+{
+  // Do nothing
+}
+
+//==============================================================================
+bool LbfgsbSolver::solve()
+{
+  std::shared_ptr<Problem> problem = mProperties.mProblem;
+  if(nullptr == problem)
+  {
+    dtwarn << "[LbfgsbSolver::solve] Attempting to solve a nullptr problem! "
+           << "We will return false.\n";
+    return false;
+  }
+
+  const size_t dim = problem->getDimension();
+  if(dim == 0)
+  {
+    problem->setOptimalSolution(Eigen::VectorXd());
+    problem->setOptimumValue(0.0);
+    return true;
+  }
+
+  assert(problem->getInitialGuess().size() == static_cast<int>(dim));
+  assert(problem->getLowerBounds().size() == static_cast<int>(dim));
+  assert(problem->getUpperBounds().size() == static_cast<int>(dim));
+
+  allocate();
+
+  const double tol = std::abs(mProperties.mTolerance);
+  const bool hasConstraints = problem->getNumEqConstraints() > 0
+      || problem->getNumIneqConstraints() > 0;
+
+  mLastNumIterations = 0;
+  mLastNumEvaluations = 0;
+
+  bool minimized = false;
+  bool satisfied = false;
+  size_t attemptCount = 0;
+  while(true)
+  {
+    if(attemptCount == 0)
+      mX = problem->getInitialGuess();
+    else
+      mX = problem->getSeed(attemptCount-1);
+
+    mX = mX.cwiseMax(problem->getLowerBounds())
+           .cwiseMin(problem->getUpperBounds());
+
+    mEqMultipliers.setZero();
+    mIneqMultipliers.setZero();
+    mPenalty = mLbfgsbP.mInitialPenalty;
+
+    double lastViolation = std::numeric_limits<double>::infinity();
+    for(size_t i=0; i < std::max<size_t>(mLbfgsbP.mMaxOuterIterations, 1); ++i)
+    {
+      size_t numIterations = 0;
+      minimized = minimizeSubproblem(numIterations);
+
+      const double violation = evalConstraintViolation();
+      satisfied = violation <= tol;
+
+      if((minimized && satisfied) || !hasConstraints)
+        break;
+
+      // Updating the multipliers will not help if the subproblem could not
+      // make any progress at all
+      if(!minimized && numIterations <= 1)
+        break;
+
+      if(mProperties.mNumMaxIterations > 0
+         && mLastNumIterations >= mProperties.mNumMaxIterations)
+        break;
+
+      // Update the multipliers with the first order rule, and stiffen the
+      // penalty if the constraints did not get sufficiently closer to being
+      // satisfied
+      mEqMultipliers += mPenalty * mEqValues;
+      for(int j=0; j < mIneqMultipliers.size(); ++j)
+      {
+        mIneqMultipliers[j] = std::max(
+              0.0, mIneqMultipliers[j] + mPenalty * mIneqValues[j]);
+      }
+
+      if(violation > 0.25 * lastViolation)
+      {
+        mPenalty = std::min(mPenalty * mLbfgsbP.mPenaltyFactor,
+                            mLbfgsbP.mMaxPenalty);
+      }
+      lastViolation = violation;
+    }
+
+    if(minimized && satisfied)
+      break;
+
+    ++attemptCount;
+    if(mLbfgsbP.mMaxAttempts > 0 && attemptCount >= mLbfgsbP.mMaxAttempts)
+      break;
+
+    if(attemptCount-1 >= problem->getSeeds().size())
+      break;
+  }
+
+  problem->setOptimalSolution(mX);
+  if(problem->getObjective())
+    problem->setOptimumValue(problem->getObjective()->eval(mX));
+  else
+    problem->setOptimumValue(0.0);
+
+  return minimized && satisfied;
+}
+
+//==============================================================================
+std::string LbfgsbSolver::getType() const
+{
+  return Type;
+}
+
+//==============================================================================
+std::shared_ptr<Solver> LbfgsbSolver::clone() const
+{
+  return std::make_shared<LbfgsbSolver>(getLbfgsbProperties());
+}
+
+//==============================================================================
+void LbfgsbSolver::setProperties(const Properties& _properties)
+{
+  Solver::setProperties(_properties);
+  setProperties(static_cast<const UniqueProperties&>(_properties));
+}
+
+//==============================================================================
+void LbfgsbSolver::setProperties(const UniqueProperties& _properties)
+{
+  setHistorySize(_properties.mHistorySize);
+  setGradientTolerance(_properties.mGradientTolerance);
+  setMaxAttempts(_properties.mMaxAttempts);
+  setMaxOuterIterations(_properties.mMaxOuterIterations);
+  setInitialPenalty(_properties.mInitialPenalty);
+  setPenaltyFactor(_properties.mPenaltyFactor);
+  setMaxPenalty(_properties.mMaxPenalty);
+}
+
+//==============================================================================
+LbfgsbSolver::Properties LbfgsbSolver::getLbfgsbProperties() const
+{
+  return LbfgsbSolver::Properties(getSolverProperties(), mLbfgsbP);
+}
+
+//==============================================================================
+void LbfgsbSolver::copy(const LbfgsbSolver& _other)
+{
+  if(this == &_other)
+    return;
+
+  setProperties(_other.getLbfgsbProperties());
+}
+
+//==============================================================================
+LbfgsbSolver& LbfgsbSolver::operator=(const LbfgsbSolver& _other)
+{
+  copy(_other);
+  return *this;
+}
+
+//==============================================================================
+void LbfgsbSolver::setHistorySize(size_t _size)
+{
+  mLbfgsbP.mHistorySize = std::max<size_t>(_size, 1);
+}
+
+//==============================================================================
+size_t LbfgsbSolver::getHistorySize() const
+{
+  return mLbfgsbP.mHistorySize;
+}
+
+//==============================================================================
+void LbfgsbSolver::setGradientTolerance(double _tolerance)
+{
+  mLbfgsbP.mGradientTolerance = _tolerance;
+}
+
+//==============================================================================
+double LbfgsbSolver::getGradientTolerance() const
+{
+  return mLbfgsbP.mGradientTolerance;
+}
+
+//==============================================================================
+void LbfgsbSolver::setMaxAttempts(size_t _maxAttempts)
+{
+  mLbfgsbP.mMaxAttempts = _maxAttempts;
+}
+
+//==============================================================================
+size_t LbfgsbSolver::getMaxAttempts() const
+{
+  return mLbfgsbP.mMaxAttempts;
+}
+
+//==============================================================================
+void LbfgsbSolver::setMaxOuterIterations(size_t _maxIterations)
+{
+  mLbfgsbP.mMaxOuterIterations = _maxIterations;
+}
+
+//==============================================================================
+size_t LbfgsbSolver::getMaxOuterIterations() const
+{
+  return mLbfgsbP.mMaxOuterIterations;
+}
+
+//==============================================================================
+void LbfgsbSolver::setInitialPenalty(double _penalty)
+{
+  mLbfgsbP.mInitialPenalty = _penalty;
+}
+
+//==============================================================================
+double LbfgsbSolver::getInitialPenalty() const
+{
+  return mLbfgsbP.mInitialPenalty;
+}
+
+//==============================================================================
+void LbfgsbSolver::setPenaltyFactor(double _factor)
+{
+  mLbfgsbP.mPenaltyFactor = _factor;
+}
+
+//==============================================================================
+double LbfgsbSolver::getPenaltyFactor() const
+{
+  return mLbfgsbP.mPenaltyFactor;
+}
+
+//==============================================================================
+void LbfgsbSolver::setMaxPenalty(double _penalty)
+{
+  mLbfgsbP.mMaxPenalty = _penalty;
+}
+
+//==============================================================================
+double LbfgsbSolver::getMaxPenalty() const
+{
+  return mLbfgsbP.mMaxPenalty;
+}
+
+//==============================================================================
+size_t LbfgsbSolver::getLastNumIterations() const
+{
+  return mLastNumIterations;
+}
+
+//==============================================================================
+size_t LbfgsbSolver::getLastNumEvaluations() const
+{
+  return mLastNumEvaluations;
+}
+
+//==============================================================================
+void LbfgsbSolver::allocate()
+{
+  const std::shared_ptr<Problem>& problem = mProperties.mProblem;
+  const size_t dim = problem->getDimension();
+  const size_t historySize = mLbfgsbP.mHistorySize;
+
+  mX.resize(dim);
+  mGrad.resize(dim);
+  mTrialX.resize(dim);
+  mTrialGrad.resize(dim);
+  mDirection.resize(dim);
+  mConstraintGrad.resize(dim);
+  mFree.resize(dim);
+
+  mS.resize(dim, historySize);
+  mY.resize(dim, historySize);
+  mRho.resize(historySize);
+  mAlpha.resize(historySize);
+  mNumCorrections = 0;
+  mNewestCorrection = 0;
+
+  mEqValues.resize(problem->getNumEqConstraints());
+  mIneqValues.resize(problem->getNumIneqConstraints());
+  mEqMultipliers.resize(problem->getNumEqConstraints());
+  mIneqMultipliers.resize(problem->getNumIneqConstraints());
+}
+
+//==============================================================================
+bool LbfgsbSolver::minimizeSubproblem(size_t& _numIterations)
+{
+  const std::shared_ptr<Problem>& problem = mProperties.mProblem;
+  const Eigen::VectorXd& lower = problem->getLowerBounds();
+  const Eigen::VectorXd& upper = problem->getUpperBounds();
+  const double tol = std::abs(mProperties.mTolerance);
+  const size_t historySize = mLbfgsbP.mHistorySize;
+
+  mNumCorrections = 0;
+  double f = evalLagrangian(mX, mGrad);
+
+  while(true)
+  {
+    // Find the variables that are held on their bounds, and measure the
+    // projected gradient
+    double projectedGradNorm = 0.0;
+    for(int i=0; i < mX.size(); ++i)
+    {
+      const bool held = (mX[i] <= lower[i] && mGrad[i] > 0.0)
+          || (mX[i] >= upper[i] && mGrad[i] < 0.0);
+      mFree[i] = held? 0.0 : 1.0;
+
+      const double projected
+          = math::clip(mX[i] - mGrad[i], lower[i], upper[i]) - mX[i];
+      projectedGradNorm = std::max(projectedGradNorm, std::abs(projected));
+    }
+
+    if(projectedGradNorm <= mLbfgsbP.mGradientTolerance)
+      return true;
+
+    if(mProperties.mNumMaxIterations > 0
+       && mLastNumIterations >= mProperties.mNumMaxIterations)
+      return false;
+
+    ++mLastNumIterations;
+    ++_numIterations;
+
+    computeDirection();
+    double slope = mGrad.dot(mDirection);
+    if(!(slope < 0.0))
+    {
+      // The approximation went bad, so fall back to steepest descent
+      mNumCorrections = 0;
+      computeDirection();
+      slope = mGrad.dot(mDirection);
+      if(!(slope < 0.0))
+        return true;
+    }
+
+    // Without curvature information, limit the length of the first step
+    double step = 1.0;
+    if(mNumCorrections == 0)
+      step = std::min(1.0, 1.0 / mDirection.lpNorm<Eigen::Infinity>());
+
+    // Backtracking line search along the projected path
+    bool accepted = false;
+    double trialF = f;
+    for(size_t i=0; i < MAX_LINE_SEARCH_STEPS; ++i)
+    {
+      mTrialX = (mX + step * mDirection).cwiseMax(lower).cwiseMin(upper);
+      trialF = evalLagrangian(mTrialX, mTrialGrad);
+
+      const double decrease = mGrad.dot(mTrialX - mX);
+      if(trialF <= f + ARMIJO_FACTOR * decrease)
+      {
+        accepted = true;
+        break;
+      }
+
+      step *= BACKTRACKING_FACTOR;
+    }
+
+    if(!accepted)
+    {
+      // Try again without the curvature information before giving up
+      if(mNumCorrections > 0)
+      {
+        mNumCorrections = 0;
+        continue;
+      }
+
+      return false;
+    }
+
+    // Store the new correction pair if it keeps the approximation positive
+    // definite. Otherwise the function is not convex along the step, and the
+    // stored pairs describe a different region, so they are dropped.
+    const double sy = (mTrialX - mX).dot(mTrialGrad - mGrad);
+    const double yy = (mTrialGrad - mGrad).squaredNorm();
+    if(sy > CURVATURE_EPSILON * yy)
+    {
+      const size_t column = mNumCorrections == 0?
+            0 : (mNewestCorrection + 1) % historySize;
+      mS.col(column) = mTrialX - mX;
+      mY.col(column) = mTrialGrad - mGrad;
+      mRho[column] = 1.0 / sy;
+      mNewestCorrection = column;
+      mNumCorrections = std::min(mNumCorrections + 1, historySize);
+    }
+    else
+    {
+      mNumCorrections = 0;
+    }
+
+    const double stepNorm = (mTrialX - mX).norm();
+
+    mX.swap(mTrialX);
+    mGrad.swap(mTrialGrad);
+    f = trialF;
+
+    if(nullptr != mProperties.mOutStream &&
+       mProperties.mIterationsPerPrint > 0 &&
+       mLastNumIterations%mProperties.mIterationsPerPrint == 0)
+    {
+      *mProperties.mOutStream
+          << "[LbfgsbSolver] Progress (iteration #" << mLastNumIterations
+          << ")\n"
+          << "augmented Lagrangian: " << f << " | "
+          << "penalty: " << mPenalty << "\n"
+          << "x: " << mX.transpose() << "\n"
+          << "grad: " << mGrad.transpose() << std::endl;
+    }
+
+    if(stepNorm < tol)
+      return true;
+  }
+}
+
+//==============================================================================
+double LbfgsbSolver::evalLagrangian(const Eigen::VectorXd& _x,
+                                    Eigen::VectorXd& _grad)
+{
+  const std::shared_ptr<Problem>& problem = mProperties.mProblem;
+  const int dim = static_cast<int>(problem->getDimension());
+  Eigen::Map<Eigen::VectorXd> constraintGrad(mConstraintGrad.data(), dim);
+
+  ++mLastNumEvaluations;
+
+  double f = 0.0;
+  _grad.setZero();
+  const FunctionPtr& objective = problem->getObjective();
+  if(objective)
+  {
+    f = objective->eval(_x);
+    objective->evalGradient(_x, Eigen::Map<Eigen::VectorXd>(_grad.data(), dim));
+  }
+
+  for(size_t i=0; i < problem->getNumEqConstraints(); ++i)
+  {
+    const FunctionPtr& constraint = problem->getEqConstraint(i);
+    const double value = constraint->eval(_x);
+    const double multiplier = mEqMultipliers[i] + mPenalty * value;
+    f += mEqMultipliers[i] * value + 0.5 * mPenalty * value * value;
+
+    if(multiplier != 0.0)
+    {
+      mConstraintGrad.setZero();
+      constraint->evalGradient(_x, constraintGrad);
+      _grad += multiplier * mConstraintGrad;
+    }
+  }
+
+  for(size_t i=0; i < problem->getNumIneqConstraints(); ++i)
+  {
+    const FunctionPtr& constraint = problem->getIneqConstraint(i);
+    const double value = constraint->eval(_x);
+    const double multiplier
+        = std::max(0.0, mIneqMultipliers[i] + mPenalty * value);
+    f += (multiplier * multiplier
+          - mIneqMultipliers[i] * mIneqMultipliers[i]) / (2.0 * mPenalty);
+
+    if(multiplier > 0.0)
+    {
+      mConstraintGrad.setZero();
+      constraint->evalGradient(_x, constraintGrad);
+      _grad += multiplier * mConstraintGrad;
+    }
+  }
+
+  return f;
+}
+
+//==============================================================================
+double LbfgsbSolver::evalConstraintViolation()
+{
+  const std::shared_ptr<Problem>& problem = mProperties.mProblem;
+
+  double violation = 0.0;
+  for(size_t i=0; i < problem->getNumEqConstraints(); ++i)
+  {
+    mEqValues[i] = problem->getEqConstraint(i)->eval(mX);
+    violation = std::max(violation, std::abs(mEqValues[i]));
+  }
+
+  // An inequality constraint also counts as violated while its multiplier is
+  // still pushing an inactive constraint, since the solution of the
+  // subproblem is then biased
+  for(size_t i=0; i < problem->getNumIneqConstraints(); ++i)
+  {
+    mIneqValues[i] = problem->getIneqConstraint(i)->eval(mX);
+    violation = std::max(violation, std::abs(std::max(
+        mIneqValues[i], -mIneqMultipliers[i] / mPenalty)));
+  }
+
+  return violation;
+}
+
+//==============================================================================
+void LbfgsbSolver::computeDirection()
+{
+  const size_t historySize = mLbfgsbP.mHistorySize;
+
+  // Two-loop recursion restricted to the free variables
+  mDirection = mGrad.cwiseProduct(mFree);
+
+  size_t column = mNewestCorrection;
+  for(size_t i=0; i < mNumCorrections; ++i)
+  {
+    mAlpha[column] = mRho[column] * mS.col(column).dot(mDirection);
+    mDirection -= mAlpha[column] * mY.col(column).cwiseProduct(mFree);
+    column = (column + historySize - 1) % historySize;
+  }
+
+  if(mNumCorrections > 0)
+  {
+    const double yy = mY.col(mNewestCorrection).squaredNorm();
+    mDirection *= 1.0 / (mRho[mNewestCorrection] * yy);
+  }
+
+  for(size_t i=0; i < mNumCorrections; ++i)
+  {
+    column = (column + 1) % historySize;
+    const double beta = mRho[column] * mY.col(column).dot(mDirection);
+    mDirection += (mAlpha[column] - beta) * mS.col(column).cwiseProduct(mFree);
+  }
+
+  mDirection = -mDirection;
+}
+
+} // namespace optimizer
+} // namespace dart
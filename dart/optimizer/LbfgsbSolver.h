@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_OPTIMIZER_LBFGSBSOLVER_H_
+#define DART_OPTIMIZER_LBFGSBSOLVER_H_
+
+#include "dart/optimizer/Solver.h"
+
+namespace dart {
+namespace optimizer {
+
+/// LbfgsbSolver is a quasi-Newton Solver that is native to DART, so it is
+/// available even when none of the third-party optimization libraries are
+/// installed.
+///
+/// The bounds of the Problem are handled by a projected limited-memory BFGS
+/// method: variables that sit on a bound and whose gradient pushes them outward
+/// are held fixed, the two-loop recursion gives the search direction for the
+/// remaining ones, and a backtracking line search is performed along the
+/// projected path. The equality and inequality constraints of the Problem are
+/// handled by an augmented Lagrangian method whose subproblems are solved with
+/// the bounded L-BFGS method.
+///
+/// All the memory is allocated when solve() starts, so iterations do not
+/// allocate as long as the Functions of the Problem do not.
+class LbfgsbSolver : public Solver
+{
+public:
+
+  static const std::string Type;
+
+  struct UniqueProperties
+  {
+    /// Number of correction pairs that approximate the inverse Hessian
+    size_t mHistorySize;
+
+    /// The Problem is considered minimized when the infinity norm of the
+    /// projected gradient falls below this value
+    double mGradientTolerance;
+
+    /// Number of attempts to make before quitting. The first attempt starts
+    /// from the initial guess of the Problem, and each following attempt starts
+    /// from the next seed provided by the Problem.
+    size_t mMaxAttempts;
+
+    /// Maximum number of multiplier updates of the augmented Lagrangian method
+    size_t mMaxOuterIterations;
+
+    /// Initial weight of the quadratic penalty on the constraints
+    double mInitialPenalty;
+
+    /// Factor that the penalty is multiplied by when the constraint violation
+    /// does not decrease fast enough
+    double mPenaltyFactor;
+
+    /// Largest penalty weight
+    double mMaxPenalty;
+
+    UniqueProperties(
+        size_t _historySize = 8,
+        double _gradientTolerance = 1e-8,
+        size_t _maxAttempts = 1,
+        size_t _maxOuterIterations = 50,
+        double _initialPenalty = 10.0,
+        double _penaltyFactor = 10.0,
+        double _maxPenalty = 1e10);
+  };
+
+  struct Properties : Solver::Properties, UniqueProperties
+  {
+    Properties(
+        const Solver::Properties& _solverProperties = Solver::Properties(),
+        const UniqueProperties& _lbfgsbProperties = UniqueProperties());
+  };
+
+  /// Default constructor
+  explicit LbfgsbSolver(const Properties& _properties = Properties());
+
+  /// Alternative constructor
+  explicit LbfgsbSolver(std::shared_ptr<Problem> _problem);
+
+  /// Destructor
+  virtual ~LbfgsbSolver();
+
+  // Documentation inherited
+  virtual bool solve() override;
+
+  // Documentation inherited
+  virtual std::string getType() const override;
+
+  // Documentation inherited
+  virtual std::shared_ptr<Solver> clone() const override;
+
+  /// Set the Properties of this LbfgsbSolver
+  void setProperties(const Properties& _properties);
+
+  /// Set the Properties of this LbfgsbSolver
+  void setProperties(const UniqueProperties& _properties);
+
+  /// Get the Properties of this LbfgsbSolver
+  Properties getLbfgsbProperties() const;
+
+  /// Copy the Properties of another LbfgsbSolver
+  void copy(const LbfgsbSolver& _other);
+
+  /// Copy the Properties of another LbfgsbSolver
+  LbfgsbSolver& operator=(const LbfgsbSolver& _other);
+
+  /// Set UniqueProperties::mHistorySize
+  void setHistorySize(size_t _size);
+
+  /// Get UniqueProperties::mHistorySize
+  size_t getHistorySize() const;
+
+  /// Set UniqueProperties::mGradientTolerance
+  void setGradientTolerance(double _tolerance);
+
+  /// Get UniqueProperties::mGradientTolerance
+  double getGradientTolerance() const;
+
+  /// Set UniqueProperties::mMaxAttempts
+  void setMaxAttempts(size_t _maxAttempts);
+
+  /// Get UniqueProperties::mMaxAttempts
+  size_t getMaxAttempts() const;
+
+  /// Set UniqueProperties::mMaxOuterIterations
+  void setMaxOuterIterations(size_t _maxIterations);
+
+  /// Get UniqueProperties::mMaxOuterIterations
+  size_t getMaxOuterIterations() const;
+
+  /// Set UniqueProperties::mInitialPenalty
+  void setInitialPenalty(double _penalty);
+
+  /// Get UniqueProperties::mInitialPenalty
+  double getInitialPenalty() const;
+
+  /// Set UniqueProperties::mPenaltyFactor
+  void setPenaltyFactor(double _factor);
+
+  /// Get UniqueProperties::mPenaltyFactor
+  double getPenaltyFactor() const;
+
+  /// Set UniqueProperties::mMaxPenalty
+  void setMaxPenalty(double _penalty);
+
+  /// Get UniqueProperties::mMaxPenalty
+  double getMaxPenalty() const;
+
+  /// Get the total number of L-BFGS iterations used in the last call to
+  /// solve()
+  size_t getLastNumIterations() const;
+
+  /// Get the number of function evaluations used in the last call to solve()
+  size_t getLastNumEvaluations() const;
+
+protected:
+
+  /// Resize the workspace to the dimensions of the Problem
+  void allocate();
+
+  /// Minimize the augmented Lagrangian over the bounds, starting from mX.
+  /// Returns true if it converged.
+  bool minimizeSubproblem(size_t& _numIterations);
+
+  /// Evaluate the augmented Lagrangian and its gradient at _x
+  double evalLagrangian(const Eigen::VectorXd& _x, Eigen::VectorXd& _grad);
+
+  /// Evaluate the constraints at mX, and return the largest violation
+  double evalConstraintViolation();
+
+  /// Compute the search direction mDirection from the gradient mGrad using the
+  /// correction pairs, ignoring the variables that are held on their bounds
+  void computeDirection();
+
+  /// LbfgsbSolver properties
+  UniqueProperties mLbfgsbP;
+
+  /// Number of L-BFGS iterations used in the last call to solve()
+  size_t mLastNumIterations;
+
+  /// Number of function evaluations used in the last call to solve()
+  size_t mLastNumEvaluations;
+
+  /// Current configuration
+  Eigen::VectorXd mX;
+
+  /// Gradient of the augmented Lagrangian at mX
+  Eigen::VectorXd mGrad;
+
+  /// Trial configuration of the line search
+  Eigen::VectorXd mTrialX;
+
+  /// Gradient of the augmented Lagrangian at mTrialX
+  Eigen::VectorXd mTrialGrad;
+
+  /// Search direction
+  Eigen::VectorXd mDirection;
+
+  /// Scratch buffer for the gradients of the constraints
+  Eigen::VectorXd mConstraintGrad;
+
+  /// 1 for the variables that are free to move, 0 for the ones held on a bound
+  Eigen::VectorXd mFree;
+
+  /// Changes of configuration of the correction pairs, one per column
+  Eigen::MatrixXd mS;
+
+  /// Changes of gradient of the correction pairs, one per column
+  Eigen::MatrixXd mY;
+
+  /// Inverse of the dot product of each correction pair
+  Eigen::VectorXd mRho;
+
+  /// Coefficients of the two-loop recursion
+  Eigen::VectorXd mAlpha;
+
+  /// Number of stored correction pairs
+  size_t mNumCorrections;
+
+  /// Column of the newest correction pair
+  size_t mNewestCorrection;
+
+  /// Values of the equality constraints
+  Eigen::VectorXd mEqValues;
+
+  /// Values of the inequality constraints
+  Eigen::VectorXd mIneqValues;
+
+  /// Lagrange multipliers of the equality constraints
+  Eigen::VectorXd mEqMultipliers;
+
+  /// Lagrange multipliers of the inequality constraints
+  Eigen::VectorXd mIneqMultipliers;
+
+  /// Current weight of the quadratic penalty
+  double mPenalty;
+};
+
+} // namespace optimizer
+} // namespace dart
+
+#endif // DART_OPTIMIZER_LBFGSBSOLVER_H_
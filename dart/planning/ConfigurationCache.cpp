@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/planning/ConfigurationCache.h"
+
+#include <cstring>
+
+namespace dart {
+namespace planning {
+
+//==============================================================================
+ConfigurationCache::ConfigurationCache(size_t _maxSize)
+  : mMaxSize(_maxSize),
+    mNumHits(0u),
+    mNumMisses(0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void ConfigurationCache::setMaxSize(size_t _maxSize)
+{
+  mMaxSize = _maxSize;
+  if (mMap.size() > mMaxSize)
+    mMap.clear();
+  if (mSegments.size() > mMaxSize)
+    mSegments.clear();
+}
+
+//==============================================================================
+size_t ConfigurationCache::getMaxSize() const
+{
+  return mMaxSize;
+}
+
+//==============================================================================
+bool ConfigurationCache::lookup(const Eigen::VectorXd& _config,
+                                bool& _isValid) const
+{
+  computeKey(_config, mKey);
+
+  const auto it = mMap.find(mKey);
+  if (it == mMap.end())
+  {
+    ++mNumMisses;
+    return false;
+  }
+
+  ++mNumHits;
+  _isValid = it->second;
+  return true;
+}
+
+//==============================================================================
+void ConfigurationCache::insert(const Eigen::VectorXd& _config, bool _isValid)
+{
+  // A crude but cheap eviction policy: planners revisit recent samples far
+  // more often than old ones, so starting over is fine.
+  if (mMap.size() >= mMaxSize)
+    mMap.clear();
+
+  computeKey(_config, mKey);
+  mMap[mKey] = _isValid;
+}
+
+//==============================================================================
+bool ConfigurationCache::lookupSegment(const Eigen::VectorXd& _config1,
+                                       const Eigen::VectorXd& _config2,
+                                       double _resolution, bool& _isFree) const
+{
+  computeSegmentKey(_config1, _config2, _resolution, mKey);
+
+  const auto it = mSegments.find(mKey);
+  if (it == mSegments.end())
+  {
+    ++mNumMisses;
+    return false;
+  }
+
+  ++mNumHits;
+  _isFree = it->second;
+  return true;
+}
+
+//==============================================================================
+void ConfigurationCache::insertSegment(const Eigen::VectorXd& _config1,
+                                       const Eigen::VectorXd& _config2,
+                                       double _resolution, bool _isFree)
+{
+  if (mSegments.size() >= mMaxSize)
+    mSegments.clear();
+
+  computeSegmentKey(_config1, _config2, _resolution, mKey);
+  mSegments[mKey] = _isFree;
+}
+
+//==============================================================================
+void ConfigurationCache::clear()
+{
+  mMap.clear();
+  mSegments.clear();
+  mNumHits = 0u;
+  mNumMisses = 0u;
+}
+
+//==============================================================================
+size_t ConfigurationCache::getSize() const
+{
+  return mMap.size();
+}
+
+//==============================================================================
+size_t ConfigurationCache::getNumSegments() const
+{
+  return mSegments.size();
+}
+
+//==============================================================================
+size_t ConfigurationCache::getNumHits() const
+{
+  return mNumHits;
+}
+
+//==============================================================================
+size_t ConfigurationCache::getNumMisses() const
+{
+  return mNumMisses;
+}
+
+//==============================================================================
+size_t ConfigurationCache::KeyHash::operator()(const Key& _key) const
+{
+  // FNV-1a style mixing of the coordinates
+  size_t hash = 14695981039346656037ull;
+  for (const uint64_t value : _key)
+  {
+    hash ^= static_cast<size_t>(value);
+    hash *= 1099511628211ull;
+  }
+
+  return hash;
+}
+
+//==============================================================================
+void ConfigurationCache::computeKey(const Eigen::VectorXd& _config,
+                                    Key& _key) const
+{
+  _key.clear();
+  for (int i = 0; i < _config.size(); ++i)
+    appendToKey(_config[i], _key);
+}
+
+//==============================================================================
+void ConfigurationCache::computeSegmentKey(const Eigen::VectorXd& _config1,
+                                           const Eigen::VectorXd& _config2,
+                                           double _resolution,
+                                           Key& _key) const
+{
+  computeKey(_config1, _key);
+  for (int i = 0; i < _config2.size(); ++i)
+    appendToKey(_config2[i], _key);
+  appendToKey(_resolution, _key);
+}
+
+//==============================================================================
+void ConfigurationCache::appendToKey(double _value, Key& _key)
+{
+  // -0.0 and 0.0 would have different keys
+  if (_value == 0.0)
+    _value = 0.0;
+
+  uint64_t bits;
+  std::memcpy(&bits, &_value, sizeof(double));
+  _key.push_back(bits);
+}
+
+}  // namespace planning
+}  // namespace dart
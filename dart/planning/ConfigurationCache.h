@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_PLANNING_CONFIGURATIONCACHE_H_
+#define DART_PLANNING_CONFIGURATIONCACHE_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <Eigen/Core>
+
+namespace dart {
+namespace planning {
+
+/// ConfigurationCache memorizes the outcome of collision checks. The entries
+/// are keyed on the exact configuration, so a lookup only succeeds for a
+/// configuration that has been checked before. Planners revisit exactly the
+/// same configurations often: RRT validates the stored nodes of candidate paths
+/// and the path shortener tries the same shortcuts between waypoints. The
+/// latter are stored as whole segments, keyed on their end points and the
+/// resolution they were checked at, so that a repeated shortcut costs a single
+/// lookup instead of one for each of its intermediate configurations.
+///
+/// The cache knows nothing about the world. It must be cleared whenever the
+/// obstacles change.
+class ConfigurationCache
+{
+public:
+  /// Constructor
+  explicit ConfigurationCache(size_t _maxSize = 1000000u);
+
+  /// Set the maximum number of entries. The configurations and the segments
+  /// are cleared separately when either of them grows beyond this size.
+  void setMaxSize(size_t _maxSize);
+
+  /// Get the maximum number of entries
+  size_t getMaxSize() const;
+
+  /// Look up _config. Returns true and sets _isValid if the same configuration
+  /// has been stored before.
+  bool lookup(const Eigen::VectorXd& _config, bool& _isValid) const;
+
+  /// Store the validity of _config
+  void insert(const Eigen::VectorXd& _config, bool _isValid);
+
+  /// Look up the segment from _config1 to _config2 checked at _resolution.
+  /// Returns true and sets _isFree if the same segment has been stored before.
+  bool lookupSegment(const Eigen::VectorXd& _config1,
+                     const Eigen::VectorXd& _config2,
+                     double _resolution, bool& _isFree) const;
+
+  /// Store whether the segment from _config1 to _config2 is collision-free
+  /// when it is checked at _resolution
+  void insertSegment(const Eigen::VectorXd& _config1,
+                     const Eigen::VectorXd& _config2,
+                     double _resolution, bool _isFree);
+
+  /// Remove all the entries and reset the statistics
+  void clear();
+
+  /// Number of stored configurations
+  size_t getSize() const;
+
+  /// Number of stored segments
+  size_t getNumSegments() const;
+
+  /// Number of successful lookups of configurations and segments since the
+  /// last clear()
+  size_t getNumHits() const;
+
+  /// Number of failed lookups of configurations and segments since the last
+  /// clear()
+  size_t getNumMisses() const;
+
+protected:
+  typedef std::vector<uint64_t> Key;
+
+  struct KeyHash
+  {
+    size_t operator()(const Key& _key) const;
+  };
+
+  /// Copy the bit patterns of the coordinates of _config into _key
+  void computeKey(const Eigen::VectorXd& _config, Key& _key) const;
+
+  /// Copy the bit patterns of the end points and the resolution of a segment
+  /// into _key
+  void computeSegmentKey(const Eigen::VectorXd& _config1,
+                         const Eigen::VectorXd& _config2,
+                         double _resolution, Key& _key) const;
+
+  /// Append the bit pattern of _value to _key
+  static void appendToKey(double _value, Key& _key);
+
+  /// Maximum number of entries
+  size_t mMaxSize;
+
+  /// Validity of the checked configurations
+  std::unordered_map<Key, bool, KeyHash> mMap;
+
+  /// Whether the checked segments are collision-free
+  std::unordered_map<Key, bool, KeyHash> mSegments;
+
+  /// Scratch key reused by lookup() and insert() to avoid allocations
+  mutable Key mKey;
+
+  /// Number of successful lookups
+  mutable size_t mNumHits;
+
+  /// Number of failed lookups
+  mutable size_t mNumMisses;
+};
+
+}  // namespace planning
+}  // namespace dart
+
+#endif  // DART_PLANNING_CONFIGURATIONCACHE_H_
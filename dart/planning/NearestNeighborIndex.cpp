@@ -0,0 +1,521 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/planning/NearestNeighborIndex.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace dart {
+namespace planning {
+
+namespace {
+
+/// Number of points collected before they are merged into a tree
+const size_t BUFFER_SIZE = 32u;
+
+/// Maximum number of points in a leaf of a tree
+const size_t LEAF_SIZE = 8u;
+
+//==============================================================================
+double wrapAngle(double _angle)
+{
+  return _angle - 2.0 * M_PI * std::floor((_angle + M_PI) / (2.0 * M_PI));
+}
+
+//==============================================================================
+double getAngularDistance(double _angle1, double _angle2)
+{
+  return std::abs(std::remainder(_angle1 - _angle2, 2.0 * M_PI));
+}
+
+} // anonymous namespace
+
+//==============================================================================
+NearestNeighborIndex::NearestNeighborIndex(size_t _dim)
+  : mDim(_dim),
+    mNumRemoved(0u),
+    mNumRemovedInTrees(0u),
+    mWeights(Eigen::VectorXd::Ones(_dim)),
+    mCyclic(_dim, 0)
+{
+  mBuffer.reserve(BUFFER_SIZE);
+
+  mQuery.mPoint.resize(_dim);
+  mQuery.mLower.resize(_dim);
+  mQuery.mUpper.resize(_dim);
+  mQuery.mBounds.resize(_dim);
+}
+
+//==============================================================================
+size_t NearestNeighborIndex::getDimension() const
+{
+  return mDim;
+}
+
+//==============================================================================
+void NearestNeighborIndex::setWeights(const Eigen::VectorXd& _weights)
+{
+  assert(static_cast<size_t>(_weights.size()) == mDim);
+  assert((_weights.array() >= 0.0).all());
+  mWeights = _weights;
+  rebuild();
+}
+
+//==============================================================================
+const Eigen::VectorXd& NearestNeighborIndex::getWeights() const
+{
+  return mWeights;
+}
+
+//==============================================================================
+void NearestNeighborIndex::setCyclic(size_t _dim, bool _cyclic)
+{
+  assert(_dim < mDim);
+  if (static_cast<bool>(mCyclic[_dim]) == _cyclic)
+    return;
+
+  mCyclic[_dim] = _cyclic;
+  rebuild();
+}
+
+//==============================================================================
+bool NearestNeighborIndex::isCyclic(size_t _dim) const
+{
+  assert(_dim < mDim);
+  return static_cast<bool>(mCyclic[_dim]);
+}
+
+//==============================================================================
+void NearestNeighborIndex::reserve(size_t _size)
+{
+  mPoints.reserve(_size * mDim);
+  mRemoved.reserve(_size);
+}
+
+//==============================================================================
+size_t NearestNeighborIndex::addPoint(const Eigen::VectorXd& _point)
+{
+  assert(static_cast<size_t>(_point.size()) == mDim);
+
+  const size_t id = mRemoved.size();
+  mPoints.insert(mPoints.end(), _point.data(), _point.data() + mDim);
+  mRemoved.push_back(0);
+
+  mBuffer.push_back(id);
+  if (mBuffer.size() >= BUFFER_SIZE)
+    flushBuffer();
+
+  return id;
+}
+
+//==============================================================================
+void NearestNeighborIndex::removePoint(size_t _id)
+{
+  assert(_id < mRemoved.size());
+  if (mRemoved[_id])
+    return;
+
+  mRemoved[_id] = 1;
+  ++mNumRemoved;
+
+  if (std::find(mBuffer.begin(), mBuffer.end(), _id) != mBuffer.end())
+    return;
+
+  // Compact the forest once most of the points it references are dead
+  ++mNumRemovedInTrees;
+  size_t numPointsInTrees = 0u;
+  for (const Tree& tree : mTrees)
+    numPointsInTrees += tree.mIds.size();
+  if (2u * mNumRemovedInTrees > numPointsInTrees)
+    rebuild();
+}
+
+//==============================================================================
+bool NearestNeighborIndex::isRemoved(size_t _id) const
+{
+  assert(_id < mRemoved.size());
+  return static_cast<bool>(mRemoved[_id]);
+}
+
+//==============================================================================
+Eigen::Map<const Eigen::VectorXd> NearestNeighborIndex::getPoint(
+    size_t _id) const
+{
+  assert(_id < mRemoved.size());
+  return Eigen::Map<const Eigen::VectorXd>(&mPoints[_id * mDim], mDim);
+}
+
+//==============================================================================
+size_t NearestNeighborIndex::getSize() const
+{
+  return mRemoved.size();
+}
+
+//==============================================================================
+size_t NearestNeighborIndex::getNumActivePoints() const
+{
+  return mRemoved.size() - mNumRemoved;
+}
+
+//==============================================================================
+size_t NearestNeighborIndex::getNumTrees() const
+{
+  return mTrees.size();
+}
+
+//==============================================================================
+void NearestNeighborIndex::clear()
+{
+  mPoints.clear();
+  mRemoved.clear();
+  mNumRemoved = 0u;
+  mNumRemovedInTrees = 0u;
+  mBuffer.clear();
+  mTrees.clear();
+}
+
+//==============================================================================
+int NearestNeighborIndex::getNearestNeighbor(const Eigen::VectorXd& _query,
+                                             double* _distance) const
+{
+  assert(static_cast<size_t>(_query.size()) == mDim);
+
+  Query& query = mQuery;
+  for (size_t i = 0u; i < mDim; ++i)
+    query.mPoint[i] = mCyclic[i] ? wrapAngle(_query[i]) : _query[i];
+  query.mBestDistance = std::numeric_limits<double>::infinity();
+  query.mBestId = -1;
+
+  for (const size_t id : mBuffer)
+  {
+    if (mRemoved[id])
+      continue;
+
+    const double distance = computeSquaredDistance(
+          query.mPoint.data(), id, query.mBestDistance);
+    if (distance < query.mBestDistance)
+    {
+      query.mBestDistance = distance;
+      query.mBestId = static_cast<int>(id);
+    }
+  }
+
+  for (const Tree& tree : mTrees)
+  {
+    for (size_t i = 0u; i < mDim; ++i)
+    {
+      if (mCyclic[i])
+      {
+        query.mLower[i] = -M_PI;
+        query.mUpper[i] = M_PI;
+      }
+      else
+      {
+        query.mLower[i] = -std::numeric_limits<double>::infinity();
+        query.mUpper[i] = std::numeric_limits<double>::infinity();
+      }
+    }
+    query.mBounds.setZero();
+
+    searchNode(tree, 0u, 0.0, query);
+  }
+
+  if (_distance)
+    *_distance = std::sqrt(query.mBestDistance);
+
+  return query.mBestId;
+}
+
+//==============================================================================
+double NearestNeighborIndex::getDistance(const Eigen::VectorXd& _p1,
+                                         const Eigen::VectorXd& _p2) const
+{
+  assert(static_cast<size_t>(_p1.size()) == mDim);
+  assert(static_cast<size_t>(_p2.size()) == mDim);
+
+  double distance = 0.0;
+  for (size_t i = 0u; i < mDim; ++i)
+  {
+    const double diff = mCyclic[i] ? getAngularDistance(_p1[i], _p2[i])
+                                   : _p1[i] - _p2[i];
+    distance += mWeights[i] * diff * diff;
+  }
+
+  return std::sqrt(distance);
+}
+
+//==============================================================================
+double NearestNeighborIndex::getCoordinate(size_t _id, size_t _dim) const
+{
+  const double value = mPoints[_id * mDim + _dim];
+  return mCyclic[_dim] ? wrapAngle(value) : value;
+}
+
+//==============================================================================
+double NearestNeighborIndex::computeSquaredDistance(
+    const double* _query, size_t _id, double _bound) const
+{
+  const double* point = &mPoints[_id * mDim];
+
+  double distance = 0.0;
+  for (size_t i = 0u; i < mDim; ++i)
+  {
+    const double diff = mCyclic[i] ? getAngularDistance(_query[i], point[i])
+                                   : _query[i] - point[i];
+    distance += mWeights[i] * diff * diff;
+
+    if (distance >= _bound)
+      break;
+  }
+
+  return distance;
+}
+
+//==============================================================================
+double NearestNeighborIndex::computeIntervalBound(
+    size_t _dim, double _value, double _lower, double _upper) const
+{
+  if (_lower <= _value && _value <= _upper)
+    return 0.0;
+
+  double diff;
+  if (mCyclic[_dim])
+  {
+    // The closest point of an arc that does not contain the value is one of
+    // its end points
+    diff = std::min(getAngularDistance(_value, _lower),
+                    getAngularDistance(_value, _upper));
+  }
+  else
+  {
+    diff = (_value < _lower) ? _lower - _value : _value - _upper;
+  }
+
+  return mWeights[_dim] * diff * diff;
+}
+
+//==============================================================================
+void NearestNeighborIndex::flushBuffer()
+{
+  std::vector<size_t> ids;
+  ids.reserve(mBuffer.size());
+  for (const size_t id : mBuffer)
+  {
+    if (!mRemoved[id])
+      ids.push_back(id);
+  }
+  mBuffer.clear();
+
+  // Merge with all the trees that are not larger than the new one, like
+  // carrying in a binary counter
+  while (!mTrees.empty() && mTrees.back().mIds.size() <= ids.size())
+  {
+    for (const size_t id : mTrees.back().mIds)
+    {
+      if (mRemoved[id])
+        --mNumRemovedInTrees;
+      else
+        ids.push_back(id);
+    }
+    mTrees.pop_back();
+  }
+
+  if (ids.empty())
+    return;
+
+  mTrees.push_back(Tree());
+  buildTree(mTrees.back(), ids);
+}
+
+//==============================================================================
+void NearestNeighborIndex::rebuild()
+{
+  std::vector<size_t> ids;
+  ids.reserve(getNumActivePoints());
+  for (size_t id = 0u; id < mRemoved.size(); ++id)
+  {
+    if (!mRemoved[id])
+      ids.push_back(id);
+  }
+
+  mBuffer.clear();
+  mTrees.clear();
+  mNumRemovedInTrees = 0u;
+
+  if (ids.empty())
+    return;
+
+  mTrees.push_back(Tree());
+  buildTree(mTrees.back(), ids);
+}
+
+//==============================================================================
+void NearestNeighborIndex::buildTree(Tree& _tree, std::vector<size_t>& _ids)
+{
+  _tree.mIds.swap(_ids);
+  _tree.mNodes.clear();
+  _tree.mNodes.reserve(2u * (_tree.mIds.size() / LEAF_SIZE + 1u));
+  buildNode(_tree, 0u, _tree.mIds.size());
+}
+
+//==============================================================================
+size_t NearestNeighborIndex::buildNode(Tree& _tree, size_t _begin, size_t _end)
+{
+  const size_t index = _tree.mNodes.size();
+  _tree.mNodes.push_back(Node());
+
+  Node& node = _tree.mNodes.back();
+  node.mDim = -1;
+  node.mSplit = 0.0;
+  node.mBegin = _begin;
+  node.mEnd = _end;
+  node.mLeft = 0u;
+  node.mRight = 0u;
+
+  if (_end - _begin <= LEAF_SIZE)
+    return index;
+
+  // Split the dimension with the largest weighted spread at the median
+  int splitDim = -1;
+  double maxSpread = 0.0;
+  for (size_t i = 0u; i < mDim; ++i)
+  {
+    double lower = std::numeric_limits<double>::infinity();
+    double upper = -std::numeric_limits<double>::infinity();
+    for (size_t j = _begin; j < _end; ++j)
+    {
+      const double value = getCoordinate(_tree.mIds[j], i);
+      lower = std::min(lower, value);
+      upper = std::max(upper, value);
+    }
+
+    const double spread = mWeights[i] * (upper - lower);
+    if (spread > maxSpread)
+    {
+      maxSpread = spread;
+      splitDim = static_cast<int>(i);
+    }
+  }
+
+  // All the points coincide
+  if (splitDim < 0)
+    return index;
+
+  const size_t mid = _begin + (_end - _begin) / 2u;
+  std::nth_element(_tree.mIds.begin() + _begin, _tree.mIds.begin() + mid,
+                   _tree.mIds.begin() + _end,
+                   [=](size_t _id1, size_t _id2)
+  {
+    return getCoordinate(_id1, splitDim) < getCoordinate(_id2, splitDim);
+  });
+  const double split = getCoordinate(_tree.mIds[mid], splitDim);
+
+  const size_t left = buildNode(_tree, _begin, mid);
+  const size_t right = buildNode(_tree, mid, _end);
+
+  // The reference to the node may have been invalidated by the recursion
+  Node& splitNode = _tree.mNodes[index];
+  splitNode.mDim = splitDim;
+  splitNode.mSplit = split;
+  splitNode.mLeft = left;
+  splitNode.mRight = right;
+
+  return index;
+}
+
+//==============================================================================
+void NearestNeighborIndex::searchNode(const Tree& _tree, size_t _node,
+                                      double _bound, Query& _query) const
+{
+  const Node& node = _tree.mNodes[_node];
+
+  if (node.mDim < 0)
+  {
+    for (size_t i = node.mBegin; i < node.mEnd; ++i)
+    {
+      const size_t id = _tree.mIds[i];
+      if (mRemoved[id])
+        continue;
+
+      const double distance = computeSquaredDistance(
+            _query.mPoint.data(), id, _query.mBestDistance);
+      if (distance < _query.mBestDistance)
+      {
+        _query.mBestDistance = distance;
+        _query.mBestId = static_cast<int>(id);
+      }
+    }
+
+    return;
+  }
+
+  const size_t dim = static_cast<size_t>(node.mDim);
+  const double value = _query.mPoint[dim];
+  const double lower = _query.mLower[dim];
+  const double upper = _query.mUpper[dim];
+  const double oldBound = _query.mBounds[dim];
+
+  const double leftBound = computeIntervalBound(
+        dim, value, lower, std::min(upper, node.mSplit));
+  const double rightBound = computeIntervalBound(
+        dim, value, std::max(lower, node.mSplit), upper);
+
+  const bool leftFirst = value < node.mSplit;
+  for (int i = 0; i < 2; ++i)
+  {
+    const bool left = (i == 0) == leftFirst;
+    const double childBound = left ? leftBound : rightBound;
+    const double bound = _bound - oldBound + childBound;
+    if (bound >= _query.mBestDistance)
+      continue;
+
+    if (left)
+      _query.mUpper[dim] = std::min(upper, node.mSplit);
+    else
+      _query.mLower[dim] = std::max(lower, node.mSplit);
+    _query.mBounds[dim] = childBound;
+
+    searchNode(_tree, left ? node.mLeft : node.mRight, bound, _query);
+
+    _query.mLower[dim] = lower;
+    _query.mUpper[dim] = upper;
+    _query.mBounds[dim] = oldBound;
+  }
+}
+
+}  // namespace planning
+}  // namespace dart
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_PLANNING_NEARESTNEIGHBORINDEX_H_
+#define DART_PLANNING_NEARESTNEIGHBORINDEX_H_
+
+#include <vector>
+#include <Eigen/Core>
+
+namespace dart {
+namespace planning {
+
+/// NearestNeighborIndex is an incremental nearest neighbor structure for
+/// configuration space planners.
+///
+/// The points are kept in a single contiguous array and are indexed by a
+/// forest of static kd-trees whose sizes grow geometrically (the logarithmic
+/// method). New points are first collected in a small buffer that is searched
+/// linearly; when the buffer is full it is merged with the smaller trees into
+/// a new tree. Every point is thus moved O(log n) times and no insertion ever
+/// triggers a rebuild of the whole index.
+///
+/// The distance is a weighted Euclidean distance in which cyclic (SO(2))
+/// dimensions wrap around at +/- pi.
+class NearestNeighborIndex
+{
+public:
+  /// Constructor
+  explicit NearestNeighborIndex(size_t _dim);
+
+  /// Dimension of the points
+  size_t getDimension() const;
+
+  /// Set the weights of the dimensions. This rebuilds the index.
+  void setWeights(const Eigen::VectorXd& _weights);
+
+  /// Get the weights of the dimensions
+  const Eigen::VectorXd& getWeights() const;
+
+  /// Set whether a dimension is an angle that wraps around at +/- pi. This
+  /// rebuilds the index.
+  void setCyclic(size_t _dim, bool _cyclic);
+
+  /// Return whether a dimension is an angle that wraps around at +/- pi
+  bool isCyclic(size_t _dim) const;
+
+  /// Reserve memory for _size points
+  void reserve(size_t _size);
+
+  /// Add a point and return its id. Ids are consecutive, starting from zero.
+  size_t addPoint(const Eigen::VectorXd& _point);
+
+  /// Exclude a point from future queries. Its id stays valid.
+  void removePoint(size_t _id);
+
+  /// Return whether a point has been removed
+  bool isRemoved(size_t _id) const;
+
+  /// Return the point with the given id
+  Eigen::Map<const Eigen::VectorXd> getPoint(size_t _id) const;
+
+  /// Number of points that have been added, including removed ones
+  size_t getSize() const;
+
+  /// Number of points that have not been removed
+  size_t getNumActivePoints() const;
+
+  /// Number of kd-trees in the forest
+  size_t getNumTrees() const;
+
+  /// Remove all the points
+  void clear();
+
+  /// Return the id of the point nearest to _query, or -1 if there is no
+  /// active point. If _distance is not nullptr, it is set to the distance of
+  /// the nearest point.
+  int getNearestNeighbor(const Eigen::VectorXd& _query,
+                         double* _distance = nullptr) const;
+
+  /// Distance between two configurations under the metric of this index
+  double getDistance(const Eigen::VectorXd& _p1,
+                     const Eigen::VectorXd& _p2) const;
+
+protected:
+  struct Node
+  {
+    /// Splitting dimension, or -1 for a leaf
+    int mDim;
+
+    /// Splitting value (in wrapped coordinates)
+    double mSplit;
+
+    /// Range of Tree::mIds covered by this node
+    size_t mBegin;
+    size_t mEnd;
+
+    /// Children in Tree::mNodes
+    size_t mLeft;
+    size_t mRight;
+  };
+
+  struct Tree
+  {
+    /// Ids of the points in this tree, permuted so that every node covers a
+    /// contiguous range
+    std::vector<size_t> mIds;
+
+    /// Nodes of the tree. The root is the first node.
+    std::vector<Node> mNodes;
+  };
+
+  /// Scratch data of a single query
+  struct Query
+  {
+    /// The query point, wrapped
+    Eigen::VectorXd mPoint;
+
+    /// Bounds of the current node
+    Eigen::VectorXd mLower;
+    Eigen::VectorXd mUpper;
+
+    /// Contribution of each dimension to the bound of the current node
+    Eigen::VectorXd mBounds;
+
+    /// Squared distance and id of the best point found so far
+    double mBestDistance;
+    int mBestId;
+  };
+
+  /// Coordinate of a stored point, wrapped into [-pi, pi) if cyclic
+  double getCoordinate(size_t _id, size_t _dim) const;
+
+  /// Squared distance between _query (wrapped) and the stored point _id, or
+  /// a value greater than or equal to _bound if it exceeds _bound
+  double computeSquaredDistance(const double* _query, size_t _id,
+                                double _bound) const;
+
+  /// Squared lower bound of the distance between _value and the interval
+  /// [_lower, _upper] in dimension _dim
+  double computeIntervalBound(size_t _dim, double _value,
+                              double _lower, double _upper) const;
+
+  /// Merge the buffer into the forest
+  void flushBuffer();
+
+  /// Rebuild all the trees, dropping removed points
+  void rebuild();
+
+  /// Build a kd-tree over _ids
+  void buildTree(Tree& _tree, std::vector<size_t>& _ids);
+
+  /// Recursively build the node covering [_begin, _end) of _tree.mIds
+  size_t buildNode(Tree& _tree, size_t _begin, size_t _end);
+
+  /// Recursively search _node of _tree
+  void searchNode(const Tree& _tree, size_t _node, double _bound,
+                  Query& _query) const;
+
+  /// Dimension of the points
+  size_t mDim;
+
+  /// Coordinates of all the points, stored contiguously
+  std::vector<double> mPoints;
+
+  /// Whether each point has been removed
+  std::vector<char> mRemoved;
+
+  /// Number of removed points
+  size_t mNumRemoved;
+
+  /// Number of removed points that are still referenced by trees
+  size_t mNumRemovedInTrees;
+
+  /// Weights of the dimensions
+  Eigen::VectorXd mWeights;
+
+  /// Whether each dimension wraps around at +/- pi
+  std::vector<char> mCyclic;
+
+  /// Points that have not been merged into a tree yet
+  std::vector<size_t> mBuffer;
+
+  /// The forest, ordered by decreasing size
+  std::vector<Tree> mTrees;
+
+  /// Scratch query data reused to avoid allocations
+  mutable Query mQuery;
+};
+
+}  // namespace planning
+}  // namespace dart
+
+#endif  // DART_PLANNING_NEARESTNEIGHBORINDEX_H_
@@ -34,6 +34,7 @@ public:
   double stepSize;        ///< Step size from a node in the tree to the random/goal node
   double goalBias;        ///< Choose btw goal and random value (for goal-biased search)
   size_t maxNodes;        ///< Maximum number of iterations the sampling would continue
+  bool lazy;              ///< Whether the rrts postpone collision checks until a path is found
   simulation::WorldPtr world;  ///< The world that the robot is in (for obstacles and etc.)
 
   // NOTE: It is useful to keep the rrts around after planning for reuse, analysis, and etc.
@@ -43,12 +44,12 @@ public:
 public:
 
   /// The default constructor
-  PathPlanner() : world(nullptr) {}
+  PathPlanner() : lazy(false), world(nullptr) {}
 
   /// The desired constructor - you should use this one.
   PathPlanner(simulation::World& world, bool bidirectional_ = true, bool connect_ = true, double stepSize_ = 0.1,
-    size_t maxNodes_ = 1e6, double goalBias_ = 0.3) : world(&world), bidirectional(bidirectional_),
-    connect(connect_), stepSize(stepSize_), maxNodes(maxNodes_), goalBias(goalBias_) {
+    size_t maxNodes_ = 1e6, double goalBias_ = 0.3, bool lazy_ = false) : world(&world), bidirectional(bidirectional_),
+    connect(connect_), stepSize(stepSize_), maxNodes(maxNodes_), goalBias(goalBias_), lazy(lazy_) {
   }
 
   /// The destructor
@@ -150,6 +151,7 @@ bool PathPlanner<R>::planSingleTreeRrt(dynamics::Skeleton* robot, const std::vec
 
   // Initialize the RRT
   start_rrt = new R (world, robot, dofs, start, stepSize);
+  start_rrt->setLazyCollisionChecking(lazy);
 
   // Expand the tree until the goal is reached or the max # nodes is passed
   typename R::StepResult result = R::STEP_PROGRESS;
@@ -169,7 +171,9 @@ bool PathPlanner<R>::planSingleTreeRrt(dynamics::Skeleton* robot, const std::vec
 
     // Check if the goal is reached and create the path, if so
     double gap = start_rrt->getGap(goal);
-    if(gap < stepSize) {
+    // In lazy mode, the path is only a candidate until its nodes are checked. If one of them is in
+    // collision, its subtree is pruned and the search goes on.
+    if(gap < stepSize && (!lazy || start_rrt->validatePath(start_rrt->activeNode))) {
       if(debug) std::cout << "Returning true, reached the goal" << std::endl;
       start_rrt->tracePath(start_rrt->activeNode, path);
       return true;
@@ -198,6 +202,8 @@ bool PathPlanner<R>::planBidirectionalRrt(dynamics::Skeleton* robot, const std::
   // (random or goal) node.
   start_rrt = new R(world, robot, dofs, start, stepSize);
   goal_rrt = new R(world, robot, dofs, goal, stepSize);
+  start_rrt->setLazyCollisionChecking(lazy);
+  goal_rrt->setLazyCollisionChecking(lazy);
   R* rrt1 = start_rrt;
   R* rrt2 = goal_rrt;
 
@@ -227,10 +233,17 @@ bool PathPlanner<R>::planBidirectionalRrt(dynamics::Skeleton* robot, const std::
     // NOTE: connect(x) and tryStep(x) functions return true if rrt2 can add the given node
     // in the tree. In this case, this would imply that the two trees meet.
     bool treesMet = false;
-    const Eigen::VectorXd& rrt2target = *(rrt1->configVector[rrt1->activeNode]);
+    const Eigen::VectorXd rrt2target = rrt1->getConfig(rrt1->activeNode);
     if(connect) treesMet = rrt2->connect(rrt2target);
     else treesMet = (rrt2->tryStep(rrt2target) == R::STEP_REACHED);
 
+    // In lazy mode, both halves of the path need to be validated (and pruned if in collision)
+    if(treesMet && lazy) {
+      const bool startValid = start_rrt->validatePath(start_rrt->activeNode);
+      const bool goalValid = goal_rrt->validatePath(goal_rrt->activeNode);
+      treesMet = startValid && goalValid;
+    }
+
     // Check if the trees have met and create the path, if so.
     if(treesMet) {
       start_rrt->tracePath(start_rrt->activeNode, path);
@@ -243,11 +256,11 @@ bool PathPlanner<R>::planBidirectionalRrt(dynamics::Skeleton* robot, const std::
 
     // Print the gap between the trees in debug mode
     if(debug) {
-      double gap = rrt2->getGap(*(rrt1->configVector[rrt1->activeNode]));
+      double gap = rrt2->getGap(rrt1->getConfig(rrt1->activeNode));
       if(gap < smallestGap) {
         smallestGap = gap;
-        std::cout << "Gap: " << smallestGap << "  Sizes: " << start_rrt->configVector.size()
-          << "/" << goal_rrt->configVector.size() << std::endl;
+        std::cout << "Gap: " << smallestGap << "  Sizes: " << start_rrt->getSize()
+          << "/" << goal_rrt->getSize() << std::endl;
       }
     }
   }
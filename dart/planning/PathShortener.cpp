@@ -1,6 +1,7 @@
 #include "PathShortener.h"
 #include "dart/simulation/World.h"
 #include "RRT.h"
+#include "ConfigurationCache.h"
 #include "dart/collision/CollisionDetector.h"
 #include "dart/dynamics/Skeleton.h"
 #include <ctime>
@@ -76,6 +77,10 @@ bool PathShortener::localPlanner(list<VectorXd> &intermediatePoints, list<Vector
 // true iff collision-free
 // does not check endpoints
 // interemdiatePoints are only touched if collision-free
+//
+// The intermediate configurations are checked in bisection order (midpoint first, then the
+// quarter points, and so on) instead of from one end to the other, so an obstacle anywhere on
+// the segment is found after a few checks and invalid shortcuts are rejected early.
 bool PathShortener::segmentCollisionFree(list<VectorXd> &intermediatePoints, const VectorXd &config1, const VectorXd &config2) {
 	const double length = (config1 - config2).norm();
 	if(length <= stepSize) {
@@ -83,28 +88,64 @@ bool PathShortener::segmentCollisionFree(list<VectorXd> &intermediatePoints, con
 	}
 
 	const int n = (int)(length / stepSize) + 1; // number of intermediate segments
-	int n1 = n / 2;
-	int n2 = n / 2;
-	if(n % 2 == 1) {
-		n2 += 1;
-	}
 
-	VectorXd midpoint = (double)n2 / (double)n * config1 + (double)n1 / (double)n * config2;
-	list<VectorXd> intermediatePoints1, intermediatePoints2;
-  // TODO(JS): What kinematic values should be updated here?
-  robot->setPositions(dofs, midpoint);
-	if(!world->checkCollision() && segmentCollisionFree(intermediatePoints1, config1, midpoint)
-			&& segmentCollisionFree(intermediatePoints2, midpoint, config2))
-	{
-		intermediatePoints.clear();
-		intermediatePoints.splice(intermediatePoints.end(), intermediatePoints1);
-		intermediatePoints.push_back(midpoint);
-		intermediatePoints.splice(intermediatePoints.end(), intermediatePoints2);
-		return true;
+	// Shortcut attempts keep picking the same pairs of waypoints until one of them succeeds
+	bool isFree = true;
+	if(!cache || !cache->lookupSegment(config1, config2, stepSize, isFree)) {
+		// Breadth-first traversal of the segment intervals [lo, hi] in units of length / n
+		vector<pair<int, int> > intervals;
+		intervals.reserve(n);
+		intervals.push_back(make_pair(0, n));
+		VectorXd config(config1.size());
+		for(size_t i = 0; i < intervals.size() && isFree; i++) {
+			const int lo = intervals[i].first;
+			const int hi = intervals[i].second;
+			const int mid = (lo + hi) / 2;
+
+			config = config1 + ((double)mid / (double)n) * (config2 - config1);
+			isFree = !checkCollisions(config);
+
+			if(mid - lo > 1) intervals.push_back(make_pair(lo, mid));
+			if(hi - mid > 1) intervals.push_back(make_pair(mid, hi));
+		}
+
+		if(cache) {
+			cache->insertSegment(config1, config2, stepSize, isFree);
+		}
 	}
-	else {
+
+	if(!isFree) {
 		return false;
 	}
+
+	intermediatePoints.clear();
+	for(int i = 1; i < n; i++) {
+		intermediatePoints.push_back(config1 + ((double)i / (double)n) * (config2 - config1));
+	}
+	return true;
+}
+
+bool PathShortener::checkCollisions(const VectorXd &config) {
+  bool valid;
+  if(cache && cache->lookup(config, valid)) {
+    return !valid;
+  }
+
+  // TODO(JS): What kinematic values should be updated here?
+  robot->setPositions(dofs, config);
+  const bool collision = world->checkCollision();
+  if(cache) {
+    cache->insert(config, !collision);
+  }
+  return collision;
+}
+
+void PathShortener::setConfigurationCache(const std::shared_ptr<ConfigurationCache>& cache) {
+	this->cache = cache;
+}
+
+std::shared_ptr<ConfigurationCache> PathShortener::getConfigurationCache() const {
+	return cache;
 }
 
 } // namespace planning
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <list>
+#include <memory>
 #include <vector>
 #include <Eigen/Core>
 
@@ -13,6 +14,8 @@ namespace dynamics { class Skeleton; }
 
 namespace planning {
 
+class ConfigurationCache;
+
 class PathShortener
 {
 public:
@@ -21,11 +24,24 @@ public:
 	~PathShortener();
 	virtual void shortenPath(std::list<Eigen::VectorXd> &rawPath);
 	bool segmentCollisionFree(std::list<Eigen::VectorXd> &waypoints, const Eigen::VectorXd &config1, const Eigen::VectorXd &config2);
+
+	/// Sets a cache for the results of collision checks. Shortcut attempts revisit the same
+	/// segments many times, and the cache can also be shared with the RRT that produced the
+	/// path. Pass nullptr to disable caching.
+	void setConfigurationCache(const std::shared_ptr<ConfigurationCache>& cache);
+
+	/// Returns the cache for the results of collision checks
+	std::shared_ptr<ConfigurationCache> getConfigurationCache() const;
 protected:
   simulation::WorldPtr world;
   dynamics::SkeletonPtr robot;
 	std::vector<size_t> dofs;
 	double stepSize;
+	std::shared_ptr<ConfigurationCache> cache;
+
+	/// Returns true iff the given configuration is in collision
+	virtual bool checkCollisions(const Eigen::VectorXd &config);
+
 	virtual bool localPlanner(std::list<Eigen::VectorXd> &waypoints, std::list<Eigen::VectorXd>::const_iterator it1, std::list<Eigen::VectorXd>::const_iterator it2);
 };
 
@@ -42,9 +42,11 @@
  */
 
 #include "RRT.h"
+#include "ConfigurationCache.h"
 #include "dart/simulation/World.h"
 #include "dart/dynamics/Skeleton.h"
-#include <flann/flann.hpp>
+#include "dart/dynamics/DegreeOfFreedom.h"
+#include <cmath>
 
 using namespace std;
 using namespace Eigen;
@@ -63,10 +65,12 @@ RRT::RRT(WorldPtr world, SkeletonPtr robot, const std::vector<size_t> &dofs,
 	world(world),
 	robot(robot),
 	dofs(dofs),
-  index(new flann::Index<flann::L2<double> >(flann::KDTreeSingleIndexParams()))
+  index(dofs.size()),
+  lazyCollisionChecking(false)
 {
-	// Reset the random number generator and add the given start configuration to the flann structure
+	// Reset the random number generator and add the given start configuration to the index
   srand(time(nullptr));
+	initializeIndex();
 	addNode(root, -1);
 }
 
@@ -77,10 +81,12 @@ RRT::RRT(WorldPtr world, SkeletonPtr robot, const std::vector<size_t> &dofs, con
 	world(world),
 	robot(robot),
 	dofs(dofs),
-	index(new flann::Index<flann::L2<double> >(flann::KDTreeSingleIndexParams()))
+	index(dofs.size()),
+	lazyCollisionChecking(false)
 {
-	// Reset the random number generator and add the given start configurations to the flann structure
+	// Reset the random number generator and add the given start configurations to the index
   srand(time(nullptr));
+	initializeIndex();
   for(size_t i = 0; i < roots.size(); i++) {
 		addNode(roots[i], -1);
 	}
@@ -102,7 +108,7 @@ bool RRT::connect(const VectorXd &target) {
 	StepResult result = STEP_PROGRESS;
 	while(result == STEP_PROGRESS) {
 		result = tryStepFromNode(target, NNidx);
-		NNidx = configVector.size() - 1;
+		NNidx = getSize() - 1;
 	}
 	return (result == STEP_REACHED);
 }
@@ -123,13 +129,15 @@ RRT::StepResult RRT::tryStep(const VectorXd &qtry) {
 RRT::StepResult RRT::tryStepFromNode(const VectorXd &qtry, int NNidx) {
 
 	// Get the configuration of the nearest neighbor and check if already reached
-	const VectorXd& qnear = *(configVector[NNidx]);
-	if((qtry - qnear).norm() < stepSize) {
+	const VectorXd qnear = getConfig(NNidx);
+	const VectorXd direction = getDifference(qtry, qnear);
+	if(direction.norm() < stepSize) {
 		return STEP_REACHED;
 	}
 
 	// Create the new node: scale the direction vector to stepSize and add to qnear
-	VectorXd qnew = qnear + stepSize * (qtry - qnear).normalized();
+	VectorXd qnew = qnear + stepSize * direction.normalized();
+	wrapConfig(qnew);
 
 	// Check for collision, make changes to the qNew and create intermediate points if necessary
 	// NOTE: This is largely implementation dependent and in default, no points are created.
@@ -147,37 +155,31 @@ RRT::StepResult RRT::tryStepFromNode(const VectorXd &qtry, int NNidx) {
 
 /* ********************************************************************************************* */
 bool RRT::newConfig(list<VectorXd> &/*intermediatePoints*/, VectorXd &qnew, const VectorXd &/*qnear*/, const VectorXd &/*qtarget*/) {
+	// In lazy mode, the check is postponed to validatePath()
+	if(lazyCollisionChecking) return true;
 	return !checkCollisions(qnew);
 }
 
 /* ********************************************************************************************* */
 int RRT::addNode(const VectorXd &qnew, int parentId) {
 	
-	// Update the graph vector
-	VectorXd* temp = new VectorXd(qnew);
-	configVector.push_back(temp);
+	// Update the graph vector and the nearest neighbor index, which stores the configuration. The
+	// cyclic dofs are stored wrapped so that the nearest neighbor distances are correct for them.
+	VectorXd config = qnew;
+	wrapConfig(config);
+	const int id = index.addPoint(config);
 	parentVector.push_back(parentId);
 
-	// Update the underlying flann structure (the kdtree)
-	unsigned int id = configVector.size() - 1;
-	if(id == 0) 
-		index->buildIndex(flann::Matrix<double>((double*)temp->data(), 1, temp->size()));
-	else 
-		index->addPoints(flann::Matrix<double>((double*)temp->data(), 1, temp->size()));
-	
+	// Roots are checked by the caller and nodes are checked by newConfig() unless we are lazy
+	statusVector.push_back((lazyCollisionChecking && parentId != -1) ? NODE_UNCHECKED : NODE_VALID);
+
 	activeNode = id;
 	return id;
 }
 
 /* ********************************************************************************************* */
-inline int RRT::getNearestNeighbor(const VectorXd &qsamp) {
-	int nearest;
-	double distance;
-	const flann::Matrix<double> queryMatrix((double*)qsamp.data(), 1, qsamp.size());
-	flann::Matrix<int> nearestMatrix(&nearest, 1, 1);
-	flann::Matrix<double> distanceMatrix(flann::Matrix<double>(&distance, 1, 1));
-	index->knnSearch(queryMatrix, nearestMatrix, distanceMatrix, 1, 
-		flann::SearchParams(flann::FLANN_CHECKS_UNLIMITED));
+int RRT::getNearestNeighbor(const VectorXd &qsamp) {
+	const int nearest = index.getNearestNeighbor(qsamp);
 	activeNode = nearest;
 	return nearest;
 }
@@ -198,14 +200,15 @@ VectorXd RRT::getRandomConfig() {
 	// configuration vectors (and returns ref to it)
 	VectorXd config(ndim);
 	for (int i = 0; i < ndim; ++i) {
-    config[i] = randomInRange(robot->getPositionLowerLimit(dofs[i]), robot->getPositionUpperLimit(dofs[i]));
+		if(index.isCyclic(i)) config[i] = randomInRange(-M_PI, M_PI);
+    else config[i] = randomInRange(robot->getPositionLowerLimit(dofs[i]), robot->getPositionUpperLimit(dofs[i]));
 	}
 	return config;
 }
 
 /* ********************************************************************************************* */
 double RRT::getGap(const VectorXd &target) {
-	return (target - *(configVector[activeNode])).norm();
+	return getDifference(target, getConfig(activeNode)).norm();
 }
 
 /* ********************************************************************************************* */
@@ -214,21 +217,120 @@ void RRT::tracePath(int node, std::list<VectorXd> &path, bool reverse) {
 	// Keep following the "linked list" in the given direction
 	int x = node;
 	while(x != -1) {
-		if(!reverse) path.push_front(*(configVector[x]));	
-		else path.push_back(*(configVector[x]));
+		if(!reverse) path.push_front(getConfig(x));
+		else path.push_back(getConfig(x));
 		x = parentVector[x];
 	}
 }
 
 /* ********************************************************************************************* */
 bool RRT::checkCollisions(const VectorXd &c) {
+	bool valid;
+	if(cache && cache->lookup(c, valid)) return !valid;
+
   robot->setPositions(dofs, c);
-	return world->checkCollision();
+	const bool collision = world->checkCollision();
+	if(cache) cache->insert(c, !collision);
+	return collision;
 }
 
 /* ********************************************************************************************* */
 size_t RRT::getSize() {
-	return configVector.size();
+	return index.getSize();
+}
+
+/* ********************************************************************************************* */
+Eigen::Map<const VectorXd> RRT::getConfig(int node) const {
+	return index.getPoint(node);
+}
+
+/* ********************************************************************************************* */
+NearestNeighborIndex& RRT::getNearestNeighborIndex() {
+	return index;
+}
+
+/* ********************************************************************************************* */
+const NearestNeighborIndex& RRT::getNearestNeighborIndex() const {
+	return index;
+}
+
+/* ********************************************************************************************* */
+void RRT::initializeIndex() {
+	for(int i = 0; i < ndim; ++i)
+		index.setCyclic(i, robot->getDof(dofs[i])->isCyclic());
+}
+
+/* ********************************************************************************************* */
+VectorXd RRT::getDifference(const VectorXd &q1, const VectorXd &q2) const {
+	VectorXd diff = q1 - q2;
+	for(int i = 0; i < ndim; ++i) {
+		if(index.isCyclic(i)) diff[i] = std::remainder(diff[i], 2.0 * M_PI);
+	}
+	return diff;
+}
+
+/* ********************************************************************************************* */
+void RRT::wrapConfig(VectorXd &config) const {
+	for(int i = 0; i < ndim; ++i) {
+		if(index.isCyclic(i)) config[i] = std::remainder(config[i], 2.0 * M_PI);
+	}
+}
+
+/* ********************************************************************************************* */
+void RRT::setLazyCollisionChecking(bool lazy) {
+	lazyCollisionChecking = lazy;
+}
+
+/* ********************************************************************************************* */
+bool RRT::getLazyCollisionChecking() const {
+	return lazyCollisionChecking;
+}
+
+/* ********************************************************************************************* */
+bool RRT::validatePath(int node) {
+
+	// Collect the nodes on the path so that they can be checked starting from the root: a node
+	// close to the root that is in collision invalidates the largest subtree.
+	vector<int> pathNodes;
+	for(int x = node; x != -1; x = parentVector[x]) {
+		if(statusVector[x] == NODE_INVALID) return false;
+		pathNodes.push_back(x);
+	}
+
+	for(vector<int>::reverse_iterator it = pathNodes.rbegin(); it != pathNodes.rend(); ++it) {
+		if(statusVector[*it] != NODE_UNCHECKED) continue;
+		if(checkCollisions(getConfig(*it))) {
+			invalidateSubtree(*it);
+			return false;
+		}
+		statusVector[*it] = NODE_VALID;
+	}
+	return true;
+}
+
+/* ********************************************************************************************* */
+void RRT::invalidateSubtree(int node) {
+
+	// Children are always added after their parents, so a single forward sweep finds the subtree
+	statusVector[node] = NODE_INVALID;
+	index.removePoint(node);
+	for(size_t i = node + 1; i < getSize(); ++i) {
+		const int parent = parentVector[i];
+		if(parent != -1 && statusVector[parent] == NODE_INVALID && statusVector[i] != NODE_INVALID) {
+			statusVector[i] = NODE_INVALID;
+			index.removePoint(i);
+		}
+	}
+}
+
+/* ********************************************************************************************* */
+void RRT::setConfigurationCache(const std::shared_ptr<ConfigurationCache>& cache) {
+	this->cache = cache;
+}
+
+/* ********************************************************************************************* */
+std::shared_ptr<ConfigurationCache> RRT::getConfigurationCache() const {
+	return cache;
 }
 
 } // namespace planning
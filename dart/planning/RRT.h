@@ -45,15 +45,12 @@
 
 #include <vector>
 #include <list>
+#include <memory>
 #include <Eigen/Core>
 
 #include "dart/dynamics/SmartPointer.h"
 #include "dart/simulation/World.h"
-
-namespace flann {
-	template <class A> class L2;
-	template <class A> class Index;
-}
+#include "dart/planning/NearestNeighborIndex.h"
 
 namespace dart {
 
@@ -62,6 +59,8 @@ namespace dynamics { class Skeleton; }
 
 namespace planning {
 
+class ConfigurationCache;
+
 /// The rapidly-expanding random tree implementation
 class RRT {
 public:
@@ -76,6 +75,13 @@ public:
 		STEP_PROGRESS	 // One node added.
 	} StepResult;
 
+	/// The collision status of a node. Nodes are only left unchecked in lazy mode.
+	typedef enum {
+		NODE_UNCHECKED, // Added without a collision check (lazy mode)
+		NODE_VALID,     // Collision-free
+		NODE_INVALID    // In collision, or a descendant of a node in collision
+	} NodeStatus;
+
 public:
 	// Initialization constants and search variables
 
@@ -83,12 +89,8 @@ public:
 	const double stepSize;	///< Step size at each node creation
 
 	int activeNode;	 								///< Last added node or the nearest node found after a search
-	std::vector<int> parentVector;		///< The ith node in configVector has parent with index pV[i]
-
-	/// All visited configs
-	// NOTE We are using pointers for the VectorXd's because flann copies the pointers for the
-	// data points and we give it the copies made in the heap
-	std::vector<const Eigen::VectorXd*> configVector; 	
+	std::vector<int> parentVector;		///< The ith node has parent with index pV[i]
+	std::vector<NodeStatus> statusVector;	///< The collision status of the ith node
 
 public:
 
@@ -132,12 +134,44 @@ public:
 	double getGap(const Eigen::VectorXd &target);
 
 	/// Traces the path from some node to the initConfig node - useful in creating the full path
-	/// after the goal is reached.
+	/// after the goal is reached. The cyclic dofs of the configurations are wrapped into [-pi, pi],
+	/// so consecutive configurations may differ by about 2 pi in them.
 	void tracePath(int node, std::list<Eigen::VectorXd> &path, bool reverse = false);
 
 	/// Returns the number of nodes in the tree.
 	size_t getSize();
 
+	/// Returns the configuration of the given node. The nodes are stored contiguously by the nearest
+	/// neighbor index.
+	Eigen::Map<const Eigen::VectorXd> getConfig(int node) const;
+
+	/// Returns the nearest neighbor index, e.g., to change the weights of the distance metric. Dofs
+	/// that are cyclic (see DegreeOfFreedom::isCyclic()) are set up to wrap around at +/- pi.
+	NearestNeighborIndex& getNearestNeighborIndex();
+
+	/// Returns the nearest neighbor index
+	const NearestNeighborIndex& getNearestNeighborIndex() const;
+
+	/// Enables or disables lazy collision checking. In lazy mode, new nodes are added to the tree
+	/// without being checked and are only validated when validatePath() is called on a candidate
+	/// solution, which saves the checks for all the branches that never become part of a path.
+	void setLazyCollisionChecking(bool lazy);
+
+	/// Returns whether lazy collision checking is enabled
+	bool getLazyCollisionChecking() const;
+
+	/// Checks the unchecked nodes between the given node and the root, starting from the root. If a
+	/// node is in collision, it is invalidated together with its subtree, the invalidated nodes are
+	/// removed from the nearest neighbor search and false is returned.
+	bool validatePath(int node);
+
+	/// Sets a cache for the results of checkCollisions(). The cache can be shared with other planners
+	/// and path shorteners working in the same (static) world. Pass nullptr to disable caching.
+	void setConfigurationCache(const std::shared_ptr<ConfigurationCache>& cache);
+
+	/// Returns the cache for the results of checkCollisions()
+	std::shared_ptr<ConfigurationCache> getConfigurationCache() const;
+
 	/// Implementation-specific function for checking collisions 
 	virtual bool checkCollisions(const Eigen::VectorXd &c);
 
@@ -150,8 +184,26 @@ protected:
   dynamics::SkeletonPtr robot;        ///< The ID of the robot for which a plan is generated
 	std::vector<size_t> dofs;                    ///< The dofs of the robot the planner can manipulate
 
-	/// The underlying flann data structure for fast nearest neighbor searches 
-	flann::Index<flann::L2<double> >* index;
+	/// The incremental nearest neighbor index, which also stores the configurations of the nodes
+	NearestNeighborIndex index;
+
+	/// Whether new nodes are added without collision checks
+	bool lazyCollisionChecking;
+
+	/// The cache for the results of collision checks (optional)
+	std::shared_ptr<ConfigurationCache> cache;
+
+	/// Marks the given node and all of its descendants as invalid
+	void invalidateSubtree(int node);
+
+	/// Sets up the cyclic dofs of the nearest neighbor index
+	void initializeIndex();
+
+	/// Returns the difference between two configurations, wrapping the cyclic dofs
+	Eigen::VectorXd getDifference(const Eigen::VectorXd &q1, const Eigen::VectorXd &q2) const;
+
+	/// Wraps the cyclic dofs of the given configuration into [-pi, pi]
+	void wrapConfig(Eigen::VectorXd &config) const;
 
 	/// Returns a random value between the given minimum and maximum value
 	double randomInRange(double min, double max);
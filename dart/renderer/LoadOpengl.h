@@ -47,12 +47,20 @@
   #endif
   #include <GL/gl.h>
   #include <GL/glu.h>
+  // Buffer objects are not declared by the OpenGL 1.1 headers of Windows
+  #define DART_RENDERER_HAVE_BUFFER_OBJECTS 0
 #elif defined(__linux__)
+  #ifndef GL_GLEXT_PROTOTYPES
+    #define GL_GLEXT_PROTOTYPES
+  #endif
   #include <GL/gl.h>
+  #include <GL/glext.h>
   #include <GL/glu.h>
+  #define DART_RENDERER_HAVE_BUFFER_OBJECTS 1
 #elif defined(__APPLE__)
   #include <OpenGL/gl.h>
   #include <OpenGL/glu.h>
+  #define DART_RENDERER_HAVE_BUFFER_OBJECTS 1
 #else
   #error "Load OpenGL Error: What's your operating system?"
 #endif
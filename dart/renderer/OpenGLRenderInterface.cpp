@@ -34,10 +34,15 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
+#include <map>
+#include <tuple>
 #include <assimp/cimport.h>
 
 #include "dart/common/Console.h"
+#include "dart/common/StlHelpers.h"
 #include "dart/dynamics/Skeleton.h"
 #include "dart/dynamics/BodyNode.h"
 #include "dart/dynamics/Shape.h"
@@ -46,6 +51,9 @@
 #include "dart/dynamics/CylinderShape.h"
 #include "dart/dynamics/EllipsoidShape.h"
 #include "dart/dynamics/MeshShape.h"
+#include "dart/dynamics/SoftMeshShape.h"
+#include "dart/dynamics/SoftBodyNode.h"
+#include "dart/dynamics/PointMass.h"
 #include "dart/dynamics/LineSegmentShape.h"
 #include "dart/renderer/LoadOpengl.h"
 #include "dart/renderer/OpenGLRenderInterface.h"
@@ -81,7 +89,20 @@ void OpenGLRenderInterface::initialize() {
 }
 
 void OpenGLRenderInterface::destroy() {
+    clearMeshBuffers();
+}
+
+void OpenGLRenderInterface::endFrame() {
+    for(auto it = mMeshBuffers.begin(); it != mMeshBuffers.end(); ) {
+        if(it->second.mFrame != mFrame) {
+            releaseMeshBuffer(it->second);
+            it = mMeshBuffers.erase(it);
+        } else {
+            ++it;
+        }
+    }
 
+    ++mFrame;
 }
 
 void OpenGLRenderInterface::setViewport(int _x,int _y,int _width,int _height) {
@@ -386,6 +407,519 @@ void OpenGLRenderInterface::drawMesh(const Eigen::Vector3d& _scale, const aiScen
     }
 }
 
+//==============================================================================
+OpenGLRenderInterface::MeshBuffer::MeshBuffer()
+  : mScene(nullptr),
+    mVersion(0),
+    mNumVertices(0),
+    mNumIndices(0),
+    mVertexBuffer(0),
+    mIndexBuffer(0),
+    mFrame(0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+OpenGLRenderInterface::MeshBuffer& OpenGLRenderInterface::getMeshBuffer(
+    int _id, bool& _isNew)
+{
+  auto insertion = mMeshBuffers.insert(std::make_pair(_id, MeshBuffer()));
+  _isNew = insertion.second;
+
+  MeshBuffer& buffer = insertion.first->second;
+  buffer.mFrame = mFrame;
+
+  return buffer;
+}
+
+//==============================================================================
+void OpenGLRenderInterface::drawMeshShape(const dynamics::MeshShape* _shape)
+{
+  const aiScene* scene = _shape->getMesh();
+  if(nullptr == scene)
+    return;
+
+  if(!mUseMeshBuffers)
+  {
+    drawMesh(_shape->getScale(), scene);
+    return;
+  }
+
+  bool isNew;
+  MeshBuffer& buffer = getMeshBuffer(_shape->getID(), isNew);
+
+  const size_t version = _shape->getVersion();
+  if(isNew || buffer.mScene != scene || buffer.mVersion != version)
+  {
+    // Changes of the vertex data, e.g. colors, keep the faces, unless the
+    // Shape says that its elements might change
+    bool withFaces = isNew || buffer.mScene != scene
+        || _shape->checkDataVariance(dynamics::Shape::DYNAMIC_ELEMENTS);
+
+    const size_t numVertices = buffer.mNumVertices;
+    fillMeshBuffer(scene, buffer, withFaces);
+    if(!withFaces && buffer.mNumVertices != numVertices)
+    {
+      withFaces = true;
+      fillMeshBuffer(scene, buffer, withFaces);
+    }
+
+    buffer.mScene = scene;
+    buffer.mVersion = version;
+
+    const bool dynamic =
+        !_shape->checkDataVariance(dynamics::Shape::STATIC);
+    uploadMeshBuffer(buffer, withFaces, dynamic);
+  }
+
+  const Eigen::Vector3d& scale = _shape->getScale();
+  glPushMatrix();
+  glScaled(scale[0], scale[1], scale[2]);
+  drawMeshBuffer(scene, buffer);
+  glPopMatrix();
+}
+
+//==============================================================================
+void OpenGLRenderInterface::drawSoftMeshShape(
+    const dynamics::SoftMeshShape* _shape)
+{
+  const dynamics::SoftBodyNode* softBodyNode = _shape->getSoftBodyNode();
+  if(nullptr == softBodyNode)
+    return;
+
+  if(!mUseMeshBuffers)
+  {
+    glEnable(GL_LIGHTING);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+    Eigen::Vector3d pos;
+    Eigen::Vector3d pos_normalized;
+    glBegin(GL_TRIANGLES);
+    for(size_t i = 0; i < softBodyNode->getNumFaces(); ++i)
+    {
+      const Eigen::Vector3i& face = softBodyNode->getFace(i);
+      for(size_t j = 0; j < 3; ++j)
+      {
+        pos = softBodyNode->getPointMass(face[j])->getLocalPosition();
+        pos_normalized = pos.normalized();
+        glNormal3f(pos_normalized(0), pos_normalized(1), pos_normalized(2));
+        glVertex3f(pos(0), pos(1), pos(2));
+      }
+    }
+    glEnd();
+
+    return;
+  }
+
+  bool isNew;
+  MeshBuffer& buffer = getMeshBuffer(_shape->getID(), isNew);
+
+  // The PointMasses move in every step, but the faces stay the same
+  const bool withFaces = isNew
+      || buffer.mNumVertices != softBodyNode->getNumPointMasses()
+      || buffer.mNumIndices != 3 * softBodyNode->getNumFaces();
+
+  fillSoftMeshBuffer(_shape, buffer, withFaces);
+  uploadMeshBuffer(buffer, withFaces, true);
+
+  glPushAttrib(GL_POLYGON_BIT);
+  glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+  drawMeshBuffer(nullptr, buffer);
+  glPopAttrib();
+}
+
+//==============================================================================
+void OpenGLRenderInterface::setMeshBuffersEnabled(bool _enabled)
+{
+  mUseMeshBuffers = _enabled;
+}
+
+//==============================================================================
+bool OpenGLRenderInterface::areMeshBuffersEnabled() const
+{
+  return mUseMeshBuffers;
+}
+
+//==============================================================================
+void OpenGLRenderInterface::clearMeshBuffers()
+{
+  for(auto& entry : mMeshBuffers)
+    releaseMeshBuffer(entry.second);
+
+  mMeshBuffers.clear();
+}
+
+//==============================================================================
+size_t OpenGLRenderInterface::getNumMeshBuffers() const
+{
+  return mMeshBuffers.size();
+}
+
+//==============================================================================
+bool OpenGLRenderInterface::hasBufferObjects()
+{
+#if DART_RENDERER_HAVE_BUFFER_OBJECTS
+  if(mBufferObjectSupport < 0)
+  {
+    // Buffer objects are core since OpenGL 1.5
+    int major = 0;
+    int minor = 0;
+    const char* version =
+        reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    if(version)
+      std::sscanf(version, "%d.%d", &major, &minor);
+
+    mBufferObjectSupport = (major > 1 || (major == 1 && minor >= 5)) ? 1 : 0;
+  }
+
+  return mBufferObjectSupport > 0;
+#else
+  return false;
+#endif
+}
+
+//==============================================================================
+namespace {
+
+/// Key that the faces of a mesh buffer are batched by
+struct BatchKey
+{
+  unsigned int mMaterialIndex;
+  GLenum mMode;
+  bool mHasNormals;
+  bool mHasColors;
+
+  bool operator<(const BatchKey& _other) const
+  {
+    return std::tie(mMaterialIndex, mMode, mHasNormals, mHasColors)
+        < std::tie(_other.mMaterialIndex, _other.mMode,
+                   _other.mHasNormals, _other.mHasColors);
+  }
+};
+
+using BatchMap = std::map<BatchKey, std::vector<GLuint>>;
+
+const size_t VERTEX_SIZE = 10;
+
+//==============================================================================
+void appendVertex(std::vector<GLfloat>& _data,
+                  const Eigen::Vector3f& _position,
+                  const Eigen::Vector3f& _normal,
+                  const GLfloat* _color)
+{
+  _data.insert(_data.end(), _position.data(), _position.data() + 3);
+  _data.insert(_data.end(), _normal.data(), _normal.data() + 3);
+  _data.insert(_data.end(), _color, _color + 4);
+}
+
+//==============================================================================
+void collectMeshes(const aiScene* _scene, const aiNode* _node,
+                   const Eigen::Matrix4f& _parentTransform,
+                   std::vector<GLfloat>& _vertexData, BatchMap* _batches)
+{
+  const aiMatrix4x4& m = _node->mTransformation;
+  Eigen::Matrix4f local;
+  local << m.a1, m.a2, m.a3, m.a4,
+           m.b1, m.b2, m.b3, m.b4,
+           m.c1, m.c2, m.c3, m.c4,
+           m.d1, m.d2, m.d3, m.d4;
+  const Eigen::Matrix4f transform = _parentTransform * local;
+  const Eigen::Matrix3f linear = transform.topLeftCorner<3,3>();
+  const Eigen::Matrix3f normalTransform = linear.inverse().transpose();
+
+  static const GLfloat white[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+
+  for(size_t n = 0; n < _node->mNumMeshes; ++n)
+  {
+    const aiMesh* mesh = _scene->mMeshes[_node->mMeshes[n]];
+    const GLuint first = static_cast<GLuint>(_vertexData.size() / VERTEX_SIZE);
+
+    for(size_t i = 0; i < mesh->mNumVertices; ++i)
+    {
+      const aiVector3D& v = mesh->mVertices[i];
+      const Eigen::Vector3f position =
+          linear * Eigen::Vector3f(v.x, v.y, v.z)
+          + transform.topRightCorner<3,1>();
+
+      Eigen::Vector3f normal = Eigen::Vector3f::UnitZ();
+      if(mesh->mNormals)
+      {
+        const aiVector3D& vn = mesh->mNormals[i];
+        normal = (normalTransform * Eigen::Vector3f(vn.x, vn.y, vn.z))
+            .normalized();
+      }
+
+      const GLfloat* color = mesh->mColors[0]
+          ? reinterpret_cast<const GLfloat*>(&mesh->mColors[0][i]) : white;
+
+      appendVertex(_vertexData, position, normal, color);
+    }
+
+    if(!_batches)
+      continue;
+
+    for(size_t t = 0; t < mesh->mNumFaces; ++t)
+    {
+      const aiFace& face = mesh->mFaces[t];
+
+      BatchKey key;
+      key.mMaterialIndex = mesh->mMaterialIndex;
+      key.mHasNormals = (nullptr != mesh->mNormals);
+      key.mHasColors = (nullptr != mesh->mColors[0]);
+
+      switch(face.mNumIndices)
+      {
+        case 0: continue;
+        case 1: key.mMode = GL_POINTS; break;
+        case 2: key.mMode = GL_LINES; break;
+        default: key.mMode = GL_TRIANGLES; break;
+      }
+
+      std::vector<GLuint>& indices = (*_batches)[key];
+      if(face.mNumIndices <= 3)
+      {
+        for(size_t i = 0; i < face.mNumIndices; ++i)
+          indices.push_back(first + face.mIndices[i]);
+        continue;
+      }
+
+      // Polygons are split into a fan of triangles
+      for(size_t i = 2; i < face.mNumIndices; ++i)
+      {
+        indices.push_back(first + face.mIndices[0]);
+        indices.push_back(first + face.mIndices[i-1]);
+        indices.push_back(first + face.mIndices[i]);
+      }
+    }
+  }
+
+  for(size_t n = 0; n < _node->mNumChildren; ++n)
+    collectMeshes(_scene, _node->mChildren[n], transform, _vertexData,
+                  _batches);
+}
+
+} // anonymous namespace
+
+//==============================================================================
+void OpenGLRenderInterface::fillMeshBuffer(
+    const aiScene* _scene, MeshBuffer& _buffer, bool _withFaces)
+{
+  _buffer.mVertexData.clear();
+
+  BatchMap batches;
+  collectMeshes(_scene, _scene->mRootNode, Eigen::Matrix4f::Identity(),
+                _buffer.mVertexData, _withFaces ? &batches : nullptr);
+  _buffer.mNumVertices = _buffer.mVertexData.size() / VERTEX_SIZE;
+
+  if(!_withFaces)
+    return;
+
+  _buffer.mIndices.clear();
+  _buffer.mBatches.clear();
+  for(const auto& batch : batches)
+  {
+    MeshBatch meshBatch;
+    meshBatch.mMode = batch.first.mMode;
+    meshBatch.mMaterialIndex = batch.first.mMaterialIndex;
+    meshBatch.mHasNormals = batch.first.mHasNormals;
+    meshBatch.mHasColors = batch.first.mHasColors;
+    meshBatch.mFirstIndex = _buffer.mIndices.size();
+    meshBatch.mNumIndices = batch.second.size();
+    _buffer.mBatches.push_back(meshBatch);
+
+    _buffer.mIndices.insert(_buffer.mIndices.end(),
+                            batch.second.begin(), batch.second.end());
+  }
+  _buffer.mNumIndices = _buffer.mIndices.size();
+}
+
+//==============================================================================
+void OpenGLRenderInterface::fillSoftMeshBuffer(
+    const dynamics::SoftMeshShape* _shape, MeshBuffer& _buffer,
+    bool _withFaces)
+{
+  const dynamics::SoftBodyNode* softBodyNode = _shape->getSoftBodyNode();
+  const size_t numPointMasses = softBodyNode->getNumPointMasses();
+
+  static const GLfloat white[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+
+  _buffer.mVertexData.clear();
+  _buffer.mVertexData.reserve(VERTEX_SIZE * numPointMasses);
+  for(size_t i = 0; i < numPointMasses; ++i)
+  {
+    // Like the immediate mode path, use the direction from the center of the
+    // SoftBodyNode as the normal
+    const Eigen::Vector3f position =
+        softBodyNode->getPointMass(i)->getLocalPosition().cast<float>();
+    appendVertex(_buffer.mVertexData, position, position.normalized(), white);
+  }
+  _buffer.mNumVertices = numPointMasses;
+
+  if(!_withFaces)
+    return;
+
+  const size_t numFaces = softBodyNode->getNumFaces();
+  _buffer.mIndices.resize(3 * numFaces);
+  for(size_t i = 0; i < numFaces; ++i)
+  {
+    const Eigen::Vector3i& face = softBodyNode->getFace(i);
+    for(size_t j = 0; j < 3; ++j)
+      _buffer.mIndices[3*i + j] = static_cast<GLuint>(face[j]);
+  }
+  _buffer.mNumIndices = _buffer.mIndices.size();
+
+  MeshBatch batch;
+  batch.mMode = GL_TRIANGLES;
+  batch.mMaterialIndex = static_cast<unsigned int>(-1);
+  batch.mHasNormals = true;
+  batch.mHasColors = false;
+  batch.mFirstIndex = 0;
+  batch.mNumIndices = _buffer.mNumIndices;
+  _buffer.mBatches.assign(1, batch);
+}
+
+//==============================================================================
+void OpenGLRenderInterface::uploadMeshBuffer(
+    MeshBuffer& _buffer, bool _withFaces, bool _dynamic)
+{
+#if DART_RENDERER_HAVE_BUFFER_OBJECTS
+  if(!hasBufferObjects())
+    return;
+
+  const GLenum usage = _dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW;
+
+  // Only the vertex data is uploaded again when the faces stay the same
+  const GLsizeiptr vertexBytes = static_cast<GLsizeiptr>(
+        _buffer.mVertexData.size() * sizeof(GLfloat));
+  if(0 == _buffer.mVertexBuffer)
+    glGenBuffers(1, &_buffer.mVertexBuffer);
+  glBindBuffer(GL_ARRAY_BUFFER, _buffer.mVertexBuffer);
+  GLint currentSize = 0;
+  glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &currentSize);
+  if(currentSize == vertexBytes)
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertexBytes,
+                    _buffer.mVertexData.data());
+  else
+    glBufferData(GL_ARRAY_BUFFER, vertexBytes, _buffer.mVertexData.data(),
+                 usage);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  if(_withFaces)
+  {
+    if(0 == _buffer.mIndexBuffer)
+      glGenBuffers(1, &_buffer.mIndexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffer.mIndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(
+                   _buffer.mIndices.size() * sizeof(GLuint)),
+                 _buffer.mIndices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    std::vector<GLuint>().swap(_buffer.mIndices);
+  }
+
+  // Shapes that are not expected to change do not need a copy in memory
+  if(!_dynamic)
+    std::vector<GLfloat>().swap(_buffer.mVertexData);
+#else
+  DART_UNUSED(_buffer);
+  DART_UNUSED(_withFaces);
+  DART_UNUSED(_dynamic);
+#endif
+}
+
+//==============================================================================
+void OpenGLRenderInterface::drawMeshBuffer(
+    const aiScene* _scene, const MeshBuffer& _buffer)
+{
+  // Offsets into the buffer objects, or pointers into client memory
+  std::uintptr_t vertexBase =
+      reinterpret_cast<std::uintptr_t>(_buffer.mVertexData.data());
+  std::uintptr_t indexBase =
+      reinterpret_cast<std::uintptr_t>(_buffer.mIndices.data());
+
+  glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+
+#if DART_RENDERER_HAVE_BUFFER_OBJECTS
+  if(_buffer.mVertexBuffer && _buffer.mIndexBuffer)
+  {
+    glBindBuffer(GL_ARRAY_BUFFER, _buffer.mVertexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffer.mIndexBuffer);
+    vertexBase = 0;
+    indexBase = 0;
+  }
+#endif
+
+  const GLsizei stride = VERTEX_SIZE * sizeof(GLfloat);
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glVertexPointer(3, GL_FLOAT, stride,
+                  reinterpret_cast<const GLvoid*>(vertexBase));
+  glNormalPointer(GL_FLOAT, stride,
+                  reinterpret_cast<const GLvoid*>(
+                    vertexBase + 3 * sizeof(GLfloat)));
+  glColorPointer(4, GL_FLOAT, stride,
+                 reinterpret_cast<const GLvoid*>(
+                   vertexBase + 6 * sizeof(GLfloat)));
+
+  for(const MeshBatch& batch : _buffer.mBatches)
+  {
+    glPushAttrib(GL_POLYGON_BIT | GL_LIGHTING_BIT | GL_CURRENT_BIT);
+
+    // -1 is being used to indicate no material
+    if(_scene && batch.mMaterialIndex != static_cast<unsigned int>(-1)
+       && batch.mMaterialIndex < _scene->mNumMaterials)
+      applyMaterial(_scene->mMaterials[batch.mMaterialIndex]);
+
+    if(batch.mHasNormals)
+    {
+      glEnable(GL_LIGHTING);
+      glEnableClientState(GL_NORMAL_ARRAY);
+    }
+    else
+    {
+      glDisable(GL_LIGHTING);
+      glDisableClientState(GL_NORMAL_ARRAY);
+    }
+
+    if(batch.mHasColors)
+      glEnableClientState(GL_COLOR_ARRAY);
+    else
+      glDisableClientState(GL_COLOR_ARRAY);
+
+    glDrawElements(batch.mMode, static_cast<GLsizei>(batch.mNumIndices),
+                   GL_UNSIGNED_INT,
+                   reinterpret_cast<const GLvoid*>(
+                     indexBase + batch.mFirstIndex * sizeof(GLuint)));
+
+    glPopAttrib();
+  }
+
+#if DART_RENDERER_HAVE_BUFFER_OBJECTS
+  if(_buffer.mVertexBuffer && _buffer.mIndexBuffer)
+  {
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  }
+#endif
+
+  glPopClientAttrib();
+}
+
+//==============================================================================
+void OpenGLRenderInterface::releaseMeshBuffer(MeshBuffer& _buffer)
+{
+#if DART_RENDERER_HAVE_BUFFER_OBJECTS
+  if(_buffer.mVertexBuffer)
+    glDeleteBuffers(1, &_buffer.mVertexBuffer);
+  if(_buffer.mIndexBuffer)
+    glDeleteBuffers(1, &_buffer.mIndexBuffer);
+#endif
+
+  _buffer.mVertexBuffer = 0;
+  _buffer.mIndexBuffer = 0;
+}
+
 void OpenGLRenderInterface::drawList(GLuint index) {
     glCallList(index);
 }
@@ -581,7 +1115,7 @@ void OpenGLRenderInterface::draw(dynamics::Shape* shape)
       else if(mesh->getDisplayList())
         drawList(mesh->getDisplayList());
       else
-        drawMesh(mesh->getScale(), mesh->getMesh());
+        drawMeshShape(mesh);
 
       break;
     }
@@ -666,7 +1200,7 @@ void OpenGLRenderInterface::draw(dynamics::ShapeFrame* shapeFrame)
       else if(mesh->getDisplayList())
         drawList(mesh->getDisplayList());
       else
-        drawMesh(mesh->getScale(), mesh->getMesh());
+        drawMeshShape(mesh);
 
       break;
     }
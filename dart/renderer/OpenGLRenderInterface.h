@@ -38,6 +38,7 @@
 #define DART_RENDERER_OPENGLRENDERINTERFACE_H
 
 #include <list>
+#include <unordered_map>
 #include <vector>
 #include "RenderInterface.h"
 #include "dart/renderer/LoadOpengl.h"
@@ -55,12 +56,17 @@ namespace renderer {
 class OpenGLRenderInterface : public RenderInterface {
 
 public:
-    OpenGLRenderInterface() : mViewportX(0.0), mViewportY(0.0), mViewportWidth(0.0), mViewportHeight(0.0) {}
+    OpenGLRenderInterface() : mViewportX(0.0), mViewportY(0.0), mViewportWidth(0.0), mViewportHeight(0.0), mUseMeshBuffers(true), mBufferObjectSupport(-1), mFrame(0) {}
     virtual ~OpenGLRenderInterface(){}
 
     virtual void initialize() override;
     virtual void destroy() override;
 
+    /// Release the mesh buffers of the Shapes that were not drawn since the
+    /// previous call, so that the buffers of removed Shapes do not pile up.
+    /// The GL context that they were created in must be current.
+    virtual void endFrame() override;
+
     virtual void setViewport(int _x,int _y,int _width,int _height) override;
     virtual void getViewport(int& _x, int& _y, int& _width, int& _height) const override;
 
@@ -94,6 +100,8 @@ public:
     virtual void drawCube(const Eigen::Vector3d& _size) override;
     virtual void drawCylinder(double _radius, double _height) override;
     virtual void drawMesh(const Eigen::Vector3d& _scale, const aiScene* _mesh) override;
+    virtual void drawMeshShape(const dynamics::MeshShape* _shape) override;
+    virtual void drawSoftMeshShape(const dynamics::SoftMeshShape* _shape) override;
     virtual void drawList(GLuint index) override;
     virtual void drawLineSegments(const std::vector<Eigen::Vector3d>& _vertices,
                                   const Eigen::aligned_vector<Eigen::Vector2i>& _connections) override;
@@ -106,7 +114,78 @@ public:
     virtual void saveToImage(const char* _filename, DecoBufferType _buffType = BT_Back) override;
     virtual void readFrameBuffer(DecoBufferType _buffType, DecoColorChannel _ch, void* _pixels) override;
 
+    /// Draw MeshShapes and SoftMeshShapes from mesh buffers, which are built
+    /// once per Shape and only rebuilt when the version of the Shape changes.
+    /// The faces are batched by material, so a mesh takes one draw call per
+    /// material. The buffers are uploaded into buffer objects where these are
+    /// available, and drawn from client-side vertex arrays otherwise. When
+    /// this is turned off, meshes are drawn in immediate mode. The buffers of
+    /// the Shapes that are not drawn in a frame are released by endFrame().
+    void setMeshBuffersEnabled(bool _enabled);
+
+    /// True iff MeshShapes and SoftMeshShapes are drawn from mesh buffers
+    bool areMeshBuffersEnabled() const;
+
+    /// Release the mesh buffers of all Shapes. The GL context that they were
+    /// created in must be current. destroy() calls this.
+    void clearMeshBuffers();
+
+    /// Number of Shapes that currently have a mesh buffer
+    size_t getNumMeshBuffers() const;
+
 private:
+    /// Faces of a mesh buffer that are drawn with a single call
+    struct MeshBatch {
+        GLenum mMode;
+        unsigned int mMaterialIndex;
+        bool mHasNormals;
+        bool mHasColors;
+        size_t mFirstIndex;
+        size_t mNumIndices;
+    };
+
+    /// Vertices and faces of a Shape, with the transforms of the aiNodes
+    /// already applied to the vertices
+    struct MeshBuffer {
+        MeshBuffer();
+
+        /// Scene and version of the Shape that the data was taken from
+        const aiScene* mScene;
+        size_t mVersion;
+
+        /// Interleaved position (3), normal (3) and color (4) of each vertex.
+        /// This is released once it has been uploaded into a buffer object,
+        /// unless the Shape is expected to change.
+        std::vector<GLfloat> mVertexData;
+        std::vector<GLuint> mIndices;
+        std::vector<MeshBatch> mBatches;
+
+        size_t mNumVertices;
+        size_t mNumIndices;
+
+        /// Buffer objects, or 0 if the data is drawn from client memory
+        GLuint mVertexBuffer;
+        GLuint mIndexBuffer;
+
+        /// Frame in which the buffer was drawn last
+        size_t mFrame;
+    };
+
+    /// Get the mesh buffer of the Shape with _id, creating it if needed, and
+    /// mark it as drawn in the current frame. _isNew is set to true if the
+    /// buffer was created.
+    MeshBuffer& getMeshBuffer(int _id, bool& _isNew);
+
+    /// True iff buffer objects can be used in the current GL context
+    bool hasBufferObjects();
+
+    void fillMeshBuffer(const aiScene* _scene, MeshBuffer& _buffer, bool _withFaces);
+    void fillSoftMeshBuffer(const dynamics::SoftMeshShape* _shape, MeshBuffer& _buffer, bool _withFaces);
+    void uploadMeshBuffer(MeshBuffer& _buffer, bool _withFaces, bool _dynamic);
+    void drawMeshBuffer(const aiScene* _scene, const MeshBuffer& _buffer);
+    void releaseMeshBuffer(MeshBuffer& _buffer);
+
+
     void color4_to_float4(const aiColor4D *c, float f[4]);
     void set_float4(float f[4], float a, float b, float c, float d);
     void applyMaterial(const struct aiMaterial *mtl);
@@ -114,6 +193,17 @@ private:
 
     int mViewportX, mViewportY, mViewportWidth, mViewportHeight;
 
+    bool mUseMeshBuffers;
+
+    /// 1 if buffer objects are supported, 0 if not, -1 if not checked yet
+    int mBufferObjectSupport;
+
+    /// Mesh buffers, keyed by the unique IDs of the Shapes
+    std::unordered_map<int, MeshBuffer> mMeshBuffers;
+
+    /// Number of frames that have been ended
+    size_t mFrame;
+
 public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
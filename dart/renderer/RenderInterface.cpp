@@ -36,6 +36,8 @@
 
 #include "RenderInterface.h"
 
+#include "dart/dynamics/MeshShape.h"
+
 namespace dart {
 namespace renderer {
 
@@ -47,6 +49,10 @@ void RenderInterface::destroy()
 {
 }
 
+void RenderInterface::endFrame()
+{
+}
+
 void RenderInterface::setViewport(int /*_x*/,int /*_y*/,int /*_width*/,int /*_height*/)
 {
 }
@@ -114,6 +120,15 @@ void RenderInterface::drawMesh(const Eigen::Vector3d& /*_scale*/, const aiScene*
 {
 }
 
+void RenderInterface::drawMeshShape(const dynamics::MeshShape* _shape)
+{
+    drawMesh(_shape->getScale(), _shape->getMesh());
+}
+
+void RenderInterface::drawSoftMeshShape(const dynamics::SoftMeshShape* /*_shape*/)
+{
+}
+
 void RenderInterface::drawList(unsigned int /*indeX*/)
 {
 }
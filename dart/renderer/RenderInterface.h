@@ -44,6 +44,12 @@
 #include "dart/math/MathTypes.h"
 
 namespace dart {
+
+namespace dynamics {
+class MeshShape;
+class SoftMeshShape;
+} // namespace dynamics
+
 namespace renderer {
 
 enum DecoBufferType {
@@ -76,6 +82,11 @@ public:
     virtual void initialize();
     virtual void destroy();
 
+    /// Called after everything of a frame has been drawn, so that render
+    /// interfaces can release the data of the objects that were not drawn in
+    /// it. The default implementation does nothing.
+    virtual void endFrame();
+
     virtual void setViewport(int _x,int _y,int _width,int _height);
     virtual void getViewport(int& _x, int& _y,int& _width,int& _height) const;
 
@@ -99,6 +110,17 @@ public:
     virtual void drawCube(const Eigen::Vector3d& _size);
     virtual void drawCylinder(double _radius, double _height);
     virtual void drawMesh(const Eigen::Vector3d& _scale, const aiScene* _mesh);
+
+    /// Draw a MeshShape. Unlike drawMesh(), this gives render interfaces the
+    /// chance to keep the mesh data between frames and to tell from the
+    /// version of the Shape when it has changed. The default implementation
+    /// calls drawMesh().
+    virtual void drawMeshShape(const dynamics::MeshShape* _shape);
+
+    /// Draw the surface of the SoftBodyNode of a SoftMeshShape at the current
+    /// positions of its PointMasses. The default implementation does nothing.
+    virtual void drawSoftMeshShape(const dynamics::SoftMeshShape* _shape);
+
     virtual void drawList(unsigned int index);
     virtual void drawLineSegments(const std::vector<Eigen::Vector3d>& _vertices,
                                   const Eigen::aligned_vector<Eigen::Vector2i>& _connections);
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/simulation/AsyncRecorder.h"
+
+#include <cassert>
+#include <chrono>
+
+#include "dart/simulation/Recording.h"
+
+namespace dart {
+namespace simulation {
+
+//==============================================================================
+AsyncRecorder::AsyncRecorder(Recording* _recording, size_t _capacity,
+                             OverflowPolicy _policy)
+  : mRecording(_recording),
+    mPolicy(_policy),
+    mFrames(_capacity),
+    mHead(0u),
+    mTail(0u),
+    mMaxNumPendingFrames(0u),
+    mNumRecordedFrames(0u),
+    mNumDroppedFrames(0u),
+    mNumBlockedFrames(0u),
+    mStop(false)
+{
+  assert(mRecording);
+  assert(_capacity > 0u);
+
+  mThread = std::thread(&AsyncRecorder::run, this);
+}
+
+//==============================================================================
+AsyncRecorder::~AsyncRecorder()
+{
+  flush();
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStop = true;
+  }
+  mCondition.notify_one();
+  mThread.join();
+}
+
+//==============================================================================
+AsyncRecorder::Frame* AsyncRecorder::beginFrame()
+{
+  const size_t head = mHead.load(std::memory_order_relaxed);
+
+  if (head - mTail.load(std::memory_order_acquire) == mFrames.size())
+  {
+    if (mPolicy == DROP_FRAMES)
+    {
+      ++mNumDroppedFrames;
+      return nullptr;
+    }
+
+    ++mNumBlockedFrames;
+    mCondition.notify_one();
+    while (head - mTail.load(std::memory_order_acquire) == mFrames.size())
+      std::this_thread::yield();
+  }
+
+  return &mFrames[head % mFrames.size()];
+}
+
+//==============================================================================
+void AsyncRecorder::endFrame()
+{
+  const size_t head = mHead.load(std::memory_order_relaxed) + 1u;
+  mHead.store(head, std::memory_order_release);
+
+  const size_t numPending = head - mTail.load(std::memory_order_relaxed);
+  if (numPending > mMaxNumPendingFrames.load(std::memory_order_relaxed))
+    mMaxNumPendingFrames.store(numPending, std::memory_order_relaxed);
+
+  mCondition.notify_one();
+}
+
+//==============================================================================
+void AsyncRecorder::flush()
+{
+  const size_t head = mHead.load(std::memory_order_relaxed);
+  while (mTail.load(std::memory_order_acquire) != head)
+  {
+    mCondition.notify_one();
+    std::this_thread::yield();
+  }
+}
+
+//==============================================================================
+Recording* AsyncRecorder::getRecording() const
+{
+  return mRecording;
+}
+
+//==============================================================================
+void AsyncRecorder::setOverflowPolicy(OverflowPolicy _policy)
+{
+  mPolicy = _policy;
+}
+
+//==============================================================================
+AsyncRecorder::OverflowPolicy AsyncRecorder::getOverflowPolicy() const
+{
+  return mPolicy;
+}
+
+//==============================================================================
+size_t AsyncRecorder::getCapacity() const
+{
+  return mFrames.size();
+}
+
+//==============================================================================
+size_t AsyncRecorder::getNumPendingFrames() const
+{
+  return mHead.load(std::memory_order_relaxed)
+      - mTail.load(std::memory_order_relaxed);
+}
+
+//==============================================================================
+size_t AsyncRecorder::getMaxNumPendingFrames() const
+{
+  return mMaxNumPendingFrames.load(std::memory_order_relaxed);
+}
+
+//==============================================================================
+size_t AsyncRecorder::getNumRecordedFrames() const
+{
+  return mNumRecordedFrames.load(std::memory_order_relaxed);
+}
+
+//==============================================================================
+size_t AsyncRecorder::getNumDroppedFrames() const
+{
+  return mNumDroppedFrames.load(std::memory_order_relaxed);
+}
+
+//==============================================================================
+size_t AsyncRecorder::getNumBlockedFrames() const
+{
+  return mNumBlockedFrames.load(std::memory_order_relaxed);
+}
+
+//==============================================================================
+void AsyncRecorder::resetStatistics()
+{
+  mMaxNumPendingFrames = 0u;
+  mNumRecordedFrames = 0u;
+  mNumDroppedFrames = 0u;
+  mNumBlockedFrames = 0u;
+}
+
+//==============================================================================
+void AsyncRecorder::run()
+{
+  while (true)
+  {
+    const size_t tail = mTail.load(std::memory_order_relaxed);
+
+    if (tail == mHead.load(std::memory_order_acquire))
+    {
+      if (mStop)
+        return;
+
+      // The producer never takes the mutex, so a notification can be missed.
+      // The timeout bounds the delay in that case.
+      std::unique_lock<std::mutex> lock(mMutex);
+      mCondition.wait_for(lock, std::chrono::milliseconds(1), [&]() {
+        return mStop || tail != mHead.load(std::memory_order_acquire);
+      });
+      continue;
+    }
+
+    const Frame& frame = mFrames[tail % mFrames.size()];
+    mRecording->addState(frame.mPositions.data(), frame.mContacts.data(),
+                         frame.mContacts.size() / 6);
+
+    ++mNumRecordedFrames;
+    mTail.store(tail + 1u, std::memory_order_release);
+  }
+}
+
+}  // namespace simulation
+}  // namespace dart
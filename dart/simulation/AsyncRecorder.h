@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_SIMULATION_ASYNCRECORDER_H_
+#define DART_SIMULATION_ASYNCRECORDER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dart {
+namespace simulation {
+
+class Recording;
+
+/// \brief class AsyncRecorder
+///
+/// AsyncRecorder moves the work of storing baked frames off the simulation
+/// thread. The simulation thread copies each frame into a slot of a fixed-size
+/// lock-free ring buffer, and a background thread moves the frames into a
+/// Recording, which in turn serializes and compresses them if it has a stream.
+///
+/// There must be a single producer thread. The Recording must not be accessed
+/// by other threads until flush() returns.
+class AsyncRecorder
+{
+public:
+  /// \brief What to do with a new frame when the buffer is full
+  enum OverflowPolicy
+  {
+    /// Discard the new frame and count it as dropped
+    DROP_FRAMES,
+
+    /// Wait for the background thread to free a slot
+    BLOCK
+  };
+
+  /// \brief A frame in the ring buffer. The vectors keep their capacity from
+  /// one use to the next, so filling a slot does not allocate in steady state.
+  struct Frame
+  {
+    /// Generalized coordinates of all skeletons
+    std::vector<double> mPositions;
+
+    /// Contact points and forces
+    std::vector<double> mContacts;
+  };
+
+  /// \brief Constructor. Frames are written to _recording, which must outlive
+  /// this AsyncRecorder.
+  AsyncRecorder(Recording* _recording, size_t _capacity = 256,
+                OverflowPolicy _policy = DROP_FRAMES);
+
+  /// \brief Destructor. Stores the pending frames before stopping the
+  /// background thread.
+  virtual ~AsyncRecorder();
+
+  AsyncRecorder(const AsyncRecorder&) = delete;
+  AsyncRecorder& operator=(const AsyncRecorder&) = delete;
+
+  /// \brief Get a free slot to fill with a new frame, or nullptr if the buffer
+  /// is full and the policy is DROP_FRAMES. Every successful call must be
+  /// followed by a call to endFrame().
+  Frame* beginFrame();
+
+  /// \brief Publish the frame obtained from beginFrame() to the background
+  /// thread
+  void endFrame();
+
+  /// \brief Block until all the published frames are stored in the Recording
+  void flush();
+
+  /// \brief Get the Recording that the frames are stored in
+  Recording* getRecording() const;
+
+  /// \brief Set what to do with a new frame when the buffer is full
+  void setOverflowPolicy(OverflowPolicy _policy);
+
+  /// \brief Get what is done with a new frame when the buffer is full
+  OverflowPolicy getOverflowPolicy() const;
+
+  /// \brief Get the number of slots of the ring buffer
+  size_t getCapacity() const;
+
+  /// \brief Get the number of frames waiting to be stored
+  size_t getNumPendingFrames() const;
+
+  /// \brief Get the largest number of frames that were waiting at once since
+  /// the last call to resetStatistics(). A value close to getCapacity() means
+  /// that the background thread can barely keep up.
+  size_t getMaxNumPendingFrames() const;
+
+  /// \brief Get the number of frames stored in the Recording
+  size_t getNumRecordedFrames() const;
+
+  /// \brief Get the number of frames discarded because the buffer was full
+  size_t getNumDroppedFrames() const;
+
+  /// \brief Get the number of times the simulation thread had to wait for a
+  /// free slot
+  size_t getNumBlockedFrames() const;
+
+  /// \brief Reset the statistics
+  void resetStatistics();
+
+protected:
+  /// \brief Main loop of the background thread
+  void run();
+
+  /// \brief Recording that the frames are stored in
+  Recording* mRecording;
+
+  /// \brief What to do with a new frame when the buffer is full
+  OverflowPolicy mPolicy;
+
+  /// \brief Slots of the ring buffer
+  std::vector<Frame> mFrames;
+
+  /// \brief Number of frames published by the simulation thread
+  std::atomic<size_t> mHead;
+
+  /// \brief Number of frames stored by the background thread
+  std::atomic<size_t> mTail;
+
+  /// \brief Largest number of pending frames
+  std::atomic<size_t> mMaxNumPendingFrames;
+
+  /// \brief Number of frames stored since the last resetStatistics()
+  std::atomic<size_t> mNumRecordedFrames;
+
+  /// \brief Number of discarded frames
+  std::atomic<size_t> mNumDroppedFrames;
+
+  /// \brief Number of frames that had to wait for a free slot
+  std::atomic<size_t> mNumBlockedFrames;
+
+  /// \brief Whether the background thread should stop
+  std::atomic<bool> mStop;
+
+  /// \brief Used to put the background thread to sleep when there is nothing
+  /// to do. The ring buffer itself is not protected by the mutex.
+  std::mutex mMutex;
+
+  /// \brief Wakes up the background thread
+  std::condition_variable mCondition;
+
+  /// \brief Background thread
+  std::thread mThread;
+};
+
+}  // namespace simulation
+}  // namespace dart
+
+#endif  // DART_SIMULATION_ASYNCRECORDER_H_
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/simulation/RealTimeStepper.h"
+
+#include <cassert>
+#include <chrono>
+
+#include "dart/dynamics/BodyNode.h"
+#include "dart/dynamics/ShapeFrame.h"
+#include "dart/dynamics/SimpleFrame.h"
+#include "dart/dynamics/Skeleton.h"
+#include "dart/simulation/World.h"
+
+namespace dart {
+namespace simulation {
+
+namespace {
+
+/// Set in the middle index of the triple buffer when it holds a snapshot that
+/// the renderer has not picked up yet
+const uint8_t FRESH_SNAPSHOT = 0x4;
+
+/// Mask for the slot number in the middle index
+const uint8_t SLOT_MASK = 0x3;
+
+/// Largest lag behind the real-time schedule, in wall-clock seconds, that the
+/// simulation tries to catch up with
+const double MAX_LAG = 0.1;
+
+}  // anonymous namespace
+
+//==============================================================================
+RealTimeStepper::RealTimeStepper(const std::shared_ptr<World>& _world)
+  : mWorld(_world),
+    mRealTimeFactor(1.0),
+    mBackIndex(0u),
+    mMiddleIndex(1u),
+    mFrontIndex(2u),
+    mHasFrontSnapshot(false),
+    mNumSteps(0u),
+    mNumOverruns(0u),
+    mRunning(false),
+    mStop(false)
+{
+  assert(mWorld);
+}
+
+//==============================================================================
+RealTimeStepper::~RealTimeStepper()
+{
+  stop();
+}
+
+//==============================================================================
+const std::shared_ptr<World>& RealTimeStepper::getWorld() const
+{
+  return mWorld;
+}
+
+//==============================================================================
+void RealTimeStepper::start()
+{
+  if (mRunning)
+    return;
+
+  mNumSteps = 0u;
+  mNumOverruns = 0u;
+  mStop = false;
+
+  // Snapshots of the previous run may refer to ShapeFrames that no longer
+  // exist
+  mMiddleIndex.store(mMiddleIndex.load() & SLOT_MASK);
+  mHasFrontSnapshot = false;
+  publishSnapshot();
+
+  mRunning = true;
+  mThread = std::thread(&RealTimeStepper::run, this);
+}
+
+//==============================================================================
+void RealTimeStepper::stop()
+{
+  if (!mRunning)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStop = true;
+  }
+  mCondition.notify_one();
+  mThread.join();
+  mRunning = false;
+}
+
+//==============================================================================
+bool RealTimeStepper::isRunning() const
+{
+  return mRunning;
+}
+
+//==============================================================================
+void RealTimeStepper::setRealTimeFactor(double _factor)
+{
+  mRealTimeFactor = _factor;
+}
+
+//==============================================================================
+double RealTimeStepper::getRealTimeFactor() const
+{
+  return mRealTimeFactor;
+}
+
+//==============================================================================
+void RealTimeStepper::setStepCallbacks(const std::function<void()>& _preStep,
+                                       const std::function<void()>& _postStep)
+{
+  assert(!mRunning);
+  mPreStep = _preStep;
+  mPostStep = _postStep;
+}
+
+//==============================================================================
+const RealTimeStepper::Snapshot* RealTimeStepper::getLatestSnapshot()
+{
+  if (mMiddleIndex.load(std::memory_order_relaxed) & FRESH_SNAPSHOT)
+  {
+    const uint8_t middle = mMiddleIndex.exchange(
+        mFrontIndex, std::memory_order_acq_rel);
+    mFrontIndex = middle & SLOT_MASK;
+    mHasFrontSnapshot = true;
+  }
+
+  return mHasFrontSnapshot ? &mSnapshots[mFrontIndex] : nullptr;
+}
+
+//==============================================================================
+size_t RealTimeStepper::getNumSteps() const
+{
+  return mNumSteps;
+}
+
+//==============================================================================
+size_t RealTimeStepper::getNumOverruns() const
+{
+  return mNumOverruns;
+}
+
+//==============================================================================
+void RealTimeStepper::run()
+{
+  using Clock = std::chrono::steady_clock;
+
+  // Steps are scheduled relative to the time at which the schedule was last
+  // reset, so that rounding errors do not accumulate
+  Clock::time_point origin = Clock::now();
+  double factor = mRealTimeFactor;
+  size_t numScheduledSteps = 0u;
+
+  while (!mStop)
+  {
+    if (mPreStep)
+      mPreStep();
+    mWorld->step();
+    if (mPostStep)
+      mPostStep();
+
+    ++mNumSteps;
+    publishSnapshot();
+
+    // Restart the schedule whenever the real-time factor changes
+    const double newFactor = mRealTimeFactor;
+    ++numScheduledSteps;
+    if (newFactor != factor)
+    {
+      factor = newFactor;
+      origin = Clock::now();
+      numScheduledSteps = 0u;
+    }
+
+    if (factor <= 0.0)
+      continue;
+
+    const double wallTime = numScheduledSteps * mWorld->getTimeStep() / factor;
+    const Clock::time_point next = origin
+        + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(wallTime));
+
+    const Clock::time_point now = Clock::now();
+    if (next < now)
+    {
+      // Give up on the lost time if the simulation is too slow to catch up
+      if (now - next > std::chrono::duration<double>(MAX_LAG))
+      {
+        ++mNumOverruns;
+        origin = now;
+        numScheduledSteps = 0u;
+      }
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCondition.wait_until(lock, next, [this]() { return mStop.load(); });
+  }
+}
+
+//==============================================================================
+void RealTimeStepper::publishSnapshot()
+{
+  Snapshot& snapshot = mSnapshots[mBackIndex];
+  snapshot.mShapeFrames.clear();
+  snapshot.mTransforms.clear();
+  snapshot.mTime = mWorld->getTime();
+  snapshot.mNumSteps = mNumSteps;
+
+  for (size_t i = 0; i < mWorld->getNumSkeletons(); ++i)
+  {
+    const dynamics::SkeletonPtr& skeleton = mWorld->getSkeleton(i);
+    for (size_t j = 0; j < skeleton->getNumTrees(); ++j)
+      addShapeFrames(skeleton->getRootBodyNode(j), snapshot);
+  }
+
+  for (size_t i = 0; i < mWorld->getNumSimpleFrames(); ++i)
+    addShapeFrames(mWorld->getSimpleFrame(i).get(), snapshot);
+
+  const uint8_t middle = mMiddleIndex.exchange(
+      mBackIndex | FRESH_SNAPSHOT, std::memory_order_acq_rel);
+  mBackIndex = middle & SLOT_MASK;
+}
+
+//==============================================================================
+void RealTimeStepper::addShapeFrames(dynamics::Frame* _frame,
+                                     Snapshot& _snapshot)
+{
+  // Same traversal as the one that osgDart::WorldNode uses to find the
+  // ShapeFrames it renders
+  mQueue.clear();
+  mQueue.push_back(_frame);
+  for (size_t i = 0; i < mQueue.size(); ++i)
+  {
+    dynamics::Frame* frame = mQueue[i];
+    if (frame->isShapeFrame())
+    {
+      dynamics::ShapeFrame* shapeFrame
+          = dynamic_cast<dynamics::ShapeFrame*>(frame);
+      if (shapeFrame)
+      {
+        _snapshot.mShapeFrames.push_back(shapeFrame);
+        _snapshot.mTransforms.push_back(frame->getWorldTransform());
+      }
+    }
+
+    for (dynamics::Frame* child : frame->getChildFrames())
+      mQueue.push_back(child);
+  }
+}
+
+}  // namespace simulation
+}  // namespace dart
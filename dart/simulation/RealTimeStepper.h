@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_SIMULATION_REALTIMESTEPPER_H_
+#define DART_SIMULATION_REALTIMESTEPPER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <Eigen/Geometry>
+
+namespace dart {
+
+namespace dynamics {
+class Frame;
+class ShapeFrame;
+}  // namespace dynamics
+
+namespace simulation {
+
+class World;
+
+/// \brief class RealTimeStepper
+///
+/// RealTimeStepper steps a World on a background thread at a fixed real-time
+/// rate, so that the simulation does not depend on how fast a viewer renders.
+/// One simulation second takes 1 / getRealTimeFactor() wall-clock seconds. If
+/// the simulation cannot keep up, it runs as fast as it can, and the schedule
+/// is reset instead of trying to catch up with the lost time.
+///
+/// After every step, the simulation thread publishes a Snapshot with the world
+/// transforms of all the ShapeFrames of the World, i.e. the ShapeNodes of all
+/// the Skeletons and all the SimpleFrames. The snapshots are exchanged through
+/// a lock-free triple buffer, so neither thread ever waits for the other: the
+/// renderer always gets the latest complete snapshot, and the simulation
+/// overwrites snapshots that have not been picked up.
+///
+/// While the stepper is running, the World belongs to the simulation thread.
+/// Other threads must not modify it, and the structure of the World, i.e. its
+/// Skeletons, BodyNodes, ShapeFrames and SimpleFrames, must not change.
+/// Call stop() first, or change the World from the step callbacks.
+class RealTimeStepper
+{
+public:
+  /// \brief Transforms of the ShapeFrames of the World after a step
+  struct Snapshot
+  {
+    /// ShapeFrames of the World, in breadth-first order from the root
+    /// BodyNodes of the Skeletons followed by the SimpleFrames
+    std::vector<dynamics::ShapeFrame*> mShapeFrames;
+
+    /// World transform of each ShapeFrame
+    std::vector<Eigen::Isometry3d,
+                Eigen::aligned_allocator<Eigen::Isometry3d>> mTransforms;
+
+    /// Simulation time of the snapshot
+    double mTime;
+
+    /// Number of steps taken since start() when the snapshot was taken
+    size_t mNumSteps;
+  };
+
+  /// \brief Constructor. The stepper does not start until start() is called.
+  explicit RealTimeStepper(const std::shared_ptr<World>& _world);
+
+  /// \brief Destructor. Stops the simulation thread.
+  virtual ~RealTimeStepper();
+
+  RealTimeStepper(const RealTimeStepper&) = delete;
+  RealTimeStepper& operator=(const RealTimeStepper&) = delete;
+
+  /// \brief Get the World that is being stepped
+  const std::shared_ptr<World>& getWorld() const;
+
+  /// \brief Start stepping the World on the simulation thread. Publishes a
+  /// snapshot of the current state before the first step.
+  void start();
+
+  /// \brief Stop stepping and wait for the simulation thread to finish the
+  /// current step
+  void stop();
+
+  /// \brief Returns true while the simulation thread is running
+  bool isRunning() const;
+
+  /// \brief Set the ratio of simulation time to wall-clock time. Pass in a
+  /// non-positive value to step as fast as possible.
+  void setRealTimeFactor(double _factor);
+
+  /// \brief Get the ratio of simulation time to wall-clock time
+  double getRealTimeFactor() const;
+
+  /// \brief Set functions to call on the simulation thread before and after
+  /// each step. They can only be changed while the stepper is stopped.
+  void setStepCallbacks(const std::function<void()>& _preStep,
+                        const std::function<void()>& _postStep);
+
+  /// \brief Get the latest published snapshot, or nullptr if none has been
+  /// published yet. The snapshot stays valid until the next call of this
+  /// function. This must only be called from one thread at a time.
+  const Snapshot* getLatestSnapshot();
+
+  /// \brief Get the number of steps taken since start()
+  size_t getNumSteps() const;
+
+  /// \brief Get the number of times the simulation fell behind the real-time
+  /// schedule since start()
+  size_t getNumOverruns() const;
+
+protected:
+  /// \brief Main loop of the simulation thread
+  void run();
+
+  /// \brief Fill the snapshot that the simulation thread owns and publish it
+  void publishSnapshot();
+
+  /// \brief Add the ShapeFrames of the tree rooted at _frame to _snapshot
+  void addShapeFrames(dynamics::Frame* _frame, Snapshot& _snapshot);
+
+  /// \brief World that is being stepped
+  std::shared_ptr<World> mWorld;
+
+  /// \brief Called on the simulation thread before each step
+  std::function<void()> mPreStep;
+
+  /// \brief Called on the simulation thread after each step
+  std::function<void()> mPostStep;
+
+  /// \brief Ratio of simulation time to wall-clock time
+  std::atomic<double> mRealTimeFactor;
+
+  /// \brief Slots of the triple buffer
+  Snapshot mSnapshots[3];
+
+  /// \brief Slot that the simulation thread writes to
+  uint8_t mBackIndex;
+
+  /// \brief Slot that is being exchanged, with FRESH_SNAPSHOT set if it has
+  /// not been picked up yet
+  std::atomic<uint8_t> mMiddleIndex;
+
+  /// \brief Slot that the renderer reads from
+  uint8_t mFrontIndex;
+
+  /// \brief Whether the renderer has ever received a snapshot
+  bool mHasFrontSnapshot;
+
+  /// \brief Queue used by addShapeFrames(), kept to avoid allocations
+  std::vector<dynamics::Frame*> mQueue;
+
+  /// \brief Number of steps taken since start()
+  std::atomic<size_t> mNumSteps;
+
+  /// \brief Number of times the simulation fell behind
+  std::atomic<size_t> mNumOverruns;
+
+  /// \brief Whether the simulation thread is running
+  std::atomic<bool> mRunning;
+
+  /// \brief Whether the simulation thread should stop
+  std::atomic<bool> mStop;
+
+  /// \brief Used to interrupt the simulation thread while it waits for the
+  /// next step. The snapshots are not protected by the mutex.
+  std::mutex mMutex;
+
+  /// \brief Wakes up the simulation thread when it should stop
+  std::condition_variable mCondition;
+
+  /// \brief Simulation thread
+  std::thread mThread;
+};
+
+}  // namespace simulation
+}  // namespace dart
+
+#endif  // DART_SIMULATION_REALTIMESTEPPER_H_
@@ -42,25 +42,39 @@
 
 #include "dart/simulation/Recording.h"
 
+#include <algorithm>
+#include <cassert>
 #include <iostream>
 
+#include "dart/common/Console.h"
 #include "dart/dynamics/Skeleton.h"
+#include "dart/simulation/RecordingFile.h"
 
 namespace dart {
 namespace simulation {
 
+const size_t Recording::DEFAULT_FRAMES_PER_CHUNK;
+
 //==============================================================================
 Recording::Recording(const std::vector<dynamics::SkeletonPtr>& _skeletons)
+  : mNumFrames(0),
+    mFramesPerChunk(DEFAULT_FRAMES_PER_CHUNK),
+    mKeepFrames(true)
 {
   for (size_t i = 0; i < _skeletons.size(); i++)
     mNumGenCoordsForSkeletons.push_back(_skeletons[i]->getNumDofs());
+  updateOffsets();
 }
 
 //==============================================================================
 Recording::Recording(const std::vector<int>& _skelDofs)
+  : mNumFrames(0),
+    mFramesPerChunk(DEFAULT_FRAMES_PER_CHUNK),
+    mKeepFrames(true)
 {
   for (size_t i = 0; i < _skelDofs.size(); i++)
     mNumGenCoordsForSkeletons.push_back(_skelDofs[i]);
+  updateOffsets();
 }
 
 //==============================================================================
@@ -71,7 +85,7 @@ Recording::~Recording()
 //==============================================================================
 int Recording::getNumFrames() const
 {
-  return mBakedStates.size();
+  return mNumFrames;
 }
 
 //==============================================================================
@@ -86,71 +100,236 @@ int Recording::getNumDofs(int _skelIdx) const
   return mNumGenCoordsForSkeletons[_skelIdx];
 }
 
+//==============================================================================
+int Recording::getNumDofs() const
+{
+  return mOffsets.back();
+}
+
 //==============================================================================
 int Recording::getNumContacts(int _frameIdx) const
 {
-  int totalDofs = 0;
-  for (size_t i = 0; i < mNumGenCoordsForSkeletons.size(); i++)
-    totalDofs += mNumGenCoordsForSkeletons[i];
-  return (mBakedStates[_frameIdx].size() - totalDofs) / 6;
+  size_t localIdx;
+  const Chunk& chunk = getChunk(_frameIdx, localIdx);
+  return (chunk.mContactOffsets[localIdx + 1]
+          - chunk.mContactOffsets[localIdx]) / 6;
 }
 
 //==============================================================================
 Eigen::VectorXd Recording::getConfig(int _frameIdx, int _skelIdx) const
 {
-  int index = 0;
-  for (int i = 0; i < _skelIdx; i++)
-    index += mNumGenCoordsForSkeletons[i];
-  return mBakedStates[_frameIdx].segment(index, getNumDofs(_skelIdx));
+  return getConfigs(_frameIdx).segment(mOffsets[_skelIdx],
+                                       getNumDofs(_skelIdx));
+}
+
+//==============================================================================
+Eigen::Map<const Eigen::VectorXd> Recording::getConfigs(int _frameIdx) const
+{
+  size_t localIdx;
+  const Chunk& chunk = getChunk(_frameIdx, localIdx);
+  return Eigen::Map<const Eigen::VectorXd>(
+        chunk.mPositions.data() + localIdx * chunk.mPositions.rows(),
+        chunk.mPositions.rows());
 }
 
 //==============================================================================
 double Recording::getGenCoord(int _frameIdx, int _skelIdx, int _dofIdx) const
 {
-  int index = 0;
-  for (int i = 0; i < _skelIdx; i++)
-    index += mNumGenCoordsForSkeletons[i];
-  return mBakedStates[_frameIdx][index + _dofIdx];
+  size_t localIdx;
+  const Chunk& chunk = getChunk(_frameIdx, localIdx);
+  return chunk.mPositions(mOffsets[_skelIdx] + _dofIdx, localIdx);
 }
 
 //==============================================================================
 Eigen::Vector3d Recording::getContactPoint(int _frameIdx, int _contactIdx) const
 {
-  int totalDofs = 0;
-  for (size_t i = 0; i < mNumGenCoordsForSkeletons.size(); i++)
-    totalDofs += mNumGenCoordsForSkeletons[i];
-  return mBakedStates[_frameIdx].segment(totalDofs + _contactIdx * 6, 3);
+  size_t localIdx;
+  const Chunk& chunk = getChunk(_frameIdx, localIdx);
+  const size_t index = chunk.mContactOffsets[localIdx] + _contactIdx * 6;
+  assert(index + 6 <= chunk.mContactOffsets[localIdx + 1]);
+  return Eigen::Map<const Eigen::Vector3d>(&chunk.mContacts[index]);
 }
 
 //==============================================================================
 Eigen::Vector3d Recording::getContactForce(int _frameIdx, int _contactIdx) const
 {
-  int totalDofs = 0;
-  for (size_t i = 0; i < mNumGenCoordsForSkeletons.size(); i++)
-    totalDofs += mNumGenCoordsForSkeletons[i];
-  return mBakedStates[_frameIdx].segment(totalDofs + _contactIdx * 6 + 3, 3);
+  size_t localIdx;
+  const Chunk& chunk = getChunk(_frameIdx, localIdx);
+  const size_t index = chunk.mContactOffsets[localIdx] + _contactIdx * 6 + 3;
+  assert(index + 3 <= chunk.mContactOffsets[localIdx + 1]);
+  return Eigen::Map<const Eigen::Vector3d>(&chunk.mContacts[index]);
+}
+
+//==============================================================================
+Eigen::VectorXd Recording::getState(int _frameIdx) const
+{
+  size_t localIdx;
+  const Chunk& chunk = getChunk(_frameIdx, localIdx);
+  const size_t numDofs = chunk.mPositions.rows();
+  const size_t begin = chunk.mContactOffsets[localIdx];
+  const size_t end = chunk.mContactOffsets[localIdx + 1];
+
+  Eigen::VectorXd state(numDofs + end - begin);
+  state.head(numDofs) = chunk.mPositions.col(localIdx);
+  for (size_t i = begin; i < end; ++i)
+    state[numDofs + i - begin] = chunk.mContacts[i];
+
+  return state;
 }
 
 //==============================================================================
 void Recording::clear() {
-  mBakedStates.clear();
+  mChunks.clear();
+  mNumFrames = 0;
 }
 
 //==============================================================================
 void Recording::addState(const Eigen::VectorXd& _state)
 {
-  mBakedStates.push_back(_state);
+  const int numDofs = getNumDofs();
+  assert(_state.size() >= numDofs);
+  assert((_state.size() - numDofs) % 6 == 0);
+
+  addState(_state.data(), _state.data() + numDofs,
+           (_state.size() - numDofs) / 6);
+}
+
+//==============================================================================
+void Recording::addState(const double* _positions,
+                         const double* _contacts, size_t _numContacts)
+{
+  if (mStream)
+    mStream->addState(_positions, _contacts, _numContacts);
+
+  if (!mKeepFrames)
+    return;
+
+  const size_t localIdx = mNumFrames % mFramesPerChunk;
+  if (localIdx == 0)
+  {
+    mChunks.push_back(Chunk());
+    mChunks.back().mPositions.resize(getNumDofs(), mFramesPerChunk);
+    mChunks.back().mContactOffsets.reserve(mFramesPerChunk + 1);
+    mChunks.back().mContactOffsets.push_back(0);
+  }
+
+  Chunk& chunk = mChunks.back();
+  const int numDofs = getNumDofs();
+  chunk.mPositions.col(localIdx)
+      = Eigen::Map<const Eigen::VectorXd>(_positions, numDofs);
+  chunk.mContacts.insert(chunk.mContacts.end(),
+                         _contacts, _contacts + 6 * _numContacts);
+  chunk.mContactOffsets.push_back(chunk.mContacts.size());
+
+  ++mNumFrames;
 }
 
 //==============================================================================
 void Recording::updateNumGenCoords(
     const std::vector<dynamics::SkeletonPtr>& _skeletons)
 {
+  const std::vector<int> oldNumGenCoords = mNumGenCoordsForSkeletons;
+
   mNumGenCoordsForSkeletons.clear();
   for (size_t i = 0; i < _skeletons.size(); ++i)
     mNumGenCoordsForSkeletons.push_back(_skeletons[i]->getNumDofs());
+
+  if (mNumGenCoordsForSkeletons == oldNumGenCoords)
+    return;
+
+  const int oldNumDofs = getNumDofs();
+  updateOffsets();
+
+  // The stream has been opened with the old layout
+  if (mStream)
+  {
+    dtwarn << "[Recording::updateNumGenCoords] The skeletons changed while "
+           << "streaming the recording. The stream is closed.\n";
+    mStream.reset();
+    mKeepFrames = true;
+  }
+
+  if (mNumFrames == 0)
+    return;
+
+  // Skeletons that are added to the end keep the recorded frames. The new
+  // skeletons are recorded at their current configuration in those frames.
+  const bool isAppended
+      = oldNumGenCoords.size() <= mNumGenCoordsForSkeletons.size()
+        && std::equal(oldNumGenCoords.begin(), oldNumGenCoords.end(),
+                      mNumGenCoordsForSkeletons.begin());
+  if (!isAppended)
+  {
+    dtwarn << "[Recording::updateNumGenCoords] The skeletons of the "
+           << "recording changed, so the layout of the " << mNumFrames
+           << " recorded frames no longer matches. Dropping them.\n";
+    clear();
+    return;
+  }
+
+  dtwarn << "[Recording::updateNumGenCoords] Skeletons were added after "
+         << mNumFrames << " frames had been recorded. Their current "
+         << "configurations are used for those frames.\n";
+
+  Eigen::VectorXd newPositions(getNumDofs() - oldNumDofs);
+  for (size_t i = oldNumGenCoords.size(); i < _skeletons.size(); ++i)
+  {
+    newPositions.segment(mOffsets[i] - oldNumDofs, getNumDofs(i))
+        = _skeletons[i]->getPositions();
+  }
+
+  for (Chunk& chunk : mChunks)
+  {
+    chunk.mPositions.conservativeResize(getNumDofs(), Eigen::NoChange);
+    chunk.mPositions.bottomRows(newPositions.size()).colwise() = newPositions;
+  }
+}
+
+//==============================================================================
+void Recording::setFramesPerChunk(size_t _framesPerChunk)
+{
+  assert(_framesPerChunk > 0);
+  clear();
+  mFramesPerChunk = _framesPerChunk;
+}
+
+//==============================================================================
+size_t Recording::getFramesPerChunk() const
+{
+  return mFramesPerChunk;
+}
+
+//==============================================================================
+void Recording::setStream(const std::shared_ptr<RecordingWriter>& _writer,
+                          bool _keepFrames)
+{
+  mStream = _writer;
+  mKeepFrames = _keepFrames || !_writer;
+}
+
+//==============================================================================
+std::shared_ptr<RecordingWriter> Recording::getStream() const
+{
+  return mStream;
+}
+
+//==============================================================================
+void Recording::updateOffsets()
+{
+  mOffsets.resize(mNumGenCoordsForSkeletons.size() + 1);
+  mOffsets[0] = 0;
+  for (size_t i = 0; i < mNumGenCoordsForSkeletons.size(); ++i)
+    mOffsets[i + 1] = mOffsets[i] + mNumGenCoordsForSkeletons[i];
+}
+
+//==============================================================================
+const Recording::Chunk& Recording::getChunk(int _frameIdx,
+                                            size_t& _localIdx) const
+{
+  assert(0 <= _frameIdx && static_cast<size_t>(_frameIdx) < mNumFrames);
+  _localIdx = _frameIdx % mFramesPerChunk;
+  return mChunks[_frameIdx / mFramesPerChunk];
 }
 
 }  // namespace simulation
 }  // namespace dart
-
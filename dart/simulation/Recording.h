@@ -43,6 +43,7 @@
 #ifndef DART_SIMULATION_RECORDING_H_
 #define DART_SIMULATION_RECORDING_H_
 
+#include <memory>
 #include <vector>
 
 #include <Eigen/Dense>
@@ -57,10 +58,23 @@ class Skeleton;
 
 namespace simulation {
 
+class RecordingWriter;
+
 /// \brief class Recording
+///
+/// The frames are stored in chunks of contiguous memory instead of one heap
+/// allocation per frame, and the offsets of the skeletons in a frame are
+/// precomputed, so that every frame lookup is O(1).
+///
+/// A Recording can also stream its frames to a binary file through a
+/// RecordingWriter, optionally without keeping them in memory. Such a file can
+/// be played back with a RecordingReader.
 class Recording
 {
 public:
+  /// \brief Default number of frames per chunk
+  static const size_t DEFAULT_FRAMES_PER_CHUNK = 256;
+
   /// \brief Create Recording with a list of skeletons
   explicit Recording(const std::vector<dynamics::SkeletonPtr>& _skeletons);
 
@@ -70,7 +84,7 @@ public:
   /// \brief Destructor
   virtual ~Recording();
 
-  /// \brief Get number of frames
+  /// \brief Get number of frames that are kept in memory
   int getNumFrames() const;
 
   /// \brief Get number of skeletons
@@ -80,6 +94,9 @@ public:
   /// _skelIdx
   int getNumDofs(int _skelIdx) const;
 
+  /// \brief Get the total number of generalized coordinates of all skeletons
+  int getNumDofs() const;
+
   /// \brief Get number of contacts at frame number _frameIdx
   int getNumContacts(int _frameIdx) const;
 
@@ -87,6 +104,10 @@ public:
   /// _frameIdx
   Eigen::VectorXd getConfig(int _frameIdx, int _skelIdx) const;
 
+  /// \brief Get the generalized coordinates of all skeletons at frame number
+  /// _frameIdx, without copying them
+  Eigen::Map<const Eigen::VectorXd> getConfigs(int _frameIdx) const;
+
   /// \brief Get _dofIdx-th single configruation of a skeleton whose index is
   /// _skelIdx at frame number _frameIdx
   double getGenCoord(int _frameIdx, int _skelIdx, int _dofIdx) const;
@@ -99,21 +120,86 @@ public:
   /// _frameIdx
   Eigen::Vector3d getContactForce(int _frameIdx, int _contactIdx) const;
 
+  /// \brief Get the full state (generalized coordinates followed by contact
+  /// points and forces) at frame number _frameIdx, as passed to addState()
+  Eigen::VectorXd getState(int _frameIdx) const;
+
   /// \brief Clear the saved histories
   void clear();  
 
   /// \brief Add state
   void addState(const Eigen::VectorXd& _state);
 
-  /// \brief Update list for number of generalized coordinates
+  /// \brief Add a frame given the generalized coordinates of all skeletons and
+  /// _numContacts contacts, each stored as a point followed by a force
+  void addState(const double* _positions,
+                const double* _contacts, size_t _numContacts);
+
+  /// \brief Update list for number of generalized coordinates. Skeletons that
+  /// are added to the end of the list keep the recorded frames, which record
+  /// the new skeletons at their current configuration. Any other change drops
+  /// the recorded frames with a warning, since their layout would no longer
+  /// match. A stream is closed on any change.
   void updateNumGenCoords(const std::vector<dynamics::SkeletonPtr>& _skeletons);
 
+  /// \brief Set the number of frames per chunk. This clears the recording.
+  void setFramesPerChunk(size_t _framesPerChunk);
+
+  /// \brief Get the number of frames per chunk
+  size_t getFramesPerChunk() const;
+
+  /// \brief Stream every new frame to _writer. If _keepFrames is false, the
+  /// frames are only written to the stream and are not kept in memory. Pass
+  /// nullptr to stop streaming.
+  void setStream(const std::shared_ptr<RecordingWriter>& _writer,
+                 bool _keepFrames = true);
+
+  /// \brief Get the writer that new frames are streamed to
+  std::shared_ptr<RecordingWriter> getStream() const;
+
 private:
-  /// \brief Baked states
-  std::vector<Eigen::VectorXd> mBakedStates;
+  /// \brief A block of consecutive frames
+  struct Chunk
+  {
+    /// Generalized coordinates. The ith column is the ith frame of the chunk.
+    Eigen::MatrixXd mPositions;
+
+    /// Contact points and forces of all the frames of the chunk
+    std::vector<double> mContacts;
+
+    /// Index of the first contact value of each frame in mContacts, plus one
+    /// past the end
+    std::vector<size_t> mContactOffsets;
+  };
+
+  /// \brief Recompute the offsets of the skeletons in a frame
+  void updateOffsets();
+
+  /// \brief Get the chunk containing _frameIdx and the index of the frame
+  /// within it
+  const Chunk& getChunk(int _frameIdx, size_t& _localIdx) const;
+
+  /// \brief Chunks of baked states
+  std::vector<Chunk> mChunks;
+
+  /// \brief Number of frames kept in memory
+  size_t mNumFrames;
+
+  /// \brief Number of frames per chunk
+  size_t mFramesPerChunk;
 
   /// \brief Number of generalized coordinates for skeletons
   std::vector<int> mNumGenCoordsForSkeletons;
+
+  /// \brief Index of the first generalized coordinate of each skeleton in a
+  /// frame, plus the total number of generalized coordinates
+  std::vector<int> mOffsets;
+
+  /// \brief Stream that new frames are written to
+  std::shared_ptr<RecordingWriter> mStream;
+
+  /// \brief Whether frames are kept in memory while streaming
+  bool mKeepFrames;
 };
 
 }  // namespace simulation
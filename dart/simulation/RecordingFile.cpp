@@ -0,0 +1,902 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/simulation/RecordingFile.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "dart/common/Console.h"
+#include "dart/common/MemoryMappedResource.h"
+#include "dart/simulation/Recording.h"
+
+namespace dart {
+namespace simulation {
+
+namespace {
+
+// File layout (all chunks and sections are aligned to 8 bytes):
+//
+//   header  : magic[8] version:u32 compression:u32 resolution:f64
+//             framesPerChunk:u32 numSkeletons:u32 numDofs:i32[numSkeletons]
+//   chunk*  : magic:u32 numFrames:u32 size:u64
+//             contactOffsets:u32[numFrames + 1]
+//             positions (f64[numFrames * totalDofs] or size:u64 varints)
+//             contacts (f64[numContactValues] or size:u64 varints)
+//   index   : numChunks:u64 chunkOffsets:u64[numChunks]
+//   trailer : indexOffset:u64 magic[8]
+//
+// The index and the trailer are only present if the writer was closed.
+
+const char FILE_MAGIC[8] = {'D', 'A', 'R', 'T', 'R', 'E', 'C', '\0'};
+const char INDEX_MAGIC[8] = {'D', 'A', 'R', 'T', 'I', 'D', 'X', '\0'};
+const uint32_t CHUNK_MAGIC = 0x4b4e4843u; // "CHNK"
+const uint32_t FILE_VERSION = 1u;
+const size_t CHUNK_HEADER_SIZE = 16u;
+const size_t TRAILER_SIZE = 16u;
+
+//==============================================================================
+size_t getPadding(size_t _size)
+{
+  return (8u - _size % 8u) % 8u;
+}
+
+//==============================================================================
+template <typename T>
+void append(std::vector<uint8_t>& _buffer, const T& _value)
+{
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&_value);
+  _buffer.insert(_buffer.end(), bytes, bytes + sizeof(T));
+}
+
+//==============================================================================
+void appendArray(std::vector<uint8_t>& _buffer, const void* _data,
+                 size_t _size)
+{
+  const uint8_t* bytes = static_cast<const uint8_t*>(_data);
+  _buffer.insert(_buffer.end(), bytes, bytes + _size);
+}
+
+//==============================================================================
+void appendPadding(std::vector<uint8_t>& _buffer)
+{
+  _buffer.resize(_buffer.size() + getPadding(_buffer.size()), 0u);
+}
+
+//==============================================================================
+void appendVarint(std::vector<uint8_t>& _buffer, uint64_t _value)
+{
+  while (_value >= 0x80u)
+  {
+    _buffer.push_back(static_cast<uint8_t>(_value | 0x80u));
+    _value >>= 7;
+  }
+  _buffer.push_back(static_cast<uint8_t>(_value));
+}
+
+//==============================================================================
+bool readVarint(const uint8_t*& _data, const uint8_t* _end, uint64_t& _value)
+{
+  _value = 0u;
+  for (int shift = 0; shift < 64 && _data < _end; shift += 7)
+  {
+    const uint8_t byte = *_data++;
+    _value |= static_cast<uint64_t>(byte & 0x7fu) << shift;
+    if (!(byte & 0x80u))
+      return true;
+  }
+
+  return false;
+}
+
+//==============================================================================
+uint64_t encodeZigZag(int64_t _value)
+{
+  return (static_cast<uint64_t>(_value) << 1)
+      ^ static_cast<uint64_t>(_value >> 63);
+}
+
+//==============================================================================
+int64_t decodeZigZag(uint64_t _value)
+{
+  return static_cast<int64_t>(_value >> 1) ^ -static_cast<int64_t>(_value & 1u);
+}
+
+//==============================================================================
+uint64_t toBits(double _value)
+{
+  uint64_t bits;
+  std::memcpy(&bits, &_value, sizeof(bits));
+  return bits;
+}
+
+//==============================================================================
+double fromBits(uint64_t _bits)
+{
+  double value;
+  std::memcpy(&value, &_bits, sizeof(value));
+  return value;
+}
+
+//==============================================================================
+template <typename T>
+bool read(const uint8_t* _data, size_t _size, size_t& _offset, T& _value)
+{
+  if (_offset + sizeof(T) > _size)
+    return false;
+
+  std::memcpy(&_value, _data + _offset, sizeof(T));
+  _offset += sizeof(T);
+  return true;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+RecordingFileOptions::RecordingFileOptions(Compression _compression,
+                                           double _resolution,
+                                           size_t _framesPerChunk)
+  : mCompression(_compression),
+    mResolution(_resolution),
+    mFramesPerChunk(_framesPerChunk)
+{
+  // Do nothing
+}
+
+//==============================================================================
+RecordingWriter::RecordingWriter(const std::string& _path,
+                                 const std::vector<int>& _numDofs,
+                                 const RecordingFileOptions& _options)
+  : mFile(std::fopen(_path.c_str(), "wb")),
+    mGood(true),
+    mOptions(_options),
+    mNumDofs(_numDofs),
+    mTotalDofs(0u),
+    mNumFrames(0u),
+    mOffset(0u)
+{
+  assert(mOptions.mFramesPerChunk > 0u);
+  assert(mOptions.mResolution > 0.0);
+
+  if (!mFile)
+  {
+    dtwarn << "[RecordingWriter::constructor] Failed opening file '" << _path
+           << "' for writing: " << std::strerror(errno) << "\n";
+    mGood = false;
+    return;
+  }
+
+  for (const int numDofs : mNumDofs)
+    mTotalDofs += numDofs;
+
+  mPositions.reserve(mOptions.mFramesPerChunk * mTotalDofs);
+  mContactOffsets.reserve(mOptions.mFramesPerChunk + 1u);
+  mContactOffsets.push_back(0u);
+
+  mEncoded.clear();
+  appendArray(mEncoded, FILE_MAGIC, sizeof(FILE_MAGIC));
+  append(mEncoded, FILE_VERSION);
+  append(mEncoded, static_cast<uint32_t>(mOptions.mCompression));
+  append(mEncoded, mOptions.mResolution);
+  append(mEncoded, static_cast<uint32_t>(mOptions.mFramesPerChunk));
+  append(mEncoded, static_cast<uint32_t>(mNumDofs.size()));
+  for (const int numDofs : mNumDofs)
+    append(mEncoded, static_cast<int32_t>(numDofs));
+  appendPadding(mEncoded);
+
+  writeBytes(mEncoded.data(), mEncoded.size());
+}
+
+//==============================================================================
+RecordingWriter::~RecordingWriter()
+{
+  close();
+}
+
+//==============================================================================
+bool RecordingWriter::isGood() const
+{
+  return mGood;
+}
+
+//==============================================================================
+bool RecordingWriter::addState(const Eigen::VectorXd& _state)
+{
+  assert(static_cast<size_t>(_state.size()) >= mTotalDofs);
+  assert((_state.size() - mTotalDofs) % 6 == 0);
+
+  return addState(_state.data(), _state.data() + mTotalDofs,
+                  (_state.size() - mTotalDofs) / 6);
+}
+
+//==============================================================================
+bool RecordingWriter::addState(const double* _positions,
+                               const double* _contacts, size_t _numContacts)
+{
+  if (!mFile || !mGood)
+    return false;
+
+  mPositions.insert(mPositions.end(), _positions, _positions + mTotalDofs);
+  mContacts.insert(mContacts.end(), _contacts, _contacts + 6 * _numContacts);
+  mContactOffsets.push_back(static_cast<uint32_t>(mContacts.size()));
+  ++mNumFrames;
+
+  if (mContactOffsets.size() > mOptions.mFramesPerChunk)
+    return writeChunk();
+
+  return true;
+}
+
+//==============================================================================
+bool RecordingWriter::close()
+{
+  if (!mFile)
+    return mGood;
+
+  if (mContactOffsets.size() > 1u)
+    writeChunk();
+
+  mEncoded.clear();
+  const uint64_t indexOffset = mOffset;
+  append(mEncoded, static_cast<uint64_t>(mChunkOffsets.size()));
+  for (const uint64_t offset : mChunkOffsets)
+    append(mEncoded, offset);
+  append(mEncoded, indexOffset);
+  appendArray(mEncoded, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+  writeBytes(mEncoded.data(), mEncoded.size());
+
+  if (std::fclose(mFile) == EOF)
+  {
+    dtwarn << "[RecordingWriter::close] Failed closing file: "
+           << std::strerror(errno) << "\n";
+    mGood = false;
+  }
+  mFile = nullptr;
+
+  return mGood;
+}
+
+//==============================================================================
+size_t RecordingWriter::getNumFrames() const
+{
+  return mNumFrames;
+}
+
+//==============================================================================
+const RecordingFileOptions& RecordingWriter::getOptions() const
+{
+  return mOptions;
+}
+
+//==============================================================================
+bool RecordingWriter::write(const std::string& _path,
+                            const Recording& _recording,
+                            const RecordingFileOptions& _options)
+{
+  std::vector<int> numDofs(_recording.getNumSkeletons());
+  for (size_t i = 0u; i < numDofs.size(); ++i)
+    numDofs[i] = _recording.getNumDofs(i);
+
+  RecordingWriter writer(_path, numDofs, _options);
+  for (int i = 0; i < _recording.getNumFrames() && writer.isGood(); ++i)
+    writer.addState(_recording.getState(i));
+
+  return writer.close();
+}
+
+//==============================================================================
+bool RecordingWriter::writeChunk()
+{
+  const size_t numFrames = mContactOffsets.size() - 1u;
+
+  mEncoded.clear();
+  append(mEncoded, CHUNK_MAGIC);
+  append(mEncoded, static_cast<uint32_t>(numFrames));
+  append(mEncoded, static_cast<uint64_t>(0u)); // Size, filled in below
+
+  appendArray(mEncoded, mContactOffsets.data(),
+              mContactOffsets.size() * sizeof(uint32_t));
+  appendPadding(mEncoded);
+
+  // Generalized coordinates
+  if (mOptions.mCompression == RecordingFileOptions::COMPRESSION_NONE)
+  {
+    appendArray(mEncoded, mPositions.data(),
+                mPositions.size() * sizeof(double));
+  }
+  else
+  {
+    const size_t sizeOffset = mEncoded.size();
+    append(mEncoded, static_cast<uint64_t>(0u));
+
+    // Encode dof by dof so that consecutive values are similar
+    for (size_t i = 0u; i < mTotalDofs; ++i)
+    {
+      if (mOptions.mCompression == RecordingFileOptions::COMPRESSION_DELTA)
+      {
+        uint64_t previous = 0u;
+        for (size_t j = 0u; j < numFrames; ++j)
+        {
+          const uint64_t bits = toBits(mPositions[j * mTotalDofs + i]);
+          appendVarint(mEncoded, bits ^ previous);
+          previous = bits;
+        }
+      }
+      else
+      {
+        int64_t previous = 0;
+        for (size_t j = 0u; j < numFrames; ++j)
+        {
+          const int64_t value = std::llround(
+                mPositions[j * mTotalDofs + i] / mOptions.mResolution);
+          appendVarint(mEncoded, encodeZigZag(value - previous));
+          previous = value;
+        }
+      }
+    }
+
+    const uint64_t size = mEncoded.size() - sizeOffset - sizeof(uint64_t);
+    std::memcpy(&mEncoded[sizeOffset], &size, sizeof(size));
+    appendPadding(mEncoded);
+  }
+
+  // Contacts
+  if (mOptions.mCompression == RecordingFileOptions::COMPRESSION_QUANTIZED)
+  {
+    const size_t sizeOffset = mEncoded.size();
+    append(mEncoded, static_cast<uint64_t>(0u));
+
+    for (const double value : mContacts)
+    {
+      appendVarint(mEncoded, encodeZigZag(
+                     std::llround(value / mOptions.mResolution)));
+    }
+
+    const uint64_t size = mEncoded.size() - sizeOffset - sizeof(uint64_t);
+    std::memcpy(&mEncoded[sizeOffset], &size, sizeof(size));
+  }
+  else
+  {
+    appendArray(mEncoded, mContacts.data(), mContacts.size() * sizeof(double));
+  }
+  appendPadding(mEncoded);
+
+  const uint64_t chunkSize = mEncoded.size() - CHUNK_HEADER_SIZE;
+  std::memcpy(&mEncoded[8], &chunkSize, sizeof(chunkSize));
+
+  mChunkOffsets.push_back(mOffset);
+
+  mPositions.clear();
+  mContacts.clear();
+  mContactOffsets.clear();
+  mContactOffsets.push_back(0u);
+
+  return writeBytes(mEncoded.data(), mEncoded.size());
+}
+
+//==============================================================================
+bool RecordingWriter::writeBytes(const void* _data, size_t _size)
+{
+  if (!mFile || !mGood)
+    return false;
+
+  if (std::fwrite(_data, 1u, _size, mFile) != _size)
+  {
+    dtwarn << "[RecordingWriter::writeBytes] Failed writing to file: "
+           << std::strerror(errno) << "\n";
+    mGood = false;
+    return false;
+  }
+
+  mOffset += _size;
+  return true;
+}
+
+//==============================================================================
+RecordingReader::RecordingReader(const std::string& _path)
+  : mData(nullptr),
+    mSize(0u),
+    mGood(false),
+    mNumFrames(0u),
+    mCurrentChunk(static_cast<size_t>(-1)),
+    mPositions(nullptr),
+    mContacts(nullptr),
+    mContactOffsets(nullptr)
+{
+  if (!map(_path))
+    return;
+
+  mGood = parse();
+  if (!mGood)
+  {
+    dtwarn << "[RecordingReader::constructor] '" << _path
+           << "' is not a valid recording file.\n";
+  }
+}
+
+//==============================================================================
+RecordingReader::~RecordingReader()
+{
+  unmap();
+}
+
+//==============================================================================
+bool RecordingReader::isGood() const
+{
+  return mGood;
+}
+
+//==============================================================================
+bool RecordingReader::isRecordingFile(const std::string& _path)
+{
+  std::FILE* file = std::fopen(_path.c_str(), "rb");
+  if (!file)
+    return false;
+
+  char magic[sizeof(FILE_MAGIC)];
+  const bool result = std::fread(magic, 1u, sizeof(magic), file)
+      == sizeof(magic) && !std::memcmp(magic, FILE_MAGIC, sizeof(magic));
+  std::fclose(file);
+
+  return result;
+}
+
+//==============================================================================
+const RecordingFileOptions& RecordingReader::getOptions() const
+{
+  return mOptions;
+}
+
+//==============================================================================
+int RecordingReader::getNumFrames() const
+{
+  return mNumFrames;
+}
+
+//==============================================================================
+int RecordingReader::getNumSkeletons() const
+{
+  return mNumDofs.size();
+}
+
+//==============================================================================
+int RecordingReader::getNumDofs(int _skelIdx) const
+{
+  return mNumDofs[_skelIdx];
+}
+
+//==============================================================================
+int RecordingReader::getNumDofs() const
+{
+  return mOffsets.back();
+}
+
+//==============================================================================
+int RecordingReader::getNumContacts(int _frameIdx) const
+{
+  const size_t localIdx = loadFrame(_frameIdx);
+  return (mContactOffsets[localIdx + 1] - mContactOffsets[localIdx]) / 6;
+}
+
+//==============================================================================
+Eigen::Map<const Eigen::VectorXd> RecordingReader::getConfigs(
+    int _frameIdx) const
+{
+  const size_t localIdx = loadFrame(_frameIdx);
+  return Eigen::Map<const Eigen::VectorXd>(
+        mPositions + localIdx * getNumDofs(), getNumDofs());
+}
+
+//==============================================================================
+Eigen::VectorXd RecordingReader::getConfig(int _frameIdx, int _skelIdx) const
+{
+  return getConfigs(_frameIdx).segment(mOffsets[_skelIdx],
+                                       mNumDofs[_skelIdx]);
+}
+
+//==============================================================================
+double RecordingReader::getGenCoord(int _frameIdx, int _skelIdx,
+                                    int _dofIdx) const
+{
+  return getConfigs(_frameIdx)[mOffsets[_skelIdx] + _dofIdx];
+}
+
+//==============================================================================
+Eigen::Vector3d RecordingReader::getContactPoint(int _frameIdx,
+                                                 int _contactIdx) const
+{
+  const size_t localIdx = loadFrame(_frameIdx);
+  const size_t index = mContactOffsets[localIdx] + _contactIdx * 6;
+  assert(index + 6 <= mContactOffsets[localIdx + 1]);
+  return Eigen::Map<const Eigen::Vector3d>(mContacts + index);
+}
+
+//==============================================================================
+Eigen::Vector3d RecordingReader::getContactForce(int _frameIdx,
+                                                 int _contactIdx) const
+{
+  const size_t localIdx = loadFrame(_frameIdx);
+  const size_t index = mContactOffsets[localIdx] + _contactIdx * 6 + 3;
+  assert(index + 3 <= mContactOffsets[localIdx + 1]);
+  return Eigen::Map<const Eigen::Vector3d>(mContacts + index);
+}
+
+//==============================================================================
+std::unique_ptr<Recording> RecordingReader::createRecording() const
+{
+  std::unique_ptr<Recording> recording(new Recording(mNumDofs));
+  recording->setFramesPerChunk(mOptions.mFramesPerChunk);
+
+  for (size_t i = 0u; i < mNumFrames; ++i)
+  {
+    const size_t localIdx = loadFrame(i);
+    const size_t begin = mContactOffsets[localIdx];
+    const size_t end = mContactOffsets[localIdx + 1];
+    recording->addState(mPositions + localIdx * getNumDofs(),
+                        mContacts + begin, (end - begin) / 6);
+  }
+
+  return recording;
+}
+
+//==============================================================================
+bool RecordingReader::map(const std::string& _path)
+{
+  mFile.reset(new common::MemoryMappedResource(_path));
+  if (!mFile->isGood())
+  {
+    mFile.reset();
+    return false;
+  }
+
+  if (mFile->getSize() == 0u)
+  {
+    dtwarn << "[RecordingReader::map] File '" << _path << "' is empty.\n";
+    mFile.reset();
+    return false;
+  }
+
+  mData = static_cast<const uint8_t*>(mFile->getData());
+  mSize = mFile->getSize();
+  return true;
+}
+
+//==============================================================================
+void RecordingReader::unmap()
+{
+  mFile.reset();
+  mData = nullptr;
+  mSize = 0u;
+}
+
+//==============================================================================
+bool RecordingReader::parse()
+{
+  size_t offset = 0u;
+
+  char magic[sizeof(FILE_MAGIC)];
+  if (!read(mData, mSize, offset, magic)
+      || std::memcmp(magic, FILE_MAGIC, sizeof(magic)))
+    return false;
+
+  uint32_t version, compression, framesPerChunk, numSkeletons;
+  if (!read(mData, mSize, offset, version) || version != FILE_VERSION
+      || !read(mData, mSize, offset, compression)
+      || compression > RecordingFileOptions::COMPRESSION_QUANTIZED
+      || !read(mData, mSize, offset, mOptions.mResolution)
+      || !read(mData, mSize, offset, framesPerChunk) || framesPerChunk == 0u
+      || !read(mData, mSize, offset, numSkeletons))
+    return false;
+
+  mOptions.mCompression
+      = static_cast<RecordingFileOptions::Compression>(compression);
+  mOptions.mFramesPerChunk = framesPerChunk;
+
+  if (numSkeletons > (mSize - offset) / sizeof(int32_t))
+    return false;
+
+  mNumDofs.resize(numSkeletons);
+  mOffsets.resize(numSkeletons + 1u);
+  mOffsets[0] = 0;
+  for (uint32_t i = 0u; i < numSkeletons; ++i)
+  {
+    int32_t numDofs;
+    if (!read(mData, mSize, offset, numDofs) || numDofs < 0
+        || numDofs > std::numeric_limits<int>::max() - mOffsets[i])
+      return false;
+    mNumDofs[i] = numDofs;
+    mOffsets[i + 1] = mOffsets[i] + numDofs;
+  }
+  offset += getPadding(offset);
+
+  // Collect the chunk offsets from the index if the file was closed, or by
+  // scanning the chunks otherwise
+  std::vector<uint64_t> chunkOffsets;
+  size_t trailerOffset = mSize >= TRAILER_SIZE ? mSize - TRAILER_SIZE : 0u;
+  uint64_t indexOffset;
+  size_t indexEnd = mSize;
+  if (mSize >= offset + TRAILER_SIZE
+      && read(mData, mSize, trailerOffset, indexOffset)
+      && !std::memcmp(mData + mSize - sizeof(INDEX_MAGIC), INDEX_MAGIC,
+                      sizeof(INDEX_MAGIC)))
+  {
+    size_t indexPos = indexOffset;
+    uint64_t numChunks;
+    if (!read(mData, mSize, indexPos, numChunks)
+        || numChunks > (mSize - indexPos) / sizeof(uint64_t))
+      return false;
+    chunkOffsets.resize(numChunks);
+    for (uint64_t& chunkOffset : chunkOffsets)
+    {
+      if (!read(mData, mSize, indexPos, chunkOffset))
+        return false;
+    }
+    indexEnd = indexOffset;
+  }
+  else
+  {
+    dtwarn << "[RecordingReader::parse] The recording file has no index. It "
+           << "was probably not closed properly. Scanning its chunks.\n";
+    size_t chunkOffset = offset;
+    while (chunkOffset + CHUNK_HEADER_SIZE <= mSize)
+    {
+      size_t pos = chunkOffset;
+      uint32_t chunkMagic, numFrames;
+      uint64_t size;
+      read(mData, mSize, pos, chunkMagic);
+      read(mData, mSize, pos, numFrames);
+      read(mData, mSize, pos, size);
+      if (chunkMagic != CHUNK_MAGIC || size > mSize - pos)
+        break;
+      chunkOffsets.push_back(chunkOffset);
+      chunkOffset = pos + size;
+    }
+  }
+
+  // Validate the chunks. All but the last one must be full for O(1) lookup.
+  mChunks.resize(chunkOffsets.size());
+  mNumFrames = 0u;
+  for (size_t i = 0u; i < chunkOffsets.size(); ++i)
+  {
+    ChunkInfo& info = mChunks[i];
+    if (chunkOffsets[i] > indexEnd
+        || !parseChunk(chunkOffsets[i], indexEnd, info)
+        || (i + 1u < chunkOffsets.size() && info.mNumFrames != framesPerChunk)
+        || info.mNumFrames > framesPerChunk)
+      return false;
+
+    mNumFrames += info.mNumFrames;
+  }
+
+  return true;
+}
+
+//==============================================================================
+bool RecordingReader::parseChunk(size_t _offset, size_t _end,
+                                 ChunkInfo& _info) const
+{
+  size_t pos = _offset;
+  uint32_t chunkMagic, numFrames;
+  uint64_t size;
+  if (_offset % 8u != 0u
+      || !read(mData, _end, pos, chunkMagic) || chunkMagic != CHUNK_MAGIC
+      || !read(mData, _end, pos, numFrames)
+      || !read(mData, _end, pos, size) || size > _end - pos)
+    return false;
+
+  // All the sections must lie within the chunk
+  const size_t end = pos + size;
+  _info.mOffset = _offset;
+  _info.mNumFrames = numFrames;
+
+  // Contact offsets, which must start at zero, grow by whole contacts and end
+  // at the number of contact values
+  const size_t numOffsets = static_cast<size_t>(numFrames) + 1u;
+  if (numOffsets > (end - pos) / sizeof(uint32_t))
+    return false;
+
+  _info.mContactOffsetsBegin = pos;
+  const uint32_t* contactOffsets
+      = reinterpret_cast<const uint32_t*>(mData + pos);
+  if (contactOffsets[0] != 0u)
+    return false;
+  for (size_t i = 0u; i < numFrames; ++i)
+  {
+    if (contactOffsets[i + 1] < contactOffsets[i]
+        || (contactOffsets[i + 1] - contactOffsets[i]) % 6u != 0u)
+      return false;
+  }
+  _info.mNumContactValues = contactOffsets[numFrames];
+  pos += numOffsets * sizeof(uint32_t);
+  pos += getPadding(pos);
+  if (pos > end)
+    return false;
+
+  // Generalized coordinates
+  const size_t totalDofs = getNumDofs();
+  if (mOptions.mCompression == RecordingFileOptions::COMPRESSION_NONE)
+  {
+    if (totalDofs > 0u
+        && numFrames > (end - pos) / (totalDofs * sizeof(double)))
+      return false;
+
+    _info.mPositionsBegin = pos;
+    pos += numFrames * totalDofs * sizeof(double);
+    _info.mPositionsEnd = pos;
+  }
+  else
+  {
+    // Every encoded value takes at least one byte
+    uint64_t encodedSize;
+    if (!read(mData, end, pos, encodedSize) || encodedSize > end - pos
+        || (totalDofs > 0u && numFrames > encodedSize / totalDofs))
+      return false;
+
+    _info.mPositionsBegin = pos;
+    pos += encodedSize;
+    _info.mPositionsEnd = pos;
+    pos += getPadding(pos);
+    if (pos > end)
+      return false;
+  }
+
+  // Contacts
+  if (mOptions.mCompression == RecordingFileOptions::COMPRESSION_QUANTIZED)
+  {
+    uint64_t encodedSize;
+    if (!read(mData, end, pos, encodedSize) || encodedSize > end - pos
+        || _info.mNumContactValues > encodedSize)
+      return false;
+
+    _info.mContactsBegin = pos;
+    _info.mContactsEnd = pos + encodedSize;
+  }
+  else
+  {
+    if (_info.mNumContactValues > (end - pos) / sizeof(double))
+      return false;
+
+    _info.mContactsBegin = pos;
+    _info.mContactsEnd = pos + _info.mNumContactValues * sizeof(double);
+  }
+
+  return true;
+}
+
+//==============================================================================
+void RecordingReader::loadChunk(size_t _chunkIdx) const
+{
+  if (_chunkIdx == mCurrentChunk)
+    return;
+
+  // The layout of the chunk has been validated by parse()
+  const ChunkInfo& info = mChunks[_chunkIdx];
+  const size_t numFrames = info.mNumFrames;
+  const size_t totalDofs = getNumDofs();
+  bool isCorrupt = false;
+
+  mContactOffsets
+      = reinterpret_cast<const uint32_t*>(mData + info.mContactOffsetsBegin);
+
+  // Generalized coordinates
+  if (mOptions.mCompression == RecordingFileOptions::COMPRESSION_NONE)
+  {
+    mPositions = reinterpret_cast<const double*>(mData + info.mPositionsBegin);
+  }
+  else
+  {
+    const uint8_t* data = mData + info.mPositionsBegin;
+    const uint8_t* end = mData + info.mPositionsEnd;
+
+    mDecodedPositions.resize(numFrames * totalDofs);
+    for (size_t i = 0u; i < totalDofs; ++i)
+    {
+      uint64_t previousBits = 0u;
+      int64_t previousValue = 0;
+      for (size_t j = 0u; j < numFrames; ++j)
+      {
+        uint64_t encoded = 0u;
+        if (!readVarint(data, end, encoded))
+        {
+          isCorrupt = true;
+          mDecodedPositions[j * totalDofs + i] = 0.0;
+          continue;
+        }
+
+        if (mOptions.mCompression == RecordingFileOptions::COMPRESSION_DELTA)
+        {
+          previousBits ^= encoded;
+          mDecodedPositions[j * totalDofs + i] = fromBits(previousBits);
+        }
+        else
+        {
+          previousValue += decodeZigZag(encoded);
+          mDecodedPositions[j * totalDofs + i]
+              = previousValue * mOptions.mResolution;
+        }
+      }
+    }
+
+    mPositions = mDecodedPositions.data();
+  }
+
+  // Contacts
+  if (mOptions.mCompression == RecordingFileOptions::COMPRESSION_QUANTIZED)
+  {
+    const uint8_t* data = mData + info.mContactsBegin;
+    const uint8_t* end = mData + info.mContactsEnd;
+
+    mDecodedContacts.resize(info.mNumContactValues);
+    for (double& value : mDecodedContacts)
+    {
+      uint64_t encoded = 0u;
+      if (!readVarint(data, end, encoded))
+      {
+        isCorrupt = true;
+        value = 0.0;
+        continue;
+      }
+      value = decodeZigZag(encoded) * mOptions.mResolution;
+    }
+    mContacts = mDecodedContacts.data();
+  }
+  else
+  {
+    mContacts = reinterpret_cast<const double*>(mData + info.mContactsBegin);
+  }
+
+  if (isCorrupt)
+  {
+    dtwarn << "[RecordingReader::loadChunk] Chunk " << _chunkIdx << " is "
+           << "corrupt. The values that could not be decoded are set to "
+           << "zero.\n";
+  }
+
+  mCurrentChunk = _chunkIdx;
+}
+
+//==============================================================================
+size_t RecordingReader::loadFrame(int _frameIdx) const
+{
+  assert(0 <= _frameIdx && static_cast<size_t>(_frameIdx) < mNumFrames);
+  loadChunk(_frameIdx / mOptions.mFramesPerChunk);
+  return _frameIdx % mOptions.mFramesPerChunk;
+}
+
+}  // namespace simulation
+}  // namespace dart
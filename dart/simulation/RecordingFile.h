@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_SIMULATION_RECORDINGFILE_H_
+#define DART_SIMULATION_RECORDINGFILE_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Eigen/Dense>
+
+namespace dart {
+namespace common {
+class MemoryMappedResource;
+}  // namespace common
+
+namespace simulation {
+
+class Recording;
+
+/// Options of the binary recording format
+struct RecordingFileOptions
+{
+  enum Compression
+  {
+    /// Raw doubles. Generalized coordinates can be read from a memory-mapped
+    /// file without decoding.
+    COMPRESSION_NONE = 0,
+
+    /// Lossless: each generalized coordinate is XOR-ed with its value in the
+    /// previous frame and stored as a variable-length integer
+    COMPRESSION_DELTA = 1,
+
+    /// Lossy: all values are rounded to multiples of mResolution, and each
+    /// generalized coordinate is stored as the difference to its value in the
+    /// previous frame as a variable-length integer
+    COMPRESSION_QUANTIZED = 2
+  };
+
+  /// Constructor
+  RecordingFileOptions(Compression _compression = COMPRESSION_NONE,
+                       double _resolution = 1e-6,
+                       size_t _framesPerChunk = 256);
+
+  /// How the frames are compressed
+  Compression mCompression;
+
+  /// Quantization step of COMPRESSION_QUANTIZED
+  double mResolution;
+
+  /// Number of frames per chunk. Chunks are the units of writing and of
+  /// decompression.
+  size_t mFramesPerChunk;
+};
+
+/// RecordingWriter writes a stream of frames to a compact binary file. The
+/// frames are buffered and written one chunk at a time, so memory usage does
+/// not grow with the length of the recording. An index of the chunks is
+/// appended when the writer is closed; files that were not closed properly
+/// can still be read, but the chunks have to be scanned when they are opened.
+///
+/// The file is written in the byte order of the host.
+class RecordingWriter
+{
+public:
+  /// Open _path for writing frames of skeletons with the given numbers of
+  /// generalized coordinates
+  RecordingWriter(const std::string& _path, const std::vector<int>& _numDofs,
+                  const RecordingFileOptions& _options
+                      = RecordingFileOptions());
+
+  /// Destructor. Closes the file.
+  virtual ~RecordingWriter();
+
+  RecordingWriter(const RecordingWriter&) = delete;
+  RecordingWriter& operator=(const RecordingWriter&) = delete;
+
+  /// Return whether the file is open and no write error has occurred
+  bool isGood() const;
+
+  /// Add a frame. See Recording::addState().
+  bool addState(const Eigen::VectorXd& _state);
+
+  /// Add a frame. See Recording::addState().
+  bool addState(const double* _positions,
+                const double* _contacts, size_t _numContacts);
+
+  /// Write the pending frames and the index, and close the file
+  bool close();
+
+  /// Number of frames added so far
+  size_t getNumFrames() const;
+
+  /// Options of the file
+  const RecordingFileOptions& getOptions() const;
+
+  /// Write all the frames of _recording to _path
+  static bool write(const std::string& _path, const Recording& _recording,
+                    const RecordingFileOptions& _options
+                        = RecordingFileOptions());
+
+protected:
+  /// Encode and write the buffered frames as one chunk
+  bool writeChunk();
+
+  /// Write raw bytes
+  bool writeBytes(const void* _data, size_t _size);
+
+  /// The file
+  std::FILE* mFile;
+
+  /// Whether an error has occurred
+  bool mGood;
+
+  /// Options of the file
+  RecordingFileOptions mOptions;
+
+  /// Number of generalized coordinates of every skeleton
+  std::vector<int> mNumDofs;
+
+  /// Total number of generalized coordinates
+  size_t mTotalDofs;
+
+  /// Number of frames added so far
+  size_t mNumFrames;
+
+  /// Current write position
+  uint64_t mOffset;
+
+  /// Offsets of the chunks that have been written
+  std::vector<uint64_t> mChunkOffsets;
+
+  /// Buffered generalized coordinates, frame after frame
+  std::vector<double> mPositions;
+
+  /// Buffered contact values
+  std::vector<double> mContacts;
+
+  /// Index of the first contact value of each buffered frame
+  std::vector<uint32_t> mContactOffsets;
+
+  /// Scratch buffer for encoding
+  std::vector<uint8_t> mEncoded;
+};
+
+/// RecordingReader plays back a file written by RecordingWriter. The file is
+/// memory-mapped, so frames are read on demand and opening a file does not
+/// depend on its length (except for unclosed files, whose chunks need to be
+/// scanned). Frame lookup is O(1). Uncompressed chunks are read directly from
+/// the mapping; compressed chunks are decoded on first access, and the last
+/// decoded chunk is cached.
+///
+/// A RecordingReader is not safe to use from several threads at once.
+class RecordingReader
+{
+public:
+  /// Open _path
+  explicit RecordingReader(const std::string& _path);
+
+  /// Destructor. Unmaps the file.
+  virtual ~RecordingReader();
+
+  RecordingReader(const RecordingReader&) = delete;
+  RecordingReader& operator=(const RecordingReader&) = delete;
+
+  /// Return whether the file was opened and parsed successfully
+  bool isGood() const;
+
+  /// Return whether _path starts like a file written by RecordingWriter
+  static bool isRecordingFile(const std::string& _path);
+
+  /// Options the file was written with
+  const RecordingFileOptions& getOptions() const;
+
+  /// Get number of frames
+  int getNumFrames() const;
+
+  /// Get number of skeletons
+  int getNumSkeletons() const;
+
+  /// Get number of generalized coordinates of a skeleton
+  int getNumDofs(int _skelIdx) const;
+
+  /// Get the total number of generalized coordinates
+  int getNumDofs() const;
+
+  /// Get number of contacts at a frame
+  int getNumContacts(int _frameIdx) const;
+
+  /// Get the generalized coordinates of all skeletons at a frame. The map is
+  /// valid until the next call to any function of this reader.
+  Eigen::Map<const Eigen::VectorXd> getConfigs(int _frameIdx) const;
+
+  /// Get the configuration of a skeleton at a frame
+  Eigen::VectorXd getConfig(int _frameIdx, int _skelIdx) const;
+
+  /// Get a single generalized coordinate of a skeleton at a frame
+  double getGenCoord(int _frameIdx, int _skelIdx, int _dofIdx) const;
+
+  /// Get a contact point at a frame
+  Eigen::Vector3d getContactPoint(int _frameIdx, int _contactIdx) const;
+
+  /// Get a contact force at a frame
+  Eigen::Vector3d getContactForce(int _frameIdx, int _contactIdx) const;
+
+  /// Load all the frames into a new Recording
+  std::unique_ptr<Recording> createRecording() const;
+
+protected:
+  struct ChunkInfo
+  {
+    /// Offset of the chunk in the file
+    uint64_t mOffset;
+
+    /// Number of frames in the chunk
+    uint32_t mNumFrames;
+
+    /// Offset of the contact offsets in the file
+    uint64_t mContactOffsetsBegin;
+
+    /// Offset and end of the (encoded) generalized coordinates in the file
+    uint64_t mPositionsBegin;
+    uint64_t mPositionsEnd;
+
+    /// Offset and end of the (encoded) contact values in the file
+    uint64_t mContactsBegin;
+    uint64_t mContactsEnd;
+
+    /// Number of contact values in the chunk
+    uint64_t mNumContactValues;
+  };
+
+  /// Map the file into memory
+  bool map(const std::string& _path);
+
+  /// Unmap the file
+  void unmap();
+
+  /// Parse the header and the chunk index
+  bool parse();
+
+  /// Read the layout of the chunk at _offset into _info and check that all
+  /// its sections lie within the first _end bytes of the file
+  bool parseChunk(size_t _offset, size_t _end, ChunkInfo& _info) const;
+
+  /// Make _chunkIdx the current chunk, decoding it if necessary. Values that
+  /// cannot be decoded are set to zero.
+  void loadChunk(size_t _chunkIdx) const;
+
+  /// Make the chunk containing _frameIdx current and return the index of the
+  /// frame within it
+  size_t loadFrame(int _frameIdx) const;
+
+  /// Mapping of the file
+  std::unique_ptr<common::MemoryMappedResource> mFile;
+
+  /// Contents of the mapped file
+  const uint8_t* mData;
+
+  /// Size of the mapped file
+  size_t mSize;
+
+  /// Whether the file was parsed successfully
+  bool mGood;
+
+  /// Options the file was written with
+  RecordingFileOptions mOptions;
+
+  /// Number of generalized coordinates of every skeleton
+  std::vector<int> mNumDofs;
+
+  /// Index of the first generalized coordinate of every skeleton, plus the
+  /// total number of generalized coordinates
+  std::vector<int> mOffsets;
+
+  /// Number of frames
+  size_t mNumFrames;
+
+  /// Chunks of the file
+  std::vector<ChunkInfo> mChunks;
+
+  /// Index of the current chunk
+  mutable size_t mCurrentChunk;
+
+  /// Generalized coordinates of the current chunk
+  mutable const double* mPositions;
+
+  /// Contact values of the current chunk
+  mutable const double* mContacts;
+
+  /// Contact offsets of the current chunk
+  mutable const uint32_t* mContactOffsets;
+
+  /// Decoded generalized coordinates of the current chunk
+  mutable std::vector<double> mDecodedPositions;
+
+  /// Decoded contact values of the current chunk
+  mutable std::vector<double> mDecodedContacts;
+};
+
+}  // namespace simulation
+}  // namespace dart
+
+#endif  // DART_SIMULATION_RECORDINGFILE_H_
@@ -42,6 +42,7 @@
 
 #include "dart/simulation/World.h"
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -49,11 +50,105 @@
 #include "dart/common/Console.h"
 #include "dart/integration/SemiImplicitEulerIntegrator.h"
 #include "dart/dynamics/Skeleton.h"
+#include "dart/dynamics/SoftBodyNode.h"
+#include "dart/dynamics/PointMass.h"
+#include "dart/collision/CollisionDetector.h"
 #include "dart/constraint/ConstraintSolver.h"
 
+#define DART_SUB_STEPPING_ERROR_TOLERANCE  1e-3
+#define DART_MAX_NUM_SUB_STEPS             16
+
 namespace dart {
 namespace simulation {
 
+namespace {
+
+//==============================================================================
+size_t getNumStates(const dynamics::Skeleton* _skel)
+{
+  size_t numStates = _skel->getNumDofs();
+  for (size_t i = 0; i < _skel->getNumSoftBodyNodes(); ++i)
+    numStates += 3 * _skel->getSoftBodyNode(i)->getNumPointMasses();
+
+  return numStates;
+}
+
+//==============================================================================
+/// Stack the generalized positions and velocities of _skel and of all its
+/// point masses
+void getState(const dynamics::Skeleton* _skel,
+              Eigen::VectorXd& _positions, Eigen::VectorXd& _velocities)
+{
+  const size_t numDofs = _skel->getNumDofs();
+  _positions.resize(getNumStates(_skel));
+  _velocities.resize(_positions.size());
+  _positions.head(numDofs) = _skel->getPositions();
+  _velocities.head(numDofs) = _skel->getVelocities();
+
+  size_t index = numDofs;
+  for (size_t i = 0; i < _skel->getNumSoftBodyNodes(); ++i)
+  {
+    const dynamics::SoftBodyNode* bn = _skel->getSoftBodyNode(i);
+    for (size_t j = 0; j < bn->getNumPointMasses(); ++j)
+    {
+      const dynamics::PointMass* pointMass = bn->getPointMass(j);
+      _positions.segment<3>(index) = pointMass->getPositions();
+      _velocities.segment<3>(index) = pointMass->getVelocities();
+      index += 3;
+    }
+  }
+}
+
+//==============================================================================
+/// Inverse of getState()
+void setState(dynamics::Skeleton* _skel,
+              const Eigen::VectorXd& _positions,
+              const Eigen::VectorXd& _velocities)
+{
+  const size_t numDofs = _skel->getNumDofs();
+  _skel->setPositions(_positions.head(numDofs));
+  _skel->setVelocities(_velocities.head(numDofs));
+
+  size_t index = numDofs;
+  for (size_t i = 0; i < _skel->getNumSoftBodyNodes(); ++i)
+  {
+    dynamics::SoftBodyNode* bn = _skel->getSoftBodyNode(i);
+    for (size_t j = 0; j < bn->getNumPointMasses(); ++j)
+    {
+      dynamics::PointMass* pointMass = bn->getPointMass(j);
+      pointMass->setPositions(_positions.segment<3>(index));
+      pointMass->setVelocities(_velocities.segment<3>(index));
+      index += 3;
+    }
+  }
+}
+
+//==============================================================================
+double getMaxPenetrationDepth(collision::CollisionDetector* _detector)
+{
+  double depth = 0.0;
+  for (size_t i = 0; i < _detector->getNumContacts(); ++i)
+  {
+    depth = std::max(depth,
+                     _detector->getContactRecord(i).penetrationDepth);
+  }
+
+  return depth;
+}
+
+}  // anonymous namespace
+
+//==============================================================================
+World::SubSteppingStatistics::SubSteppingStatistics()
+  : mNumSteps(0u),
+    mNumSubSteps(0u),
+    mNumRejectedSubSteps(0u),
+    mMaxNumSubStepsPerStep(0u),
+    mMaxError(0.0)
+{
+  // Do nothing
+}
+
 //==============================================================================
 World::World(const std::string& _name)
   : mName(_name),
@@ -61,10 +156,16 @@ World::World(const std::string& _name)
     mNameMgrForSimpleFrames("World::SimpleFrame | " + _name, "frame"),
     mGravity(0.0, 0.0, -9.81),
     mTimeStep(0.001),
+    mImplicitSpringIntegration(false),
+    mAdaptiveTimeStepping(false),
+    mErrorTolerance(DART_SUB_STEPPING_ERROR_TOLERANCE),
+    mMaxNumSubSteps(DART_MAX_NUM_SUB_STEPS),
     mTime(0.0),
     mFrame(0),
     mConstraintSolver(new constraint::ConstraintSolver(mTimeStep)),
     mRecording(new Recording(mSkeletons)),
+    mBakeDecimation(1u),
+    mNumBakeCalls(0u),
     onNameChanged(mNameChangedSignal)
 {
   mIndices.push_back(0);
@@ -74,6 +175,7 @@ World::World(const std::string& _name)
 World::~World()
 {
   delete mConstraintSolver;
+  mAsyncRecorder.reset();
   delete mRecording;
 
   for(common::Connection& connection : mNameConnectionsForSkeletons)
@@ -90,6 +192,10 @@ WorldPtr World::clone() const
 
   worldClone->setGravity(mGravity);
   worldClone->setTimeStep(mTimeStep);
+  worldClone->setImplicitSpringIntegration(mImplicitSpringIntegration);
+  worldClone->setAdaptiveTimeStepping(mAdaptiveTimeStepping);
+  worldClone->setErrorTolerance(mErrorTolerance);
+  worldClone->setMaxNumSubSteps(mMaxNumSubSteps);
 
   // Clone and add each Skeleton
   for(size_t i=0; i<mSkeletons.size(); ++i)
@@ -142,56 +248,120 @@ double World::getTimeStep() const
   return mTimeStep;
 }
 
+//==============================================================================
+void World::setImplicitSpringIntegration(bool _implicit)
+{
+  mImplicitSpringIntegration = _implicit;
+
+  for (auto& skel : mSkeletons)
+    skel->setImplicitSpringIntegration(_implicit);
+}
+
+//==============================================================================
+bool World::isImplicitSpringIntegration() const
+{
+  return mImplicitSpringIntegration;
+}
+
 //==============================================================================
 void World::reset()
 {
   mTime = 0.0;
   mFrame = 0;
+  if (mAsyncRecorder)
+    mAsyncRecorder->flush();
   mRecording->clear();
+  mNumBakeCalls = 0u;
+  resetSubSteppingStatistics();
 }
 
 //==============================================================================
 void World::step(bool _resetCommand)
 {
-  // Integrate velocity for unconstrained skeletons
-  for (auto& skel : mSkeletons)
-  {
-    if (!skel->isMobile())
-      continue;
+  // Wake up the sleeping skeletons whose forces, commands or state have changed
+  mConstraintSolver->wakeUpDisturbedIslands();
 
-    skel->computeForwardDynamics();
-    skel->integrateVelocities(mTimeStep);
-  }
+  if (mAdaptiveTimeStepping)
+    integrateAdaptively();
+  else
+    integrate(mTimeStep);
 
-  // Detect activated constraints and compute constraint impulses
-  mConstraintSolver->solve();
-
-  // Compute velocity changes given constraint impulses
-  for (auto& skel : mSkeletons)
+  if (_resetCommand)
   {
-    if (!skel->isMobile())
-      continue;
-
-    if (skel->isImpulseApplied())
+    for (auto& skel : mSkeletons)
     {
-      skel->computeImpulseForwardDynamics();
-      skel->setImpulseApplied(false);
-    }
-
-    skel->integratePositions(mTimeStep);
+      if (!skel->isMobile() || skel->isSleeping())
+        continue;
 
-    if (_resetCommand)
-    {
       skel->clearInternalForces();
       skel->clearExternalForces();
       skel->resetCommands();
     }
   }
 
+  // Put the islands that have come to rest to sleep
+  mConstraintSolver->updateSleepingIslands();
+
   mTime += mTimeStep;
   mFrame++;
 }
 
+//==============================================================================
+void World::setAdaptiveTimeStepping(bool _adaptive)
+{
+  mAdaptiveTimeStepping = _adaptive;
+}
+
+//==============================================================================
+bool World::isAdaptiveTimeStepping() const
+{
+  return mAdaptiveTimeStepping;
+}
+
+//==============================================================================
+void World::setErrorTolerance(double _tolerance)
+{
+  assert(_tolerance > 0.0 && "Invalid error tolerance.");
+  mErrorTolerance = _tolerance;
+}
+
+//==============================================================================
+double World::getErrorTolerance() const
+{
+  return mErrorTolerance;
+}
+
+//==============================================================================
+void World::setMaxNumSubSteps(size_t _maxNumSubSteps)
+{
+  if (_maxNumSubSteps == 0u)
+  {
+    dtwarn << "[World::setMaxNumSubSteps] At least one sub-step is required. "
+           << "Using 1 instead.\n";
+    _maxNumSubSteps = 1u;
+  }
+
+  mMaxNumSubSteps = _maxNumSubSteps;
+}
+
+//==============================================================================
+size_t World::getMaxNumSubSteps() const
+{
+  return mMaxNumSubSteps;
+}
+
+//==============================================================================
+const World::SubSteppingStatistics& World::getSubSteppingStatistics() const
+{
+  return mSubSteppingStatistics;
+}
+
+//==============================================================================
+void World::resetSubSteppingStatistics()
+{
+  mSubSteppingStatistics = SubSteppingStatistics();
+}
+
 //==============================================================================
 void World::setTime(double _time)
 {
@@ -303,12 +473,15 @@ std::string World::addSkeleton(dynamics::SkeletonPtr _skeleton)
                        _skeleton->getName(), _skeleton));
 
   _skeleton->setTimeStep(mTimeStep);
+  _skeleton->setImplicitSpringIntegration(mImplicitSpringIntegration);
   _skeleton->setGravity(mGravity);
 
   mIndices.push_back(mIndices.back() + _skeleton->getNumDofs());
   mConstraintSolver->addSkeleton(_skeleton);
 
   // Update recording
+  if (mAsyncRecorder)
+    mAsyncRecorder->flush();
   mRecording->updateNumGenCoords(mSkeletons);
 
   return _skeleton->getName();
@@ -360,6 +533,8 @@ void World::removeSkeleton(dynamics::SkeletonPtr _skeleton)
   mNameConnectionsForSkeletons.erase(mNameConnectionsForSkeletons.begin()+index);
 
   // Update recording
+  if (mAsyncRecorder)
+    mAsyncRecorder->flush();
   mRecording->updateNumGenCoords(mSkeletons);
 
   // Remove from NameManager
@@ -503,31 +678,249 @@ constraint::ConstraintSolver* World::getConstraintSolver() const
 //==============================================================================
 void World::bake()
 {
+  if (mNumBakeCalls++ % mBakeDecimation != 0u)
+    return;
+
+  AsyncRecorder::Frame* frame = &mBakeFrame;
+  if (mAsyncRecorder)
+  {
+    frame = mAsyncRecorder->beginFrame();
+    if (!frame)
+      return;
+  }
+
   collision::CollisionDetector* cd
       = getConstraintSolver()->getCollisionDetector();
-  int nContacts = cd->getNumContacts();
   int nSkeletons = getNumSkeletons();
-  Eigen::VectorXd state(getIndex(nSkeletons) + 6 * nContacts);
+
+  // Fill the frame in place, reusing the capacity of its vectors
+  frame->mPositions.resize(getIndex(nSkeletons));
   for (size_t i = 0; i < getNumSkeletons(); i++)
   {
-    state.segment(getIndex(i), getSkeleton(i)->getNumDofs())
-        = getSkeleton(i)->getPositions();
+    Eigen::Map<Eigen::VectorXd>(
+          frame->mPositions.data() + getIndex(i),
+          getSkeleton(i)->getNumDofs()) = getSkeleton(i)->getPositions();
   }
-  for (int i = 0; i < nContacts; i++)
+
+  // Predicted contacts are left out since their points lie on the bodies
+  // before they touch
+  int nContacts = 0;
+  frame->mContacts.resize(6 * cd->getNumContacts());
+  for (size_t i = 0; i < cd->getNumContacts(); i++)
   {
-    int begin = getIndex(nSkeletons) + i * 6;
-    state.segment(begin, 3)     = cd->getContact(i).point;
-    state.segment(begin + 3, 3) = cd->getContact(i).force;
+    const collision::ContactRecord& contact = cd->getContactRecord(i);
+    if (contact.timeOfImpact > 0.0)
+      continue;
+
+    Eigen::Map<Eigen::Vector3d>(&frame->mContacts[nContacts * 6])
+        = contact.point;
+    Eigen::Map<Eigen::Vector3d>(&frame->mContacts[nContacts * 6 + 3])
+        = contact.force;
+    ++nContacts;
   }
-  mRecording->addState(state);
+  frame->mContacts.resize(6 * nContacts);
+
+  if (mAsyncRecorder)
+    mAsyncRecorder->endFrame();
+  else
+    mRecording->addState(frame->mPositions.data(), frame->mContacts.data(),
+                         nContacts);
 }
 
 //==============================================================================
 Recording* World::getRecording()
 {
+  if (mAsyncRecorder)
+    mAsyncRecorder->flush();
+
   return mRecording;
 }
 
+//==============================================================================
+void World::setBakeDecimation(size_t _decimation)
+{
+  assert(_decimation > 0u);
+  mBakeDecimation = _decimation;
+}
+
+//==============================================================================
+size_t World::getBakeDecimation() const
+{
+  return mBakeDecimation;
+}
+
+//==============================================================================
+void World::setAsyncBaking(bool _async, size_t _capacity,
+                           AsyncRecorder::OverflowPolicy _policy)
+{
+  // Destroying the recorder stores its pending frames
+  mAsyncRecorder.reset();
+
+  if (_async)
+    mAsyncRecorder.reset(new AsyncRecorder(mRecording, _capacity, _policy));
+}
+
+//==============================================================================
+bool World::isAsyncBaking() const
+{
+  return mAsyncRecorder != nullptr;
+}
+
+//==============================================================================
+AsyncRecorder* World::getAsyncRecorder() const
+{
+  return mAsyncRecorder.get();
+}
+
+//==============================================================================
+void World::integrate(double _timeStep)
+{
+  // Integrate velocity for unconstrained skeletons
+  for (auto& skel : mSkeletons)
+  {
+    if (!skel->isMobile() || skel->isSleeping())
+      continue;
+
+    skel->computeForwardDynamics();
+    skel->integrateVelocities(_timeStep);
+  }
+
+  // Detect activated constraints and compute constraint impulses
+  mConstraintSolver->solve();
+
+  // Compute velocity changes given constraint impulses
+  for (auto& skel : mSkeletons)
+  {
+    if (!skel->isMobile() || skel->isSleeping())
+      continue;
+
+    if (skel->isImpulseApplied())
+    {
+      skel->computeImpulseForwardDynamics();
+      skel->setImpulseApplied(false);
+    }
+
+    skel->integratePositions(_timeStep);
+  }
+}
+
+//==============================================================================
+void World::integrateAdaptively()
+{
+  // Sub-steps are numbered in units of mTimeStep / numSubSteps. Halving the
+  // sub-step doubles both counters, so the step always ends exactly at
+  // mTimeStep.
+  size_t numSubSteps = 1u;
+  size_t numTaken = 0u;
+  while (numTaken < numSubSteps)
+  {
+    const double timeStep = mTimeStep / numSubSteps;
+    if (numSubSteps > 1u)
+      setSubStepTimeStep(timeStep);
+
+    saveSubStepState();
+    integrate(timeStep);
+
+    const double error = computeSubStepError(timeStep);
+    if (error > mErrorTolerance && 2u * numSubSteps <= mMaxNumSubSteps)
+    {
+      restoreSubStepState();
+      numSubSteps *= 2u;
+      numTaken *= 2u;
+      ++mSubSteppingStatistics.mNumRejectedSubSteps;
+      continue;
+    }
+
+    mSubSteppingStatistics.mMaxError
+        = std::max(mSubSteppingStatistics.mMaxError, error);
+    ++mSubSteppingStatistics.mNumSubSteps;
+    ++numTaken;
+  }
+
+  if (numSubSteps > 1u)
+    setSubStepTimeStep(mTimeStep);
+
+  ++mSubSteppingStatistics.mNumSteps;
+  mSubSteppingStatistics.mMaxNumSubStepsPerStep
+      = std::max(mSubSteppingStatistics.mMaxNumSubStepsPerStep, numSubSteps);
+}
+
+//==============================================================================
+void World::setSubStepTimeStep(double _timeStep)
+{
+  mConstraintSolver->setTimeStep(_timeStep);
+  for (auto& skel : mSkeletons)
+    skel->setTimeStep(_timeStep);
+}
+
+//==============================================================================
+void World::saveSubStepState()
+{
+  mSubStepSkeletons.clear();
+  mSubStepSleeping.clear();
+  for (auto& skel : mSkeletons)
+  {
+    if (!skel->isMobile())
+      continue;
+
+    mSubStepSkeletons.push_back(skel.get());
+    mSubStepSleeping.push_back(skel->isSleeping());
+  }
+
+  mSubStepPositions.resize(mSubStepSkeletons.size());
+  mSubStepVelocities.resize(mSubStepSkeletons.size());
+  for (size_t i = 0; i < mSubStepSkeletons.size(); ++i)
+  {
+    getState(mSubStepSkeletons[i],
+             mSubStepPositions[i], mSubStepVelocities[i]);
+  }
+}
+
+//==============================================================================
+void World::restoreSubStepState()
+{
+  for (size_t i = 0; i < mSubStepSkeletons.size(); ++i)
+  {
+    setState(mSubStepSkeletons[i],
+             mSubStepPositions[i], mSubStepVelocities[i]);
+    mSubStepSkeletons[i]->setSleeping(mSubStepSleeping[i]);
+  }
+}
+
+//==============================================================================
+double World::computeSubStepError(double _timeStep)
+{
+  // Explicit Euler would have moved the positions by h*v_old instead of
+  // h*v_new, which bounds the local error of the first order update
+  double error = 0.0;
+  Eigen::VectorXd positions;
+  Eigen::VectorXd velocities;
+  for (size_t i = 0; i < mSubStepSkeletons.size(); ++i)
+  {
+    getState(mSubStepSkeletons[i], positions, velocities);
+    if (velocities.size() == 0)
+      continue;
+
+    error = std::max(error, 0.5 * _timeStep
+                     * (velocities - mSubStepVelocities[i]).cwiseAbs()
+                       .maxCoeff());
+  }
+
+  // Penetration that the sub-step has added on top of the penetration the
+  // constraint solver has just seen. The contacts of the solver carry the
+  // contact forces that are recorded, so the ones found at the end of the
+  // sub-step are only used for this and discarded.
+  collision::CollisionDetector* detector
+      = mConstraintSolver->getCollisionDetector();
+  const double penetration = getMaxPenetrationDepth(detector);
+  detector->swapContactRecords(mSubStepContacts);
+  detector->detectCollision(true, true);
+  error = std::max(error, getMaxPenetrationDepth(detector) - penetration);
+  detector->swapContactRecords(mSubStepContacts);
+
+  return error;
+}
+
 //==============================================================================
 void World::handleSkeletonNameChange(
     dynamics::ConstMetaSkeletonPtr _skeleton)
@@ -43,6 +43,7 @@
 #ifndef DART_SIMULATION_WORLD_H_
 #define DART_SIMULATION_WORLD_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <set>
@@ -52,6 +53,8 @@
 #include "dart/common/Timer.h"
 #include "dart/common/NameManager.h"
 #include "dart/common/Subject.h"
+#include "dart/collision/CollisionDetector.h"
+#include "dart/simulation/AsyncRecorder.h"
 #include "dart/simulation/Recording.h"
 #include "dart/dynamics/SimpleFrame.h"
 #include "dart/dynamics/Skeleton.h"
@@ -120,6 +123,15 @@ public:
   /// Get time step
   double getTimeStep() const;
 
+  /// Set whether the edge springs of soft bodies are integrated with
+  /// linearized backward Euler in all the skeletons of this world. Joint
+  /// springs and damping are always implicit. The implicit mode keeps stiff
+  /// soft bodies stable at much larger time steps. It is disabled by default.
+  void setImplicitSpringIntegration(bool _implicit);
+
+  /// Return true if the edge springs of soft bodies are integrated implicitly
+  bool isImplicitSpringIntegration() const;
+
   //--------------------------------------------------------------------------
   // Structural Properties
   //--------------------------------------------------------------------------
@@ -198,6 +210,73 @@ public:
   /// getSimpleFrame()
   int getSimFrames() const;
 
+  /// Statistics of adaptive time stepping
+  struct SubSteppingStatistics
+  {
+    /// Number of calls to step()
+    size_t mNumSteps;
+
+    /// Number of accepted sub-steps. Equal to mNumSteps if no step had to be
+    /// subdivided.
+    size_t mNumSubSteps;
+
+    /// Number of sub-steps that were rolled back because their error exceeded
+    /// the tolerance
+    size_t mNumRejectedSubSteps;
+
+    /// Largest number of sub-steps a single step was divided into
+    size_t mMaxNumSubStepsPerStep;
+
+    /// Largest error estimate of an accepted sub-step
+    double mMaxError;
+
+    /// Constructor
+    SubSteppingStatistics();
+  };
+
+  /// Enable or disable adaptive time stepping. When enabled, step() first
+  /// tries to take a single step of the world time step. If the error
+  /// estimate of that step exceeds the error tolerance, the state is rolled
+  /// back and the step is taken as two half steps, each of which is checked
+  /// in the same way, until the tolerance or the maximum number of sub-steps
+  /// is reached. Every call to step() still advances the time by exactly
+  /// getTimeStep().
+  ///
+  /// The error estimate of a sub-step of size h is the larger of
+  /// - h/2 times the largest change of a generalized velocity (including
+  ///   point masses), which is the difference between the explicit and the
+  ///   semi-implicit Euler updates of the positions, and
+  /// - the increase of the largest penetration depth over the sub-step.
+  ///
+  /// The second one requires one extra collision check per sub-step, after
+  /// which the collision detector holds the contacts at the end of the step.
+  void setAdaptiveTimeStepping(bool _adaptive);
+
+  /// Return true if adaptive time stepping is enabled
+  bool isAdaptiveTimeStepping() const;
+
+  /// Set the error tolerance of adaptive time stepping. The error is measured
+  /// in the units of the generalized coordinates, so in meters for
+  /// translations and radians for rotations.
+  void setErrorTolerance(double _tolerance);
+
+  /// Get the error tolerance of adaptive time stepping
+  double getErrorTolerance() const;
+
+  /// Set the maximum number of sub-steps per step. Steps are halved, so the
+  /// largest power of two that does not exceed this number is used.
+  void setMaxNumSubSteps(size_t _maxNumSubSteps);
+
+  /// Get the maximum number of sub-steps per step
+  size_t getMaxNumSubSteps() const;
+
+  /// Get the statistics of adaptive time stepping since the last reset
+  const SubSteppingStatistics& getSubSteppingStatistics() const;
+
+  /// Reset the statistics of adaptive time stepping. This is also done by
+  /// reset().
+  void resetSubSteppingStatistics();
+
   //--------------------------------------------------------------------------
   // Constraint
   //--------------------------------------------------------------------------
@@ -208,11 +287,55 @@ public:
   /// Bake simulated current state and store it into mRecording
   void bake();
 
-  /// Get recording
+  /// Get recording. If baking is asynchronous, this waits until all the baked
+  /// frames are stored.
   Recording* getRecording();
 
+  /// Only record one out of every _decimation calls to bake()
+  void setBakeDecimation(size_t _decimation);
+
+  /// Get the number of calls to bake() per recorded frame
+  size_t getBakeDecimation() const;
+
+  /// Enable or disable asynchronous baking. When enabled, bake() only copies
+  /// the state into a ring buffer of _capacity frames, and the frames are
+  /// stored into the recording by a background thread. _policy decides what
+  /// happens when the background thread falls behind.
+  void setAsyncBaking(bool _async, size_t _capacity = 256,
+                      AsyncRecorder::OverflowPolicy _policy
+                          = AsyncRecorder::DROP_FRAMES);
+
+  /// Return true if baking is asynchronous
+  bool isAsyncBaking() const;
+
+  /// Get the recorder used for asynchronous baking, which reports dropped
+  /// frames and backpressure. Returns nullptr if baking is synchronous.
+  AsyncRecorder* getAsyncRecorder() const;
+
 protected:
 
+  /// Integrate the mobile skeletons that are awake by _timeStep
+  void integrate(double _timeStep);
+
+  /// Integrate by getTimeStep(), subdividing the step where the error
+  /// estimate exceeds the tolerance
+  void integrateAdaptively();
+
+  /// Set the time step of the skeletons and the constraint solver without
+  /// changing the time step of this world
+  void setSubStepTimeStep(double _timeStep);
+
+  /// Store the positions, velocities and sleeping states of the mobile
+  /// skeletons
+  void saveSubStepState();
+
+  /// Restore the states stored by saveSubStepState()
+  void restoreSubStepState();
+
+  /// Return the error estimate of the sub-step of size _timeStep taken since
+  /// the last call to saveSubStepState()
+  double computeSubStepError(double _timeStep);
+
   /// Register when a Skeleton's name is changed
   void handleSkeletonNameChange(dynamics::ConstMetaSkeletonPtr _skeleton);
 
@@ -260,6 +383,41 @@ protected:
   /// Simulation time step
   double mTimeStep;
 
+  /// True if the edge springs of soft bodies are integrated implicitly
+  bool mImplicitSpringIntegration;
+
+  /// True if steps are subdivided when their error is too large
+  bool mAdaptiveTimeStepping;
+
+  /// Error tolerance of adaptive time stepping
+  double mErrorTolerance;
+
+  /// Maximum number of sub-steps per step
+  size_t mMaxNumSubSteps;
+
+  /// Statistics of adaptive time stepping
+  SubSteppingStatistics mSubSteppingStatistics;
+
+  /// Mobile skeletons at the beginning of the current sub-step
+  std::vector<dynamics::Skeleton*> mSubStepSkeletons;
+
+  /// Whether mSubStepSkeletons were sleeping at the beginning of the current
+  /// sub-step. The constraint solver wakes up the islands that the sub-step
+  /// touches, which has to be undone when the sub-step is rejected.
+  std::vector<bool> mSubStepSleeping;
+
+  /// Positions of mSubStepSkeletons and their point masses at the beginning
+  /// of the current sub-step
+  std::vector<Eigen::VectorXd> mSubStepPositions;
+
+  /// Velocities of mSubStepSkeletons and their point masses at the beginning
+  /// of the current sub-step
+  std::vector<Eigen::VectorXd> mSubStepVelocities;
+
+  /// Contacts of the last constraint solve, which are set aside while the
+  /// penetration at the end of a sub-step is measured
+  std::vector<collision::ContactRecord> mSubStepContacts;
+
   /// Current simulation time
   double mTime;
 
@@ -272,6 +430,18 @@ protected:
   ///
   Recording* mRecording;
 
+  /// Recorder for asynchronous baking
+  std::unique_ptr<AsyncRecorder> mAsyncRecorder;
+
+  /// Number of calls to bake() per recorded frame
+  size_t mBakeDecimation;
+
+  /// Number of calls to bake() since the last reset
+  size_t mNumBakeCalls;
+
+  /// Scratch frame for synchronous baking
+  AsyncRecorder::Frame mBakeFrame;
+
   //--------------------------------------------------------------------------
   // Signals
   //--------------------------------------------------------------------------
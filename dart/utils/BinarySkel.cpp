@@ -0,0 +1,1652 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/utils/BinarySkel.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <vector>
+
+#include "dart/common/Console.h"
+#include "dart/common/LocalResourceRetriever.h"
+#include "dart/dynamics/ArrowShape.h"
+#include "dart/dynamics/BallJoint.h"
+#include "dart/dynamics/BodyNode.h"
+#include "dart/dynamics/BoxShape.h"
+#include "dart/dynamics/CylinderShape.h"
+#include "dart/dynamics/EllipsoidShape.h"
+#include "dart/dynamics/EulerJoint.h"
+#include "dart/dynamics/FreeJoint.h"
+#include "dart/dynamics/LineSegmentShape.h"
+#include "dart/dynamics/MeshCache.h"
+#include "dart/dynamics/MeshShape.h"
+#include "dart/dynamics/PlanarJoint.h"
+#include "dart/dynamics/PlaneShape.h"
+#include "dart/dynamics/PointMass.h"
+#include "dart/dynamics/PrismaticJoint.h"
+#include "dart/dynamics/RevoluteJoint.h"
+#include "dart/dynamics/ScrewJoint.h"
+#include "dart/dynamics/ShapeNode.h"
+#include "dart/dynamics/SimpleFrame.h"
+#include "dart/dynamics/SoftBodyNode.h"
+#include "dart/dynamics/TranslationalJoint.h"
+#include "dart/dynamics/UniversalJoint.h"
+#include "dart/dynamics/WeldJoint.h"
+
+namespace dart {
+namespace utils {
+
+namespace BinarySkel {
+
+const std::string Extension = ".dartskel";
+
+} // namespace BinarySkel
+
+namespace {
+
+using namespace dynamics;
+
+const char FILE_MAGIC[8] = { 'D', 'A', 'R', 'T', 'S', 'K', 'L', '\0' };
+
+/// Incremented whenever the layout of the file changes
+const uint32_t FILE_VERSION = 3u;
+
+/// What the file contains
+enum ContentType : uint32_t
+{
+  CONTENT_SKELETON = 1u,
+  CONTENT_WORLD = 2u
+};
+
+/// Shape types as stored in the file. These are independent of
+/// Shape::ShapeType so that the file format does not change along with it.
+enum ShapeRecordType : uint8_t
+{
+  SHAPE_NONE = 0u,
+  SHAPE_BOX,
+  SHAPE_ELLIPSOID,
+  SHAPE_CYLINDER,
+  SHAPE_PLANE,
+  SHAPE_MESH,
+  SHAPE_LINE_SEGMENT,
+  SHAPE_ARROW
+};
+
+/// Kinds of parent Frames of a SimpleFrame
+enum ParentRecordType : uint8_t
+{
+  PARENT_WORLD = 0u,
+  PARENT_SIMPLE_FRAME,
+  PARENT_BODY_NODE
+};
+
+//==============================================================================
+/// Appends values to a buffer in the native byte order
+class Writer
+{
+public:
+  template <typename T>
+  void write(const T& value)
+  {
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                  "Only arithmetic values can be written directly");
+    const char* data = reinterpret_cast<const char*>(&value);
+    mBuffer.insert(mBuffer.end(), data, data + sizeof(T));
+  }
+
+  void writeSize(size_t size)
+  {
+    write(static_cast<uint64_t>(size));
+  }
+
+  void writeString(const std::string& value)
+  {
+    writeSize(value.size());
+    mBuffer.insert(mBuffer.end(), value.begin(), value.end());
+  }
+
+  template <typename Derived>
+  void writeMatrix(const Eigen::MatrixBase<Derived>& matrix)
+  {
+    for(int j = 0; j < matrix.cols(); ++j)
+      for(int i = 0; i < matrix.rows(); ++i)
+        write(static_cast<double>(matrix(i, j)));
+  }
+
+  void writeVector(const Eigen::VectorXd& vector)
+  {
+    writeSize(static_cast<size_t>(vector.size()));
+    writeMatrix(vector);
+  }
+
+  void writeTransform(const Eigen::Isometry3d& tf)
+  {
+    writeMatrix(tf.affine());
+  }
+
+  bool save(const std::string& fileName) const
+  {
+    std::ofstream file(fileName.c_str(), std::ios::binary);
+    if(!file)
+      return false;
+
+    file.write(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+    return static_cast<bool>(file);
+  }
+
+private:
+  std::vector<char> mBuffer;
+};
+
+//==============================================================================
+/// Reads values from a buffer. Reading past the end of the buffer puts the
+/// Reader into a failed state in which every read returns zero.
+class Reader
+{
+public:
+  Reader(const char* data, size_t size)
+    : mData(data), mEnd(data + size), mFailed(false)
+  {
+    // Do nothing
+  }
+
+  bool failed() const
+  {
+    return mFailed;
+  }
+
+  void fail()
+  {
+    mFailed = true;
+    mData = mEnd;
+  }
+
+  template <typename T>
+  T read()
+  {
+    T value;
+    if(!take(&value, sizeof(T)))
+      std::memset(&value, 0, sizeof(T));
+    return value;
+  }
+
+  bool readBool()
+  {
+    return read<uint8_t>() != 0u;
+  }
+
+  /// Read a number of elements. Each element takes at least one byte, which
+  /// bounds the result for corrupted files.
+  size_t readSize()
+  {
+    const uint64_t size = read<uint64_t>();
+    if(size > static_cast<uint64_t>(mEnd - mData))
+    {
+      fail();
+      return 0u;
+    }
+    return static_cast<size_t>(size);
+  }
+
+  std::string readString()
+  {
+    const size_t size = readSize();
+    std::string value(mData, mData + size);
+    mData += size;
+    return value;
+  }
+
+  template <typename Derived>
+  void readMatrix(Eigen::MatrixBase<Derived>& matrix)
+  {
+    for(int j = 0; j < matrix.cols(); ++j)
+      for(int i = 0; i < matrix.rows(); ++i)
+        matrix(i, j) = read<double>();
+  }
+
+  template <typename Derived>
+  void readMatrix(Eigen::MatrixBase<Derived>&& matrix)
+  {
+    readMatrix(matrix);
+  }
+
+  Eigen::VectorXd readVector()
+  {
+    Eigen::VectorXd vector(static_cast<int>(readSize()));
+    readMatrix(vector);
+    return vector;
+  }
+
+  Eigen::Isometry3d readTransform()
+  {
+    Eigen::Isometry3d tf;
+    readMatrix(tf.affine());
+    tf.makeAffine();
+    return tf;
+  }
+
+private:
+  bool take(void* value, size_t size)
+  {
+    if(mFailed || static_cast<size_t>(mEnd - mData) < size)
+    {
+      fail();
+      return false;
+    }
+
+    std::memcpy(value, mData, size);
+    mData += size;
+    return true;
+  }
+
+  const char* mData;
+  const char* mEnd;
+  bool mFailed;
+};
+
+//==============================================================================
+void writeBool(Writer& writer, bool value)
+{
+  writer.write(static_cast<uint8_t>(value));
+}
+
+//==============================================================================
+// Joints
+//==============================================================================
+void writeJointProperties(Writer& writer, const Joint::Properties& properties)
+{
+  writer.writeString(properties.mName);
+  writer.writeTransform(properties.mT_ParentBodyToJoint);
+  writer.writeTransform(properties.mT_ChildBodyToJoint);
+  writeBool(writer, properties.mIsPositionLimited);
+  writer.write(static_cast<int32_t>(properties.mActuatorType));
+}
+
+//==============================================================================
+void readJointProperties(Reader& reader, Joint::Properties& properties)
+{
+  properties.mName = reader.readString();
+  properties.mT_ParentBodyToJoint = reader.readTransform();
+  properties.mT_ChildBodyToJoint = reader.readTransform();
+  properties.mIsPositionLimited = reader.readBool();
+  properties.mActuatorType
+      = static_cast<Joint::ActuatorType>(reader.read<int32_t>());
+}
+
+//==============================================================================
+void writeSingleDofProperties(Writer& writer,
+                              const SingleDofJoint::Properties& properties)
+{
+  writeJointProperties(writer, properties);
+  writer.write(properties.mPositionLowerLimit);
+  writer.write(properties.mPositionUpperLimit);
+  writer.write(properties.mInitialPosition);
+  writer.write(properties.mVelocityLowerLimit);
+  writer.write(properties.mVelocityUpperLimit);
+  writer.write(properties.mInitialVelocity);
+  writer.write(properties.mAccelerationLowerLimit);
+  writer.write(properties.mAccelerationUpperLimit);
+  writer.write(properties.mForceLowerLimit);
+  writer.write(properties.mForceUpperLimit);
+  writer.write(properties.mSpringStiffness);
+  writer.write(properties.mRestPosition);
+  writer.write(properties.mDampingCoefficient);
+  writer.write(properties.mFriction);
+  writeBool(writer, properties.mPreserveDofName);
+  writer.writeString(properties.mDofName);
+}
+
+//==============================================================================
+void readSingleDofProperties(Reader& reader,
+                             SingleDofJoint::Properties& properties)
+{
+  readJointProperties(reader, properties);
+  properties.mPositionLowerLimit = reader.read<double>();
+  properties.mPositionUpperLimit = reader.read<double>();
+  properties.mInitialPosition = reader.read<double>();
+  properties.mVelocityLowerLimit = reader.read<double>();
+  properties.mVelocityUpperLimit = reader.read<double>();
+  properties.mInitialVelocity = reader.read<double>();
+  properties.mAccelerationLowerLimit = reader.read<double>();
+  properties.mAccelerationUpperLimit = reader.read<double>();
+  properties.mForceLowerLimit = reader.read<double>();
+  properties.mForceUpperLimit = reader.read<double>();
+  properties.mSpringStiffness = reader.read<double>();
+  properties.mRestPosition = reader.read<double>();
+  properties.mDampingCoefficient = reader.read<double>();
+  properties.mFriction = reader.read<double>();
+  properties.mPreserveDofName = reader.readBool();
+  properties.mDofName = reader.readString();
+}
+
+//==============================================================================
+template <size_t DOF>
+void writeMultiDofProperties(
+    Writer& writer, const typename MultiDofJoint<DOF>::Properties& properties)
+{
+  writeJointProperties(writer, properties);
+  writer.writeMatrix(properties.mPositionLowerLimits);
+  writer.writeMatrix(properties.mPositionUpperLimits);
+  writer.writeMatrix(properties.mInitialPositions);
+  writer.writeMatrix(properties.mVelocityLowerLimits);
+  writer.writeMatrix(properties.mVelocityUpperLimits);
+  writer.writeMatrix(properties.mInitialVelocities);
+  writer.writeMatrix(properties.mAccelerationLowerLimits);
+  writer.writeMatrix(properties.mAccelerationUpperLimits);
+  writer.writeMatrix(properties.mForceLowerLimits);
+  writer.writeMatrix(properties.mForceUpperLimits);
+  writer.writeMatrix(properties.mSpringStiffnesses);
+  writer.writeMatrix(properties.mRestPositions);
+  writer.writeMatrix(properties.mDampingCoefficients);
+  writer.writeMatrix(properties.mFrictions);
+  for(size_t i = 0; i < DOF; ++i)
+  {
+    writeBool(writer, properties.mPreserveDofNames[i]);
+    writer.writeString(properties.mDofNames[i]);
+  }
+}
+
+//==============================================================================
+template <size_t DOF>
+void readMultiDofProperties(
+    Reader& reader, typename MultiDofJoint<DOF>::Properties& properties)
+{
+  readJointProperties(reader, properties);
+  reader.readMatrix(properties.mPositionLowerLimits);
+  reader.readMatrix(properties.mPositionUpperLimits);
+  reader.readMatrix(properties.mInitialPositions);
+  reader.readMatrix(properties.mVelocityLowerLimits);
+  reader.readMatrix(properties.mVelocityUpperLimits);
+  reader.readMatrix(properties.mInitialVelocities);
+  reader.readMatrix(properties.mAccelerationLowerLimits);
+  reader.readMatrix(properties.mAccelerationUpperLimits);
+  reader.readMatrix(properties.mForceLowerLimits);
+  reader.readMatrix(properties.mForceUpperLimits);
+  reader.readMatrix(properties.mSpringStiffnesses);
+  reader.readMatrix(properties.mRestPositions);
+  reader.readMatrix(properties.mDampingCoefficients);
+  reader.readMatrix(properties.mFrictions);
+  for(size_t i = 0; i < DOF; ++i)
+  {
+    properties.mPreserveDofNames[i] = reader.readBool();
+    properties.mDofNames[i] = reader.readString();
+  }
+}
+
+//==============================================================================
+/// Write the type and the Properties of joint. Returns false if the type of
+/// Joint is not supported.
+bool writeJoint(Writer& writer, const Joint* joint)
+{
+  const std::string& type = joint->getType();
+  writer.writeString(type);
+
+  if(type == WeldJoint::getStaticType())
+  {
+    writeJointProperties(writer, static_cast<const WeldJoint*>(
+                           joint)->getWeldJointProperties());
+  }
+  else if(type == RevoluteJoint::getStaticType())
+  {
+    const RevoluteJoint::Properties properties
+        = static_cast<const RevoluteJoint*>(joint)->getRevoluteJointProperties();
+    writeSingleDofProperties(writer, properties);
+    writer.writeMatrix(properties.mAxis);
+  }
+  else if(type == PrismaticJoint::getStaticType())
+  {
+    const PrismaticJoint::Properties properties
+        = static_cast<const PrismaticJoint*>(
+            joint)->getPrismaticJointProperties();
+    writeSingleDofProperties(writer, properties);
+    writer.writeMatrix(properties.mAxis);
+  }
+  else if(type == ScrewJoint::getStaticType())
+  {
+    const ScrewJoint::Properties properties
+        = static_cast<const ScrewJoint*>(joint)->getScrewJointProperties();
+    writeSingleDofProperties(writer, properties);
+    writer.writeMatrix(properties.mAxis);
+    writer.write(properties.mPitch);
+  }
+  else if(type == UniversalJoint::getStaticType())
+  {
+    const UniversalJoint::Properties properties
+        = static_cast<const UniversalJoint*>(
+            joint)->getUniversalJointProperties();
+    writeMultiDofProperties<2>(writer, properties);
+    writer.writeMatrix(properties.mAxis[0]);
+    writer.writeMatrix(properties.mAxis[1]);
+  }
+  else if(type == TranslationalJoint::getStaticType())
+  {
+    writeMultiDofProperties<3>(writer, static_cast<const TranslationalJoint*>(
+                                 joint)->getTranslationalJointProperties());
+  }
+  else if(type == BallJoint::getStaticType())
+  {
+    writeMultiDofProperties<3>(writer, static_cast<const BallJoint*>(
+                                 joint)->getBallJointProperties());
+  }
+  else if(type == EulerJoint::getStaticType())
+  {
+    const EulerJoint::Properties properties
+        = static_cast<const EulerJoint*>(joint)->getEulerJointProperties();
+    writeMultiDofProperties<3>(writer, properties);
+    writer.write(static_cast<int32_t>(properties.mAxisOrder));
+  }
+  else if(type == PlanarJoint::getStaticType())
+  {
+    const PlanarJoint::Properties properties
+        = static_cast<const PlanarJoint*>(joint)->getPlanarJointProperties();
+    writeMultiDofProperties<3>(writer, properties);
+    writer.write(static_cast<int32_t>(properties.mPlaneType));
+    writer.writeMatrix(properties.mTransAxis1);
+    writer.writeMatrix(properties.mTransAxis2);
+    writer.writeMatrix(properties.mRotAxis);
+  }
+  else if(type == FreeJoint::getStaticType())
+  {
+    writeMultiDofProperties<6>(writer, static_cast<const FreeJoint*>(
+                                 joint)->getFreeJointProperties());
+  }
+  else
+  {
+    dtwarn << "[BinarySkel::writeSkeleton] Unsupported Joint type [" << type
+           << "] of Joint [" << joint->getName() << "].\n";
+    return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+// BodyNodes
+//==============================================================================
+void writeBodyNodeProperties(Writer& writer, const BodyNode* bodyNode,
+                             const BodyNode::Properties& properties)
+{
+  writer.writeString(properties.mName);
+
+  const Inertia& inertia = properties.mInertia;
+  writer.write(inertia.getMass());
+  writer.writeMatrix(inertia.getLocalCOM());
+  for(int i = Inertia::I_XX; i <= Inertia::I_YZ; ++i)
+    writer.write(inertia.getParameter(static_cast<Inertia::Param>(i)));
+
+  writeBool(writer, properties.mIsCollidable);
+  writer.write(properties.mFrictionCoeff);
+  writer.write(properties.mRestitutionCoeff);
+  writeBool(writer, properties.mGravityMode);
+  writeBool(writer, properties.mContinuousCollision);
+
+  // Markers that were added through BodyNode::addMarker() are missing from
+  // the Properties, so they are taken from the BodyNode itself
+  writer.writeSize(bodyNode->getNumMarkers());
+  for(size_t i = 0; i < bodyNode->getNumMarkers(); ++i)
+  {
+    const Marker::Properties& marker
+        = bodyNode->getMarker(i)->getMarkerProperties();
+    writer.writeString(marker.mName);
+    writer.writeMatrix(marker.mOffset);
+    writer.writeMatrix(marker.mColor);
+    writer.write(static_cast<int32_t>(marker.mType));
+  }
+}
+
+//==============================================================================
+void readBodyNodeProperties(Reader& reader, BodyNode::Properties& properties)
+{
+  properties.mName = reader.readString();
+
+  const double mass = reader.read<double>();
+  Eigen::Vector3d com;
+  reader.readMatrix(com);
+  double moment[6];
+  for(size_t i = 0; i < 6; ++i)
+    moment[i] = reader.read<double>();
+  properties.mInertia = Inertia(mass, com[0], com[1], com[2], moment[0],
+                                moment[1], moment[2], moment[3], moment[4],
+                                moment[5]);
+
+  properties.mIsCollidable = reader.readBool();
+  properties.mFrictionCoeff = reader.read<double>();
+  properties.mRestitutionCoeff = reader.read<double>();
+  properties.mGravityMode = reader.readBool();
+  properties.mContinuousCollision = reader.readBool();
+
+  properties.mMarkerProperties.resize(reader.readSize());
+  for(Marker::Properties& marker : properties.mMarkerProperties)
+  {
+    marker.mName = reader.readString();
+    reader.readMatrix(marker.mOffset);
+    reader.readMatrix(marker.mColor);
+    marker.mType = static_cast<Marker::ConstraintType>(reader.read<int32_t>());
+  }
+}
+
+//==============================================================================
+void writeSoftBodyNodeProperties(Writer& writer,
+                                 const SoftBodyNode::UniqueProperties& properties)
+{
+  writer.write(properties.mKv);
+  writer.write(properties.mKe);
+  writer.write(properties.mDampCoeff);
+
+  writer.writeSize(properties.mPointProps.size());
+  for(const PointMass::Properties& point : properties.mPointProps)
+  {
+    writer.writeMatrix(point.mX0);
+    writer.write(point.mMass);
+    writer.writeSize(point.mConnectedPointMassIndices.size());
+    for(const size_t index : point.mConnectedPointMassIndices)
+      writer.writeSize(index);
+    writer.writeMatrix(point.mPositionLowerLimits);
+    writer.writeMatrix(point.mPositionUpperLimits);
+    writer.writeMatrix(point.mVelocityLowerLimits);
+    writer.writeMatrix(point.mVelocityUpperLimits);
+    writer.writeMatrix(point.mAccelerationLowerLimits);
+    writer.writeMatrix(point.mAccelerationUpperLimits);
+    writer.writeMatrix(point.mForceLowerLimits);
+    writer.writeMatrix(point.mForceUpperLimits);
+  }
+
+  writer.writeSize(properties.mFaces.size());
+  for(const Eigen::Vector3i& face : properties.mFaces)
+  {
+    for(size_t i = 0; i < 3; ++i)
+      writer.write(static_cast<int32_t>(face[i]));
+  }
+}
+
+//==============================================================================
+void readSoftBodyNodeProperties(Reader& reader,
+                                SoftBodyNode::UniqueProperties& properties)
+{
+  properties.mKv = reader.read<double>();
+  properties.mKe = reader.read<double>();
+  properties.mDampCoeff = reader.read<double>();
+
+  properties.mPointProps.resize(reader.readSize());
+  for(PointMass::Properties& point : properties.mPointProps)
+  {
+    reader.readMatrix(point.mX0);
+    point.mMass = reader.read<double>();
+    point.mConnectedPointMassIndices.resize(reader.readSize());
+    for(size_t& index : point.mConnectedPointMassIndices)
+      index = static_cast<size_t>(reader.read<uint64_t>());
+    reader.readMatrix(point.mPositionLowerLimits);
+    reader.readMatrix(point.mPositionUpperLimits);
+    reader.readMatrix(point.mVelocityLowerLimits);
+    reader.readMatrix(point.mVelocityUpperLimits);
+    reader.readMatrix(point.mAccelerationLowerLimits);
+    reader.readMatrix(point.mAccelerationUpperLimits);
+    reader.readMatrix(point.mForceLowerLimits);
+    reader.readMatrix(point.mForceUpperLimits);
+  }
+
+  properties.mFaces.resize(reader.readSize());
+  for(Eigen::Vector3i& face : properties.mFaces)
+  {
+    for(size_t i = 0; i < 3; ++i)
+      face[i] = reader.read<int32_t>();
+  }
+
+  // Indices that point outside of the PointMasses would crash the
+  // SoftBodyNode
+  const size_t numPoints = properties.mPointProps.size();
+  for(const PointMass::Properties& point : properties.mPointProps)
+  {
+    for(const size_t index : point.mConnectedPointMassIndices)
+    {
+      if(index >= numPoints)
+        reader.fail();
+    }
+  }
+
+  for(const Eigen::Vector3i& face : properties.mFaces)
+  {
+    for(size_t i = 0; i < 3; ++i)
+    {
+      if(face[i] < 0 || static_cast<size_t>(face[i]) >= numPoints)
+        reader.fail();
+    }
+  }
+
+  if(properties.mKv < 0.0 || properties.mKe < 0.0
+     || properties.mDampCoeff < 0.0)
+    reader.fail();
+}
+
+//==============================================================================
+// Shapes
+//==============================================================================
+void writeShape(Writer& writer, const ConstShapePtr& shape)
+{
+  if(!shape)
+  {
+    writer.write(SHAPE_NONE);
+    return;
+  }
+
+  if(const auto arrow = std::dynamic_pointer_cast<const ArrowShape>(shape))
+  {
+    writer.write(SHAPE_ARROW);
+    writer.writeMatrix(arrow->getTail());
+    writer.writeMatrix(arrow->getHead());
+
+    const ArrowShape::Properties& properties = arrow->getProperties();
+    writer.write(properties.mRadius);
+    writer.write(properties.mHeadRadiusScale);
+    writer.write(properties.mHeadLengthScale);
+    writer.write(properties.mMinHeadLength);
+    writer.write(properties.mMaxHeadLength);
+    writeBool(writer, properties.mDoubleArrow);
+
+    // The color only exists in the vertex colors of the generated mesh
+    Eigen::Vector4d color(0.5, 0.5, 1.0, 1.0);
+    const aiScene* scene = arrow->getMesh();
+    if(scene && scene->mNumMeshes > 0 && scene->mMeshes[0]->mColors[0]
+       && scene->mMeshes[0]->mNumVertices > 0)
+    {
+      const aiColor4D& c = scene->mMeshes[0]->mColors[0][0];
+      color << c.r, c.g, c.b, c.a;
+    }
+    writer.writeMatrix(color);
+  }
+  else if(const auto box = std::dynamic_pointer_cast<const BoxShape>(shape))
+  {
+    writer.write(SHAPE_BOX);
+    writer.writeMatrix(box->getSize());
+  }
+  else if(const auto ellipsoid
+          = std::dynamic_pointer_cast<const EllipsoidShape>(shape))
+  {
+    writer.write(SHAPE_ELLIPSOID);
+    writer.writeMatrix(ellipsoid->getSize());
+  }
+  else if(const auto cylinder
+          = std::dynamic_pointer_cast<const CylinderShape>(shape))
+  {
+    writer.write(SHAPE_CYLINDER);
+    writer.write(cylinder->getRadius());
+    writer.write(cylinder->getHeight());
+  }
+  else if(const auto plane = std::dynamic_pointer_cast<const PlaneShape>(shape))
+  {
+    writer.write(SHAPE_PLANE);
+    writer.writeMatrix(plane->getNormal());
+    writer.write(plane->getOffset());
+  }
+  else if(const auto mesh = std::dynamic_pointer_cast<const MeshShape>(shape))
+  {
+    if(mesh->getMeshUri().empty())
+    {
+      dtwarn << "[BinarySkel] A MeshShape that was not loaded from a URI "
+             << "cannot be stored. It will be empty when it is read.\n";
+    }
+
+    writer.write(SHAPE_MESH);
+    writer.writeString(mesh->getMeshUri());
+    writer.writeMatrix(mesh->getScale());
+    writer.write(static_cast<int32_t>(mesh->getColorMode()));
+    writer.write(static_cast<int32_t>(mesh->getColorIndex()));
+  }
+  else if(const auto lines
+          = std::dynamic_pointer_cast<const LineSegmentShape>(shape))
+  {
+    writer.write(SHAPE_LINE_SEGMENT);
+    writer.write(lines->getThickness());
+    writer.writeSize(lines->getVertices().size());
+    for(const Eigen::Vector3d& vertex : lines->getVertices())
+      writer.writeMatrix(vertex);
+    writer.writeSize(lines->getConnections().size());
+    for(const Eigen::Vector2i& connection : lines->getConnections())
+    {
+      writer.write(static_cast<int32_t>(connection[0]));
+      writer.write(static_cast<int32_t>(connection[1]));
+    }
+  }
+  else
+  {
+    dtwarn << "[BinarySkel] Unsupported type of Shape. It will be missing "
+           << "when the file is read.\n";
+    writer.write(SHAPE_NONE);
+    return;
+  }
+
+  writer.write(static_cast<uint32_t>(shape->getDataVariance()));
+}
+
+//==============================================================================
+ShapePtr readShape(Reader& reader,
+                   const common::ResourceRetrieverPtr& retriever)
+{
+  ShapePtr shape;
+  switch(reader.read<ShapeRecordType>())
+  {
+    case SHAPE_NONE:
+      return nullptr;
+
+    case SHAPE_BOX:
+    {
+      Eigen::Vector3d size;
+      reader.readMatrix(size);
+      if(reader.failed() || (size.array() <= 0.0).any())
+        break;
+      shape = std::make_shared<BoxShape>(size);
+      break;
+    }
+
+    case SHAPE_ELLIPSOID:
+    {
+      Eigen::Vector3d size;
+      reader.readMatrix(size);
+      if(reader.failed() || (size.array() <= 0.0).any())
+        break;
+      shape = std::make_shared<EllipsoidShape>(size);
+      break;
+    }
+
+    case SHAPE_CYLINDER:
+    {
+      const double radius = reader.read<double>();
+      const double height = reader.read<double>();
+      if(reader.failed() || radius <= 0.0 || height <= 0.0)
+        break;
+      shape = std::make_shared<CylinderShape>(radius, height);
+      break;
+    }
+
+    case SHAPE_PLANE:
+    {
+      Eigen::Vector3d normal;
+      reader.readMatrix(normal);
+      const double offset = reader.read<double>();
+      if(reader.failed())
+        break;
+      shape = std::make_shared<PlaneShape>(normal, offset);
+      break;
+    }
+
+    case SHAPE_MESH:
+    {
+      const std::string uri = reader.readString();
+      Eigen::Vector3d scale;
+      reader.readMatrix(scale);
+      const int colorMode = reader.read<int32_t>();
+      const int colorIndex = reader.read<int32_t>();
+      if(reader.failed())
+        return nullptr;
+
+      std::shared_ptr<const aiScene> scene;
+      if(!uri.empty())
+        scene = MeshCache::getDefault().getMesh(uri, retriever);
+
+      const auto mesh
+          = std::make_shared<MeshShape>(scale, scene, uri, retriever);
+      mesh->setColorMode(static_cast<MeshShape::ColorMode>(colorMode));
+      mesh->setColorIndex(colorIndex);
+      shape = mesh;
+      break;
+    }
+
+    case SHAPE_LINE_SEGMENT:
+    {
+      const auto lines
+          = std::make_shared<LineSegmentShape>(reader.read<float>());
+      const size_t numVertices = reader.readSize();
+      for(size_t i = 0; i < numVertices; ++i)
+      {
+        Eigen::Vector3d vertex;
+        reader.readMatrix(vertex);
+        lines->addVertex(vertex);
+      }
+
+      const size_t numConnections = reader.readSize();
+      for(size_t i = 0; i < numConnections; ++i)
+      {
+        const int32_t index1 = reader.read<int32_t>();
+        const int32_t index2 = reader.read<int32_t>();
+        if(index1 < 0 || index2 < 0
+           || static_cast<size_t>(index1) >= numVertices
+           || static_cast<size_t>(index2) >= numVertices)
+        {
+          reader.fail();
+          return nullptr;
+        }
+        lines->addConnection(index1, index2);
+      }
+      shape = lines;
+      break;
+    }
+
+    case SHAPE_ARROW:
+    {
+      Eigen::Vector3d tail, head;
+      reader.readMatrix(tail);
+      reader.readMatrix(head);
+
+      ArrowShape::Properties properties;
+      properties.mRadius = reader.read<double>();
+      properties.mHeadRadiusScale = reader.read<double>();
+      properties.mHeadLengthScale = reader.read<double>();
+      properties.mMinHeadLength = reader.read<double>();
+      properties.mMaxHeadLength = reader.read<double>();
+      properties.mDoubleArrow = reader.readBool();
+
+      Eigen::Vector4d color;
+      reader.readMatrix(color);
+      if(reader.failed())
+        break;
+      shape = std::make_shared<ArrowShape>(tail, head, properties, color);
+      break;
+    }
+
+    default:
+      break;
+  }
+
+  if(!shape)
+  {
+    reader.fail();
+    return nullptr;
+  }
+
+  shape->setDataVariance(reader.read<uint32_t>());
+  return shape;
+}
+
+//==============================================================================
+/// Write the Shape and the standard Addons of frame
+void writeShapeFrame(Writer& writer, const ShapeFrame* frame)
+{
+  writeShape(writer, frame->getShape());
+
+  const VisualAddon* visual = frame->getVisualAddon();
+  writeBool(writer, visual != nullptr);
+  if(visual)
+  {
+    const VisualAddon::PropertiesData& properties = visual->getProperties();
+    writer.writeMatrix(properties.mRGBA);
+    writeBool(writer, properties.mUseDefaultColor);
+    writeBool(writer, properties.mHidden);
+  }
+
+  const CollisionAddon* collision = frame->getCollisionAddon();
+  writeBool(writer, collision != nullptr);
+  if(collision)
+    writeBool(writer, collision->getProperties().mCollidable);
+
+  const DynamicsAddon* dynamics = frame->getDynamicsAddon();
+  writeBool(writer, dynamics != nullptr);
+  if(dynamics)
+  {
+    writer.write(dynamics->getProperties().mFrictionCoeff);
+    writer.write(dynamics->getProperties().mRestitutionCoeff);
+  }
+}
+
+//==============================================================================
+/// Read the Addons of a ShapeFrame whose Shape has already been read
+void readShapeFrameAddons(Reader& reader, ShapeFrame* frame)
+{
+  if(reader.readBool())
+  {
+    VisualAddon::PropertiesData properties;
+    reader.readMatrix(properties.mRGBA);
+    properties.mUseDefaultColor = reader.readBool();
+    properties.mHidden = reader.readBool();
+    frame->getVisualAddon(true)->setProperties(properties);
+  }
+  else if(frame->hasVisualAddon())
+  {
+    frame->eraseVisualAddon();
+  }
+
+  if(reader.readBool())
+  {
+    CollisionAddon::PropertiesData properties;
+    properties.mCollidable = reader.readBool();
+    frame->getCollisionAddon(true)->setProperties(properties);
+  }
+  else if(frame->hasCollisionAddon())
+  {
+    frame->eraseCollisionAddon();
+  }
+
+  if(reader.readBool())
+  {
+    DynamicsAddon::PropertiesData properties;
+    properties.mFrictionCoeff = reader.read<double>();
+    properties.mRestitutionCoeff = reader.read<double>();
+    frame->getDynamicsAddon(true)->setProperties(properties);
+  }
+  else if(frame->hasDynamicsAddon())
+  {
+    frame->eraseDynamicsAddon();
+  }
+}
+
+//==============================================================================
+void writeShapeNodes(Writer& writer, const BodyNode* bodyNode)
+{
+  // The ShapeNode of a SoftBodyNode's soft mesh is created along with the
+  // SoftBodyNode, so it is not stored
+  std::vector<const ShapeNode*> shapeNodes;
+  for(size_t i = 0; i < bodyNode->getNumShapeNodes(); ++i)
+  {
+    const ShapeNode* shapeNode = bodyNode->getShapeNode(i);
+    const ConstShapePtr shape = shapeNode->getShape();
+    if(!shape || shape->getShapeType() != Shape::SOFT_MESH)
+      shapeNodes.push_back(shapeNode);
+  }
+
+  writer.writeSize(shapeNodes.size());
+  for(const ShapeNode* shapeNode : shapeNodes)
+  {
+    writer.writeString(shapeNode->getName());
+    writer.writeTransform(shapeNode->getRelativeTransform());
+    writeShapeFrame(writer, shapeNode);
+  }
+}
+
+//==============================================================================
+void readShapeNodes(Reader& reader, BodyNode* bodyNode,
+                    const common::ResourceRetrieverPtr& retriever)
+{
+  const size_t numShapeNodes = reader.readSize();
+  for(size_t i = 0; i < numShapeNodes && !reader.failed(); ++i)
+  {
+    const std::string name = reader.readString();
+    const Eigen::Isometry3d tf = reader.readTransform();
+    const ShapePtr shape = readShape(reader, retriever);
+    if(reader.failed())
+      return;
+
+    ShapeNode* shapeNode = bodyNode->createShapeNode(shape, name);
+    shapeNode->setRelativeTransform(tf);
+    readShapeFrameAddons(reader, shapeNode);
+  }
+}
+
+//==============================================================================
+// Skeletons
+//==============================================================================
+void writeSkeletonBlock(Writer& writer, const ConstSkeletonPtr& skeleton,
+                        bool& ok)
+{
+  const Skeleton::Properties& properties = skeleton->getSkeletonProperties();
+  writer.writeString(properties.mName);
+  writeBool(writer, properties.mIsMobile);
+  writer.writeMatrix(properties.mGravity);
+  writer.write(properties.mTimeStep);
+  writeBool(writer, properties.mEnabledSelfCollisionCheck);
+  writeBool(writer, properties.mEnabledAdjacentBodyCheck);
+  writeBool(writer, properties.mImplicitSpringIntegration);
+
+  writer.writeSize(skeleton->getNumBodyNodes());
+  for(size_t i = 0; i < skeleton->getNumBodyNodes(); ++i)
+  {
+    const BodyNode* bodyNode = skeleton->getBodyNode(i);
+    const BodyNode* parent = bodyNode->getParentBodyNode();
+    writer.write(static_cast<int64_t>(
+                   parent ? static_cast<int64_t>(parent->getIndexInSkeleton())
+                          : -1));
+
+    if(!writeJoint(writer, bodyNode->getParentJoint()))
+      ok = false;
+
+    const SoftBodyNode* softBodyNode
+        = dynamic_cast<const SoftBodyNode*>(bodyNode);
+    writeBool(writer, softBodyNode != nullptr);
+    if(softBodyNode)
+    {
+      const SoftBodyNode::Properties properties
+          = softBodyNode->getSoftBodyNodeProperties();
+      writeBodyNodeProperties(writer, bodyNode, properties);
+      writeSoftBodyNodeProperties(writer, properties);
+    }
+    else
+    {
+      writeBodyNodeProperties(writer, bodyNode,
+                              bodyNode->getBodyNodeProperties());
+    }
+
+    writeShapeNodes(writer, bodyNode);
+  }
+
+  writer.writeVector(skeleton->getPositions());
+  writer.writeVector(skeleton->getVelocities());
+  writer.writeVector(skeleton->getAccelerations());
+  writer.writeVector(skeleton->getForces());
+  writer.writeVector(skeleton->getCommands());
+
+  for(size_t i = 0; i < skeleton->getNumSoftBodyNodes(); ++i)
+  {
+    const SoftBodyNode* softBodyNode = skeleton->getSoftBodyNode(i);
+    for(size_t j = 0; j < softBodyNode->getNumPointMasses(); ++j)
+    {
+      const PointMass* pointMass = softBodyNode->getPointMass(j);
+      writer.writeMatrix(pointMass->getPositions());
+      writer.writeMatrix(pointMass->getVelocities());
+      writer.writeMatrix(pointMass->getAccelerations());
+      writer.writeMatrix(pointMass->getForces());
+    }
+  }
+}
+
+//==============================================================================
+template <class JointType>
+bool createBodyNode(Reader& reader, const SkeletonPtr& skeleton,
+                    BodyNode* parent,
+                    const typename JointType::Properties& joint,
+                    const common::ResourceRetrieverPtr& retriever)
+{
+  BodyNode* bodyNode;
+  if(reader.readBool())
+  {
+    SoftBodyNode::Properties properties;
+    readBodyNodeProperties(reader, properties);
+    readSoftBodyNodeProperties(reader, properties);
+    if(reader.failed())
+      return false;
+
+    bodyNode = skeleton->createJointAndBodyNodePair<JointType, SoftBodyNode>(
+          parent, joint, properties).second;
+  }
+  else
+  {
+    BodyNode::Properties properties;
+    readBodyNodeProperties(reader, properties);
+    if(reader.failed())
+      return false;
+
+    bodyNode = skeleton->createJointAndBodyNodePair<JointType>(
+          parent, joint, properties).second;
+  }
+
+  readShapeNodes(reader, bodyNode, retriever);
+  return !reader.failed();
+}
+
+//==============================================================================
+bool readJointAndBodyNode(Reader& reader, const SkeletonPtr& skeleton,
+                          BodyNode* parent,
+                          const common::ResourceRetrieverPtr& retriever)
+{
+  const std::string type = reader.readString();
+  if(reader.failed())
+    return false;
+
+  if(type == WeldJoint::getStaticType())
+  {
+    WeldJoint::Properties properties;
+    readJointProperties(reader, properties);
+    return createBodyNode<WeldJoint>(
+          reader, skeleton, parent, properties, retriever);
+  }
+  else if(type == RevoluteJoint::getStaticType())
+  {
+    RevoluteJoint::Properties properties;
+    readSingleDofProperties(reader, properties);
+    reader.readMatrix(properties.mAxis);
+    return createBodyNode<RevoluteJoint>(
+          reader, skeleton, parent, properties, retriever);
+  }
+  else if(type == PrismaticJoint::getStaticType())
+  {
+    PrismaticJoint::Properties properties;
+    readSingleDofProperties(reader, properties);
+    reader.readMatrix(properties.mAxis);
+    return createBodyNode<PrismaticJoint>(
+          reader, skeleton, parent, properties, retriever);
+  }
+  else if(type == ScrewJoint::getStaticType())
+  {
+    ScrewJoint::Properties properties;
+    readSingleDofProperties(reader, properties);
+    reader.readMatrix(properties.mAxis);
+    properties.mPitch = reader.read<double>();
+    return createBodyNode<ScrewJoint>(
+          reader, skeleton, parent, properties, retriever);
+  }
+  else if(type == UniversalJoint::getStaticType())
+  {
+    UniversalJoint::Properties properties;
+    readMultiDofProperties<2>(reader, properties);
+    reader.readMatrix(properties.mAxis[0]);
+    reader.readMatrix(properties.mAxis[1]);
+    return createBodyNode<UniversalJoint>(
+          reader, skeleton, parent, properties, retriever);
+  }
+  else if(type == TranslationalJoint::getStaticType())
+  {
+    TranslationalJoint::Properties properties;
+    readMultiDofProperties<3>(reader, properties);
+    return createBodyNode<TranslationalJoint>(
+          reader, skeleton, parent, properties, retriever);
+  }
+  else if(type == BallJoint::getStaticType())
+  {
+    BallJoint::Properties properties;
+    readMultiDofProperties<3>(reader, properties);
+    return createBodyNode<BallJoint>(
+          reader, skeleton, parent, properties, retriever);
+  }
+  else if(type == EulerJoint::getStaticType())
+  {
+    EulerJoint::Properties properties;
+    readMultiDofProperties<3>(reader, properties);
+    properties.mAxisOrder
+        = static_cast<EulerJoint::AxisOrder>(reader.read<int32_t>());
+    return createBodyNode<EulerJoint>(
+          reader, skeleton, parent, properties, retriever);
+  }
+  else if(type == PlanarJoint::getStaticType())
+  {
+    PlanarJoint::Properties properties;
+    readMultiDofProperties<3>(reader, properties);
+    properties.mPlaneType
+        = static_cast<PlanarJoint::PlaneType>(reader.read<int32_t>());
+    reader.readMatrix(properties.mTransAxis1);
+    reader.readMatrix(properties.mTransAxis2);
+    reader.readMatrix(properties.mRotAxis);
+    return createBodyNode<PlanarJoint>(
+          reader, skeleton, parent, properties, retriever);
+  }
+  else if(type == FreeJoint::getStaticType())
+  {
+    FreeJoint::Properties properties;
+    readMultiDofProperties<6>(reader, properties);
+    return createBodyNode<FreeJoint>(
+          reader, skeleton, parent, properties, retriever);
+  }
+
+  dtwarn << "[BinarySkel] Unsupported Joint type [" << type << "].\n";
+  reader.fail();
+  return false;
+}
+
+//==============================================================================
+SkeletonPtr readSkeletonBlock(Reader& reader,
+                              const common::ResourceRetrieverPtr& retriever)
+{
+  Skeleton::Properties properties;
+  properties.mName = reader.readString();
+  properties.mIsMobile = reader.readBool();
+  reader.readMatrix(properties.mGravity);
+  properties.mTimeStep = reader.read<double>();
+  properties.mEnabledSelfCollisionCheck = reader.readBool();
+  properties.mEnabledAdjacentBodyCheck = reader.readBool();
+  properties.mImplicitSpringIntegration = reader.readBool();
+  if(reader.failed())
+    return nullptr;
+
+  const SkeletonPtr skeleton = Skeleton::create(properties);
+
+  const size_t numBodyNodes = reader.readSize();
+  for(size_t i = 0; i < numBodyNodes; ++i)
+  {
+    // BodyNodes are stored in the order of their indices, so parents always
+    // come first
+    const int64_t parentIndex = reader.read<int64_t>();
+    if(parentIndex >= static_cast<int64_t>(i))
+      reader.fail();
+
+    if(reader.failed())
+      return nullptr;
+
+    BodyNode* parent = parentIndex < 0
+        ? nullptr : skeleton->getBodyNode(static_cast<size_t>(parentIndex));
+    if(!readJointAndBodyNode(reader, skeleton, parent, retriever))
+      return nullptr;
+  }
+
+  const Eigen::VectorXd positions = reader.readVector();
+  const Eigen::VectorXd velocities = reader.readVector();
+  const Eigen::VectorXd accelerations = reader.readVector();
+  const Eigen::VectorXd forces = reader.readVector();
+  const Eigen::VectorXd commands = reader.readVector();
+  const int numDofs = static_cast<int>(skeleton->getNumDofs());
+  if(positions.size() != numDofs || velocities.size() != numDofs
+     || accelerations.size() != numDofs || forces.size() != numDofs
+     || commands.size() != numDofs)
+  {
+    reader.fail();
+    return nullptr;
+  }
+
+  skeleton->setPositions(positions);
+  skeleton->setVelocities(velocities);
+  skeleton->setAccelerations(accelerations);
+  skeleton->setForces(forces);
+  skeleton->setCommands(commands);
+
+  for(size_t i = 0; i < skeleton->getNumSoftBodyNodes(); ++i)
+  {
+    SoftBodyNode* softBodyNode = skeleton->getSoftBodyNode(i);
+    for(size_t j = 0; j < softBodyNode->getNumPointMasses(); ++j)
+    {
+      PointMass* pointMass = softBodyNode->getPointMass(j);
+      Eigen::Vector3d value;
+      reader.readMatrix(value);
+      pointMass->setPositions(value);
+      reader.readMatrix(value);
+      pointMass->setVelocities(value);
+      reader.readMatrix(value);
+      pointMass->setAccelerations(value);
+      reader.readMatrix(value);
+      pointMass->setForces(value);
+    }
+  }
+
+  if(reader.failed())
+    return nullptr;
+
+  return skeleton;
+}
+
+//==============================================================================
+// Worlds
+//==============================================================================
+void writeSimpleFrames(Writer& writer, const simulation::WorldPtr& world)
+{
+  writer.writeSize(world->getNumSimpleFrames());
+  for(size_t i = 0; i < world->getNumSimpleFrames(); ++i)
+  {
+    const SimpleFramePtr frame = world->getSimpleFrame(i);
+    writer.writeString(frame->getName());
+
+    // Parents are identified by their indices in the World
+    const Frame* parent = frame->getParentFrame();
+    const BodyNode* parentBodyNode = dynamic_cast<const BodyNode*>(parent);
+    size_t parentFrameIndex = world->getNumSimpleFrames();
+    for(size_t j = 0; j < world->getNumSimpleFrames(); ++j)
+    {
+      if(world->getSimpleFrame(j).get() == parent)
+        parentFrameIndex = j;
+    }
+
+    size_t parentSkeletonIndex = world->getNumSkeletons();
+    if(parentBodyNode)
+    {
+      for(size_t j = 0; j < world->getNumSkeletons(); ++j)
+      {
+        if(world->getSkeleton(j) == parentBodyNode->getSkeleton())
+          parentSkeletonIndex = j;
+      }
+    }
+
+    if(parentFrameIndex < world->getNumSimpleFrames())
+    {
+      writer.write(PARENT_SIMPLE_FRAME);
+      writer.writeSize(parentFrameIndex);
+    }
+    else if(parentSkeletonIndex < world->getNumSkeletons())
+    {
+      writer.write(PARENT_BODY_NODE);
+      writer.writeSize(parentSkeletonIndex);
+      writer.writeSize(parentBodyNode->getIndexInSkeleton());
+    }
+    else
+    {
+      if(!parent->isWorld())
+      {
+        dtwarn << "[BinarySkel::writeWorld] The parent of SimpleFrame ["
+               << frame->getName() << "] is not part of the World. It will be "
+               << "attached to the World Frame when the file is read.\n";
+      }
+      writer.write(PARENT_WORLD);
+    }
+
+    writer.writeTransform(frame->getRelativeTransform());
+    writer.writeMatrix(frame->getRelativeSpatialVelocity());
+    writer.writeMatrix(frame->getRelativeSpatialAcceleration());
+    writeShapeFrame(writer, frame.get());
+  }
+}
+
+//==============================================================================
+bool readSimpleFrames(Reader& reader, const simulation::WorldPtr& world,
+                      const common::ResourceRetrieverPtr& retriever)
+{
+  struct Parent
+  {
+    ParentRecordType mType;
+    size_t mIndex1;
+    size_t mIndex2;
+  };
+
+  // Frames may refer to parents that come later, so the parents are only
+  // assigned once all the frames exist
+  const size_t numFrames = reader.readSize();
+  std::vector<SimpleFramePtr> frames;
+  std::vector<Parent> parents;
+  frames.reserve(numFrames);
+  parents.reserve(numFrames);
+  for(size_t i = 0; i < numFrames; ++i)
+  {
+    const std::string name = reader.readString();
+
+    Parent parent;
+    parent.mType = reader.read<ParentRecordType>();
+    parent.mIndex1 = 0u;
+    parent.mIndex2 = 0u;
+    if(parent.mType == PARENT_SIMPLE_FRAME)
+    {
+      parent.mIndex1 = static_cast<size_t>(reader.read<uint64_t>());
+      if(parent.mIndex1 >= numFrames || parent.mIndex1 == i)
+        reader.fail();
+    }
+    else if(parent.mType == PARENT_BODY_NODE)
+    {
+      parent.mIndex1 = static_cast<size_t>(reader.read<uint64_t>());
+      parent.mIndex2 = static_cast<size_t>(reader.read<uint64_t>());
+      if(parent.mIndex1 >= world->getNumSkeletons()
+         || parent.mIndex2
+            >= world->getSkeleton(parent.mIndex1)->getNumBodyNodes())
+        reader.fail();
+    }
+    else if(parent.mType != PARENT_WORLD)
+    {
+      reader.fail();
+    }
+
+    const Eigen::Isometry3d tf = reader.readTransform();
+    Eigen::Vector6d velocity, acceleration;
+    reader.readMatrix(velocity);
+    reader.readMatrix(acceleration);
+    const ShapePtr shape = readShape(reader, retriever);
+    if(reader.failed())
+      return false;
+
+    const SimpleFramePtr frame
+        = std::make_shared<SimpleFrame>(Frame::World(), name, tf);
+    frame->setRelativeSpatialVelocity(velocity);
+    frame->setRelativeSpatialAcceleration(acceleration);
+    frame->setShape(shape);
+    readShapeFrameAddons(reader, frame.get());
+
+    frames.push_back(frame);
+    parents.push_back(parent);
+  }
+
+  if(reader.failed())
+    return false;
+
+  for(size_t i = 0; i < frames.size(); ++i)
+  {
+    if(parents[i].mType == PARENT_SIMPLE_FRAME)
+    {
+      // Refuse cycles, which setParentFrame() would not detect
+      for(const Frame* ancestor = frames[parents[i].mIndex1].get();
+          !ancestor->isWorld(); ancestor = ancestor->getParentFrame())
+      {
+        if(ancestor == frames[i].get())
+          return false;
+      }
+
+      frames[i]->setParentFrame(frames[parents[i].mIndex1].get());
+    }
+    else if(parents[i].mType == PARENT_BODY_NODE)
+    {
+      frames[i]->setParentFrame(world->getSkeleton(
+          parents[i].mIndex1)->getBodyNode(parents[i].mIndex2));
+    }
+  }
+
+  for(const SimpleFramePtr& frame : frames)
+    world->addSimpleFrame(frame);
+
+  return true;
+}
+
+//==============================================================================
+// Files
+//==============================================================================
+void writeHeader(Writer& writer, ContentType content)
+{
+  for(const char c : FILE_MAGIC)
+    writer.write(c);
+  writer.write(FILE_VERSION);
+  writer.write(content);
+}
+
+//==============================================================================
+/// Load the file at uri and check its header. storage keeps the content
+/// alive while reader refers to it.
+bool openFile(const common::Uri& uri,
+              const common::ResourceRetrieverPtr& retriever,
+              ContentType content, std::shared_ptr<const void>& storage,
+              std::unique_ptr<Reader>& reader, const std::string& function)
+{
+  const common::ResourcePtr resource = retriever->retrieve(uri);
+  if(!resource)
+  {
+    dtwarn << "[BinarySkel::" << function << "] Failed opening URI ["
+           << uri.toString() << "].\n";
+    return false;
+  }
+
+  // Memory-mapped files are read in place
+  const size_t size = resource->getSize();
+  const void* data = resource->getData();
+  if(data)
+  {
+    storage = std::shared_ptr<const void>(resource, data);
+  }
+  else
+  {
+    std::shared_ptr<char> buffer(new char[std::max<size_t>(size, 1u)],
+                                 std::default_delete<char[]>());
+    if(size > 0u && resource->read(buffer.get(), size, 1) != 1)
+    {
+      dtwarn << "[BinarySkel::" << function << "] Failed reading URI ["
+             << uri.toString() << "].\n";
+      return false;
+    }
+    storage = buffer;
+    data = buffer.get();
+  }
+
+  reader.reset(new Reader(static_cast<const char*>(data), size));
+
+  char magic[sizeof(FILE_MAGIC)];
+  for(char& c : magic)
+    c = reader->read<char>();
+  if(reader->failed()
+     || std::memcmp(magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+  {
+    dtwarn << "[BinarySkel::" << function << "] [" << uri.toString()
+           << "] is not a binary Skeleton or World file.\n";
+    return false;
+  }
+
+  const uint32_t version = reader->read<uint32_t>();
+  if(version != FILE_VERSION)
+  {
+    dtwarn << "[BinarySkel::" << function << "] Unsupported version ["
+           << version << "] of file [" << uri.toString() << "].\n";
+    return false;
+  }
+
+  if(reader->read<ContentType>() != content)
+  {
+    dtwarn << "[BinarySkel::" << function << "] [" << uri.toString()
+           << "] does not contain a "
+           << (content == CONTENT_WORLD ? "World" : "Skeleton") << ".\n";
+    return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+common::ResourceRetrieverPtr getRetriever(
+    const common::ResourceRetrieverPtr& retriever)
+{
+  if(retriever)
+    return retriever;
+  else
+    return std::make_shared<common::LocalResourceRetriever>();
+}
+
+} // anonymous namespace
+
+//==============================================================================
+bool BinarySkel::writeSkeleton(const dynamics::ConstSkeletonPtr& skeleton,
+                               const std::string& fileName)
+{
+  Writer writer;
+  writeHeader(writer, CONTENT_SKELETON);
+
+  bool ok = true;
+  writeSkeletonBlock(writer, skeleton, ok);
+  if(!ok)
+    return false;
+
+  if(!writer.save(fileName))
+  {
+    dtwarn << "[BinarySkel::writeSkeleton] Failed writing file [" << fileName
+           << "].\n";
+    return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+dynamics::SkeletonPtr BinarySkel::readSkeleton(
+    const common::Uri& uri, const common::ResourceRetrieverPtr& retriever)
+{
+  const common::ResourceRetrieverPtr resolvedRetriever
+      = getRetriever(retriever);
+
+  std::shared_ptr<const void> storage;
+  std::unique_ptr<Reader> reader;
+  if(!openFile(uri, resolvedRetriever, CONTENT_SKELETON, storage, reader,
+               "readSkeleton"))
+    return nullptr;
+
+  const SkeletonPtr skeleton = readSkeletonBlock(*reader, resolvedRetriever);
+  if(!skeleton)
+  {
+    dtwarn << "[BinarySkel::readSkeleton] File [" << uri.toString()
+           << "] is corrupted.\n";
+    return nullptr;
+  }
+
+  return skeleton;
+}
+
+//==============================================================================
+bool BinarySkel::writeWorld(const simulation::WorldPtr& world,
+                            const std::string& fileName)
+{
+  Writer writer;
+  writeHeader(writer, CONTENT_WORLD);
+
+  writer.writeString(world->getName());
+  writer.writeMatrix(world->getGravity());
+  writer.write(world->getTimeStep());
+  writer.write(world->getTime());
+
+  bool ok = true;
+  writer.writeSize(world->getNumSkeletons());
+  for(size_t i = 0; i < world->getNumSkeletons(); ++i)
+    writeSkeletonBlock(writer, world->getSkeleton(i), ok);
+
+  writeSimpleFrames(writer, world);
+
+  if(!ok)
+    return false;
+
+  if(!writer.save(fileName))
+  {
+    dtwarn << "[BinarySkel::writeWorld] Failed writing file [" << fileName
+           << "].\n";
+    return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+simulation::WorldPtr BinarySkel::readWorld(
+    const common::Uri& uri, const common::ResourceRetrieverPtr& retriever)
+{
+  const common::ResourceRetrieverPtr resolvedRetriever
+      = getRetriever(retriever);
+
+  std::shared_ptr<const void> storage;
+  std::unique_ptr<Reader> reader;
+  if(!openFile(uri, resolvedRetriever, CONTENT_WORLD, storage, reader,
+               "readWorld"))
+    return nullptr;
+
+  const simulation::WorldPtr world(
+        new simulation::World(reader->readString()));
+  Eigen::Vector3d gravity;
+  reader->readMatrix(gravity);
+  world->setGravity(gravity);
+  world->setTimeStep(reader->read<double>());
+  world->setTime(reader->read<double>());
+
+  const size_t numSkeletons = reader->readSize();
+  bool ok = !reader->failed();
+  for(size_t i = 0; i < numSkeletons && ok; ++i)
+  {
+    const SkeletonPtr skeleton = readSkeletonBlock(*reader, resolvedRetriever);
+    if(skeleton)
+      world->addSkeleton(skeleton);
+    else
+      ok = false;
+  }
+
+  if(!ok || !readSimpleFrames(*reader, world, resolvedRetriever))
+  {
+    dtwarn << "[BinarySkel::readWorld] File [" << uri.toString()
+           << "] is corrupted.\n";
+    return nullptr;
+  }
+
+  return world;
+}
+
+} // namespace utils
+} // namespace dart
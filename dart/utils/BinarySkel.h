@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_UTILS_BINARYSKEL_H_
+#define DART_UTILS_BINARYSKEL_H_
+
+#include <string>
+#include "dart/common/ResourceRetriever.h"
+#include "dart/dynamics/Skeleton.h"
+#include "dart/simulation/World.h"
+
+namespace dart {
+namespace utils {
+
+/// BinarySkel stores Skeletons and Worlds in a versioned binary format. Unlike
+/// the XML formats, every value is stored bit for bit, so reading a file back
+/// reproduces the Properties and the state of the original exactly, and no
+/// text has to be parsed.
+///
+/// A Skeleton file contains the Skeleton's Properties, the Properties of every
+/// Joint, BodyNode (including SoftBodyNodes, their PointMasses and Markers)
+/// and ShapeNode together with its Visual, Collision and Dynamics Addons, and
+/// the positions, velocities, accelerations, forces and commands of all the
+/// DegreesOfFreedom and PointMasses. A World file additionally contains the
+/// World's settings and its SimpleFrames.
+///
+/// MeshShapes are stored by URI and are loaded again through the
+/// dynamics::MeshCache when the file is read. EndEffectors, IK modules,
+/// custom Nodes and Addons, and the constraints of the ConstraintSolver are
+/// not stored.
+namespace BinarySkel {
+
+  /// Extension of binary Skeleton and World files
+  extern const std::string Extension;
+
+  /// Write skeleton to fileName. Returns false on failure.
+  bool writeSkeleton(const dynamics::ConstSkeletonPtr& skeleton,
+                     const std::string& fileName);
+
+  /// Read a Skeleton that was written by writeSkeleton()
+  dynamics::SkeletonPtr readSkeleton(
+    const common::Uri& uri,
+    const common::ResourceRetrieverPtr& retriever = nullptr);
+
+  /// Write world to fileName. Returns false on failure.
+  bool writeWorld(const simulation::WorldPtr& world,
+                  const std::string& fileName);
+
+  /// Read a World that was written by writeWorld()
+  simulation::WorldPtr readWorld(
+    const common::Uri& uri,
+    const common::ResourceRetrieverPtr& retriever = nullptr);
+
+} // namespace BinarySkel
+
+} // namespace utils
+} // namespace dart
+
+#endif // #ifndef DART_UTILS_BINARYSKEL_H_
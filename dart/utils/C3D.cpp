@@ -39,6 +39,8 @@
 #include <cstring>
 #include <cstdio>
 
+#include "dart/common/MemoryMappedResource.h"
+
 ///////////////////////////////////////////////////////////////////////
 //  C3D file reader and writer
 ///////////////////////////////////////////////////////////////////////
@@ -72,35 +74,21 @@ void convertFloatToDec(float _f, char* _bytes) {
 }
 
 
-bool loadC3DFile(const char* _fileName, Eigen::EIGEN_VV_VEC3D& _pointData, int* _nFrame, int* _nMarker, double* _freq) {
-    char buf[C3D_REC_SIZE];
-    FILE *file;
-    Eigen::Vector3d v;
+bool readC3DLayout(const char* _data, size_t _size, c3d_layout* _layout) {
     c3d_head hdr;
     c3d_param param;
-    c3d_frameSI frameSI;
-    c3d_frame frame;
     bool bDecFmt = true;
 
-    if ((file = fopen( _fileName, "rb" )) == nullptr)
-        return false;
-
     //get the header
-    if (!fread(buf, C3D_REC_SIZE, 1, file))
-    {
-        fclose(file);
+    if (_size < C3D_REC_SIZE)
         return false;
-    }
-    memcpy(&hdr, buf, sizeof(hdr));
+    memcpy(&hdr, _data, sizeof(hdr));
 
     //get number format
     if (hdr.rec_start > 2) {
-        if (!fread(buf, C3D_REC_SIZE, 1, file))
-        {
-            fclose(file);
+        if (_size < 2 * C3D_REC_SIZE)
             return false;
-        }
-        memcpy(&param, buf, sizeof(param));
+        memcpy(&param, _data + C3D_REC_SIZE, sizeof(param));
         if (param.ftype == 84)
             bDecFmt = false;
     }
@@ -111,66 +99,88 @@ bool loadC3DFile(const char* _fileName, Eigen::EIGEN_VV_VEC3D& _pointData, int*
         hdr.scale = convertDecToFloat((char*)&hdr.scale);
     }
 
-    int numFrames = hdr.end_frame - hdr.start_frame + 1;
-    int numMarkers = hdr.pnt_cnt;
-    double c3dScale = hdr.scale;
+    _layout->numFrames = hdr.end_frame - hdr.start_frame + 1;
+    _layout->numMarkers = hdr.pnt_cnt;
+    _layout->freq = hdr.freq;
+    _layout->isFloat = hdr.scale < 0;
+    _layout->isDecFormat = bDecFmt;
+    _layout->pointScale = (hdr.scale < 0) ? 1 : hdr.scale;
 
-    *_freq = hdr.freq;
-    *_nMarker = numMarkers;
-    *_nFrame = numFrames;
+    //the points start after the header and parameter records
+    int numRecords = (hdr.rec_start > 2) ? hdr.rec_start - 1 : 1;
+    _layout->dataOffset = (size_t)numRecords * C3D_REC_SIZE;
+
+    //every marker record is followed by the analog samples
+    int analog = hdr.a_channels * hdr.a_frames;
+    if (analog < 0 || _layout->numFrames < 0 || _layout->numMarkers < 0)
+        return false;
+    if (_layout->isFloat)
+        _layout->recordSize = sizeof(c3d_frame) + analog * sizeof(float);
+    else
+        _layout->recordSize = sizeof(c3d_frameSI) + analog * sizeof(short);
 
-    float pntScale = (hdr.scale < 0) ? 1 : hdr.scale;
+    return true;
+}
 
-    //eat parameter records
-    for (int i = 3; i < hdr.rec_start; i++) {
-        if (!fread(buf, C3D_REC_SIZE, 1, file)) {
-            fclose(file);
-            return false;
+void decodeC3DPoint(const char* _record, const c3d_layout& _layout,
+                    Eigen::Vector3d* _point) {
+    c3d_frameSI frameSI;
+    c3d_frame frame;
+
+    if (_layout.isFloat) {
+        memcpy(&frame, _record, sizeof(frame));
+        if (_layout.isDecFormat) {
+            frame.y = convertDecToFloat((char*)&frame.y);
+            frame.z = convertDecToFloat((char*)&frame.z);
+            frame.x = convertDecToFloat((char*)&frame.x);
+        }
+        (*_point)[0] = frame.y / 1000.0;
+        (*_point)[1] = frame.z / 1000.0;
+        (*_point)[2] = frame.x / 1000.0;
+    } else {
+        memcpy(&frameSI, _record, sizeof(frameSI));
+        if (_layout.isDecFormat) {
+            frameSI.y = (short)convertDecToFloat((char*)&frameSI.y);
+            frameSI.z = (short)convertDecToFloat((char*)&frameSI.z);
+            frameSI.x = (short)convertDecToFloat((char*)&frameSI.x);
         }
+        (*_point)[0] = (float)frameSI.y * _layout.pointScale / 1000.0;
+        (*_point)[1] = (float)frameSI.z * _layout.pointScale / 1000.0;
+        (*_point)[2] = (float)frameSI.x * _layout.pointScale / 1000.0;
     }
+}
+
+
+bool loadC3DFile(const char* _fileName, Eigen::EIGEN_VV_VEC3D& _pointData, int* _nFrame, int* _nMarker, double* _freq) {
+    common::MemoryMappedResource file(_fileName);
+    if (!file.isGood())
+        return false;
+
+    const char* data = static_cast<const char*>(file.getData());
+    const size_t size = file.getSize();
+
+    c3d_layout layout;
+    if (!readC3DLayout(data, size, &layout))
+        return false;
+
+    *_freq = layout.freq;
+    *_nMarker = layout.numMarkers;
+    *_nFrame = layout.numFrames;
 
     // start retrieving data
-    _pointData.resize(numFrames);
+    const size_t frameSize = layout.numMarkers * layout.recordSize;
+    if (layout.dataOffset + layout.numFrames * frameSize > size)
+        return false;
 
-    int iRecSize;
-    if (c3dScale < 0)
-        iRecSize = sizeof(c3d_frame) + ( hdr.a_channels * hdr.a_frames * sizeof(float));
-    else
-        iRecSize = sizeof(c3d_frameSI) + ( hdr.a_channels * hdr.a_frames * sizeof(short));
-
-    for (int i = 0; i < numFrames; i++) {
-        _pointData[i].resize(numMarkers);
-        for (int j = 0; j < numMarkers; j++) {
-            if (!fread(buf, iRecSize, 1, file))
-            {
-                fclose(file);
-                return false;
-            }
-            if (c3dScale < 0) {
-                memcpy(&frame, buf, sizeof(frame));
-                if(bDecFmt){
-                    frame.y = convertDecToFloat((char*)&frame.y);
-                    frame.z = convertDecToFloat((char*)&frame.z);
-                    frame.x = convertDecToFloat((char*)&frame.x);
-                }
-                v[0] = frame.y / 1000.0;
-                v[1] = frame.z / 1000.0;
-                v[2] = frame.x / 1000.0;
-            } else {
-                memcpy(&frameSI, buf, sizeof(frameSI));
-                if (bDecFmt) {
-                    frameSI.y = (short)convertDecToFloat((char*)&frameSI.y);
-                    frameSI.z = (short)convertDecToFloat((char*)&frameSI.z);
-                    frameSI.x = (short)convertDecToFloat((char*)&frameSI.x);
-                }
-                v[0] = (float)frameSI.y * pntScale / 1000.0;
-                v[1] = (float)frameSI.z * pntScale / 1000.0;
-                v[2] = (float)frameSI.x * pntScale / 1000.0;
-            }
-            _pointData[i][j] = v;
+    _pointData.resize(layout.numFrames);
+    const char* record = data + layout.dataOffset;
+    for (int i = 0; i < layout.numFrames; i++) {
+        _pointData[i].resize(layout.numMarkers);
+        for (int j = 0; j < layout.numMarkers; j++) {
+            decodeC3DPoint(record, layout, &_pointData[i][j]);
+            record += layout.recordSize;
         }
     }
-    fclose(file);
 
     //const char *pch = strrchr(_fileName, '\\');  //clip leading path
     //if (pch)
@@ -37,6 +37,7 @@
 #ifndef DART_UTILS_C3D_H
 #define DART_UTILS_C3D_H
 
+#include <cstddef>
 #include <vector>
 #include <ctime>
 #include <Eigen/Dense>
@@ -82,11 +83,33 @@ typedef struct c3d_frame_t {
     float	residual;
 } c3d_frame;
 
+/// Layout of the point data of a C3D file. Every frame stores one record per
+/// marker, so the data of any frame can be located without reading the frames
+/// before it.
+typedef struct c3d_layout_t {
+    int     numFrames;
+    int     numMarkers;
+    double  freq;
+    size_t  dataOffset;   ///< Offset of the first frame, in bytes
+    size_t  recordSize;   ///< Size of the record of one marker, in bytes
+    bool    isFloat;      ///< Points are floats rather than scaled shorts
+    bool    isDecFormat;  ///< Numbers use the DEC floating point format
+    float   pointScale;
+} c3d_layout;
+
 float convertDecToFloat(char _bytes[4]);
 void convertFloatToDec(float _f, char* _bytes);
 
 bool loadC3DFile( const char* _fileName, Eigen::EIGEN_VV_VEC3D& _pointData,
                   int* _nFrame, int* _nMarker, double* _freq );
+/// Read the layout of the point data from the first records of a C3D file.
+/// Returns false if _size is too small to contain the header.
+bool readC3DLayout( const char* _data, size_t _size, c3d_layout* _layout );
+
+/// Decode the point of the marker record at _record, converted to meters
+void decodeC3DPoint( const char* _record, const c3d_layout& _layout,
+                     Eigen::Vector3d* _point );
+
 bool saveC3DFile( const char* _fileName, Eigen::EIGEN_VV_VEC3D& _pointData,
                   int _nFrame, int _nMarker, double _freq );
 
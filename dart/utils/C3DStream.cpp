@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/utils/C3DStream.h"
+
+#include <cassert>
+
+#include "dart/common/Console.h"
+
+namespace dart {
+namespace utils {
+
+//==============================================================================
+C3DStream::C3DStream(size_t _cacheCapacity)
+  : MotionStream(_cacheCapacity),
+    mData(nullptr)
+{
+  // Do nothing
+}
+
+//==============================================================================
+bool C3DStream::open(const std::string& _fileName)
+{
+  close();
+
+  std::unique_ptr<common::MemoryMappedResource> file(
+        new common::MemoryMappedResource(_fileName));
+  if(!file->isGood())
+    return false;
+
+  const char* data = static_cast<const char*>(file->getData());
+  const size_t size = file->getSize();
+  if(!readC3DLayout(data, size, &mLayout))
+  {
+    dtwarn << "[C3DStream::open] [" << _fileName << "] is not a C3D file.\n";
+    return false;
+  }
+
+  const size_t frameSize = mLayout.numMarkers * mLayout.recordSize;
+  if(mLayout.dataOffset + mLayout.numFrames * frameSize > size)
+  {
+    dtwarn << "[C3DStream::open] [" << _fileName << "] is truncated. It "
+           << "should contain " << mLayout.numFrames << " frames.\n";
+    return false;
+  }
+
+  mFile = std::move(file);
+  mData = data;
+  setLayout(mLayout.numFrames, 3u * mLayout.numMarkers, mLayout.freq);
+
+  return true;
+}
+
+//==============================================================================
+void C3DStream::close()
+{
+  reset();
+  mData = nullptr;
+  mFile.reset();
+}
+
+//==============================================================================
+size_t C3DStream::getNumMarkers() const
+{
+  return getFrameSize() / 3u;
+}
+
+//==============================================================================
+Eigen::Vector3d C3DStream::getMarker(size_t _frame, size_t _marker)
+{
+  assert(_marker < getNumMarkers());
+  return getFrame(_frame).segment<3>(3u * _marker);
+}
+
+//==============================================================================
+Eigen::Matrix3Xd C3DStream::getMarkerTrajectory(
+    size_t _marker, double _startTime, double _endTime)
+{
+  assert(_marker < getNumMarkers());
+  return getWindow(3u * _marker, 3u, _startTime, _endTime);
+}
+
+//==============================================================================
+void C3DStream::decodeFrame(size_t _frame, Eigen::VectorXd& _values) const
+{
+  const char* record = mData + mLayout.dataOffset
+      + _frame * mLayout.numMarkers * mLayout.recordSize;
+
+  Eigen::Vector3d point;
+  for(int i = 0; i < mLayout.numMarkers; ++i)
+  {
+    decodeC3DPoint(record, mLayout, &point);
+    _values.segment<3>(3 * i) = point;
+    record += mLayout.recordSize;
+  }
+}
+
+} // namespace utils
+} // namespace dart
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_UTILS_C3DSTREAM_H_
+#define DART_UTILS_C3DSTREAM_H_
+
+#include <memory>
+#include <string>
+#include "dart/common/MemoryMappedResource.h"
+#include "dart/utils/C3D.h"
+#include "dart/utils/MotionStream.h"
+
+namespace dart {
+namespace utils {
+
+/// C3DStream reads the marker positions of a C3D file on demand. The file is
+/// memory-mapped and, since every frame has the same size, opening it only
+/// reads the header. Frame i holds the positions of all the markers in meters,
+/// with the position of marker j at [3 * j, 3 * j + 3), converted the same way
+/// as by loadC3DFile().
+class C3DStream : public MotionStream
+{
+public:
+  /// Constructor
+  explicit C3DStream(size_t _cacheCapacity = 256u);
+
+  /// Destructor
+  virtual ~C3DStream() = default;
+
+  /// Open _fileName. Returns false if it is not a valid C3D file.
+  bool open(const std::string& _fileName);
+
+  /// Close the current file
+  void close();
+
+  /// Get the number of markers
+  size_t getNumMarkers() const;
+
+  /// Get the position of marker _marker at frame _frame
+  Eigen::Vector3d getMarker(size_t _frame, size_t _marker);
+
+  /// Get the positions of marker _marker at every frame in
+  /// [_startTime, _endTime] as the columns of a 3xN matrix
+  Eigen::Matrix3Xd getMarkerTrajectory(size_t _marker, double _startTime,
+                                       double _endTime);
+
+protected:
+  // Documentation inherited.
+  void decodeFrame(size_t _frame, Eigen::VectorXd& _values) const override;
+
+  /// The mapped file
+  std::unique_ptr<common::MemoryMappedResource> mFile;
+
+  /// Start of the mapped file
+  const char* mData;
+
+  /// Layout of the point data
+  c3d_layout mLayout;
+};
+
+} // namespace utils
+} // namespace dart
+
+#endif // DART_UTILS_C3DSTREAM_H_
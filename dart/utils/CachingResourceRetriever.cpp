@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/utils/CachingResourceRetriever.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include "dart/common/Console.h"
+
+namespace dart {
+namespace utils {
+
+namespace {
+
+/// Resource that reads from content shared with the cache
+class CachedResource : public common::Resource
+{
+public:
+  explicit CachedResource(
+      const std::shared_ptr<const std::vector<char>>& _content)
+    : mContent(_content),
+      mOffset(0u)
+  {
+    // Do nothing
+  }
+
+  size_t getSize() override
+  {
+    return mContent->size();
+  }
+
+  size_t tell() override
+  {
+    return mOffset;
+  }
+
+  bool seek(ptrdiff_t _offset, SeekType _origin) override
+  {
+    ptrdiff_t origin;
+    switch(_origin)
+    {
+    case Resource::SEEKTYPE_CUR:
+      origin = static_cast<ptrdiff_t>(mOffset);
+      break;
+
+    case Resource::SEEKTYPE_END:
+      origin = static_cast<ptrdiff_t>(mContent->size());
+      break;
+
+    case Resource::SEEKTYPE_SET:
+      origin = 0;
+      break;
+
+    default:
+      return false;
+    }
+
+    if(origin + _offset < 0)
+      return false;
+
+    mOffset = static_cast<size_t>(origin + _offset);
+    return true;
+  }
+
+  size_t read(void* _buffer, size_t _size, size_t _count) override
+  {
+    const size_t size = mContent->size();
+    if(_size == 0u || mOffset >= size)
+      return 0u;
+
+    const size_t count = std::min(_count, (size - mOffset) / _size);
+    std::memcpy(_buffer, mContent->data() + mOffset, count * _size);
+    mOffset += count * _size;
+
+    return count;
+  }
+
+  const void* getData() override
+  {
+    static const char empty = '\0';
+    return mContent->empty() ? &empty : mContent->data();
+  }
+
+private:
+  std::shared_ptr<const std::vector<char>> mContent;
+  size_t mOffset;
+};
+
+} // anonymous namespace
+
+//==============================================================================
+CachingResourceRetriever::CachingResourceRetriever(
+  const common::ResourceRetrieverPtr& _retriever, size_t _capacity)
+  : mRetriever(_retriever),
+    mCapacity(_capacity),
+    mCacheSize(0u),
+    mGeneration(0u),
+    mNumHits(0u),
+    mNumMisses(0u)
+{
+  assert(mRetriever);
+}
+
+//==============================================================================
+const common::ResourceRetrieverPtr&
+CachingResourceRetriever::getRetriever() const
+{
+  return mRetriever;
+}
+
+//==============================================================================
+void CachingResourceRetriever::setCapacity(size_t _capacity)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mCapacity = _capacity;
+  evict();
+}
+
+//==============================================================================
+size_t CachingResourceRetriever::getCapacity() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mCapacity;
+}
+
+//==============================================================================
+size_t CachingResourceRetriever::getCacheSize() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mCacheSize;
+}
+
+//==============================================================================
+size_t CachingResourceRetriever::getNumResources() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mEntries.size();
+}
+
+//==============================================================================
+void CachingResourceRetriever::invalidate(const common::Uri& _uri)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  erase(_uri.toString());
+  ++mGeneration;
+}
+
+//==============================================================================
+void CachingResourceRetriever::clear()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mEntries.clear();
+  mEntryMap.clear();
+  mPresent.clear();
+  mAbsent.clear();
+  mCacheSize = 0u;
+  mNumHits = 0u;
+  mNumMisses = 0u;
+  ++mGeneration;
+}
+
+//==============================================================================
+size_t CachingResourceRetriever::getNumHits() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mNumHits;
+}
+
+//==============================================================================
+size_t CachingResourceRetriever::getNumMisses() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mNumMisses;
+}
+
+//==============================================================================
+bool CachingResourceRetriever::exists(const common::Uri& _uri)
+{
+  const std::string uri = _uri.toString();
+  size_t generation;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if(mPresent.count(uri))
+    {
+      ++mNumHits;
+      return true;
+    }
+    else if(mAbsent.count(uri))
+    {
+      ++mNumHits;
+      return false;
+    }
+
+    ++mNumMisses;
+    generation = mGeneration;
+  }
+
+  // The wrapped retriever may be slow, so it is called without the lock
+  const bool result = mRetriever->exists(_uri);
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  if(generation == mGeneration)
+  {
+    if(result)
+      mPresent.insert(uri);
+    else
+      mAbsent.insert(uri);
+  }
+
+  return result;
+}
+
+//==============================================================================
+common::ResourcePtr CachingResourceRetriever::retrieve(const common::Uri& _uri)
+{
+  const std::string uri = _uri.toString();
+  size_t generation;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    const auto it = mEntryMap.find(uri);
+    if(it != mEntryMap.end())
+    {
+      ++mNumHits;
+      mEntries.splice(mEntries.begin(), mEntries, it->second);
+      return std::make_shared<CachedResource>(it->second->mContent);
+    }
+    else if(mAbsent.count(uri))
+    {
+      ++mNumHits;
+      return nullptr;
+    }
+
+    ++mNumMisses;
+    generation = mGeneration;
+  }
+
+  const common::ResourcePtr resource = mRetriever->retrieve(_uri);
+  if(!resource)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if(generation == mGeneration)
+    {
+      mPresent.erase(uri);
+      mAbsent.insert(uri);
+    }
+    return nullptr;
+  }
+
+  const size_t size = resource->getSize();
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if(generation == mGeneration)
+      mPresent.insert(uri);
+
+    // Resources that would evict everything else are not worth caching
+    if(size > mCapacity)
+      return resource;
+  }
+
+  std::shared_ptr<std::vector<char>> content
+      = std::make_shared<std::vector<char>>(size);
+  if(const void* data = resource->getData())
+  {
+    std::memcpy(content->data(), data, size);
+  }
+  else if(size > 0u && resource->read(content->data(), size, 1) != 1)
+  {
+    dtwarn << "[CachingResourceRetriever::retrieve] Failed reading URI '"
+           << uri << "'.\n";
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  if(generation == mGeneration && !mEntryMap.count(uri))
+  {
+    mEntries.push_front(Entry{uri, content});
+    mEntryMap[uri] = mEntries.begin();
+    mCacheSize += size;
+    evict();
+  }
+
+  return std::make_shared<CachedResource>(content);
+}
+
+//==============================================================================
+void CachingResourceRetriever::evict()
+{
+  while(mCacheSize > mCapacity && !mEntries.empty())
+  {
+    const Entry& entry = mEntries.back();
+    mCacheSize -= entry.mContent->size();
+    mEntryMap.erase(entry.mUri);
+    mEntries.pop_back();
+  }
+}
+
+//==============================================================================
+void CachingResourceRetriever::erase(const std::string& _uri)
+{
+  const auto it = mEntryMap.find(_uri);
+  if(it != mEntryMap.end())
+  {
+    mCacheSize -= it->second->mContent->size();
+    mEntries.erase(it->second);
+    mEntryMap.erase(it);
+  }
+
+  mPresent.erase(_uri);
+  mAbsent.erase(_uri);
+}
+
+} // namespace utils
+} // namespace dart
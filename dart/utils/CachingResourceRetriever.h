@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_UTILS_CACHINGRESOURCERETRIEVER_H_
+#define DART_UTILS_CACHINGRESOURCERETRIEVER_H_
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "dart/common/ResourceRetriever.h"
+
+namespace dart {
+namespace utils {
+
+/// CachingResourceRetriever wraps another \ref ResourceRetriever and remembers
+/// its answers, so that repeated lookups of the same URI, e.g. the meshes of
+/// several robots loaded from the same package, do not hit the underlying
+/// retrievers and the file system again.
+///
+/// The content of retrieved resources is kept in memory in a least recently
+/// used cache bounded by setCapacity(). Resources that do not fit are passed
+/// through without being cached. URIs that could not be retrieved, or for
+/// which exists() returned false, are remembered as well until they are
+/// invalidated. Resources served from the cache provide
+/// Resource::getData().
+///
+/// The cache assumes that the underlying resources do not change. Call
+/// invalidate() or clear() when they do. All member functions may be called
+/// from several threads at once, provided that the wrapped retriever supports
+/// that too.
+class CachingResourceRetriever : public virtual common::ResourceRetriever
+{
+public:
+  /// Construct a CachingResourceRetriever that caches the resources of
+  /// _retriever, using up to _capacity bytes of memory.
+  explicit CachingResourceRetriever(
+    const common::ResourceRetrieverPtr& _retriever,
+    size_t _capacity = 64u * 1024u * 1024u);
+
+  virtual ~CachingResourceRetriever() = default;
+
+  /// Get the retriever whose resources are cached
+  const common::ResourceRetrieverPtr& getRetriever() const;
+
+  /// Set the maximum number of bytes of resource content to keep in memory.
+  /// The least recently used resources are evicted if necessary.
+  void setCapacity(size_t _capacity);
+
+  /// Get the maximum number of bytes of resource content to keep in memory
+  size_t getCapacity() const;
+
+  /// Get the number of bytes of resource content that are currently cached
+  size_t getCacheSize() const;
+
+  /// Get the number of resources whose content is currently cached
+  size_t getNumResources() const;
+
+  /// Forget everything that is known about _uri
+  void invalidate(const common::Uri& _uri);
+
+  /// Forget everything and reset the hit and miss counters
+  void clear();
+
+  /// Number of calls to exists() and retrieve() that were answered from the
+  /// cache, including cached failures
+  size_t getNumHits() const;
+
+  /// Number of calls to exists() and retrieve() that were forwarded to the
+  /// wrapped retriever
+  size_t getNumMisses() const;
+
+  // Documentation inherited.
+  bool exists(const common::Uri& _uri) override;
+
+  // Documentation inherited.
+  common::ResourcePtr retrieve(const common::Uri& _uri) override;
+
+protected:
+  using Content = std::shared_ptr<const std::vector<char>>;
+
+  struct Entry
+  {
+    std::string mUri;
+    Content mContent;
+  };
+
+  /// Evict the least recently used entries until the cache fits into
+  /// mCapacity. mMutex must be locked.
+  void evict();
+
+  /// Remove _uri from all the caches. mMutex must be locked.
+  void erase(const std::string& _uri);
+
+  /// Retriever whose resources are cached
+  common::ResourceRetrieverPtr mRetriever;
+
+  /// Maximum number of bytes of content
+  size_t mCapacity;
+
+  /// Current number of bytes of content
+  size_t mCacheSize;
+
+  /// Cached contents, most recently used first
+  std::list<Entry> mEntries;
+
+  /// Position of each cached URI in mEntries
+  std::unordered_map<std::string, std::list<Entry>::iterator> mEntryMap;
+
+  /// URIs that are known to exist
+  std::unordered_set<std::string> mPresent;
+
+  /// URIs that are known not to exist or failed to be retrieved
+  std::unordered_set<std::string> mAbsent;
+
+  /// Incremented by invalidate() and clear(), so that results which were
+  /// obtained concurrently with them are not stored
+  size_t mGeneration;
+
+  /// Number of lookups answered from the cache
+  size_t mNumHits;
+
+  /// Number of lookups forwarded to mRetriever
+  size_t mNumMisses;
+
+  /// Protects all of the above, except mRetriever
+  mutable std::mutex mMutex;
+};
+
+using CachingResourceRetrieverPtr = std::shared_ptr<CachingResourceRetriever>;
+
+} // namespace utils
+} // namespace dart
+
+#endif // ifndef DART_UTILS_CACHINGRESOURCERETRIEVER_H_
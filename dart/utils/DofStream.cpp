@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/utils/DofStream.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+#include "dart/common/Console.h"
+
+namespace dart {
+namespace utils {
+
+namespace {
+
+//==============================================================================
+/// Move _offset to the start of the next whitespace-separated token. Returns
+/// false if there is none.
+bool skipSpace(const char* _data, size_t _size, size_t& _offset)
+{
+  while(_offset < _size && std::isspace(static_cast<unsigned char>(
+                                          _data[_offset])))
+    ++_offset;
+
+  return _offset < _size;
+}
+
+//==============================================================================
+/// Move _offset past the token that starts at _offset
+void skipToken(const char* _data, size_t _size, size_t& _offset)
+{
+  while(_offset < _size && !std::isspace(static_cast<unsigned char>(
+                                           _data[_offset])))
+    ++_offset;
+}
+
+//==============================================================================
+/// Read the token that starts at _offset and move _offset past it
+std::string readToken(const char* _data, size_t _size, size_t& _offset)
+{
+  const size_t start = _offset;
+  skipToken(_data, _size, _offset);
+  return std::string(_data + start, _data + _offset);
+}
+
+//==============================================================================
+/// Convert the token that starts at _offset to a number and move _offset past
+/// it. The mapped file is not null-terminated, so the token is copied first.
+double readNumber(const char* _data, size_t _size, size_t& _offset)
+{
+  char buffer[64];
+  const size_t start = _offset;
+  skipToken(_data, _size, _offset);
+  const size_t length = std::min(_offset - start, sizeof(buffer) - 1u);
+  std::memcpy(buffer, _data + start, length);
+  buffer[length] = '\0';
+
+  return std::strtod(buffer, nullptr);
+}
+
+} // anonymous namespace
+
+//==============================================================================
+DofStream::DofStream(double _fps, size_t _cacheCapacity)
+  : MotionStream(_cacheCapacity),
+    mDefaultFPS(_fps),
+    mData(nullptr),
+    mSize(0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+bool DofStream::open(const std::string& _fileName)
+{
+  close();
+
+  std::unique_ptr<common::MemoryMappedResource> file(
+        new common::MemoryMappedResource(_fileName));
+  if(!file->isGood())
+    return false;
+
+  const char* data = static_cast<const char*>(file->getData());
+  const size_t size = file->getSize();
+
+  // frames = <numFrames> dofs = <numDofs>
+  size_t offset = 0u;
+  std::string header[6];
+  for(std::string& token : header)
+  {
+    if(!skipSpace(data, size, offset))
+    {
+      dtwarn << "[DofStream::open] [" << _fileName << "] has no header.\n";
+      return false;
+    }
+    token = readToken(data, size, offset);
+  }
+
+  char* end;
+  const long numFrames = std::strtol(header[2].c_str(), &end, 10);
+  const bool validFrames = *end == '\0';
+  const long numDofs = std::strtol(header[5].c_str(), &end, 10);
+  if(!validFrames || *end != '\0' || numFrames < 0 || numDofs < 0)
+  {
+    dtwarn << "[DofStream::open] [" << _fileName << "] has an invalid "
+           << "header.\n";
+    return false;
+  }
+
+  std::vector<std::string> dofNames(numDofs);
+  for(std::string& name : dofNames)
+  {
+    if(!skipSpace(data, size, offset))
+    {
+      dtwarn << "[DofStream::open] [" << _fileName << "] is truncated.\n";
+      return false;
+    }
+    name = readToken(data, size, offset);
+  }
+
+  // Locate the frames without converting their values
+  std::vector<size_t> frameOffsets(numFrames);
+  for(size_t& frameOffset : frameOffsets)
+  {
+    for(long i = 0; i < numDofs; ++i)
+    {
+      if(!skipSpace(data, size, offset))
+      {
+        dtwarn << "[DofStream::open] [" << _fileName << "] is truncated. It "
+               << "should contain " << numFrames << " frames.\n";
+        return false;
+      }
+
+      if(i == 0)
+        frameOffset = offset;
+      skipToken(data, size, offset);
+    }
+  }
+
+  // FPS <fps>
+  double fps = mDefaultFPS;
+  if(skipSpace(data, size, offset))
+  {
+    skipToken(data, size, offset);
+    if(skipSpace(data, size, offset))
+      fps = readNumber(data, size, offset);
+  }
+
+  mFile = std::move(file);
+  mData = data;
+  mSize = size;
+  mFrameOffsets = std::move(frameOffsets);
+  mDofNames = std::move(dofNames);
+  setLayout(numFrames, numDofs, fps);
+
+  return true;
+}
+
+//==============================================================================
+void DofStream::close()
+{
+  reset();
+  mFrameOffsets.clear();
+  mDofNames.clear();
+  mData = nullptr;
+  mSize = 0u;
+  mFile.reset();
+}
+
+//==============================================================================
+size_t DofStream::getNumDofs() const
+{
+  return getFrameSize();
+}
+
+//==============================================================================
+const std::vector<std::string>& DofStream::getDofNames() const
+{
+  return mDofNames;
+}
+
+//==============================================================================
+double DofStream::getDof(size_t _frame, size_t _dof)
+{
+  assert(_dof < getNumDofs());
+  return getFrame(_frame)[_dof];
+}
+
+//==============================================================================
+Eigen::VectorXd DofStream::getDofTrajectory(size_t _dof, double _startTime,
+                                            double _endTime)
+{
+  assert(_dof < getNumDofs());
+  return getWindow(_dof, 1u, _startTime, _endTime).transpose();
+}
+
+//==============================================================================
+void DofStream::decodeFrame(size_t _frame, Eigen::VectorXd& _values) const
+{
+  // open() has made sure that every frame is complete
+  size_t offset = mFrameOffsets[_frame];
+  for(int i = 0; i < _values.size(); ++i)
+  {
+    skipSpace(mData, mSize, offset);
+    _values[i] = readNumber(mData, mSize, offset);
+  }
+}
+
+} // namespace utils
+} // namespace dart
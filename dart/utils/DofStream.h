@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_UTILS_DOFSTREAM_H_
+#define DART_UTILS_DOFSTREAM_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "dart/common/MemoryMappedResource.h"
+#include "dart/utils/MotionStream.h"
+
+namespace dart {
+namespace utils {
+
+/// DofStream reads the DOF values of a .dof file, as written by
+/// FileInfoDof::saveFile(), on demand. The file is memory-mapped and opening
+/// it only locates the first value of every frame. The values of a frame are
+/// converted from text when the frame is requested.
+class DofStream : public MotionStream
+{
+public:
+  /// Constructor. _fps is used for files that do not specify their frame
+  /// rate.
+  explicit DofStream(double _fps = 120.0, size_t _cacheCapacity = 256u);
+
+  /// Destructor
+  virtual ~DofStream() = default;
+
+  /// Open _fileName. Returns false if it is not a valid .dof file.
+  bool open(const std::string& _fileName);
+
+  /// Close the current file
+  void close();
+
+  /// Get the number of DOFs
+  size_t getNumDofs() const;
+
+  /// Get the names of the DOFs as stored in the file
+  const std::vector<std::string>& getDofNames() const;
+
+  /// Get the value of DOF _dof at frame _frame
+  double getDof(size_t _frame, size_t _dof);
+
+  /// Get the values of DOF _dof at every frame in [_startTime, _endTime]
+  Eigen::VectorXd getDofTrajectory(size_t _dof, double _startTime,
+                                   double _endTime);
+
+protected:
+  // Documentation inherited.
+  void decodeFrame(size_t _frame, Eigen::VectorXd& _values) const override;
+
+  /// Frame rate for files that do not specify it
+  double mDefaultFPS;
+
+  /// The mapped file
+  std::unique_ptr<common::MemoryMappedResource> mFile;
+
+  /// Start of the mapped file
+  const char* mData;
+
+  /// Size of the mapped file
+  size_t mSize;
+
+  /// Offset of the first value of each frame
+  std::vector<size_t> mFrameOffsets;
+
+  /// Names of the DOFs
+  std::vector<std::string> mDofNames;
+};
+
+} // namespace utils
+} // namespace dart
+
+#endif // DART_UTILS_DOFSTREAM_H_
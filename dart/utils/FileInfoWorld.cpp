@@ -60,6 +60,24 @@ FileInfoWorld::~FileInfoWorld()
 //==============================================================================
 bool FileInfoWorld::loadFile(const char* _fName)
 {
+  if (simulation::RecordingReader::isRecordingFile(_fName))
+  {
+    simulation::RecordingReader reader(_fName);
+    if (!reader.isGood())
+      return false;
+
+    // Release the previous recording
+    delete mRecord;
+
+    mRecord = reader.createRecording().release();
+
+    std::string text = _fName;
+    int lastSlash = text.find_last_of("/");
+    text = text.substr(lastSlash+1);
+    std::strcpy(mFileName, text.c_str());
+    return true;
+  }
+
   std::ifstream inFile(_fName);
   if (inFile.fail() == 1) return false;
 
@@ -167,6 +185,21 @@ bool FileInfoWorld::saveFile(const char* _fName, simulation::Recording* _record)
   return true;
 }
 
+//==============================================================================
+bool FileInfoWorld::saveBinaryFile(
+    const char* _fName, simulation::Recording* _record,
+    const simulation::RecordingFileOptions& _options)
+{
+  if (!simulation::RecordingWriter::write(_fName, *_record, _options))
+    return false;
+
+  std::string text = _fName;
+  int lastSlash = text.find_last_of("/");
+  text = text.substr(lastSlash+1);
+  std::strcpy(mFileName, text.c_str());
+  return true;
+}
+
 //==============================================================================
 simulation::Recording* FileInfoWorld::getRecording() const
 {
@@ -37,6 +37,8 @@
 #ifndef DART_UTILS_FILEINFOWORLD_H_
 #define DART_UTILS_FILEINFOWORLD_H_
 
+#include "dart/simulation/RecordingFile.h"
+
 namespace dart {
 
 namespace simulation {
@@ -55,13 +57,20 @@ public:
   /// \brief Destructor
   virtual ~FileInfoWorld();
 
-  /// \brief Load file
+  /// \brief Load file. Both the text format written by saveFile() and the
+  /// binary format written by saveBinaryFile() are supported.
   bool loadFile(const char* _fileName);
 
   /// \brief Save file
   /// \note Down sampling not implemented yet
   bool saveFile(const char* _fileName, simulation::Recording* _record);
 
+  /// \brief Save file in the binary recording format, which is much smaller
+  /// and faster to load than the text format
+  bool saveBinaryFile(const char* _fileName, simulation::Recording* _record,
+                      const simulation::RecordingFileOptions& _options
+                          = simulation::RecordingFileOptions());
+
   /// \brief Get recording
   simulation::Recording* getRecording() const;
 
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/utils/MeshPrefetcher.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "dart/dynamics/MeshCache.h"
+
+namespace dart {
+namespace utils {
+
+namespace {
+
+std::atomic<size_t> gNumThreads(1u);
+
+} // anonymous namespace
+
+//==============================================================================
+MeshPrefetcher::MeshPrefetcher(const common::ResourceRetrieverPtr& _retriever)
+  : mRetriever(_retriever)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void MeshPrefetcher::add(const std::string& _uri)
+{
+  if(mUriSet.insert(_uri).second)
+    mUris.push_back(_uri);
+}
+
+//==============================================================================
+void MeshPrefetcher::load()
+{
+  const size_t numThreads = std::min(getNumThreads(), mUris.size());
+  if(numThreads <= 1u)
+    return;
+
+  mMeshes.resize(mUris.size());
+
+  // Each thread takes the next mesh that has not been started yet, so slow
+  // imports do not hold up the others
+  std::atomic<size_t> next(0u);
+  auto work = [&]()
+  {
+    dynamics::MeshCache& cache = dynamics::MeshCache::getDefault();
+    for(size_t i = next++; i < mUris.size(); i = next++)
+    {
+      // Failures are not cached, so the parser imports the mesh again on its
+      // own thread and reports the error there
+      try
+      {
+        mMeshes[i] = cache.getMesh(mUris[i], mRetriever);
+      }
+      catch(...)
+      {
+        mMeshes[i] = nullptr;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads - 1u);
+  for(size_t i = 1u; i < numThreads; ++i)
+    threads.emplace_back(work);
+
+  work();
+
+  for(std::thread& thread : threads)
+    thread.join();
+}
+
+//==============================================================================
+size_t MeshPrefetcher::getNumMeshes() const
+{
+  return mUris.size();
+}
+
+//==============================================================================
+void MeshPrefetcher::setNumThreads(size_t _numThreads)
+{
+  gNumThreads = std::max<size_t>(_numThreads, 1u);
+}
+
+//==============================================================================
+size_t MeshPrefetcher::getNumThreads()
+{
+  return gNumThreads;
+}
+
+}  // namespace utils
+}  // namespace dart
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_UTILS_MESHPREFETCHER_H_
+#define DART_UTILS_MESHPREFETCHER_H_
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <assimp/scene.h>
+
+#include "dart/common/ResourceRetriever.h"
+
+namespace dart {
+namespace utils {
+
+/// MeshPrefetcher loads a set of meshes into dynamics::MeshCache::getDefault()
+/// on several threads at once. The file parsers first collect the URIs of all
+/// the meshes that a file refers to, prefetch them, and then build the
+/// Skeletons as usual, at which point every mesh is served by the cache. The
+/// result is therefore identical to loading the file on a single thread.
+///
+/// The prefetched meshes are kept alive until the MeshPrefetcher is destroyed,
+/// so it must outlive the construction of the Skeletons. Prefetching is
+/// disabled by default, since the ResourceRetriever that is passed to the
+/// parsers must support being used from several threads at once before it can
+/// be enabled with setNumThreads().
+class MeshPrefetcher
+{
+public:
+  /// Constructor
+  explicit MeshPrefetcher(const common::ResourceRetrieverPtr& _retriever);
+
+  /// Queue the mesh at _uri. Duplicates are ignored.
+  void add(const std::string& _uri);
+
+  /// Load all the queued meshes and wait for them to finish. Meshes that fail
+  /// to load, including by throwing, are skipped and left to the parser.
+  void load();
+
+  /// Number of distinct meshes that have been queued
+  size_t getNumMeshes() const;
+
+  /// Set the number of threads that load() uses. Prefetching is disabled when
+  /// this is 1, which is the default. Only use more threads if all the
+  /// ResourceRetrievers that are passed to the parsers are thread-safe.
+  static void setNumThreads(size_t _numThreads);
+
+  /// Get the number of threads that load() uses
+  static size_t getNumThreads();
+
+protected:
+  /// Retriever that the meshes are loaded with
+  common::ResourceRetrieverPtr mRetriever;
+
+  /// URIs in the order in which they were added
+  std::vector<std::string> mUris;
+
+  /// URIs that have been added, for fast duplicate checks
+  std::unordered_set<std::string> mUriSet;
+
+  /// Meshes that have been loaded, in the same order as mUris
+  std::vector<std::shared_ptr<const aiScene>> mMeshes;
+};
+
+}  // namespace utils
+}  // namespace dart
+
+#endif  // DART_UTILS_MESHPREFETCHER_H_
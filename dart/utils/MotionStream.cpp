@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/utils/MotionStream.h"
+
+#include <cassert>
+#include <cmath>
+#include <iterator>
+
+namespace dart {
+namespace utils {
+
+//==============================================================================
+MotionStream::MotionStream(size_t _cacheCapacity)
+  : mIsOpen(false),
+    mNumFrames(0u),
+    mFrameSize(0u),
+    mFPS(0.0),
+    mCacheCapacity(_cacheCapacity),
+    mNumDecodedFrames(0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+bool MotionStream::isOpen() const
+{
+  return mIsOpen;
+}
+
+//==============================================================================
+size_t MotionStream::getNumFrames() const
+{
+  return mNumFrames;
+}
+
+//==============================================================================
+size_t MotionStream::getFrameSize() const
+{
+  return mFrameSize;
+}
+
+//==============================================================================
+double MotionStream::getFPS() const
+{
+  return mFPS;
+}
+
+//==============================================================================
+double MotionStream::getDuration() const
+{
+  if(mNumFrames == 0u || mFPS <= 0.0)
+    return 0.0;
+
+  return static_cast<double>(mNumFrames - 1u) / mFPS;
+}
+
+//==============================================================================
+const Eigen::VectorXd& MotionStream::getFrame(size_t _frame)
+{
+  assert(_frame < mNumFrames);
+
+  const auto it = mEntryMap.find(_frame);
+  if(it != mEntryMap.end())
+  {
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+    return it->second->mValues;
+  }
+
+  if(mCacheCapacity == 0u)
+  {
+    mUncachedFrame.resize(mFrameSize);
+    decodeFrame(_frame, mUncachedFrame);
+    ++mNumDecodedFrames;
+    return mUncachedFrame;
+  }
+
+  // Reuse the storage of the least recently used frame if the cache is full
+  if(mEntries.size() >= mCacheCapacity)
+  {
+    evict(mCacheCapacity);
+    mEntryMap.erase(mEntries.back().mFrame);
+    mEntries.splice(mEntries.begin(), mEntries, std::prev(mEntries.end()));
+  }
+  else
+  {
+    mEntries.push_front(Entry());
+  }
+
+  Entry& entry = mEntries.front();
+  entry.mFrame = _frame;
+  entry.mValues.resize(mFrameSize);
+  decodeFrame(_frame, entry.mValues);
+  ++mNumDecodedFrames;
+  mEntryMap[_frame] = mEntries.begin();
+
+  return entry.mValues;
+}
+
+//==============================================================================
+Eigen::MatrixXd MotionStream::getWindow(size_t _start, size_t _count,
+                                        double _startTime, double _endTime)
+{
+  assert(_start + _count <= mFrameSize);
+
+  if(mNumFrames == 0u || _endTime < _startTime)
+    return Eigen::MatrixXd(_count, 0);
+
+  // Frames are at times i / mFPS. Without a frame rate, the window contains
+  // every frame.
+  const size_t first = getFrameAtTime(_startTime);
+  size_t end = mNumFrames;
+  if(mFPS > 0.0)
+  {
+    const double last = std::floor(_endTime * mFPS + 1e-9);
+    if(last < 0.0)
+      end = 0u;
+    else if(last + 1.0 < static_cast<double>(mNumFrames))
+      end = static_cast<size_t>(last) + 1u;
+  }
+
+  if(first >= end)
+    return Eigen::MatrixXd(_count, 0);
+
+  Eigen::MatrixXd window(_count, end - first);
+  Eigen::VectorXd values(mFrameSize);
+  for(size_t i = first; i < end; ++i)
+  {
+    const auto it = mEntryMap.find(i);
+    if(it != mEntryMap.end())
+    {
+      window.col(i - first) = it->second->mValues.segment(_start, _count);
+      continue;
+    }
+
+    decodeFrame(i, values);
+    ++mNumDecodedFrames;
+    window.col(i - first) = values.segment(_start, _count);
+  }
+
+  return window;
+}
+
+//==============================================================================
+size_t MotionStream::getFrameAtTime(double _time) const
+{
+  if(_time <= 0.0 || mFPS <= 0.0)
+    return 0u;
+
+  const double frame = std::ceil(_time * mFPS - 1e-9);
+  if(frame >= static_cast<double>(mNumFrames))
+    return mNumFrames;
+
+  return static_cast<size_t>(frame);
+}
+
+//==============================================================================
+void MotionStream::setCacheCapacity(size_t _capacity)
+{
+  mCacheCapacity = _capacity;
+  evict(mCacheCapacity);
+}
+
+//==============================================================================
+size_t MotionStream::getCacheCapacity() const
+{
+  return mCacheCapacity;
+}
+
+//==============================================================================
+size_t MotionStream::getNumCachedFrames() const
+{
+  return mEntries.size();
+}
+
+//==============================================================================
+void MotionStream::clearCache()
+{
+  mEntries.clear();
+  mEntryMap.clear();
+}
+
+//==============================================================================
+size_t MotionStream::getNumDecodedFrames() const
+{
+  return mNumDecodedFrames;
+}
+
+//==============================================================================
+void MotionStream::setLayout(size_t _numFrames, size_t _frameSize,
+                             double _fps)
+{
+  clearCache();
+  mIsOpen = true;
+  mNumFrames = _numFrames;
+  mFrameSize = _frameSize;
+  mFPS = _fps;
+  mNumDecodedFrames = 0u;
+}
+
+//==============================================================================
+void MotionStream::reset()
+{
+  clearCache();
+  mIsOpen = false;
+  mNumFrames = 0u;
+  mFrameSize = 0u;
+  mFPS = 0.0;
+  mNumDecodedFrames = 0u;
+}
+
+//==============================================================================
+void MotionStream::evict(size_t _capacity)
+{
+  while(mEntries.size() > _capacity)
+  {
+    mEntryMap.erase(mEntries.back().mFrame);
+    mEntries.pop_back();
+  }
+}
+
+} // namespace utils
+} // namespace dart
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_UTILS_MOTIONSTREAM_H_
+#define DART_UTILS_MOTIONSTREAM_H_
+
+#include <list>
+#include <unordered_map>
+#include <Eigen/Dense>
+
+namespace dart {
+namespace utils {
+
+/// MotionStream is the base class of readers that decode the frames of a
+/// motion file on demand instead of loading the whole motion up front.
+/// Derived classes index the location of every frame when the file is opened
+/// and implement decodeFrame().
+///
+/// Decoded frames are kept in a least recently used cache that holds at most
+/// getCacheCapacity() frames, so scrubbing back and forth through a part of a
+/// long capture only decodes each frame once while the memory use stays
+/// bounded. Batch extraction with getWindow() decodes the frames of the window
+/// in order and does not evict the cached frames.
+///
+/// A frame is a vector of getFrameSize() values, e.g. the positions of all the
+/// markers or all the DOFs at one point in time.
+class MotionStream
+{
+public:
+  /// Constructor. At most _cacheCapacity decoded frames are kept in memory.
+  explicit MotionStream(size_t _cacheCapacity = 256u);
+
+  /// Destructor
+  virtual ~MotionStream() = default;
+
+  /// Return true if a file has been opened successfully
+  bool isOpen() const;
+
+  /// Get the number of frames of the motion
+  size_t getNumFrames() const;
+
+  /// Get the number of values per frame
+  size_t getFrameSize() const;
+
+  /// Get the number of frames per second
+  double getFPS() const;
+
+  /// Get the duration of the motion in seconds, i.e. the time of the last frame
+  double getDuration() const;
+
+  /// Get frame _frame. The reference is valid until the next call of a
+  /// non-const member function of this MotionStream.
+  const Eigen::VectorXd& getFrame(size_t _frame);
+
+  /// Get the values [_start, _start + _count) of every frame whose time lies
+  /// in [_startTime, _endTime]. Each column of the result holds one frame.
+  Eigen::MatrixXd getWindow(size_t _start, size_t _count,
+                            double _startTime, double _endTime);
+
+  /// Get the index of the first frame at or after _time
+  size_t getFrameAtTime(double _time) const;
+
+  /// Set the maximum number of decoded frames to keep in memory. The least
+  /// recently used frames are evicted if necessary.
+  void setCacheCapacity(size_t _capacity);
+
+  /// Get the maximum number of decoded frames to keep in memory
+  size_t getCacheCapacity() const;
+
+  /// Get the number of decoded frames that are currently cached
+  size_t getNumCachedFrames() const;
+
+  /// Remove all the decoded frames from the cache
+  void clearCache();
+
+  /// Get the number of frames that have been decoded so far, including the
+  /// ones that were decoded by getWindow()
+  size_t getNumDecodedFrames() const;
+
+protected:
+  /// Set the layout of the motion after the file has been indexed. This
+  /// clears the cache.
+  void setLayout(size_t _numFrames, size_t _frameSize, double _fps);
+
+  /// Forget the current file
+  void reset();
+
+  /// Decode frame _frame into _values, which has getFrameSize() elements.
+  /// _frame is always valid.
+  virtual void decodeFrame(size_t _frame, Eigen::VectorXd& _values) const = 0;
+
+  struct Entry
+  {
+    size_t mFrame;
+    Eigen::VectorXd mValues;
+  };
+
+  /// Evict the least recently used frames until the cache fits into
+  /// _capacity
+  void evict(size_t _capacity);
+
+  /// Whether a file has been indexed
+  bool mIsOpen;
+
+  /// Number of frames
+  size_t mNumFrames;
+
+  /// Number of values per frame
+  size_t mFrameSize;
+
+  /// Frames per second
+  double mFPS;
+
+  /// Maximum number of cached frames
+  size_t mCacheCapacity;
+
+  /// Cached frames, most recently used first
+  std::list<Entry> mEntries;
+
+  /// Position of each cached frame in mEntries
+  std::unordered_map<size_t, std::list<Entry>::iterator> mEntryMap;
+
+  /// Frame returned by getFrame() when the cache capacity is zero
+  Eigen::VectorXd mUncachedFrame;
+
+  /// Number of decoded frames
+  size_t mNumDecodedFrames;
+};
+
+} // namespace utils
+} // namespace dart
+
+#endif // DART_UTILS_MOTIONSTREAM_H_
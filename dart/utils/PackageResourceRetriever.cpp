@@ -73,6 +73,16 @@ void PackageResourceRetriever::addPackageDirectory(
 //==============================================================================
 bool PackageResourceRetriever::exists(const common::Uri& _uri)
 {
+  const std::string uri = _uri.toString();
+  common::Uri resolvedUri;
+  if (getResolvedUri(uri, resolvedUri))
+  {
+    if (mLocalRetriever->exists(resolvedUri))
+      return true;
+
+    setResolvedUri(uri, "");
+  }
+
   std::string packageName, relativePath;
   if (!resolvePackageUri(_uri, packageName, relativePath))
     return false;
@@ -83,7 +93,10 @@ bool PackageResourceRetriever::exists(const common::Uri& _uri)
     fileUri.fromPath(packagePath + relativePath);
 
     if (mLocalRetriever->exists(fileUri))
+    {
+      setResolvedUri(uri, fileUri.toString());
       return true;
+    }
   }
   return false;
 }
@@ -91,6 +104,16 @@ bool PackageResourceRetriever::exists(const common::Uri& _uri)
 //==============================================================================
 common::ResourcePtr PackageResourceRetriever::retrieve(const common::Uri& _uri)
 {
+  const std::string uri = _uri.toString();
+  common::Uri resolvedUri;
+  if (getResolvedUri(uri, resolvedUri))
+  {
+    if(const auto resource = mLocalRetriever->retrieve(resolvedUri))
+      return resource;
+
+    setResolvedUri(uri, "");
+  }
+
   std::string packageName, relativePath;
   if (!resolvePackageUri(_uri, packageName, relativePath))
     return nullptr;
@@ -101,7 +124,10 @@ common::ResourcePtr PackageResourceRetriever::retrieve(const common::Uri& _uri)
     fileUri.fromPath(packagePath + relativePath);
 
     if(const auto resource = mLocalRetriever->retrieve(fileUri))
+    {
+      setResolvedUri(uri, fileUri.toString());
       return resource;
+    }
   }
   return nullptr;
 }
@@ -152,5 +178,28 @@ bool PackageResourceRetriever::resolvePackageUri(
   return true;
 }
 
+//==============================================================================
+bool PackageResourceRetriever::getResolvedUri(
+  const std::string& _uri, common::Uri& _fileUri) const
+{
+  std::lock_guard<std::mutex> lock(mResolvedUrisMutex);
+  const auto it = mResolvedUris.find(_uri);
+  if(it == std::end(mResolvedUris))
+    return false;
+
+  return _fileUri.fromString(it->second);
+}
+
+//==============================================================================
+void PackageResourceRetriever::setResolvedUri(
+  const std::string& _uri, const std::string& _fileUri)
+{
+  std::lock_guard<std::mutex> lock(mResolvedUrisMutex);
+  if(_fileUri.empty())
+    mResolvedUris.erase(_uri);
+  else
+    mResolvedUris[_uri] = _fileUri;
+}
+
 } // namespace utils
 } // namespace dart
@@ -37,6 +37,7 @@
 #ifndef DART_UTILS_PACKAGERESOURCERETRIEVER_H_
 #define DART_UTILS_PACKAGERESOURCERETRIEVER_H_
 
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 #include "dart/common/ResourceRetriever.h"
@@ -86,6 +87,10 @@ public:
   ///
   /// This class supports arbitrary URIs for \a _packageDirectory, as long as
   /// they are supported by the \a _localRetriever passed to the constructor.
+  ///
+  /// The candidate that a URI was found in is remembered, and later lookups of
+  /// the same URI try it first. Use a \ref CachingResourceRetriever to also
+  /// cache failed lookups and the content of the resources.
   void addPackageDirectory(const std::string& _packageName,
                            const std::string& _packageDirectory);
 
@@ -99,10 +104,20 @@ private:
   common::ResourceRetrieverPtr mLocalRetriever;
   std::unordered_map<std::string, std::vector<std::string> > mPackageMap;
 
+  /// Resolved file URI of each package URI that has been found
+  std::unordered_map<std::string, std::string> mResolvedUris;
+  mutable std::mutex mResolvedUrisMutex;
+
   const std::vector<std::string>& getPackagePaths(
     const std::string& _packageName) const;
   bool resolvePackageUri(const common::Uri& _uri,
     std::string& _packageName, std::string& _relativePath) const;
+
+  /// Get the previously resolved file URI of _uri, if any
+  bool getResolvedUri(const std::string& _uri, common::Uri& _fileUri) const;
+
+  /// Remember that _uri resolves to _fileUri, or forget it if _fileUri is empty
+  void setResolvedUri(const std::string& _uri, const std::string& _fileUri);
 };
 
 using PackageResourceRetrieverPtr = std::shared_ptr<PackageResourceRetriever>;
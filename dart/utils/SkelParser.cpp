@@ -59,6 +59,7 @@
 #include "dart/dynamics/CylinderShape.h"
 #include "dart/dynamics/EllipsoidShape.h"
 #include "dart/dynamics/PlaneShape.h"
+#include "dart/dynamics/MeshCache.h"
 #include "dart/dynamics/MeshShape.h"
 #include "dart/dynamics/SoftMeshShape.h"
 #include "dart/dynamics/Joint.h"
@@ -76,6 +77,7 @@
 #include "dart/dynamics/PlanarJoint.h"
 #include "dart/dynamics/Skeleton.h"
 #include "dart/dynamics/Marker.h"
+#include "dart/utils/MeshPrefetcher.h"
 #include "dart/utils/XmlHelpers.h"
 
 namespace dart {
@@ -242,6 +244,11 @@ JointPropPtr readWeldJoint(
 common::ResourceRetrieverPtr getRetriever(
     const common::ResourceRetrieverPtr& _retriever);
 
+void prefetchMeshes(
+    tinyxml2::XMLElement* _element,
+    const common::Uri& _baseUri,
+    MeshPrefetcher& _prefetcher);
+
 dynamics::ShapeNode* readShapeNode(
     dynamics::BodyNode* bodyNode,
     tinyxml2::XMLElement* shapeNodeEle,
@@ -447,6 +454,10 @@ simulation::WorldPtr SkelParser::readWorld(
     return nullptr;
   }
 
+  MeshPrefetcher prefetcher(retriever);
+  prefetchMeshes(worldElement, _uri, prefetcher);
+  prefetcher.load();
+
   return ::dart::utils:: readWorld(worldElement, _uri, retriever);
 }
 
@@ -472,6 +483,10 @@ simulation::WorldPtr SkelParser::readWorldXML(
     return nullptr;
   }
 
+  MeshPrefetcher prefetcher(retriever);
+  prefetchMeshes(worldElement, _baseUri, prefetcher);
+  prefetcher.load();
+
   return ::dart::utils:: readWorld(worldElement, _baseUri, retriever);
 }
 
@@ -519,6 +534,10 @@ dynamics::SkeletonPtr SkelParser::readSkeleton(
     return nullptr;
   }
 
+  MeshPrefetcher prefetcher(retriever);
+  prefetchMeshes(skeletonElement, _fileUri, prefetcher);
+  prefetcher.load();
+
   dynamics::SkeletonPtr newSkeleton = ::dart::utils:: readSkeleton(
     skeletonElement, _fileUri, retriever);
 
@@ -1284,7 +1303,8 @@ dynamics::ShapePtr readShape(
     Eigen::Vector3d       scale        = getValueVector3d(meshEle, "scale");
 
     const std::string meshUri = common::Uri::getRelativeUri(baseUri, filename);
-    const aiScene* model = dynamics::MeshShape::loadMesh(meshUri, retriever);
+    const std::shared_ptr<const aiScene> model
+        = dynamics::MeshCache::getDefault().getMesh(meshUri, retriever);
     if (model)
     {
       newShape = std::make_shared<dynamics::MeshShape>(
@@ -2400,6 +2420,28 @@ common::ResourceRetrieverPtr getRetriever(
     return std::make_shared<common::LocalResourceRetriever>();
 }
 
+//==============================================================================
+void prefetchMeshes(
+    tinyxml2::XMLElement* _element,
+    const common::Uri& _baseUri,
+    MeshPrefetcher& _prefetcher)
+{
+  // The URIs are resolved exactly like readShape() does
+  for (tinyxml2::XMLElement* child = _element->FirstChildElement();
+       child != nullptr; child = child->NextSiblingElement())
+  {
+    if (std::string(child->Name()) == "mesh" && hasElement(child, "file_name"))
+    {
+      _prefetcher.add(common::Uri::getRelativeUri(
+          _baseUri, getValueString(child, "file_name")));
+    }
+    else
+    {
+      prefetchMeshes(child, _baseUri, _prefetcher);
+    }
+  }
+}
+
 } // anonymous namespace
 
 }  // namespace utils
@@ -665,18 +665,30 @@ void openXMLFile(tinyxml2::XMLDocument& doc,
     throw std::runtime_error("Failed opening URI.");
   }
 
-  // C++11 guarantees that std::string has contiguous storage.
+  // TinyXML2 always copies the text that it parses. Memory-mapped resources
+  // are parsed straight from the mapping, which saves reading them into an
+  // intermediate string first.
   const size_t size = resource->getSize();
-  std::string content;
-  content.resize(size);
-  if(resource->read(&content.front(), size, 1) != 1)
+  int result;
+  if(const void* data = resource->getData())
   {
-    dtwarn << "[openXMLFile] Failed reading from URI '"
-           << uri.toString() << "'.\n";
-    throw std::runtime_error("Failed reading from URI.");
+    result = doc.Parse(static_cast<const char*>(data), size);
+  }
+  else
+  {
+    // C++11 guarantees that std::string has contiguous storage.
+    std::string content;
+    content.resize(size);
+    if(resource->read(&content.front(), size, 1) != 1)
+    {
+      dtwarn << "[openXMLFile] Failed reading from URI '"
+             << uri.toString() << "'.\n";
+      throw std::runtime_error("Failed reading from URI.");
+    }
+
+    result = doc.Parse(&content.front());
   }
 
-  int const result = doc.Parse(&content.front());
   if(result != tinyxml2::XML_SUCCESS)
   {
     dtwarn << "[openXMLFile] Failed parsing XML: TinyXML2 returned error"
@@ -53,6 +53,7 @@
 #include "dart/dynamics/BoxShape.h"
 #include "dart/dynamics/CylinderShape.h"
 #include "dart/dynamics/EllipsoidShape.h"
+#include "dart/dynamics/MeshCache.h"
 #include "dart/dynamics/MeshShape.h"
 #include "dart/dynamics/WeldJoint.h"
 #include "dart/dynamics/PrismaticJoint.h"
@@ -65,6 +66,7 @@
 #include "dart/dynamics/UniversalJoint.h"
 #include "dart/dynamics/Skeleton.h"
 #include "dart/simulation/World.h"
+#include "dart/utils/MeshPrefetcher.h"
 #include "dart/utils/SkelParser.h"
 #include "dart/utils/XmlHelpers.h"
 #include "dart/utils/sdf/SdfParser.h"
@@ -255,6 +257,11 @@ dynamics::FreeJoint::Properties readFreeJoint(
 common::ResourceRetrieverPtr getRetriever(
     const common::ResourceRetrieverPtr& retriever);
 
+void prefetchMeshes(
+    tinyxml2::XMLElement* element,
+    const std::string& skelPath,
+    MeshPrefetcher& prefetcher);
+
 } // anonymous namespace
 
 
@@ -319,6 +326,10 @@ simulation::WorldPtr readWorld(
   std::string fileName = fileUri.getFilesystemPath();  // Uri's path is unix-style path
   std::string skelPath = fileName.substr(0, fileName.rfind("/") + 1);
 
+  MeshPrefetcher prefetcher(retriever);
+  prefetchMeshes(worldElement, skelPath, prefetcher);
+  prefetcher.load();
+
   return readWorld(worldElement, skelPath, retriever);
 }
 
@@ -372,6 +383,10 @@ dynamics::SkeletonPtr readSkeleton(
   std::string fileName = fileUri.getFilesystemPath();  // Uri's path is unix-style path
   std::string skelPath = fileName.substr(0, fileName.rfind("/") + 1);
 
+  MeshPrefetcher prefetcher(retriever);
+  prefetchMeshes(skelElement, skelPath, prefetcher);
+  prefetcher.load();
+
   dynamics::SkeletonPtr newSkeleton = readSkeleton(skelElement, skelPath,
                                                    retriever);
 
@@ -959,7 +974,8 @@ dynamics::ShapePtr readShape(
           getValueVector3d(meshEle, "scale") : Eigen::Vector3d::Ones();
 
     const std::string meshUri = common::Uri::getRelativeUri(_skelPath, uri);
-    const aiScene* model = dynamics::MeshShape::loadMesh(meshUri, _retriever);
+    const std::shared_ptr<const aiScene> model
+        = dynamics::MeshCache::getDefault().getMesh(meshUri, _retriever);
 
     if (model)
       newShape = std::make_shared<dynamics::MeshShape>(
@@ -1539,6 +1555,28 @@ common::ResourceRetrieverPtr getRetriever(
     return std::make_shared<common::LocalResourceRetriever>();
 }
 
+//==============================================================================
+void prefetchMeshes(
+    tinyxml2::XMLElement* element,
+    const std::string& skelPath,
+    MeshPrefetcher& prefetcher)
+{
+  // The URIs are resolved exactly like readShape() does
+  for (tinyxml2::XMLElement* child = element->FirstChildElement();
+       child != nullptr; child = child->NextSiblingElement())
+  {
+    if (std::string(child->Name()) == "mesh" && hasElement(child, "uri"))
+    {
+      prefetcher.add(common::Uri::getRelativeUri(
+          skelPath, getValueString(child, "uri")));
+    }
+    else
+    {
+      prefetchMeshes(child, skelPath, prefetcher);
+    }
+  }
+}
+
 } // anonymouse
 
 } // namespace SdfParser
@@ -19,6 +19,7 @@
 #include "dart/dynamics/BoxShape.h"
 #include "dart/dynamics/EllipsoidShape.h"
 #include "dart/dynamics/CylinderShape.h"
+#include "dart/dynamics/MeshCache.h"
 #include "dart/dynamics/MeshShape.h"
 #include "dart/simulation/World.h"
 #include "dart/utils/urdf/urdf_world_parser.h"
@@ -28,6 +29,27 @@ using ModelInterfacePtr = boost::shared_ptr<urdf::ModelInterface>;
 namespace dart {
 namespace utils {
 
+namespace {
+
+//==============================================================================
+template <class VisualOrCollision>
+void prefetchMesh(const VisualOrCollision* _vizOrCol,
+                  const common::Uri& _baseUri,
+                  MeshPrefetcher& _prefetcher)
+{
+  const urdf::Mesh* mesh
+      = dynamic_cast<const urdf::Mesh*>(_vizOrCol->geometry.get());
+  if(!mesh)
+    return;
+
+  // The URI is resolved exactly like createShape() does
+  common::Uri absoluteUri;
+  if(absoluteUri.fromRelativeUri(_baseUri, mesh->filename))
+    _prefetcher.add(absoluteUri.toString());
+}
+
+} // anonymous namespace
+
 DartLoader::DartLoader()
   : mLocalRetriever(new common::LocalResourceRetriever),
     mPackageRetriever(new utils::PackageResourceRetriever(mLocalRetriever)),
@@ -63,6 +85,10 @@ dynamics::SkeletonPtr DartLoader::parseSkeleton(
     return nullptr;
   }
 
+  MeshPrefetcher prefetcher(resourceRetriever);
+  prefetchMeshes(urdfInterface.get(), _uri, prefetcher);
+  prefetcher.load();
+
   return modelInterfaceToSkeleton(urdfInterface.get(), _uri, resourceRetriever);
 }
 
@@ -84,8 +110,15 @@ dynamics::SkeletonPtr DartLoader::parseSkeletonString(
     return nullptr;
   }
 
+  const common::ResourceRetrieverPtr resourceRetriever
+    = getResourceRetriever(_resourceRetriever);
+
+  MeshPrefetcher prefetcher(resourceRetriever);
+  prefetchMeshes(urdfInterface.get(), _baseUri, prefetcher);
+  prefetcher.load();
+
   return modelInterfaceToSkeleton(
-    urdfInterface.get(), _baseUri, getResourceRetriever(_resourceRetriever));
+    urdfInterface.get(), _baseUri, resourceRetriever);
 }
 
 simulation::WorldPtr DartLoader::parseWorld(
@@ -125,6 +158,12 @@ simulation::WorldPtr DartLoader::parseWorldString(
     return nullptr;
   }
 
+  // Load the meshes of all the models concurrently before building them
+  MeshPrefetcher prefetcher(resourceRetriever);
+  for(const urdf_parsing::Entity& entity : worldInterface->models)
+    prefetchMeshes(entity.model.get(), entity.uri, prefetcher);
+  prefetcher.load();
+
   simulation::WorldPtr world(new simulation::World);
 
   for(size_t i = 0; i < worldInterface->models.size(); ++i)
@@ -272,8 +311,16 @@ bool DartLoader::readFileToString(
   if (!resource)
     return false;
 
-  // Safe because std::string is guaranteed to be contiguous in C++11.
+  // The URDF parser needs an std::string, so memory-mapped resources are
+  // copied straight out of the mapping
   const size_t size = resource->getSize();
+  if (const void* data = resource->getData())
+  {
+    _output.assign(static_cast<const char*>(data), size);
+    return true;
+  }
+
+  // Safe because std::string is guaranteed to be contiguous in C++11.
   _output.resize(size);
   resource->read(&_output.front(), size, 1);
 
@@ -484,6 +531,22 @@ bool DartLoader::createShapeNodes(
   return true;
 }
 
+//==============================================================================
+void DartLoader::prefetchMeshes(
+  const urdf::ModelInterface* _model,
+  const common::Uri& _baseUri,
+  MeshPrefetcher& _prefetcher)
+{
+  for(const auto& link : _model->links_)
+  {
+    for(const auto& visual : link.second->visual_array)
+      prefetchMesh(visual.get(), _baseUri, _prefetcher);
+
+    for(const auto& collision : link.second->collision_array)
+      prefetchMesh(collision.get(), _baseUri, _prefetcher);
+  }
+}
+
 /**
  * @function createShape
  */
@@ -528,8 +591,9 @@ dynamics::ShapePtr DartLoader::createShape(
 
     // Load the mesh.
     const std::string resolvedUri = absoluteUri.toString();
-    const aiScene* scene = dynamics::MeshShape::loadMesh(
-      resolvedUri, _resourceRetriever);
+    const std::shared_ptr<const aiScene> scene
+      = dynamics::MeshCache::getDefault().getMesh(
+          resolvedUri, _resourceRetriever);
     if (!scene)
       return nullptr;
 
@@ -19,6 +19,7 @@
 #include "dart/dynamics/Skeleton.h"
 #include "dart/simulation/World.h"
 #include "dart/utils/CompositeResourceRetriever.h"
+#include "dart/utils/MeshPrefetcher.h"
 #include "dart/utils/PackageResourceRetriever.h"
 
 namespace urdf
@@ -111,6 +112,12 @@ private:
       const common::Uri& _baseUri,
       const common::ResourceRetrieverPtr& _resourceRetriever);
 
+    /// Queue the meshes of all the links of _model in _prefetcher
+    static void prefetchMeshes(
+      const urdf::ModelInterface* _model,
+      const common::Uri& _baseUri,
+      MeshPrefetcher& _prefetcher);
+
     template <class VisualOrCollision>
     static dynamics::ShapePtr createShape(const VisualOrCollision* _vizOrCol,
       const common::Uri& _baseUri,
@@ -71,12 +71,32 @@ ShapeFrameNode::ShapeFrameNode(
   : mShapeFrame(_frame),
     mWorldNode(_worldNode),
     mShapeNode(nullptr),
-    mUtilized(false)
+    mUtilized(false),
+    mTransformDirty(true),
+    mShapeVersion(0),
+    mShapeFrameVersion(0)
 {
   refresh();
   setName(_frame->getName()+" [frame]");
 }
 
+//==============================================================================
+ShapeFrameNode::ShapeFrameNode(
+    dart::dynamics::ShapeFrame* _frame,
+    WorldNode* _worldNode,
+    const Eigen::Isometry3d& _worldTransform)
+  : mShapeFrame(_frame),
+    mWorldNode(_worldNode),
+    mShapeNode(nullptr),
+    mUtilized(false),
+    mTransformDirty(true),
+    mShapeVersion(0),
+    mShapeFrameVersion(0)
+{
+  refresh(_worldTransform);
+  setName(_frame->getName()+" [frame]");
+}
+
 //==============================================================================
 dart::dynamics::ShapeFrame* ShapeFrameNode::getShapeFrame()
 {
@@ -109,16 +129,48 @@ void ShapeFrameNode::refresh(bool shortCircuitIfUtilized)
 
   mUtilized = true;
 
+  if(!mTransformConnection.isConnected())
+  {
+    // We cannot know what happened to the transform while we were not
+    // listening, so it needs to be updated once
+    mTransformConnection = mShapeFrame->onTransformUpdated.connect(
+          [this](const dart::dynamics::Entity*) { mTransformDirty = true; });
+    mTransformDirty = true;
+  }
+
+  if(mTransformDirty)
+  {
+    mTransformDirty = false;
+    setMatrix(eigToOsgMatrix(mShapeFrame->getWorldTransform()));
+  }
+
   auto shape = mShapeFrame->getShape();
+  if(shape)
+    refreshShapeNode(shape);
+}
 
-  setMatrix(eigToOsgMatrix(mShapeFrame->getWorldTransform()));
-  // TODO(JS): Maybe the data varicance information should be in ShapeFrame and
-  // checked here.
+//==============================================================================
+void ShapeFrameNode::refresh(const Eigen::Isometry3d& worldTransform,
+                             bool shortCircuitIfUtilized)
+{
+  if(shortCircuitIfUtilized && mUtilized)
+    return;
 
+  mUtilized = true;
+
+  setMatrix(eigToOsgMatrix(worldTransform));
+
+  auto shape = mShapeFrame->getShape();
   if(shape)
     refreshShapeNode(shape);
 }
 
+//==============================================================================
+void ShapeFrameNode::disconnectTransformUpdates()
+{
+  mTransformConnection.disconnect();
+}
+
 //==============================================================================
 bool ShapeFrameNode::wasUtilized() const
 {
@@ -134,20 +186,32 @@ void ShapeFrameNode::clearUtilization()
 //==============================================================================
 ShapeFrameNode::~ShapeFrameNode()
 {
-  // Do nothing
+  mTransformConnection.disconnect();
 }
 
 //==============================================================================
 void ShapeFrameNode::refreshShapeNode(
     const std::shared_ptr<dart::dynamics::Shape>& shape)
 {
+  const size_t shapeVersion = shape->getVersion();
+  const size_t frameVersion = mShapeFrame->getVersion();
+
   if(mShapeNode && mShapeNode->getShape() == shape)
   {
+    // Neither the geometry nor the visual properties have changed since the
+    // last refresh, so there is nothing to extract
+    if(shapeVersion == mShapeVersion && frameVersion == mShapeFrameVersion)
+      return;
+
     mShapeNode->refresh();
-    return;
+  }
+  else
+  {
+    createShapeNode(shape);
   }
 
-  createShapeNode(shape);
+  mShapeVersion = shapeVersion;
+  mShapeFrameVersion = frameVersion;
 }
 
 //==============================================================================
@@ -40,6 +40,8 @@
 #include <map>
 #include <memory>
 #include <osg/MatrixTransform>
+#include <Eigen/Geometry>
+#include "dart/common/Signal.h"
 #include "dart/dynamics/SmartPointer.h"
 
 namespace dart {
@@ -68,6 +70,12 @@ public:
   ShapeFrameNode(dart::dynamics::ShapeFrame* frame,
                  WorldNode* worldNode);
 
+  /// Create a ShapeFrameNode that is initially placed at the given world
+  /// transform instead of the current transform of the ShapeFrame
+  ShapeFrameNode(dart::dynamics::ShapeFrame* frame,
+                 WorldNode* worldNode,
+                 const Eigen::Isometry3d& worldTransform);
+
   /// Pointer to the ShapeFrame associated with this ShapeFrameNode
   dart::dynamics::ShapeFrame* getShapeFrame();
 
@@ -78,13 +86,27 @@ public:
 
   const WorldNode* getWorldNode() const;
 
-  /// Update all rendering data for this ShapeFrame
+  /// Update the rendering data of this ShapeFrame that has changed since the
+  /// last refresh. The transform is only updated after the ShapeFrame has
+  /// notified a transform update, and the ShapeNode is only refreshed when the
+  /// version of the Shape or of the ShapeFrame has changed.
   ///
   /// If shortCircuitIfUtilized is true, this will skip the refresh process if
   /// mUtilized is set to true. clearUtilization() needs to be called before
   /// this function if short circuiting is going to be used.
   void refresh(bool shortCircuitIfUtilized = false);
 
+  /// Same as refresh(bool), but places the ShapeFrame at the given world
+  /// transform instead of querying the ShapeFrame for it. This is used to
+  /// render snapshots that were taken by a simulation thread.
+  void refresh(const Eigen::Isometry3d& worldTransform,
+               bool shortCircuitIfUtilized = false);
+
+  /// Stop listening to the transform updates of the ShapeFrame. Signals are
+  /// not thread-safe, so this must be called before the ShapeFrame is updated
+  /// by another thread. The next call of refresh(bool) listens again.
+  void disconnectTransformUpdates();
+
   /// True iff this ShapeFrameNode has been utilized on the latest update
   bool wasUtilized() const;
 
@@ -112,6 +134,19 @@ protected:
   /// used and should be deleted.
   bool mUtilized;
 
+  /// True iff the ShapeFrame has notified a transform update since the
+  /// transform of this node was last set
+  bool mTransformDirty;
+
+  /// Connection to the transform updated signal of the ShapeFrame
+  dart::common::Connection mTransformConnection;
+
+  /// Version of the Shape when the ShapeNode was last refreshed
+  size_t mShapeVersion;
+
+  /// Version of the ShapeFrame when the ShapeNode was last refreshed
+  size_t mShapeFrameVersion;
+
 };
 
 } // namespace osgDart
@@ -42,6 +42,7 @@
 #include "osgDart/ShapeFrameNode.h"
 
 #include "dart/simulation/World.h"
+#include "dart/simulation/RealTimeStepper.h"
 #include "dart/dynamics/Skeleton.h"
 #include "dart/dynamics/BodyNode.h"
 
@@ -65,9 +66,12 @@ public:
 
 //==============================================================================
 WorldNode::WorldNode(std::shared_ptr<dart::simulation::World> _world)
-  : mWorld(_world),
+  : mStructureDirty(true),
+    mWorld(_world),
     mSimulating(false),
     mNumStepsPerCycle(1),
+    mThreadedSimulation(false),
+    mRealTimeFactor(1.0),
     mViewer(nullptr)
 {
   setUpdateCallback(new WorldNodeCallback);
@@ -76,7 +80,10 @@ WorldNode::WorldNode(std::shared_ptr<dart::simulation::World> _world)
 //==============================================================================
 void WorldNode::setWorld(std::shared_ptr<dart::simulation::World> _newWorld)
 {
+  mStepper.reset();
   mWorld = _newWorld;
+  mStructureDirty = true;
+  updateStepper();
 }
 
 //==============================================================================
@@ -90,7 +97,19 @@ void WorldNode::refresh()
 {
   customPreRefresh();
 
-  clearChildUtilizationFlags();
+  if(mStepper)
+  {
+    clearChildUtilizationFlags();
+    refreshSnapshot();
+    clearUnusedNodes();
+
+    // Nodes may have been added or removed without the structure caches
+    // knowing about it
+    mStructureDirty = true;
+
+    customPostRefresh();
+    return;
+  }
 
   if(mSimulating)
   {
@@ -102,10 +121,31 @@ void WorldNode::refresh()
     }
   }
 
-  refreshSkeletons();
-  refreshSimpleFrames();
+  if(refreshStructureCache())
+  {
+    // Something was added to or removed from the World, so walk through all
+    // of its Frames to find out which nodes need to be created or cleared
+    clearChildUtilizationFlags();
 
-  clearUnusedNodes();
+    refreshSkeletons();
+    refreshSimpleFrames();
+
+    clearUnusedNodes();
+
+    mShapeFrameNodes.clear();
+    mShapeFrameNodes.reserve(mFrameToNode.size());
+    for(auto& node_pair : mFrameToNode)
+    {
+      if(node_pair.second)
+        mShapeFrameNodes.push_back(node_pair.second);
+    }
+  }
+  else
+  {
+    // Each node only touches the data whose change it has been notified of
+    for(ShapeFrameNode* node : mShapeFrameNodes)
+      node->refresh();
+  }
 
   customPostRefresh();
 }
@@ -144,6 +184,7 @@ bool WorldNode::isSimulating() const
 void WorldNode::simulate(bool _on)
 {
   mSimulating = _on;
+  updateStepper();
 }
 
 //==============================================================================
@@ -158,10 +199,39 @@ size_t WorldNode::getNumStepsPerCycle() const
   return mNumStepsPerCycle;
 }
 
+//==============================================================================
+void WorldNode::setThreadedSimulation(bool _threaded)
+{
+  mThreadedSimulation = _threaded;
+  updateStepper();
+}
+
+//==============================================================================
+bool WorldNode::isThreadedSimulation() const
+{
+  return mThreadedSimulation;
+}
+
+//==============================================================================
+void WorldNode::setRealTimeFactor(double _factor)
+{
+  mRealTimeFactor = _factor;
+  if(mStepper)
+    mStepper->setRealTimeFactor(_factor);
+}
+
+//==============================================================================
+double WorldNode::getRealTimeFactor() const
+{
+  return mRealTimeFactor;
+}
+
 //==============================================================================
 WorldNode::~WorldNode()
 {
-  // Do nothing
+  // Stop the simulation thread before the derived parts of this WorldNode,
+  // which it may call into, are gone
+  mStepper.reset();
 }
 
 //==============================================================================
@@ -229,6 +299,81 @@ void WorldNode::refreshSimpleFrames()
     refreshBaseFrameNode(mWorld->getSimpleFrame(i).get());
 }
 
+//==============================================================================
+bool WorldNode::refreshStructureCache()
+{
+  bool changed = mStructureDirty;
+  mStructureDirty = false;
+
+  if(!mWorld)
+  {
+    changed |= !mSkeletonVersions.empty() || !mSimpleShapeFrames.empty();
+    mSkeletonVersions.clear();
+    mSimpleShapeFrames.clear();
+    return changed;
+  }
+
+  // Any change to the tree of Frames of a Skeleton increments its version
+  const size_t numSkeletons = mWorld->getNumSkeletons();
+  if(mSkeletonVersions.size() != numSkeletons)
+  {
+    changed = true;
+    mSkeletonVersions.resize(numSkeletons);
+  }
+
+  for(size_t i=0; i < numSkeletons; ++i)
+  {
+    const dart::dynamics::SkeletonPtr& skeleton = mWorld->getSkeleton(i);
+    SkeletonVersion& cached = mSkeletonVersions[i];
+
+    // Compare the owners rather than the addresses, so that a new Skeleton
+    // that happens to be allocated where a removed one used to be is noticed
+    const bool sameSkeleton = !cached.first.owner_before(skeleton)
+        && !skeleton.owner_before(cached.first);
+    const size_t version = skeleton->getVersion();
+    if(!sameSkeleton || cached.second != version)
+    {
+      changed = true;
+      cached.first = skeleton;
+      cached.second = version;
+    }
+  }
+
+  // SimpleFrames do not have versions, but there are usually few of them, so
+  // we simply compare the ShapeFrames that can be found under them
+  mFrameQueue.clear();
+  for(size_t i=0, end=mWorld->getNumSimpleFrames(); i<end; ++i)
+    mFrameQueue.push_back(mWorld->getSimpleFrame(i).get());
+
+  size_t numShapeFrames = 0;
+  for(size_t i=0; i < mFrameQueue.size(); ++i)
+  {
+    dart::dynamics::Frame* frame = mFrameQueue[i];
+    if(frame->isShapeFrame())
+    {
+      if(numShapeFrames >= mSimpleShapeFrames.size()
+         || mSimpleShapeFrames[numShapeFrames] != frame)
+      {
+        changed = true;
+        mSimpleShapeFrames.resize(numShapeFrames);
+        mSimpleShapeFrames.push_back(frame);
+      }
+      ++numShapeFrames;
+    }
+
+    for(dart::dynamics::Frame* child : frame->getChildFrames())
+      mFrameQueue.push_back(child);
+  }
+
+  if(mSimpleShapeFrames.size() != numShapeFrames)
+  {
+    changed = true;
+    mSimpleShapeFrames.resize(numShapeFrames);
+  }
+
+  return changed;
+}
+
 //==============================================================================
 void WorldNode::refreshBaseFrameNode(dart::dynamics::Frame* frame)
 {
@@ -283,4 +428,65 @@ void WorldNode::refreshShapeFrameNode(dart::dynamics::Frame* frame)
   addChild(node);
 }
 
+//==============================================================================
+void WorldNode::refreshSnapshot()
+{
+  const dart::simulation::RealTimeStepper::Snapshot* snapshot =
+      mStepper->getLatestSnapshot();
+  if(!snapshot)
+    return;
+
+  // Only the snapshot is read here; the World itself belongs to the
+  // simulation thread until the stepper is stopped.
+  for(size_t i=0; i < snapshot->mShapeFrames.size(); ++i)
+  {
+    dart::dynamics::ShapeFrame* shapeFrame = snapshot->mShapeFrames[i];
+    const Eigen::Isometry3d& tf = snapshot->mTransforms[i];
+
+    std::pair<NodeMap::iterator, bool> insertion =
+        mFrameToNode.insert(std::make_pair(shapeFrame, nullptr));
+    NodeMap::iterator it = insertion.first;
+
+    if(!insertion.second)
+    {
+      if(it->second)
+        it->second->refresh(tf, true);
+      continue;
+    }
+
+    osg::ref_ptr<ShapeFrameNode> node =
+        new ShapeFrameNode(shapeFrame, this, tf);
+    it->second = node;
+    addChild(node);
+  }
+}
+
+//==============================================================================
+void WorldNode::updateStepper()
+{
+  const bool run = mWorld && mSimulating && mThreadedSimulation;
+  if(!run)
+  {
+    mStepper.reset();
+    return;
+  }
+
+  if(mStepper)
+    return;
+
+  // The signals of the World's Frames will be raised by the simulation
+  // thread, so the nodes must not listen to them while it is running
+  for(auto& node_pair : mFrameToNode)
+  {
+    if(node_pair.second)
+      node_pair.second->disconnectTransformUpdates();
+  }
+
+  mStepper.reset(new dart::simulation::RealTimeStepper(mWorld));
+  mStepper->setRealTimeFactor(mRealTimeFactor);
+  mStepper->setStepCallbacks([this]() { customPreStep(); },
+                             [this]() { customPostStep(); });
+  mStepper->start();
+}
+
 } // namespace osgDart
@@ -40,6 +40,7 @@
 #include <osg/Group>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
 #include "osgDart/Viewer.h"
 
@@ -47,12 +48,14 @@ namespace dart {
 
 namespace simulation {
 class World;
+class RealTimeStepper;
 } // namespace simulation
 
 namespace dynamics {
 class Frame;
 class Entity;
 class ShapeFrame;
+class Skeleton;
 }
 
 } // namespace dart
@@ -85,6 +88,12 @@ public:
   /// updates the tree of Frames and Entities that need to be rendered. It may
   /// also take a simulation step if the simulation is not paused.
   ///
+  /// The tree of Frames is only walked through when a Skeleton's version has
+  /// changed or the Frames under the World's SimpleFrames are different. In
+  /// all other cycles, only the nodes whose transform or Shape has changed are
+  /// updated. Frames attached to a SimpleFrame or ShapeNode of a Skeleton are
+  /// not noticed until the structure changes otherwise.
+  ///
   /// If you want to customize what happens at the beginning of each rendering
   /// cycle, you can either overload this function, or you can overload
   /// customUpdate(). This update() function will automatically call
@@ -135,6 +144,28 @@ public:
   /// if the simulation is not paused)
   size_t getNumStepsPerCycle() const;
 
+  /// Pass in true to step the World on its own thread at a fixed real-time
+  /// rate instead of taking getNumStepsPerCycle() steps in each render cycle.
+  /// The render cycles then only display the latest state that the
+  /// simulation thread has published, so a slow renderer does not slow down
+  /// the simulation and vice versa.
+  ///
+  /// While a threaded simulation is running, customPreStep() and
+  /// customPostStep() are called on the simulation thread, and the World must
+  /// only be modified from within those two functions.
+  void setThreadedSimulation(bool _threaded);
+
+  /// Returns true iff the World is stepped on its own thread while simulating
+  bool isThreadedSimulation() const;
+
+  /// Set the ratio of simulation time to wall-clock time for threaded
+  /// simulation. Pass in a non-positive value to step as fast as possible.
+  void setRealTimeFactor(double _factor);
+
+  /// Get the ratio of simulation time to wall-clock time for threaded
+  /// simulation
+  double getRealTimeFactor() const;
+
 protected:
 
   /// Destructor
@@ -162,11 +193,44 @@ protected:
 
   void refreshShapeFrameNode(dart::dynamics::Frame* frame);
 
+  /// Check whether the World has gained or lost any Frames since the last
+  /// call, and update the caches that this is decided with. Returns true if
+  /// all the Frames of the World need to be visited.
+  bool refreshStructureCache();
+
+  /// Refresh the rendering data from the latest snapshot of the simulation
+  /// thread
+  void refreshSnapshot();
+
+  /// Start the simulation thread if threaded simulation is active, or stop it
+  /// otherwise
+  void updateStepper();
+
   using NodeMap = std::unordered_map<dart::dynamics::Frame*, ShapeFrameNode*>;
 
   /// Map from Frame pointers to FrameNode pointers
   NodeMap mFrameToNode;
 
+  /// All the nodes in mFrameToNode, for refreshing them without a lookup
+  std::vector<ShapeFrameNode*> mShapeFrameNodes;
+
+  using SkeletonVersion =
+      std::pair<std::weak_ptr<dart::dynamics::Skeleton>, size_t>;
+
+  /// Versions of the Skeletons of the World when the tree of Frames was last
+  /// walked through
+  std::vector<SkeletonVersion> mSkeletonVersions;
+
+  /// ShapeFrames under the SimpleFrames of the World when the tree of Frames
+  /// was last walked through
+  std::vector<dart::dynamics::Frame*> mSimpleShapeFrames;
+
+  /// Queue reused for walking through the SimpleFrames
+  std::vector<dart::dynamics::Frame*> mFrameQueue;
+
+  /// True iff the tree of Frames must be walked through in the next refresh
+  bool mStructureDirty;
+
   /// The World that this WorldNode is associated with
   std::shared_ptr<dart::simulation::World> mWorld;
 
@@ -176,6 +240,15 @@ protected:
   /// Number of steps to take between rendering cycles
   size_t mNumStepsPerCycle;
 
+  /// True iff the World is stepped on its own thread
+  bool mThreadedSimulation;
+
+  /// Ratio of simulation time to wall-clock time for threaded simulation
+  double mRealTimeFactor;
+
+  /// Steps the World on its own thread during threaded simulation
+  std::unique_ptr<dart::simulation::RealTimeStepper> mStepper;
+
   /// Viewer that this WorldNode is inside of
   Viewer* mViewer;
 
@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include "TestHelpers.h"
+
+#include "dart/dynamics/BoxShape.h"
+#include "dart/dynamics/EllipsoidShape.h"
+#include "dart/dynamics/LineSegmentShape.h"
+#include "dart/dynamics/SimpleFrame.h"
+#include "dart/dynamics/SoftBodyNode.h"
+#include "dart/simulation/World.h"
+#include "dart/utils/BinarySkel.h"
+#include "dart/utils/SkelParser.h"
+
+using namespace dart;
+using namespace dynamics;
+using namespace simulation;
+using namespace utils;
+
+//==============================================================================
+/// Absolute path of a scratch file. The readers take URIs, which cannot be
+/// relative paths.
+std::string getScratchFileName(const std::string& _name)
+{
+  return DART_DATA_PATH "test/" + _name + BinarySkel::Extension;
+}
+
+//==============================================================================
+void expectSameShape(const ConstShapePtr& _expected,
+                     const ConstShapePtr& _actual)
+{
+  ASSERT_EQ(_expected == nullptr, _actual == nullptr);
+  if(!_expected)
+    return;
+
+  ASSERT_EQ(_expected->getShapeType(), _actual->getShapeType());
+  EXPECT_TRUE(_expected->getBoundingBox().getMin()
+              == _actual->getBoundingBox().getMin());
+  EXPECT_TRUE(_expected->getBoundingBox().getMax()
+              == _actual->getBoundingBox().getMax());
+  EXPECT_EQ(_expected->getVolume(), _actual->getVolume());
+  EXPECT_EQ(_expected->getDataVariance(), _actual->getDataVariance());
+}
+
+//==============================================================================
+void expectSameShapeFrame(const ShapeFrame* _expected,
+                          const ShapeFrame* _actual)
+{
+  EXPECT_EQ(_expected->getName(), _actual->getName());
+  EXPECT_TRUE(_expected->getRelativeTransform().matrix()
+              == _actual->getRelativeTransform().matrix());
+  expectSameShape(_expected->getShape(), _actual->getShape());
+
+  ASSERT_EQ(_expected->hasVisualAddon(), _actual->hasVisualAddon());
+  if(_expected->hasVisualAddon())
+  {
+    EXPECT_TRUE(_expected->getVisualAddon()->getRGBA()
+              == _actual->getVisualAddon()->getRGBA());
+    EXPECT_EQ(_expected->getVisualAddon()->isHidden(),
+              _actual->getVisualAddon()->isHidden());
+  }
+
+  ASSERT_EQ(_expected->hasCollisionAddon(), _actual->hasCollisionAddon());
+  if(_expected->hasCollisionAddon())
+  {
+    EXPECT_EQ(_expected->getCollisionAddon()->isCollidable(),
+              _actual->getCollisionAddon()->isCollidable());
+  }
+
+  ASSERT_EQ(_expected->hasDynamicsAddon(), _actual->hasDynamicsAddon());
+  if(_expected->hasDynamicsAddon())
+  {
+    EXPECT_EQ(_expected->getDynamicsAddon()->getFrictionCoeff(),
+              _actual->getDynamicsAddon()->getFrictionCoeff());
+    EXPECT_EQ(_expected->getDynamicsAddon()->getRestitutionCoeff(),
+              _actual->getDynamicsAddon()->getRestitutionCoeff());
+  }
+}
+
+//==============================================================================
+void expectSameSkeleton(const SkeletonPtr& _expected,
+                        const SkeletonPtr& _actual)
+{
+  ASSERT_TRUE(_actual != nullptr);
+  EXPECT_EQ(_expected->getName(), _actual->getName());
+  EXPECT_EQ(_expected->isMobile(), _actual->isMobile());
+  EXPECT_TRUE(_expected->getGravity()
+              == _actual->getGravity());
+  EXPECT_EQ(_expected->getTimeStep(), _actual->getTimeStep());
+  EXPECT_EQ(_expected->isImplicitSpringIntegration(),
+            _actual->isImplicitSpringIntegration());
+
+  ASSERT_EQ(_expected->getNumBodyNodes(), _actual->getNumBodyNodes());
+  ASSERT_EQ(_expected->getNumDofs(), _actual->getNumDofs());
+  ASSERT_EQ(_expected->getNumSoftBodyNodes(), _actual->getNumSoftBodyNodes());
+
+  EXPECT_TRUE(_expected->getPositions()
+              == _actual->getPositions());
+  EXPECT_TRUE(_expected->getVelocities()
+              == _actual->getVelocities());
+  EXPECT_TRUE(_expected->getAccelerations()
+              == _actual->getAccelerations());
+  EXPECT_TRUE(_expected->getForces()
+              == _actual->getForces());
+  EXPECT_TRUE(_expected->getCommands()
+              == _actual->getCommands());
+
+  for(size_t i = 0; i < _expected->getNumDofs(); ++i)
+  {
+    const DegreeOfFreedom* dof1 = _expected->getDof(i);
+    const DegreeOfFreedom* dof2 = _actual->getDof(i);
+    EXPECT_EQ(dof1->getName(), dof2->getName());
+    EXPECT_EQ(dof1->getPositionLowerLimit(), dof2->getPositionLowerLimit());
+    EXPECT_EQ(dof1->getPositionUpperLimit(), dof2->getPositionUpperLimit());
+    EXPECT_EQ(dof1->getVelocityUpperLimit(), dof2->getVelocityUpperLimit());
+    EXPECT_EQ(dof1->getSpringStiffness(), dof2->getSpringStiffness());
+    EXPECT_EQ(dof1->getRestPosition(), dof2->getRestPosition());
+    EXPECT_EQ(dof1->getDampingCoefficient(), dof2->getDampingCoefficient());
+    EXPECT_EQ(dof1->getCoulombFriction(), dof2->getCoulombFriction());
+  }
+
+  for(size_t i = 0; i < _expected->getNumBodyNodes(); ++i)
+  {
+    const BodyNode* bn1 = _expected->getBodyNode(i);
+    const BodyNode* bn2 = _actual->getBodyNode(i);
+    EXPECT_EQ(bn1->getName(), bn2->getName());
+    EXPECT_EQ(bn1->getParentBodyNode() == nullptr,
+              bn2->getParentBodyNode() == nullptr);
+    if(bn1->getParentBodyNode())
+    {
+      EXPECT_EQ(bn1->getParentBodyNode()->getIndexInSkeleton(),
+                bn2->getParentBodyNode()->getIndexInSkeleton());
+    }
+
+    const Joint* joint1 = bn1->getParentJoint();
+    const Joint* joint2 = bn2->getParentJoint();
+    EXPECT_EQ(joint1->getType(), joint2->getType());
+    EXPECT_EQ(joint1->getName(), joint2->getName());
+    EXPECT_EQ(joint1->getActuatorType(), joint2->getActuatorType());
+    EXPECT_TRUE(joint1->getTransformFromParentBodyNode().matrix()
+              == joint2->getTransformFromParentBodyNode().matrix());
+    EXPECT_TRUE(joint1->getTransformFromChildBodyNode().matrix()
+              == joint2->getTransformFromChildBodyNode().matrix());
+    EXPECT_TRUE(joint1->getLocalJacobian()
+              == joint2->getLocalJacobian());
+
+    EXPECT_EQ(bn1->getMass(), bn2->getMass());
+    EXPECT_TRUE(bn1->getLocalCOM()
+              == bn2->getLocalCOM());
+    EXPECT_TRUE(bn1->getSpatialInertia()
+              == bn2->getSpatialInertia());
+    EXPECT_EQ(bn1->isCollidable(), bn2->isCollidable());
+    EXPECT_EQ(bn1->getFrictionCoeff(), bn2->getFrictionCoeff());
+    EXPECT_EQ(bn1->getRestitutionCoeff(), bn2->getRestitutionCoeff());
+    EXPECT_EQ(bn1->getGravityMode(), bn2->getGravityMode());
+    EXPECT_EQ(bn1->isContinuousCollision(), bn2->isContinuousCollision());
+    EXPECT_TRUE(bn1->getWorldTransform().matrix()
+              == bn2->getWorldTransform().matrix());
+
+    ASSERT_EQ(bn1->getNumMarkers(), bn2->getNumMarkers());
+    for(size_t j = 0; j < bn1->getNumMarkers(); ++j)
+    {
+      EXPECT_EQ(bn1->getMarker(j)->getName(), bn2->getMarker(j)->getName());
+      EXPECT_TRUE(bn1->getMarker(j)->getLocalPosition()
+              == bn2->getMarker(j)->getLocalPosition());
+    }
+
+    ASSERT_EQ(bn1->getNumShapeNodes(), bn2->getNumShapeNodes());
+    for(size_t j = 0; j < bn1->getNumShapeNodes(); ++j)
+    {
+      const ShapeNode* shapeNode1 = bn1->getShapeNode(j);
+      const ShapeNode* shapeNode2 = bn2->getShapeNode(j);
+      if(shapeNode1->getShape()->getShapeType() == Shape::SOFT_MESH)
+        EXPECT_EQ(Shape::SOFT_MESH, shapeNode2->getShape()->getShapeType());
+      else
+        expectSameShapeFrame(shapeNode1, shapeNode2);
+    }
+  }
+
+  for(size_t i = 0; i < _expected->getNumSoftBodyNodes(); ++i)
+  {
+    const SoftBodyNode* sbn1 = _expected->getSoftBodyNode(i);
+    const SoftBodyNode* sbn2 = _actual->getSoftBodyNode(i);
+    EXPECT_EQ(sbn1->getVertexSpringStiffness(),
+              sbn2->getVertexSpringStiffness());
+    EXPECT_EQ(sbn1->getEdgeSpringStiffness(), sbn2->getEdgeSpringStiffness());
+    EXPECT_EQ(sbn1->getDampingCoefficient(), sbn2->getDampingCoefficient());
+    ASSERT_EQ(sbn1->getNumFaces(), sbn2->getNumFaces());
+    ASSERT_EQ(sbn1->getNumPointMasses(), sbn2->getNumPointMasses());
+    for(size_t j = 0; j < sbn1->getNumPointMasses(); ++j)
+    {
+      const PointMass* pm1 = sbn1->getPointMass(j);
+      const PointMass* pm2 = sbn2->getPointMass(j);
+      EXPECT_EQ(pm1->getMass(), pm2->getMass());
+      EXPECT_TRUE(pm1->getRestingPosition()
+              == pm2->getRestingPosition());
+      EXPECT_EQ(pm1->getNumConnectedPointMasses(),
+                pm2->getNumConnectedPointMasses());
+      EXPECT_TRUE(pm1->getPositions()
+              == pm2->getPositions());
+      EXPECT_TRUE(pm1->getVelocities()
+              == pm2->getVelocities());
+      EXPECT_TRUE(pm1->getForces()
+              == pm2->getForces());
+    }
+  }
+}
+
+//==============================================================================
+void expectSameWorld(const WorldPtr& _expected, const WorldPtr& _actual)
+{
+  ASSERT_TRUE(_actual != nullptr);
+  EXPECT_EQ(_expected->getName(), _actual->getName());
+  EXPECT_TRUE(_expected->getGravity()
+              == _actual->getGravity());
+  EXPECT_EQ(_expected->getTimeStep(), _actual->getTimeStep());
+  EXPECT_EQ(_expected->getTime(), _actual->getTime());
+
+  ASSERT_EQ(_expected->getNumSkeletons(), _actual->getNumSkeletons());
+  for(size_t i = 0; i < _expected->getNumSkeletons(); ++i)
+    expectSameSkeleton(_expected->getSkeleton(i), _actual->getSkeleton(i));
+
+  ASSERT_EQ(_expected->getNumSimpleFrames(), _actual->getNumSimpleFrames());
+  for(size_t i = 0; i < _expected->getNumSimpleFrames(); ++i)
+  {
+    const SimpleFramePtr frame1 = _expected->getSimpleFrame(i);
+    const SimpleFramePtr frame2 = _actual->getSimpleFrame(i);
+    expectSameShapeFrame(frame1.get(), frame2.get());
+    EXPECT_EQ(frame1->getParentFrame()->getName(),
+              frame2->getParentFrame()->getName());
+    EXPECT_TRUE(frame1->getWorldTransform().matrix()
+              == frame2->getWorldTransform().matrix());
+    EXPECT_TRUE(frame1->getSpatialVelocity()
+              == frame2->getSpatialVelocity());
+  }
+}
+
+//==============================================================================
+void randomizeState(const SkeletonPtr& _skel)
+{
+  const size_t numDofs = _skel->getNumDofs();
+  _skel->setPositions(Eigen::VectorXd::Random(numDofs));
+  _skel->setVelocities(Eigen::VectorXd::Random(numDofs));
+  _skel->setAccelerations(Eigen::VectorXd::Random(numDofs));
+  _skel->setForces(Eigen::VectorXd::Random(numDofs));
+  _skel->setCommands(Eigen::VectorXd::Random(numDofs));
+
+  for(size_t i = 0; i < _skel->getNumSoftBodyNodes(); ++i)
+  {
+    SoftBodyNode* softBodyNode = _skel->getSoftBodyNode(i);
+    for(size_t j = 0; j < softBodyNode->getNumPointMasses(); ++j)
+    {
+      softBodyNode->getPointMass(j)->setPositions(Eigen::Vector3d::Random());
+      softBodyNode->getPointMass(j)->setVelocities(Eigen::Vector3d::Random());
+    }
+  }
+}
+
+//==============================================================================
+template <class JointType>
+BodyNode* addBody(const SkeletonPtr& _skel, BodyNode* _parent,
+                  const std::string& _name)
+{
+  typename JointType::Properties joint;
+  joint.mName = _name + "_joint";
+  joint.mT_ParentBodyToJoint.translation() = Eigen::Vector3d::Random();
+  joint.mIsPositionLimited = true;
+
+  BodyNode::Properties body;
+  body.mName = _name;
+  body.mInertia.setMass(0.5 + std::abs(Eigen::Vector3d::Random()[0]));
+  body.mInertia.setLocalCOM(Eigen::Vector3d::Random());
+  body.mFrictionCoeff = 0.3;
+
+  BodyNode* bn = _skel->createJointAndBodyNodePair<JointType>(
+        _parent, joint, body).second;
+
+  ShapeNode* shapeNode = bn->createShapeNodeWith<
+      VisualAddon, CollisionAddon, DynamicsAddon>(
+        std::make_shared<BoxShape>(Eigen::Vector3d::Random().cwiseAbs()));
+  shapeNode->setRelativeTranslation(Eigen::Vector3d::Random());
+  shapeNode->getVisualAddon()->setRGBA(Eigen::Vector4d::Random());
+  shapeNode->getDynamicsAddon()->setFrictionCoeff(0.7);
+
+  bn->createShapeNodeWith<VisualAddon>(
+        std::make_shared<EllipsoidShape>(Eigen::Vector3d::Ones()));
+
+  return bn;
+}
+
+//==============================================================================
+TEST(BinarySkel, AllJointTypes)
+{
+  const SkeletonPtr skel = Skeleton::create("all_joints");
+  BodyNode* bn = addBody<FreeJoint>(skel, nullptr, "free");
+  bn = addBody<RevoluteJoint>(skel, bn, "revolute");
+  bn = addBody<PrismaticJoint>(skel, bn, "prismatic");
+  bn = addBody<ScrewJoint>(skel, bn, "screw");
+  bn = addBody<UniversalJoint>(skel, bn, "universal");
+  bn = addBody<BallJoint>(skel, bn, "ball");
+  bn = addBody<EulerJoint>(skel, bn, "euler");
+  bn = addBody<TranslationalJoint>(skel, bn, "translational");
+  addBody<WeldJoint>(skel, bn, "weld");
+  addBody<PlanarJoint>(skel, skel->getBodyNode(0), "planar");
+
+  SoftBodyNode::Properties soft(
+        BodyNode::Properties(Entity::Properties("soft")),
+        SoftBodyNodeHelper::makeBoxProperties(
+          Eigen::Vector3d::Ones(), Eigen::Isometry3d::Identity(), 2.0));
+  skel->createJointAndBodyNodePair<BallJoint, SoftBodyNode>(
+        skel->getBodyNode(0), BallJoint::Properties(), soft);
+
+  static_cast<ScrewJoint*>(skel->getJoint(3))->setPitch(0.25);
+  static_cast<EulerJoint*>(skel->getJoint(6))->setAxisOrder(
+        EulerJoint::AxisOrder::XYZ);
+  static_cast<PlanarJoint*>(skel->getJoint(9))->setArbitraryPlane(
+        Eigen::Vector3d::UnitX(), Eigen::Vector3d::UnitZ());
+  skel->getJoint(1)->setActuatorType(Joint::VELOCITY);
+  skel->getDof(6)->setSpringStiffness(12.0);
+  skel->getDof(6)->setDampingCoefficient(0.5);
+  skel->getDof(7)->setPositionLowerLimit(-1.5);
+  skel->setImplicitSpringIntegration(true);
+  skel->getBodyNode(0)->setContinuousCollision(true);
+  skel->getBodyNode(1)->addMarker(new Marker("marker", Eigen::Vector3d::Ones(),
+                                             Eigen::Vector4d::Random(),
+                                             skel->getBodyNode(1)));
+  randomizeState(skel);
+
+  const std::string fileName = getScratchFileName("all_joints");
+  ASSERT_TRUE(BinarySkel::writeSkeleton(skel, fileName));
+  const SkeletonPtr copy = BinarySkel::readSkeleton(fileName);
+  expectSameSkeleton(skel, copy);
+  std::remove(fileName.c_str());
+}
+
+//==============================================================================
+TEST(BinarySkel, SimpleFrames)
+{
+  const WorldPtr world(new World("frames"));
+  world->setTime(1.25);
+
+  const SkeletonPtr skel = Skeleton::create("skel");
+  BodyNode* bn = addBody<FreeJoint>(skel, nullptr, "body");
+  world->addSkeleton(skel);
+
+  const SimpleFramePtr frame1 = std::make_shared<SimpleFrame>(
+        bn, "attached", Eigen::Isometry3d::Identity());
+  Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+  tf.translation() = Eigen::Vector3d::Random();
+  frame1->setRelativeTransform(tf);
+  frame1->setShape(std::make_shared<BoxShape>(Eigen::Vector3d::Ones()));
+  frame1->createVisualAddon();
+
+  // The child is added before its parent
+  const SimpleFramePtr frame2 = std::make_shared<SimpleFrame>(
+        frame1.get(), "child");
+  frame2->setRelativeSpatialVelocity(Eigen::Vector6d::Random());
+  const auto lines = std::make_shared<LineSegmentShape>(2.0f);
+  lines->addVertex(Eigen::Vector3d::Zero());
+  lines->addVertex(Eigen::Vector3d::UnitX(), 0);
+  frame2->setShape(lines);
+
+  world->addSimpleFrame(frame2);
+  world->addSimpleFrame(frame1);
+  world->addSimpleFrame(std::make_shared<SimpleFrame>(Frame::World(), "free"));
+
+  const std::string fileName = getScratchFileName("frames");
+  ASSERT_TRUE(BinarySkel::writeWorld(world, fileName));
+  const WorldPtr copy = BinarySkel::readWorld(fileName);
+  expectSameWorld(world, copy);
+
+  EXPECT_EQ(copy->getSkeleton(0)->getBodyNode(0),
+            copy->getSimpleFrame(1)->getParentFrame());
+  EXPECT_EQ(copy->getSimpleFrame(1).get(),
+            copy->getSimpleFrame(0)->getParentFrame());
+
+  // The content type is checked
+  EXPECT_TRUE(BinarySkel::readSkeleton(fileName) == nullptr);
+  std::remove(fileName.c_str());
+}
+
+//==============================================================================
+TEST(BinarySkel, CorruptedFiles)
+{
+  const SkeletonPtr skel = Skeleton::create("skel");
+  addBody<RevoluteJoint>(skel, addBody<FreeJoint>(skel, nullptr, "a"), "b");
+
+  const std::string fileName = getScratchFileName("corrupted");
+  ASSERT_TRUE(BinarySkel::writeSkeleton(skel, fileName));
+
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  const std::string content((std::istreambuf_iterator<char>(file)),
+                            std::istreambuf_iterator<char>());
+  file.close();
+
+  // Every truncation of the file must be refused without crashing
+  for(size_t size = 0; size < content.size(); size += 7)
+  {
+    std::ofstream(fileName.c_str(), std::ios::binary).write(
+          content.data(), static_cast<std::streamsize>(size));
+    EXPECT_TRUE(BinarySkel::readSkeleton(fileName) == nullptr);
+  }
+
+  EXPECT_TRUE(BinarySkel::readSkeleton(
+                getScratchFileName("does_not_exist")) == nullptr);
+  std::remove(fileName.c_str());
+}
+
+//==============================================================================
+TEST(BinarySkel, SkelFiles)
+{
+  const std::vector<std::string> fileNames = {
+    DART_DATA_PATH"skel/shapes.skel",
+    DART_DATA_PATH"skel/fullbody1.skel",
+    DART_DATA_PATH"skel/softBodies.skel",
+    DART_DATA_PATH"skel/test/planar_joint.skel",
+    DART_DATA_PATH"skel/test/joint_actuator_type_test.skel"
+  };
+
+  for(const std::string& skelFileName : fileNames)
+  {
+    const WorldPtr world = SkelParser::readWorld(skelFileName);
+    ASSERT_TRUE(world != nullptr);
+    for(size_t i = 0; i < world->getNumSkeletons(); ++i)
+      randomizeState(world->getSkeleton(i));
+
+    const std::string fileName = getScratchFileName("world");
+    ASSERT_TRUE(BinarySkel::writeWorld(world, fileName));
+    expectSameWorld(world, BinarySkel::readWorld(fileName));
+
+    std::remove(fileName.c_str());
+  }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include "dart/common/LocalResourceRetriever.h"
+#include "dart/utils/CachingResourceRetriever.h"
+#include "TestHelpers.h"
+
+using dart::common::Uri;
+using dart::common::Resource;
+using dart::common::ResourcePtr;
+using dart::common::LocalResourceRetriever;
+using dart::utils::CachingResourceRetriever;
+
+TEST(CachingResourceRetriever, retrieve_CachesContent)
+{
+  const std::string content = "Hello World";
+
+  auto localRetriever = std::make_shared<LocalResourceRetriever>(false);
+  CachingResourceRetriever retriever(localRetriever);
+
+  for(size_t i = 0; i < 3; ++i)
+  {
+    const ResourcePtr resource
+        = retriever.retrieve(DART_DATA_PATH "test/hello_world.txt");
+    ASSERT_TRUE(resource != nullptr);
+    ASSERT_EQ(content.size(), resource->getSize());
+
+    std::vector<char> buffer(content.size() + 1, '\0');
+    ASSERT_EQ(1u, resource->read(buffer.data(), content.size(), 1));
+    EXPECT_STREQ(content.c_str(), buffer.data());
+    EXPECT_EQ(content.size(), resource->tell());
+
+    // Cached resources expose their content directly
+    const char* data = static_cast<const char*>(resource->getData());
+    ASSERT_TRUE(data != nullptr);
+    EXPECT_EQ(content, std::string(data, resource->getSize()));
+  }
+
+  EXPECT_EQ(1u, retriever.getNumMisses());
+  EXPECT_EQ(2u, retriever.getNumHits());
+  EXPECT_EQ(1u, retriever.getNumResources());
+  EXPECT_EQ(content.size(), retriever.getCacheSize());
+
+  // A resource that is known to be cached is known to exist
+  EXPECT_TRUE(retriever.exists(DART_DATA_PATH "test/hello_world.txt"));
+  EXPECT_EQ(3u, retriever.getNumHits());
+
+  retriever.invalidate(DART_DATA_PATH "test/hello_world.txt");
+  EXPECT_EQ(0u, retriever.getNumResources());
+  EXPECT_EQ(0u, retriever.getCacheSize());
+  EXPECT_TRUE(retriever.retrieve(DART_DATA_PATH "test/hello_world.txt") != nullptr);
+  EXPECT_EQ(2u, retriever.getNumMisses());
+
+  retriever.clear();
+  EXPECT_EQ(0u, retriever.getNumResources());
+  EXPECT_EQ(0u, retriever.getNumHits());
+  EXPECT_EQ(0u, retriever.getNumMisses());
+}
+
+TEST(CachingResourceRetriever, retrieve_CachesFailures)
+{
+  auto mockRetriever = std::make_shared<AbsentResourceRetriever>();
+  CachingResourceRetriever retriever(mockRetriever);
+
+  EXPECT_EQ(nullptr, retriever.retrieve(Uri::createFromString("package://test/foo")));
+  EXPECT_EQ(nullptr, retriever.retrieve(Uri::createFromString("package://test/foo")));
+  EXPECT_FALSE(retriever.exists(Uri::createFromString("package://test/foo")));
+  EXPECT_EQ(1u, mockRetriever->mRetrieve.size());
+  EXPECT_TRUE(mockRetriever->mExists.empty());
+  EXPECT_EQ(1u, retriever.getNumMisses());
+  EXPECT_EQ(2u, retriever.getNumHits());
+
+  // Invalidating a URI forwards the next lookup again
+  retriever.invalidate(Uri::createFromString("package://test/foo"));
+  EXPECT_FALSE(retriever.exists(Uri::createFromString("package://test/foo")));
+  EXPECT_FALSE(retriever.exists(Uri::createFromString("package://test/foo")));
+  EXPECT_EQ(1u, mockRetriever->mExists.size());
+}
+
+TEST(CachingResourceRetriever, exists_CachesResult)
+{
+  auto mockRetriever = std::make_shared<PresentResourceRetriever>();
+  CachingResourceRetriever retriever(mockRetriever);
+
+  EXPECT_TRUE(retriever.exists(Uri::createFromString("package://test/foo")));
+  EXPECT_TRUE(retriever.exists(Uri::createFromString("package://test/foo")));
+  EXPECT_TRUE(retriever.exists(Uri::createFromString("package://test/bar")));
+  EXPECT_EQ(2u, mockRetriever->mExists.size());
+  EXPECT_TRUE(mockRetriever->mRetrieve.empty());
+}
+
+TEST(CachingResourceRetriever, retrieve_EvictsLeastRecentlyUsed)
+{
+  const std::string uri1 = DART_DATA_PATH "skel/cube.skel";
+  const std::string uri2 = DART_DATA_PATH "obj/BoxSmall.obj";
+  const std::string uri3 = DART_DATA_PATH "test/hello_world.txt";
+
+  LocalResourceRetriever localRetriever;
+  const size_t size1 = localRetriever.retrieve(uri1)->getSize();
+  const size_t size2 = localRetriever.retrieve(uri2)->getSize();
+
+  // Room for the first two resources only
+  CachingResourceRetriever retriever(
+        std::make_shared<LocalResourceRetriever>(), size1 + size2);
+
+  EXPECT_TRUE(retriever.retrieve(uri1) != nullptr);
+  EXPECT_TRUE(retriever.retrieve(uri2) != nullptr);
+  EXPECT_EQ(2u, retriever.getNumResources());
+  EXPECT_EQ(size1 + size2, retriever.getCacheSize());
+
+  // Using uri1 again makes uri2 the least recently used one
+  EXPECT_TRUE(retriever.retrieve(uri1) != nullptr);
+  EXPECT_TRUE(retriever.retrieve(uri3) != nullptr);
+  EXPECT_EQ(2u, retriever.getNumResources());
+
+  const size_t numMisses = retriever.getNumMisses();
+  EXPECT_TRUE(retriever.retrieve(uri1) != nullptr);
+  EXPECT_TRUE(retriever.retrieve(uri3) != nullptr);
+  EXPECT_EQ(numMisses, retriever.getNumMisses());
+  EXPECT_TRUE(retriever.retrieve(uri2) != nullptr);
+  EXPECT_EQ(numMisses + 1u, retriever.getNumMisses());
+
+  // Resources larger than the capacity are passed through without caching
+  retriever.setCapacity(size2);
+  EXPECT_LE(retriever.getCacheSize(), size2);
+  retriever.clear();
+  EXPECT_TRUE(retriever.retrieve(uri1) != nullptr);
+  EXPECT_EQ(0u, retriever.getNumResources());
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -45,6 +45,8 @@
 #include "dart/common/common.h"
 #include "dart/math/math.h"
 #include "dart/dynamics/dynamics.h"
+#include "dart/collision/dart/DARTCollisionDetector.h"
+#include "dart/collision/fcl/FCLCollisionDetector.h"
 //#include "dart/collision/unc/UNCCollisionDetector.h"
 #include "dart/simulation/simulation.h"
 #include "dart/utils/utils.h"
@@ -586,6 +588,132 @@ TEST_F(COLLISION, CollisionOfPrescribedJoints)
   }
 }
 
+//==============================================================================
+SkeletonPtr createFreeBox(const std::string& _name,
+                          const Eigen::Vector3d& _position)
+{
+  SkeletonPtr skel = Skeleton::create(_name);
+  BodyNode* bn = skel->createJointAndBodyNodePair<FreeJoint>().second;
+  std::shared_ptr<Shape> box(new BoxShape(Eigen::Vector3d(1.0, 1.0, 1.0)));
+  bn->createShapeNodeWith<VisualAddon, CollisionAddon, DynamicsAddon>(box);
+
+  Eigen::Vector6d positions = Eigen::Vector6d::Zero();
+  positions.tail<3>() = _position;
+  skel->setPositions(positions);
+
+  return skel;
+}
+
+//==============================================================================
+TEST_F(COLLISION, ContactRecords)
+{
+  SkeletonPtr skel1 = createFreeBox("box 1", Eigen::Vector3d::Zero());
+  SkeletonPtr skel2 = createFreeBox("box 2", Eigen::Vector3d(0.0, 0.0, 0.9));
+
+  collision::DARTCollisionDetector detector;
+  detector.addSkeleton(skel1);
+  detector.addSkeleton(skel2);
+
+  EXPECT_TRUE(detector.detectCollision(true, true));
+  ASSERT_GT(detector.getNumContacts(), 0u);
+
+  for (size_t i = 0; i < detector.getNumContacts(); ++i)
+  {
+    collision::ContactRecord& record = detector.getContactRecord(i);
+    EXPECT_TRUE(record.bodyNode1 == skel1->getBodyNode(0)
+                || record.bodyNode1 == skel2->getBodyNode(0));
+    EXPECT_TRUE(record.bodyNode2 == skel1->getBodyNode(0)
+                || record.bodyNode2 == skel2->getBodyNode(0));
+    EXPECT_NE(record.bodyNode1, record.bodyNode2);
+
+    // The view carries the same data, including forces that were written to
+    // the record after the view had been created
+    const collision::Contact& contact = detector.getContact(i);
+    EXPECT_EQ(contact.bodyNode1.lock().get(), record.bodyNode1);
+    EXPECT_EQ(contact.bodyNode2.lock().get(), record.bodyNode2);
+    EXPECT_TRUE(contact.point.isApprox(record.point));
+    EXPECT_TRUE(contact.normal.isApprox(record.normal));
+
+    record.force = Eigen::Vector3d(1.0, 2.0, 3.0);
+    EXPECT_TRUE(detector.getContact(i).force.isApprox(record.force));
+  }
+
+  // Removing a Skeleton must not leave records that point to its BodyNodes
+  detector.removeSkeleton(skel2);
+  EXPECT_EQ(detector.getNumContacts(), 0u);
+  EXPECT_FALSE(detector.detectCollision(true, true));
+}
+
+//==============================================================================
+/// Return the earliest predicted contact of _detector, or nullptr if there is
+/// none
+const collision::ContactRecord* findPredictedContact(
+    collision::CollisionDetector& _detector)
+{
+  const collision::ContactRecord* first = nullptr;
+  for (size_t i = 0; i < _detector.getNumContacts(); ++i)
+  {
+    const collision::ContactRecord& record = _detector.getContactRecord(i);
+    if (record.timeOfImpact > 0.0
+        && (!first || record.timeOfImpact < first->timeOfImpact))
+    {
+      first = &record;
+    }
+  }
+
+  return first;
+}
+
+//==============================================================================
+TEST_F(COLLISION, ContinuousCollision)
+{
+  // The upper box moves through the lower one within a single step
+  const double timeStep = 0.01;
+  SkeletonPtr skel1 = createFreeBox("box 1", Eigen::Vector3d::Zero());
+  SkeletonPtr skel2 = createFreeBox("box 2", Eigen::Vector3d(0.0, 0.0, 1.5));
+  skel2->setVelocity(5, -200.0);
+  skel2->getBodyNode(0)->setContinuousCollision(true);
+
+  collision::FCLCollisionDetector fclDetector;
+  collision::DARTCollisionDetector dartDetector;
+  collision::CollisionDetector* detectors[2] = {&fclDetector, &dartDetector};
+  for (collision::CollisionDetector* detector : detectors)
+  {
+    detector->addSkeleton(skel1);
+    detector->addSkeleton(skel2);
+
+    EXPECT_FALSE(detector->detectCollision(true, true));
+    EXPECT_TRUE(detector->detectContinuousCollision(timeStep));
+  }
+
+  // The boxes touch after closing the gap of 0.5 at a speed of 200
+  const collision::ContactRecord* fclContact
+      = findPredictedContact(fclDetector);
+  ASSERT_TRUE(fclContact != nullptr);
+  EXPECT_NEAR(fclContact->timeOfImpact, 0.5 / 200.0, 1e-4);
+  EXPECT_NEAR(fclContact->gap, 0.5, 0.02);
+  EXPECT_EQ(fclContact->penetrationDepth, 0.0);
+  EXPECT_NEAR(std::abs(fclContact->normal[2]), 1.0, 1e-6);
+  EXPECT_TRUE(
+      (fclContact->bodyNode1 == skel1->getBodyNode(0)
+       && fclContact->bodyNode2 == skel2->getBodyNode(0))
+      || (fclContact->bodyNode1 == skel2->getBodyNode(0)
+          && fclContact->bodyNode2 == skel1->getBodyNode(0)));
+
+  // FCL predicts the same impact as the DART collision detector
+  const collision::ContactRecord* dartContact
+      = findPredictedContact(dartDetector);
+  ASSERT_TRUE(dartContact != nullptr);
+  EXPECT_NEAR(fclContact->timeOfImpact, dartContact->timeOfImpact, 1e-4);
+  EXPECT_NEAR(fclContact->gap, dartContact->gap, 0.02);
+  EXPECT_EQ(dartContact->penetrationDepth, 0.0);
+
+  // The bodies are not moved by the prediction
+  EXPECT_TRUE(skel2->getBodyNode(0)->getWorldTransform().translation()
+              .isApprox(Eigen::Vector3d(0.0, 0.0, 1.5)));
+  EXPECT_FALSE(fclDetector.detectCollision(true, true));
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
@@ -36,6 +36,7 @@
  */
 
 #include <iostream>
+#include <limits>
 
 #include <Eigen/Dense>
 #include <gtest/gtest.h>
@@ -46,8 +47,15 @@
 #include "dart/math/Geometry.h"
 #include "dart/math/Helpers.h"
 #include "dart/collision/dart/DARTCollisionDetector.h"
+#include "dart/constraint/APGDLCPSolver.h"
+#include "dart/constraint/ContactConstraint.h"
+#include "dart/constraint/IslandBuilder.h"
+#include "dart/constraint/PGSLCPSolver.h"
 #include "dart/dynamics/BodyNode.h"
+#include "dart/dynamics/BoxShape.h"
+#include "dart/dynamics/FreeJoint.h"
 #include "dart/dynamics/Skeleton.h"
+#include "dart/lcpsolver/lcp.h"
 #include "dart/simulation/World.h"
 #include "dart/utils/SkelParser.h"
 
@@ -239,6 +247,534 @@ TEST_F(ConstraintTest, SingleContactTest)
   SingleContactTest(getList()[0]);
 }
 
+//==============================================================================
+/// LCP with the structure of _numContacts frictional contacts: one normal row
+/// followed by two friction rows that refer to it through findex
+struct ContactLCP
+{
+  int n;
+  int nSkip;
+  std::vector<double> A;
+  std::vector<double> b;
+  std::vector<double> lo;
+  std::vector<double> hi;
+  std::vector<int> findex;
+};
+
+//==============================================================================
+ContactLCP createContactLCP(int _numContacts, double _mu)
+{
+  ContactLCP lcp;
+  lcp.n = 3 * _numContacts;
+  lcp.nSkip = dPAD(lcp.n);
+
+  const Eigen::MatrixXd M = Eigen::MatrixXd::Random(lcp.n, lcp.n);
+  const Eigen::MatrixXd A
+      = M * M.transpose() + 0.1 * Eigen::MatrixXd::Identity(lcp.n, lcp.n);
+
+  lcp.A.assign(lcp.n * lcp.nSkip, 0.0);
+  for (int i = 0; i < lcp.n; ++i)
+    for (int j = 0; j < lcp.n; ++j)
+      lcp.A[i * lcp.nSkip + j] = A(i, j);
+
+  lcp.b.resize(lcp.n);
+  lcp.lo.resize(lcp.n);
+  lcp.hi.resize(lcp.n);
+  lcp.findex.resize(lcp.n);
+  for (int i = 0; i < _numContacts; ++i)
+  {
+    lcp.b[3*i] = math::random(-0.5, 1.5);
+    lcp.lo[3*i] = 0.0;
+    lcp.hi[3*i] = std::numeric_limits<double>::infinity();
+    lcp.findex[3*i] = -1;
+
+    for (int j = 1; j < 3; ++j)
+    {
+      lcp.b[3*i + j] = math::random(-1.0, 1.0);
+      lcp.lo[3*i + j] = -_mu;
+      lcp.hi[3*i + j] = _mu;
+      lcp.findex[3*i + j] = 3*i;
+    }
+  }
+
+  return lcp;
+}
+
+//==============================================================================
+/// Largest violation of the LCP conditions by _x
+double computeLCPError(const ContactLCP& _lcp, const std::vector<double>& _x)
+{
+  const double tol = 1e-9;
+  double error = 0.0;
+  for (int i = 0; i < _lcp.n; ++i)
+  {
+    double lo = _lcp.lo[i];
+    double hi = _lcp.hi[i];
+    if (_lcp.findex[i] >= 0)
+    {
+      hi = _lcp.hi[i] * _x[_lcp.findex[i]];
+      lo = -hi;
+    }
+
+    double r = _lcp.b[i];
+    for (int j = 0; j < _lcp.n; ++j)
+      r -= _lcp.A[i * _lcp.nSkip + j] * _x[j];
+
+    error = std::max(error, lo - _x[i]);
+    error = std::max(error, _x[i] - hi);
+
+    if (hi - lo <= tol)
+      continue;
+    else if (_x[i] <= lo + tol)
+      error = std::max(error, r);
+    else if (_x[i] >= hi - tol)
+      error = std::max(error, -r);
+    else
+      error = std::max(error, std::abs(r));
+  }
+
+  return error;
+}
+
+//==============================================================================
+/// Solve _lcp with solvePGS() starting from zero and return the solution
+std::vector<double> runPGS(const ContactLCP& _lcp,
+                           const constraint::PGSOption& _option,
+                           constraint::PGSStatistics* _statistics)
+{
+  // solvePGS() scales the rows of A and b in place
+  ContactLCP work = _lcp;
+  constraint::PGSOption option = _option;
+  std::vector<double> x(_lcp.n, 0.0);
+  constraint::solvePGS(_lcp.n, _lcp.nSkip, 0, work.A.data(), x.data(),
+                       work.b.data(), work.lo.data(), work.hi.data(),
+                       work.findex.data(), &option, _statistics);
+
+  return x;
+}
+
+//==============================================================================
+/// Solve _lcp with solveAPGD() starting from zero and return the solution
+std::vector<double> runAPGD(const ContactLCP& _lcp,
+                            const constraint::APGDOption& _option,
+                            constraint::APGDStatistics* _statistics)
+{
+  std::vector<double> x(_lcp.n, 0.0);
+  constraint::solveAPGD(_lcp.n, _lcp.nSkip, _lcp.A.data(), x.data(),
+                        _lcp.b.data(), _lcp.lo.data(), _lcp.hi.data(),
+                        _lcp.findex.data(), &_option, _statistics);
+
+  return x;
+}
+
+//==============================================================================
+/// Check that an iterative solver stops after an iteration budget that is too
+/// small to converge and reports it in its statistics
+template <class Option, class Statistics>
+void checkIterationBudget(
+    const ContactLCP& _lcp, Option _option,
+    std::vector<double> (*_run)(const ContactLCP&, const Option&, Statistics*))
+{
+  _option.itermax = 2;
+  Statistics statistics;
+  _run(_lcp, _option, &statistics);
+  EXPECT_LE(statistics.iterations, 2);
+  EXPECT_FALSE(statistics.converged);
+}
+
+//==============================================================================
+TEST_F(ConstraintTest, PGSConvergence)
+{
+  const int numContacts = 10;
+  ContactLCP lcp = createContactLCP(numContacts, 0.5);
+
+  constraint::PGSOption option;
+  option.setDefault();
+  option.itermax = 10000;
+  option.eps_ea = 1e-12;
+  option.eps_res = 1e-14;
+
+  constraint::PGSStatistics statistics;
+  const std::vector<double> x = runPGS(lcp, option, &statistics);
+  EXPECT_TRUE(statistics.converged);
+  EXPECT_LT(statistics.iterations, option.itermax);
+  EXPECT_GT(statistics.iterations, 1);
+  EXPECT_LE(statistics.residual, option.eps_res);
+  EXPECT_LE(statistics.relative_change, option.eps_ea);
+  EXPECT_LT(computeLCPError(lcp, x), 1e-6);
+
+  // Sweeping the contacts in a random order reaches the same solution
+  option.random_order = true;
+  const std::vector<double> shuffledX = runPGS(lcp, option, &statistics);
+  EXPECT_TRUE(statistics.converged);
+  EXPECT_GT(statistics.iterations, 8);
+  EXPECT_LT(computeLCPError(lcp, shuffledX), 1e-6);
+  option.random_order = false;
+
+  checkIterationBudget(lcp, option, &runPGS);
+}
+
+//==============================================================================
+/// Solve _lcp with ODE's Dantzig solver and return the solution
+std::vector<double> solveDantzig(const ContactLCP& _lcp,
+                                 dLCPWorkspace* _workspace)
+{
+  // dSolveLCP() permutes the problem in place
+  ContactLCP work = _lcp;
+  std::vector<double> x(_lcp.n, 0.0);
+  std::vector<double> w(_lcp.n, 0.0);
+  dSolveLCP(_lcp.n, work.A.data(), x.data(), work.b.data(), w.data(), 0,
+            work.lo.data(), work.hi.data(), work.findex.data(), _workspace);
+
+  return x;
+}
+
+//==============================================================================
+TEST_F(ConstraintTest, DantzigWarmStart)
+{
+  const int numContacts = 20;
+  ContactLCP lcp = createContactLCP(numContacts, 0.5);
+
+  dLCPWorkspace workspace;
+  workspace.warmStart = true;
+
+  // There is nothing to start from in the first solve
+  solveDantzig(lcp, &workspace);
+  EXPECT_EQ(workspace.numWarmStarted, 0);
+  EXPECT_EQ(static_cast<int>(workspace.activeSet.size()), lcp.n);
+
+  // Slightly change the problem as between two steps of a resting scene
+  for (int i = 0; i < lcp.n; ++i)
+    lcp.b[i] += math::random(-1e-3, 1e-3);
+
+  dLCPWorkspace coldWorkspace;
+  const std::vector<double> coldX = solveDantzig(lcp, &coldWorkspace);
+  const std::vector<double> warmX = solveDantzig(lcp, &workspace);
+
+  EXPECT_GT(workspace.numWarmStarted, 0);
+  EXPECT_LT(workspace.numPivots, coldWorkspace.numPivots);
+  for (int i = 0; i < lcp.n; ++i)
+    EXPECT_NEAR(warmX[i], coldX[i], 1e-9);
+
+  // A guess that does not fit the problem is discarded
+  std::fill(workspace.activeSet.begin(), workspace.activeSet.end(), 1);
+  for (int i = 0; i < numContacts; ++i)
+    lcp.b[3*i] = -1.0;
+  const std::vector<double> separatingX = solveDantzig(lcp, &workspace);
+  EXPECT_EQ(workspace.numWarmStarted, 0);
+  for (int i = 0; i < lcp.n; ++i)
+    EXPECT_NEAR(separatingX[i], 0.0, 1e-12);
+}
+
+//==============================================================================
+/// Objective that solveAPGD() minimizes
+double computeObjective(const ContactLCP& _lcp, const std::vector<double>& _x)
+{
+  double f = 0.0;
+  for (int i = 0; i < _lcp.n; ++i)
+  {
+    double Ax = 0.0;
+    for (int j = 0; j < _lcp.n; ++j)
+      Ax += _lcp.A[i * _lcp.nSkip + j] * _x[j];
+
+    f += 0.5 * _x[i] * Ax - _lcp.b[i] * _x[i];
+  }
+
+  return f;
+}
+
+//==============================================================================
+TEST_F(ConstraintTest, APGDConvergence)
+{
+  const int numContacts = 10;
+
+  constraint::APGDOption option;
+  option.setDefault();
+  option.itermax = 10000;
+  option.eps_res = 1e-9;
+
+  // Without friction the problem is an LCP
+  ContactLCP frictionless = createContactLCP(numContacts, 0.0);
+  constraint::APGDStatistics statistics;
+  std::vector<double> x = runAPGD(frictionless, option, &statistics);
+  EXPECT_TRUE(statistics.converged);
+  EXPECT_LE(statistics.residual, option.eps_res);
+  EXPECT_LT(computeLCPError(frictionless, x), 1e-6);
+
+  // With friction the solution lies in the circular cone and minimizes the
+  // objective over it
+  const double mu = 0.5;
+  ContactLCP lcp = createContactLCP(numContacts, mu);
+  x = runAPGD(lcp, option, &statistics);
+  EXPECT_TRUE(statistics.converged);
+
+  for (int i = 0; i < numContacts; ++i)
+  {
+    EXPECT_GE(x[3*i], 0.0);
+    EXPECT_LE(std::sqrt(x[3*i + 1] * x[3*i + 1] + x[3*i + 2] * x[3*i + 2]),
+              mu * x[3*i] + 1e-9);
+  }
+
+  const double f = computeObjective(lcp, x);
+  for (int k = 0; k < 100; ++k)
+  {
+    std::vector<double> y = x;
+    for (int i = 0; i < numContacts; ++i)
+    {
+      y[3*i] = std::max(0.0, y[3*i] + math::random(-0.01, 0.01));
+      const double t1 = y[3*i + 1] + math::random(-0.01, 0.01);
+      const double t2 = y[3*i + 2] + math::random(-0.01, 0.01);
+      const double tn = std::sqrt(t1 * t1 + t2 * t2);
+      const double scale = tn > mu * y[3*i] ? mu * y[3*i] / tn : 1.0;
+      y[3*i + 1] = scale * t1;
+      y[3*i + 2] = scale * t2;
+    }
+
+    EXPECT_GE(computeObjective(lcp, y), f - 1e-9);
+  }
+
+  checkIterationBudget(lcp, option, &runAPGD);
+}
+
+//==============================================================================
+dynamics::SkeletonPtr createFrictionBox(const std::string& _name,
+                                        const Eigen::Vector3d& _position)
+{
+  using namespace dynamics;
+
+  SkeletonPtr skel = Skeleton::create(_name);
+  BodyNode* bn = skel->createJointAndBodyNodePair<FreeJoint>().second;
+  std::shared_ptr<Shape> box(new BoxShape(Eigen::Vector3d(1.0, 1.0, 1.0)));
+  bn->createShapeNodeWith<CollisionAddon, DynamicsAddon>(box);
+  bn->setFrictionCoeff(0.5);
+
+  Eigen::Vector6d positions = Eigen::Vector6d::Zero();
+  positions.tail<3>() = _position;
+  skel->setPositions(positions);
+
+  return skel;
+}
+
+//==============================================================================
+// Exposes the LCP interface of ContactConstraint to the tests
+class TestContactConstraint : public constraint::ContactConstraint
+{
+public:
+  using ContactConstraint::ContactConstraint;
+  using ContactConstraint::update;
+  using ContactConstraint::getInformation;
+};
+
+//==============================================================================
+TEST_F(ConstraintTest, FrictionModels)
+{
+  using constraint::ContactConstraint;
+
+  dynamics::SkeletonPtr skel1
+      = createFrictionBox("box 1", Eigen::Vector3d::Zero());
+  dynamics::SkeletonPtr skel2
+      = createFrictionBox("box 2", Eigen::Vector3d(0.0, 0.0, 0.9));
+
+  collision::DARTCollisionDetector detector;
+  detector.addSkeleton(skel1);
+  detector.addSkeleton(skel2);
+  ASSERT_TRUE(detector.detectCollision(true, true));
+  ASSERT_GT(detector.getNumContacts(), 0u);
+
+  collision::ContactRecord& record = detector.getContactRecord(0);
+  const double timeStep = 0.001;
+  const size_t numBases = 6;
+
+  ContactConstraint frictionless(
+        record, timeStep, ContactConstraint::FRICTIONLESS, numBases);
+  EXPECT_EQ(frictionless.getNumFrictionConeBases(), 0u);
+  EXPECT_EQ(frictionless.getDimension(), 1u);
+
+  ContactConstraint box(record, timeStep, ContactConstraint::BOX, numBases);
+  EXPECT_EQ(box.getNumFrictionConeBases(), 2u);
+  EXPECT_EQ(box.getDimension(), 3u);
+
+  TestContactConstraint pyramid(
+        record, timeStep, ContactConstraint::PYRAMID, numBases);
+  EXPECT_EQ(pyramid.getNumFrictionConeBases(), numBases);
+  EXPECT_EQ(pyramid.getDimension(), 1u + numBases);
+
+  // The friction rows of the pyramid refer to the normal row and share the
+  // friction coefficient among the bases
+  const size_t dim = pyramid.getDimension();
+  std::vector<double> x(dim), lo(dim), hi(dim), b(dim), w(dim, 0.0);
+  std::vector<int> findex(dim, -1);
+  constraint::ConstraintInfo info;
+  info.x = x.data();
+  info.lo = lo.data();
+  info.hi = hi.data();
+  info.b = b.data();
+  info.w = w.data();
+  info.findex = findex.data();
+  info.invTimeStep = 1.0 / timeStep;
+
+  pyramid.update();
+  pyramid.getInformation(&info);
+
+  EXPECT_EQ(findex[0], -1);
+  EXPECT_EQ(lo[0], 0.0);
+  for (size_t i = 1; i < dim; ++i)
+  {
+    EXPECT_EQ(findex[i], 0);
+    EXPECT_NEAR(hi[i], 0.5 * DART_PI_HALF / numBases, 1e-12);
+    EXPECT_NEAR(lo[i], -hi[i], 1e-12);
+  }
+
+  // The default model is used by the two-argument constructor
+  EXPECT_EQ(ContactConstraint::getDefaultFrictionModel(),
+            ContactConstraint::BOX);
+  ContactConstraint::setDefaultFrictionModel(ContactConstraint::FRICTIONLESS);
+  ContactConstraint defaultConstraint(record, timeStep);
+  EXPECT_EQ(defaultConstraint.getFrictionModel(),
+            ContactConstraint::FRICTIONLESS);
+  EXPECT_EQ(defaultConstraint.getDimension(), 1u);
+  ContactConstraint::setDefaultFrictionModel(ContactConstraint::BOX);
+}
+
+//==============================================================================
+// A constraint that only couples two skeletons
+class CouplingConstraint : public constraint::ConstraintBase
+{
+public:
+  CouplingConstraint(dynamics::Skeleton* _skeleton1,
+                     dynamics::Skeleton* _skeleton2)
+    : mSkeleton1(_skeleton1), mSkeleton2(_skeleton2) {}
+
+  void update() override {}
+  void getInformation(constraint::ConstraintInfo*) override {}
+  void applyUnitImpulse(size_t) override {}
+  void getVelocityChange(double*, bool) override {}
+  void excite() override {}
+  void unexcite() override {}
+  void applyImpulse(double*) override {}
+  bool isActive() const override { return true; }
+  dynamics::SkeletonPtr getRootSkeleton() const override { return nullptr; }
+
+  void getSkeletons(dynamics::Skeleton*& _skeleton1,
+                    dynamics::Skeleton*& _skeleton2) const override
+  {
+    _skeleton1 = mSkeleton1;
+    _skeleton2 = mSkeleton2;
+  }
+
+private:
+  dynamics::Skeleton* mSkeleton1;
+  dynamics::Skeleton* mSkeleton2;
+};
+
+//==============================================================================
+TEST_F(ConstraintTest, IslandBuilder)
+{
+  using constraint::ConstraintBasePtr;
+
+  const size_t numSkeletons = 200;
+  std::vector<dynamics::SkeletonPtr> skels;
+  for (size_t i = 0; i < numSkeletons; ++i)
+    skels.push_back(dynamics::Skeleton::create());
+  dynamics::SkeletonPtr outsider = dynamics::Skeleton::create();
+
+  constraint::IslandBuilder builder;
+  builder.setSkeletons(skels);
+  EXPECT_EQ(builder.getNumSkeletons(), numSkeletons);
+
+  // Two chains, a single-skeleton constraint and a skeleton that is not known
+  // to the builder
+  std::vector<ConstraintBasePtr> constraints;
+  constraints.push_back(std::make_shared<CouplingConstraint>(
+                          skels[0].get(), skels[1].get()));
+  constraints.push_back(std::make_shared<CouplingConstraint>(
+                          skels[2].get(), nullptr));
+  constraints.push_back(std::make_shared<CouplingConstraint>(
+                          skels[1].get(), skels[3].get()));
+  constraints.push_back(std::make_shared<CouplingConstraint>(
+                          skels[4].get(), skels[2].get()));
+  constraints.push_back(std::make_shared<CouplingConstraint>(
+                          outsider.get(), skels[5].get()));
+  builder.build(constraints);
+
+  EXPECT_EQ(builder.getNumIslands(), 3u);
+  EXPECT_EQ(builder.getConstraintIsland(0), 0u);
+  EXPECT_EQ(builder.getConstraintIsland(1), 1u);
+  EXPECT_EQ(builder.getConstraintIsland(2), 0u);
+  EXPECT_EQ(builder.getConstraintIsland(3), 1u);
+  EXPECT_EQ(builder.getConstraintIsland(4), 2u);
+  EXPECT_EQ(builder.getSkeletonIsland(0), 0u);
+  EXPECT_EQ(builder.getSkeletonIsland(3), 0u);
+  EXPECT_EQ(builder.getSkeletonIsland(4), 1u);
+  EXPECT_EQ(builder.getSkeletonIsland(5), 2u);
+  EXPECT_EQ(builder.getSkeletonIsland(6), 3u + 6u);
+  EXPECT_TRUE(builder.getIslandSkeleton(2) == outsider.get()
+              || builder.getIslandSkeleton(2) == skels[5].get());
+
+  const constraint::IslandBuilder::Statistics& statistics
+      = builder.getStatistics();
+  EXPECT_EQ(statistics.mNumIslands, 3u);
+  EXPECT_EQ(statistics.mNumConstraints, 5u);
+  EXPECT_EQ(statistics.mNumConstrainedSkeletons, 7u);
+  EXPECT_EQ(statistics.mMaxNumIslandSkeletons, 3u);
+  EXPECT_EQ(statistics.mMaxNumIslandConstraints, 2u);
+
+  // Joining the chains merges their islands
+  constraints.push_back(std::make_shared<CouplingConstraint>(
+                          skels[3].get(), skels[4].get()));
+  builder.build(constraints);
+  EXPECT_EQ(builder.getNumIslands(), 2u);
+  EXPECT_EQ(builder.getConstraintIsland(1), 0u);
+  EXPECT_EQ(builder.getConstraintIsland(4), 1u);
+  EXPECT_EQ(builder.getSkeletonIsland(2), 0u);
+
+  // Random constraints give the same islands as a flood fill
+  constraints.clear();
+  std::vector<std::vector<size_t>> neighbors(numSkeletons);
+  for (size_t i = 0; i < 150; ++i)
+  {
+    const size_t index1 = std::rand() % numSkeletons;
+    const size_t index2 = std::rand() % numSkeletons;
+    constraints.push_back(std::make_shared<CouplingConstraint>(
+                            skels[index1].get(), skels[index2].get()));
+    neighbors[index1].push_back(index2);
+    neighbors[index2].push_back(index1);
+  }
+  builder.build(constraints);
+
+  std::vector<size_t> labels(numSkeletons, numSkeletons);
+  for (size_t i = 0; i < numSkeletons; ++i)
+  {
+    if (labels[i] != numSkeletons)
+      continue;
+
+    std::vector<size_t> stack(1u, i);
+    labels[i] = i;
+    while (!stack.empty())
+    {
+      const size_t index = stack.back();
+      stack.pop_back();
+      for (const size_t neighbor : neighbors[index])
+      {
+        if (labels[neighbor] == numSkeletons)
+        {
+          labels[neighbor] = i;
+          stack.push_back(neighbor);
+        }
+      }
+    }
+  }
+
+  for (size_t i = 0; i < numSkeletons; ++i)
+  {
+    for (size_t j = i + 1; j < numSkeletons; ++j)
+    {
+      EXPECT_EQ(labels[i] == labels[j],
+                builder.getSkeletonIsland(i) == builder.getSkeletonIsland(j));
+    }
+  }
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
@@ -43,6 +43,7 @@
 #include "dart/dynamics/BodyNode.h"
 #include "dart/dynamics/RevoluteJoint.h"
 #include "dart/dynamics/Skeleton.h"
+#include "dart/simulation/RecordingFile.h"
 #include "dart/simulation/World.h"
 #include "dart/utils/SkelParser.h"
 #include "dart/utils/FileInfoWorld.h"
@@ -135,6 +136,239 @@ TEST(FileInfoWorld, Basic)
   }
 }
 
+//==============================================================================
+void compareRecordings(Recording* _recording1, Recording* _recording2,
+                       double _tol)
+{
+  ASSERT_EQ(_recording1->getNumFrames(), _recording2->getNumFrames());
+  ASSERT_EQ(_recording1->getNumSkeletons(), _recording2->getNumSkeletons());
+
+  for (int i = 0; i < _recording1->getNumSkeletons(); ++i)
+    EXPECT_EQ(_recording1->getNumDofs(i), _recording2->getNumDofs(i));
+
+  for (int i = 0; i < _recording1->getNumFrames(); ++i)
+  {
+    for (int j = 0; j < _recording1->getNumSkeletons(); ++j)
+    {
+      for (int k = 0; k < _recording1->getNumDofs(j); ++k)
+      {
+        EXPECT_NEAR(_recording1->getGenCoord(i, j, k),
+                    _recording2->getGenCoord(i, j, k), _tol);
+      }
+    }
+
+    ASSERT_EQ(_recording1->getNumContacts(i), _recording2->getNumContacts(i));
+    for (int j = 0; j < _recording1->getNumContacts(i); ++j)
+    {
+      EXPECT_TRUE(equals(_recording1->getContactPoint(i, j),
+                         _recording2->getContactPoint(i, j), _tol));
+      EXPECT_TRUE(equals(_recording1->getContactForce(i, j),
+                         _recording2->getContactForce(i, j), _tol));
+    }
+  }
+}
+
+//==============================================================================
+TEST(FileInfoWorld, Binary)
+{
+  const size_t numFrames = 300;
+  const std::string fileName = "testWorld.rec";
+
+  WorldPtr world = SkelParser::readWorld(
+      DART_DATA_PATH"/skel/test/file_info_world_test.skel");
+  ASSERT_TRUE(world != nullptr);
+
+  for (size_t i = 0; i < numFrames; ++i)
+  {
+    world->step();
+    world->bake();
+  }
+  Recording* recording = world->getRecording();
+
+  const RecordingFileOptions::Compression compressions[] = {
+    RecordingFileOptions::COMPRESSION_NONE,
+    RecordingFileOptions::COMPRESSION_DELTA,
+    RecordingFileOptions::COMPRESSION_QUANTIZED
+  };
+
+  for (const auto compression : compressions)
+  {
+    const RecordingFileOptions options(compression, 1e-6, 64);
+    const double tol
+        = compression == RecordingFileOptions::COMPRESSION_QUANTIZED
+          ? options.mResolution : 0.0;
+
+    FileInfoWorld worldFile;
+    EXPECT_TRUE(worldFile.saveBinaryFile(fileName.c_str(), recording,
+                                         options));
+
+    // Random access playback straight from the file
+    RecordingReader reader(fileName);
+    ASSERT_TRUE(reader.isGood());
+    EXPECT_EQ(reader.getNumFrames(), recording->getNumFrames());
+    EXPECT_EQ(reader.getOptions().mCompression, compression);
+    for (int i = recording->getNumFrames() - 1; i >= 0; i -= 7)
+    {
+      EXPECT_TRUE(equals(reader.getConfigs(i), recording->getConfigs(i), tol));
+      EXPECT_EQ(reader.getNumContacts(i), recording->getNumContacts(i));
+    }
+
+    // Loading converts the file back into a Recording
+    EXPECT_TRUE(worldFile.loadFile(fileName.c_str()));
+    compareRecordings(recording, worldFile.getRecording(), tol);
+  }
+}
+
+//==============================================================================
+TEST(FileInfoWorld, Streaming)
+{
+  const size_t numFrames = 100;
+  const std::string fileName = "testWorldStream.rec";
+
+  WorldPtr world = SkelParser::readWorld(
+      DART_DATA_PATH"/skel/test/file_info_world_test.skel");
+  ASSERT_TRUE(world != nullptr);
+
+  Recording* recording = world->getRecording();
+  std::vector<int> numDofs(recording->getNumSkeletons());
+  for (size_t i = 0; i < numDofs.size(); ++i)
+    numDofs[i] = recording->getNumDofs(i);
+
+  // Stream all the frames to the file without keeping them in memory
+  std::shared_ptr<RecordingWriter> writer
+      = std::make_shared<RecordingWriter>(fileName, numDofs);
+  recording->setStream(writer, false);
+
+  std::vector<Eigen::VectorXd> positions;
+  for (size_t i = 0; i < numFrames; ++i)
+  {
+    world->step();
+    world->bake();
+    positions.push_back(world->getSkeleton(0)->getPositions());
+  }
+  recording->setStream(nullptr);
+  EXPECT_TRUE(writer->close());
+
+  EXPECT_EQ(recording->getNumFrames(), 0);
+  EXPECT_EQ(writer->getNumFrames(), numFrames);
+
+  RecordingReader reader(fileName);
+  ASSERT_TRUE(reader.isGood());
+  ASSERT_EQ(reader.getNumFrames(), static_cast<int>(numFrames));
+  for (size_t i = 0; i < numFrames; ++i)
+    EXPECT_TRUE(equals(reader.getConfig(i, 0), positions[i], 0.0));
+}
+
+//==============================================================================
+void readAllFrames(const RecordingReader& _reader)
+{
+  for (int i = 0; i < _reader.getNumFrames(); ++i)
+  {
+    EXPECT_EQ(_reader.getNumDofs(), _reader.getConfigs(i).size());
+    ASSERT_GE(_reader.getNumContacts(i), 0);
+    for (int j = 0; j < _reader.getNumContacts(i); ++j)
+    {
+      _reader.getContactPoint(i, j);
+      _reader.getContactForce(i, j);
+    }
+  }
+}
+
+//==============================================================================
+TEST(FileInfoWorld, CorruptedBinary)
+{
+  const std::string fileName = "testWorldCorrupted.rec";
+
+  std::vector<int> numDofs(2);
+  numDofs[0] = 6;
+  numDofs[1] = 2;
+  Recording recording(numDofs);
+  const Eigen::VectorXd contacts = Eigen::VectorXd::Random(12);
+  for (int i = 0; i < 40; ++i)
+  {
+    const Eigen::VectorXd positions = Eigen::VectorXd::Random(8);
+    recording.addState(positions.data(), contacts.data(), i % 3);
+  }
+
+  const RecordingFileOptions::Compression compressions[] = {
+    RecordingFileOptions::COMPRESSION_NONE,
+    RecordingFileOptions::COMPRESSION_DELTA,
+    RecordingFileOptions::COMPRESSION_QUANTIZED
+  };
+
+  for (const auto compression : compressions)
+  {
+    const RecordingFileOptions options(compression, 1e-6, 16);
+    ASSERT_TRUE(RecordingWriter::write(fileName, recording, options));
+
+    std::ifstream file(fileName.c_str(), std::ios::binary);
+    const std::string content((std::istreambuf_iterator<char>(file)),
+                              std::istreambuf_iterator<char>());
+    file.close();
+
+    // Truncated files lose their last chunks but never read past the end
+    for (size_t size = 0; size < content.size(); size += 5)
+    {
+      std::ofstream(fileName.c_str(), std::ios::binary).write(
+            content.data(), static_cast<std::streamsize>(size));
+      RecordingReader reader(fileName);
+      if (reader.isGood())
+      {
+        EXPECT_LE(reader.getNumFrames(), recording.getNumFrames());
+        readAllFrames(reader);
+      }
+    }
+
+    // Corrupted files are either refused or read without leaving the file
+    for (size_t i = 0; i < content.size(); i += 3)
+    {
+      std::string corrupted = content;
+      corrupted[i] = static_cast<char>(~corrupted[i]);
+      std::ofstream(fileName.c_str(), std::ios::binary).write(
+            corrupted.data(), static_cast<std::streamsize>(corrupted.size()));
+      RecordingReader reader(fileName);
+      if (reader.isGood())
+        readAllFrames(reader);
+    }
+  }
+
+  std::remove(fileName.c_str());
+}
+
+//==============================================================================
+TEST(FileInfoWorld, AddingSkeletons)
+{
+  WorldPtr world(new World);
+  SkeletonPtr box1 = createBox(Eigen::Vector3d::Constant(0.1));
+  world->addSkeleton(box1);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    world->step();
+    world->bake();
+  }
+
+  Recording* recording = world->getRecording();
+  const Eigen::VectorXd firstFrame = recording->getConfigs(0);
+
+  // A skeleton added to the end keeps the recorded frames
+  SkeletonPtr box2 = createBox(Eigen::Vector3d::Constant(0.1),
+                               Eigen::Vector3d(1.0, 0.0, 0.0));
+  world->addSkeleton(box2);
+  ASSERT_EQ(10, recording->getNumFrames());
+  EXPECT_EQ(2, recording->getNumSkeletons());
+  EXPECT_TRUE(equals(recording->getConfig(0, 0), firstFrame, 0.0));
+  EXPECT_TRUE(equals(recording->getConfig(9, 1), box2->getPositions(), 0.0));
+
+  world->step();
+  world->bake();
+  EXPECT_EQ(11, recording->getNumFrames());
+
+  // Removing a skeleton changes the layout of the frames
+  world->removeSkeleton(box1);
+  EXPECT_EQ(0, recording->getNumFrames());
+  EXPECT_EQ(1, recording->getNumSkeletons());
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
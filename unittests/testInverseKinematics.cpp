@@ -34,11 +34,13 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <cmath>
 #include <iostream>
 #include <gtest/gtest.h>
 
 #include "dart/config.h"
 #include "dart/math/Helpers.h"
+#include "dart/optimizer/LbfgsbSolver.h"
 #include "TestHelpers.h"
 
 using namespace Eigen;
@@ -253,6 +255,72 @@ SkeletonPtr createFreeFloatingTwoLinkRobot(Vector3d dim1,
 //}
 #endif
 
+//==============================================================================
+SkeletonPtr createSerialChainRobot(size_t numLinks, Vector3d dim)
+{
+  SkeletonPtr robot = Skeleton::create();
+  const TypeOfDOF types[] = {DOF_ROLL, DOF_PITCH, DOF_YAW};
+
+  BodyNode* parent_node = nullptr;
+  for(size_t i=0; i < numLinks; ++i)
+  {
+    BodyNode::Properties node("link" + std::to_string(i));
+    node.mInertia.setLocalCOM(Vector3d(0.0, 0.0, dim(2)/2.0));
+
+    std::pair<Joint*, BodyNode*> pair = add1DofJoint(
+          robot, parent_node, node, "joint" + std::to_string(i), 0.0,
+          -DART_PI, DART_PI, types[i%3]);
+    pair.second->createShapeNodeWith<VisualAddon>(
+          std::make_shared<BoxShape>(dim));
+
+    if(parent_node)
+    {
+      Eigen::Isometry3d T = Eigen::Isometry3d::Identity();
+      T.translate(Eigen::Vector3d(0.0, 0.0, dim(2)));
+      pair.first->setTransformFromParentBodyNode(T);
+    }
+
+    parent_node = pair.second;
+  }
+
+  addEndEffector(robot, parent_node, dim);
+
+  return robot;
+}
+
+//==============================================================================
+TEST(InverseKinematics, LbfgsbSolver)
+{
+  std::vector<SkeletonPtr> robots;
+  robots.push_back(createFreeFloatingTwoLinkRobot(
+                     Vector3d(0.3, 0.3, 1.5), Vector3d(0.3, 0.3, 1.0),
+                     DOF_ROLL));
+  robots.push_back(createSerialChainRobot(7, Vector3d(0.1, 0.1, 0.4)));
+
+  for(const SkeletonPtr& robot : robots)
+  {
+    BodyNode* ee = robot->getBodyNode(robot->getNumBodyNodes()-1);
+    const std::shared_ptr<InverseKinematics>& ik = ee->getIK(true);
+    ik->setSolver(std::make_shared<optimizer::LbfgsbSolver>());
+
+    // The default clamps are tuned for gradient descent
+    ik->getErrorMethod().setErrorLengthClamp(1e10);
+    ik->getGradientMethod().setComponentWiseClamp(1e10);
+
+    // The goal is taken from a configuration so that it is reachable
+    Eigen::VectorXd goal(robot->getNumDofs());
+    for(int i=0; i < goal.size(); ++i)
+      goal[i] = 0.5 * std::sin(i + 1.0);
+    robot->setPositions(goal);
+    ik->getTarget()->setTransform(ee->getWorldTransform());
+    robot->setPositions(Eigen::VectorXd::Constant(robot->getNumDofs(), 0.1));
+
+    EXPECT_TRUE(ik->solve());
+    EXPECT_TRUE(equals(ik->getTarget()->getTransform().matrix(),
+                       ee->getWorldTransform().matrix(), 1e-5));
+  }
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
@@ -161,6 +161,36 @@ TEST(LocalResourceRetriever, retrieve_ResourceOperations)
   EXPECT_STREQ(content.c_str(), buffer.data());
 }
 
+TEST(LocalResourceRetriever, retrieve_GetData)
+{
+  const std::string content = "Hello World";
+
+  // Files are memory-mapped by default
+  LocalResourceRetriever retriever;
+  EXPECT_TRUE(retriever.isMemoryMapped());
+  auto resource = retriever.retrieve(DART_DATA_PATH "test/hello_world.txt");
+  ASSERT_TRUE(resource != nullptr);
+
+  const char* data = static_cast<const char*>(resource->getData());
+  ASSERT_TRUE(data != nullptr);
+  EXPECT_EQ(content, std::string(data, resource->getSize()));
+
+  // The view does not depend on the position indicator
+  ASSERT_TRUE(resource->seek(5, Resource::SEEKTYPE_SET));
+  EXPECT_EQ(data, resource->getData());
+
+  // Seeking before the beginning fails without moving the position indicator
+  EXPECT_FALSE(resource->seek(-1, Resource::SEEKTYPE_SET));
+  EXPECT_EQ(5u, resource->tell());
+
+  // Resources that are not mapped do not provide a view
+  retriever.setMemoryMapped(false);
+  resource = retriever.retrieve(DART_DATA_PATH "test/hello_world.txt");
+  ASSERT_TRUE(resource != nullptr);
+  EXPECT_EQ(nullptr, resource->getData());
+  EXPECT_EQ(content.size(), resource->getSize());
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2015, Georgia Tech Research Corporation
+ * All rights reserved.
+ *
+ * Georgia Tech Graphics Lab and Humanoid Robotics Lab
+ *
+ * Directed by Prof. C. Karen Liu and Prof. Mike Stilman
+ * <karenliu@cc.gatech.edu> <mstilman@cc.gatech.edu>
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <fstream>
+#include <gtest/gtest.h>
+#include "TestHelpers.h"
+
+#include "dart/utils/C3D.h"
+#include "dart/utils/C3DStream.h"
+#include "dart/utils/DofStream.h"
+
+using namespace dart;
+using namespace utils;
+
+//==============================================================================
+TEST(MotionStream, C3DFrames)
+{
+  const std::string fileName = DART_DATA_PATH"c3d/squat.c3d";
+
+  Eigen::EIGEN_VV_VEC3D expected;
+  int numFrames, numMarkers;
+  double fps;
+  ASSERT_TRUE(loadC3DFile(fileName.c_str(), expected, &numFrames, &numMarkers,
+                          &fps));
+
+  C3DStream stream(16u);
+  ASSERT_TRUE(stream.open(fileName));
+  EXPECT_EQ(static_cast<size_t>(numFrames), stream.getNumFrames());
+  EXPECT_EQ(static_cast<size_t>(numMarkers), stream.getNumMarkers());
+  EXPECT_EQ(fps, stream.getFPS());
+
+  // Opening the file does not decode anything
+  EXPECT_EQ(0u, stream.getNumDecodedFrames());
+
+  // Visit the frames in random order
+  for(size_t i = 0; i < 200u; ++i)
+  {
+    const size_t frame = std::rand() % numFrames;
+    const size_t marker = std::rand() % numMarkers;
+    EXPECT_TRUE(expected[frame][marker] == stream.getMarker(frame, marker));
+  }
+  EXPECT_EQ(16u, stream.getNumCachedFrames());
+
+  // Scrubbing over a few frames only decodes them once
+  stream.clearCache();
+  const size_t numDecoded = stream.getNumDecodedFrames();
+  for(size_t i = 0; i < 10u; ++i)
+  {
+    for(size_t frame = 100u; frame < 110u; ++frame)
+      EXPECT_TRUE(expected[frame][0] == stream.getMarker(frame, 0));
+  }
+  EXPECT_EQ(numDecoded + 10u, stream.getNumDecodedFrames());
+
+  EXPECT_FALSE(stream.open(DART_DATA_PATH"skel/cube.skel"));
+  EXPECT_FALSE(stream.isOpen());
+}
+
+//==============================================================================
+TEST(MotionStream, C3DMarkerTrajectory)
+{
+  const std::string fileName = DART_DATA_PATH"c3d/nick_freeform_001.c3d";
+
+  Eigen::EIGEN_VV_VEC3D expected;
+  int numFrames, numMarkers;
+  double fps;
+  ASSERT_TRUE(loadC3DFile(fileName.c_str(), expected, &numFrames, &numMarkers,
+                          &fps));
+
+  C3DStream stream(0u);
+  ASSERT_TRUE(stream.open(fileName));
+
+  const size_t marker = 7u;
+  const double startTime = 1.0;
+  const double endTime = 2.5;
+  const Eigen::Matrix3Xd trajectory
+      = stream.getMarkerTrajectory(marker, startTime, endTime);
+
+  const size_t first = static_cast<size_t>(startTime * fps);
+  const size_t last = static_cast<size_t>(endTime * fps);
+  ASSERT_EQ(last - first + 1u, static_cast<size_t>(trajectory.cols()));
+  for(size_t i = first; i <= last; ++i)
+    EXPECT_TRUE(expected[i][marker] == trajectory.col(i - first));
+
+  EXPECT_EQ(0u, stream.getNumCachedFrames());
+
+  // The window is clamped to the motion
+  EXPECT_EQ(numFrames, stream.getMarkerTrajectory(0u, -1.0, 1e6).cols());
+  EXPECT_EQ(0, stream.getMarkerTrajectory(0u, 1e6, 2e6).cols());
+}
+
+//==============================================================================
+TEST(MotionStream, DofFrames)
+{
+  const std::string fileName = DART_DATA_PATH"dof/simMotion.dof";
+
+  // Read the whole file the same way as FileInfoDof::loadFile()
+  std::ifstream file(fileName.c_str());
+  std::string buffer;
+  size_t numFrames, numDofs;
+  file >> buffer >> buffer >> numFrames >> buffer >> buffer >> numDofs;
+  std::vector<std::string> names(numDofs);
+  for(std::string& name : names)
+    file >> name;
+  std::vector<Eigen::VectorXd> expected(numFrames, Eigen::VectorXd(numDofs));
+  for(Eigen::VectorXd& frame : expected)
+  {
+    for(size_t i = 0; i < numDofs; ++i)
+      file >> frame[i];
+  }
+
+  DofStream stream(120.0, 32u);
+  ASSERT_TRUE(stream.open(fileName));
+  EXPECT_EQ(numFrames, stream.getNumFrames());
+  EXPECT_EQ(numDofs, stream.getNumDofs());
+  EXPECT_EQ(names, stream.getDofNames());
+  EXPECT_EQ(0u, stream.getNumDecodedFrames());
+
+  for(size_t i = 0; i < 200u; ++i)
+  {
+    const size_t frame = std::rand() % numFrames;
+    EXPECT_TRUE(expected[frame] == stream.getFrame(frame));
+  }
+  EXPECT_EQ(32u, stream.getNumCachedFrames());
+
+  stream.setCacheCapacity(4u);
+  EXPECT_EQ(4u, stream.getNumCachedFrames());
+
+  const Eigen::VectorXd trajectory = stream.getDofTrajectory(3u, 0.5, 1.0);
+  const size_t first = stream.getFrameAtTime(0.5);
+  ASSERT_EQ(61, trajectory.size());
+  for(int i = 0; i < trajectory.size(); ++i)
+    EXPECT_EQ(expected[first + i][3], trajectory[i]);
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
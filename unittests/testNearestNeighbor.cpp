@@ -9,8 +9,14 @@
 #include <gtest/gtest.h>
 #include <flann/flann.hpp>
 #include <Eigen/Core>
+#include "dart/common/Timer.h"
+#include "dart/math/Helpers.h"
+#include "dart/planning/NearestNeighborIndex.h"
 #include "TestHelpers.h"
 
+using namespace dart;
+using namespace planning;
+
 /* ********************************************************************************************* */
 TEST(NEAREST_NEIGHBOR, 2D) {
 
@@ -45,6 +51,125 @@ TEST(NEAREST_NEIGHBOR, 2D) {
     EXPECT_TRUE(equality);
 }
 
+/* ********************************************************************************************* */
+// Returns the nearest active point by brute force
+int bruteForceNearestNeighbor(const NearestNeighborIndex& index, const Eigen::VectorXd& query) {
+    int nearest = -1;
+    double minDistance = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < index.getSize(); i++) {
+        if (index.isRemoved(i))
+            continue;
+        double distance = index.getDistance(query, index.getPoint(i));
+        if (distance < minDistance) {
+            minDistance = distance;
+            nearest = i;
+        }
+    }
+    return nearest;
+}
+
+/* ********************************************************************************************* */
+TEST(NEAREST_NEIGHBOR, INCREMENTAL_INDEX) {
+
+    const size_t dim = 5;
+    NearestNeighborIndex index(dim);
+    EXPECT_EQ(-1, index.getNearestNeighbor(Eigen::VectorXd::Zero(dim)));
+
+    // Weighted metric in which the first and the fourth dimensions are angles
+    Eigen::VectorXd weights(dim);
+    weights << 1.0, 0.5, 2.0, 1.0, 0.1;
+    index.setWeights(weights);
+    index.setCyclic(0, true);
+    index.setCyclic(3, true);
+
+    for (size_t i = 0; i < 2000; i++) {
+        Eigen::VectorXd point(dim);
+        for (size_t j = 0; j < dim; j++)
+            point[j] = math::random(-2.0 * M_PI, 2.0 * M_PI);
+        EXPECT_EQ(i, index.addPoint(point));
+
+        if (i % 5 == 4)
+            index.removePoint((size_t)math::random(0.0, (double)i));
+
+        if (i % 10 == 0) {
+            Eigen::VectorXd query(dim);
+            for (size_t j = 0; j < dim; j++)
+                query[j] = math::random(-3.0 * M_PI, 3.0 * M_PI);
+
+            double distance;
+            int nearest = index.getNearestNeighbor(query, &distance);
+            int expected = bruteForceNearestNeighbor(index, query);
+            ASSERT_NE(-1, nearest);
+            EXPECT_NEAR(index.getDistance(query, index.getPoint(expected)), distance, 1e-12);
+            EXPECT_FALSE(index.isRemoved(nearest));
+        }
+    }
+
+    // Angles wrap around
+    NearestNeighborIndex circle(1);
+    circle.setCyclic(0, true);
+    circle.addPoint(Eigen::VectorXd::Constant(1, 3.0));
+    circle.addPoint(Eigen::VectorXd::Constant(1, 0.0));
+    EXPECT_EQ(0, circle.getNearestNeighbor(Eigen::VectorXd::Constant(1, -3.0)));
+}
+
+/* ********************************************************************************************* */
+// Compares the incremental index with flann when the points are added one at a time and every
+// insertion is followed by a query, which is how the RRT uses the nearest neighbor search.
+TEST(NEAREST_NEIGHBOR, BENCHMARK) {
+
+    const size_t dim = 7;
+    const size_t numPoints = 20000;
+
+    std::vector<Eigen::VectorXd> points(numPoints);
+    std::vector<Eigen::VectorXd> queries(numPoints);
+    for (size_t i = 0; i < numPoints; i++) {
+        points[i] = Eigen::VectorXd::Random(dim);
+        queries[i] = Eigen::VectorXd::Random(dim);
+    }
+
+    std::vector<int> flannResults(numPoints);
+    common::Timer flannTimer("flann");
+    flannTimer.start();
+    flann::Index<flann::L2<double> > flannIndex (flann::KDTreeSingleIndexParams(10, true));
+    for (size_t i = 0; i < numPoints; i++) {
+        flann::Matrix<double> pointMatrix((double*)points[i].data(), 1, dim);
+        if (i == 0)
+            flannIndex.buildIndex(pointMatrix);
+        else
+            flannIndex.addPoints(pointMatrix);
+
+        double distance;
+        const flann::Matrix<double> queryMatrix((double*)queries[i].data(), 1, dim);
+        flann::Matrix<int> nearestMatrix(&flannResults[i], 1, 1);
+        flann::Matrix<double> distanceMatrix(&distance, 1, 1);
+        flannIndex.knnSearch(queryMatrix, nearestMatrix, distanceMatrix, 1,
+            flann::SearchParams(flann::FLANN_CHECKS_UNLIMITED));
+    }
+    flannTimer.stop();
+
+    std::vector<int> results(numPoints);
+    common::Timer indexTimer("NearestNeighborIndex");
+    indexTimer.start();
+    NearestNeighborIndex index(dim);
+    index.reserve(numPoints);
+    for (size_t i = 0; i < numPoints; i++) {
+        index.addPoint(points[i]);
+        results[i] = index.getNearestNeighbor(queries[i]);
+    }
+    indexTimer.stop();
+
+    for (size_t i = 0; i < numPoints; i++) {
+        EXPECT_NEAR((points[results[i]] - queries[i]).norm(),
+                    (points[flannResults[i]] - queries[i]).norm(), 1e-12);
+    }
+
+    std::cout << "Incremental nearest neighbor search (" << numPoints << " points, " << dim
+              << " dimensions):" << std::endl
+              << "  flann               : " << flannTimer.getLastElapsedTime() << " s" << std::endl
+              << "  NearestNeighborIndex: " << indexTimer.getLastElapsedTime() << " s" << std::endl;
+}
+
 /* ********************************************************************************************* */
 int main(int argc, char* argv[]) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -47,6 +47,7 @@
 #include "dart/optimizer/Function.h"
 #include "dart/optimizer/Problem.h"
 #include "dart/optimizer/GradientDescentSolver.h"
+#include "dart/optimizer/LbfgsbSolver.h"
 #include "dart/dynamics/Skeleton.h"
 #include "dart/dynamics/FreeJoint.h"
 #include "dart/dynamics/InverseKinematics.h"
@@ -146,6 +147,89 @@ TEST(Optimizer, GradientDescent)
   EXPECT_NEAR(optX[1], 0.0, solver.getTolerance());
 }
 
+//==============================================================================
+class RosenbrockFunc : public Function
+{
+public:
+  /// \copydoc Function::eval
+  virtual double eval(const Eigen::VectorXd& _x) override
+  {
+    double f = 0.0;
+    for(int i=0; i < _x.size()-1; ++i)
+    {
+      const double a = _x[i+1] - _x[i]*_x[i];
+      const double b = 1.0 - _x[i];
+      f += 100.0*a*a + b*b;
+    }
+
+    return f;
+  }
+
+  /// \copydoc Function::evalGradient
+  virtual void evalGradient(const Eigen::VectorXd& _x,
+                            Eigen::Map<Eigen::VectorXd> _grad) override
+  {
+    _grad.setZero();
+    for(int i=0; i < _x.size()-1; ++i)
+    {
+      const double a = _x[i+1] - _x[i]*_x[i];
+      _grad[i] += -400.0*a*_x[i] - 2.0*(1.0 - _x[i]);
+      _grad[i+1] += 200.0*a;
+    }
+  }
+};
+
+//==============================================================================
+TEST(Optimizer, Lbfgsb)
+{
+  // Unconstrained problem that gradient descent cannot solve in a reasonable
+  // number of iterations
+  std::shared_ptr<Problem> rosenbrock = std::make_shared<Problem>(10);
+  rosenbrock->setInitialGuess(Eigen::VectorXd::Constant(10, -1.2));
+  rosenbrock->setObjective(std::make_shared<RosenbrockFunc>());
+
+  LbfgsbSolver solver(rosenbrock);
+  solver.setTolerance(1e-10);
+  EXPECT_TRUE(solver.solve());
+  EXPECT_TRUE(equals(rosenbrock->getOptimalSolution(),
+                     Eigen::VectorXd::Ones(10).eval(), 1e-4));
+  EXPECT_NEAR(rosenbrock->getOptimumValue(), 0.0, 1e-8);
+
+  // The same problem with the minimum excluded by the bounds
+  rosenbrock->setDimension(2);
+  rosenbrock->setInitialGuess(Eigen::Vector2d(-1.2, 1.0));
+  rosenbrock->setUpperBounds(Eigen::Vector2d(0.5, HUGE_VAL));
+  EXPECT_TRUE(solver.solve());
+  EXPECT_NEAR(rosenbrock->getOptimalSolution()[0], 0.5, 1e-6);
+  EXPECT_NEAR(rosenbrock->getOptimalSolution()[1], 0.25, 1e-4);
+
+  // Nonlinear inequality constraints, see BasicNlopt
+  std::shared_ptr<Problem> prob = std::make_shared<Problem>(2);
+
+  prob->setLowerBounds(Eigen::Vector2d(-HUGE_VAL, 0));
+  prob->setInitialGuess(Eigen::Vector2d(1.234, 5.678));
+
+  FunctionPtr obj = std::make_shared<SampleObjFunc>();
+  prob->setObjective(obj);
+
+  FunctionPtr const1 = std::make_shared<SampleConstFunc>( 2, 0);
+  FunctionPtr const2 = std::make_shared<SampleConstFunc>(-1, 1);
+  prob->addIneqConstraint(const1);
+  prob->addIneqConstraint(const2);
+
+  solver.setProblem(prob);
+  solver.setTolerance(1e-8);
+  EXPECT_TRUE(solver.solve());
+
+  double minF = prob->getOptimumValue();
+  Eigen::VectorXd optX = prob->getOptimalSolution();
+
+  EXPECT_NEAR(minF, 0.544330847, 1e-6);
+  EXPECT_EQ(static_cast<size_t>(optX.size()), prob->getDimension());
+  EXPECT_NEAR(optX[0], 0.333334, 1e-5);
+  EXPECT_NEAR(optX[1], 0.296296, 1e-5);
+}
+
 //==============================================================================
 #if HAVE_NLOPT
 TEST(Optimizer, BasicNlopt)
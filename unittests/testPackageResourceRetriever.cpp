@@ -242,6 +242,40 @@ TEST(PackageResourceRetriever, retrieve_FallsBackOnSecondUri)
   EXPECT_EQ(expected2, mockRetriever->mRetrieve[1]);
 }
 
+TEST(PackageResourceRetriever, retrieve_RemembersResolvedUri)
+{
+#ifdef _WIN32
+  const char* expected2 = "file:///" DART_DATA_PATH"test2/foo";
+#else
+  const char* expected2 = "file://" DART_DATA_PATH"test2/foo";
+#endif
+
+  // Only resources in the second package directory exist
+  struct SecondDirectoryRetriever : public PresentResourceRetriever
+  {
+    ResourcePtr retrieve(const Uri& _uri) override
+    {
+      const ResourcePtr resource = PresentResourceRetriever::retrieve(_uri);
+      if(_uri.toString().find("test2") == std::string::npos)
+        return nullptr;
+      return resource;
+    }
+  };
+
+  auto mockRetriever = std::make_shared<SecondDirectoryRetriever>();
+  PackageResourceRetriever retriever(mockRetriever);
+  retriever.addPackageDirectory("test", DART_DATA_PATH"test1");
+  retriever.addPackageDirectory("test", DART_DATA_PATH"test2");
+
+  EXPECT_TRUE(retriever.retrieve(Uri::createFromString("package://test/foo")) != nullptr);
+  ASSERT_EQ(2u, mockRetriever->mRetrieve.size());
+
+  // The second lookup goes straight to the directory the URI was found in
+  EXPECT_TRUE(retriever.retrieve(Uri::createFromString("package://test/foo")) != nullptr);
+  ASSERT_EQ(3u, mockRetriever->mRetrieve.size());
+  EXPECT_EQ(expected2, mockRetriever->mRetrieve[2]);
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
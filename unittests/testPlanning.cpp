@@ -0,0 +1,289 @@
+/**
+ * @file testPlanning.cpp
+ * @brief Checks the validity cache, the bisection order of the path shortener, the lazy
+ * collision checking of RRT and its handling of cyclic dofs.
+ */
+
+#include <cmath>
+#include <list>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include "TestHelpers.h"
+#include "dart/collision/dart/DARTCollisionDetector.h"
+#include "dart/constraint/ConstraintSolver.h"
+#include "dart/dynamics/DegreeOfFreedom.h"
+#include "dart/dynamics/RevoluteJoint.h"
+#include "dart/planning/ConfigurationCache.h"
+#include "dart/planning/PathShortener.h"
+#include "dart/planning/RRT.h"
+#include "dart/simulation/World.h"
+
+using namespace dart;
+using namespace dynamics;
+using namespace planning;
+using namespace simulation;
+
+/* ********************************************************************************************* */
+// A world with a box obstacle at the origin and a small box robot that can move in the xy-plane
+struct PlanningWorld {
+    WorldPtr world;
+    SkeletonPtr robot;
+    std::vector<size_t> dofs;
+
+    PlanningWorld() : world(new World) {
+        world->getConstraintSolver()->setCollisionDetector(
+            std::unique_ptr<collision::CollisionDetector>(new collision::DARTCollisionDetector));
+
+        SkeletonPtr obstacle = createGround(Eigen::Vector3d(0.4, 0.4, 0.4));
+        world->addSkeleton(obstacle);
+
+        robot = createBox(Eigen::Vector3d::Constant(0.1));
+        world->addSkeleton(robot);
+
+        // The translations along x and y
+        dofs.push_back(3);
+        dofs.push_back(4);
+        for (size_t i = 0; i < dofs.size(); i++)
+            robot->getDof(dofs[i])->setPositionLimits(-1.0, 1.0);
+    }
+
+    bool isColliding(const Eigen::VectorXd& config) {
+        robot->setPositions(dofs, config);
+        return world->checkCollision();
+    }
+};
+
+/* ********************************************************************************************* */
+// Counts the collision checks of the path shortener
+class CountingPathShortener : public PathShortener {
+public:
+    CountingPathShortener(WorldPtr world, SkeletonPtr robot, const std::vector<size_t>& dofs,
+                          double stepSize)
+        : PathShortener(world, robot, dofs, stepSize), numChecks(0) {}
+
+    int numChecks;
+
+protected:
+    bool checkCollisions(const Eigen::VectorXd& config) override {
+        numChecks++;
+        return PathShortener::checkCollisions(config);
+    }
+};
+
+/* ********************************************************************************************* */
+TEST(PLANNING, CONFIGURATION_CACHE) {
+
+    ConfigurationCache cache(3u);
+    Eigen::VectorXd config(2), other(2);
+    config << 0.1, 0.2;
+    other << 0.1, -0.2;
+    bool valid = true;
+
+    // Only the stored configurations are found
+    EXPECT_FALSE(cache.lookup(config, valid));
+    cache.insert(config, false);
+    cache.insert(other, true);
+    EXPECT_TRUE(cache.lookup(config, valid));
+    EXPECT_FALSE(valid);
+    EXPECT_TRUE(cache.lookup(other, valid));
+    EXPECT_TRUE(valid);
+
+    // A configuration close to a stored one is not assumed to share its validity
+    const Eigen::VectorXd nearby = config + Eigen::VectorXd::Constant(2, 1e-12);
+    EXPECT_FALSE(cache.lookup(nearby, valid));
+    EXPECT_EQ(2u, cache.getNumHits());
+    EXPECT_EQ(2u, cache.getNumMisses());
+
+    // Signed zeros are the same configuration
+    Eigen::VectorXd zero = Eigen::VectorXd::Zero(2);
+    cache.insert(zero, true);
+    zero[0] = -0.0;
+    EXPECT_TRUE(cache.lookup(zero, valid));
+
+    // The cache starts over when it is full
+    cache.insert(nearby, true);
+    EXPECT_EQ(1u, cache.getSize());
+    EXPECT_FALSE(cache.lookup(config, valid));
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.getSize());
+    EXPECT_EQ(0u, cache.getNumHits());
+    EXPECT_EQ(0u, cache.getNumMisses());
+}
+
+/* ********************************************************************************************* */
+TEST(PLANNING, SEGMENT_BISECTION) {
+
+    PlanningWorld planningWorld;
+    CountingPathShortener shortener(planningWorld.world, planningWorld.robot, planningWorld.dofs,
+                                    0.05);
+
+    // The obstacle is in the middle of the segment, which is checked first
+    Eigen::VectorXd start(2), goal(2);
+    start << -0.8, 0.0;
+    goal << 0.8, 0.0;
+    std::list<Eigen::VectorXd> points;
+    points.push_back(start);
+    EXPECT_FALSE(shortener.segmentCollisionFree(points, start, goal));
+    EXPECT_EQ(1, shortener.numChecks);
+    EXPECT_EQ(1u, points.size());
+
+    // An obstacle close to the end of the segment is found after a few checks as well
+    goal << 0.0, 0.0;
+    shortener.numChecks = 0;
+    EXPECT_FALSE(shortener.segmentCollisionFree(points, start, goal));
+    EXPECT_LE(shortener.numChecks, 4);
+
+    // A free segment is subdivided into steps no longer than the step size
+    start << -0.8, 0.8;
+    goal << 0.8, 0.8;
+    shortener.numChecks = 0;
+    EXPECT_TRUE(shortener.segmentCollisionFree(points, start, goal));
+    EXPECT_EQ(32u, points.size());
+    EXPECT_EQ(32, shortener.numChecks);
+    Eigen::VectorXd previous = start;
+    for (std::list<Eigen::VectorXd>::const_iterator it = points.begin(); it != points.end(); ++it) {
+        EXPECT_LE((*it - previous).norm(), 0.05);
+        previous = *it;
+    }
+
+    // The same segment is answered from the cache the second time with a single lookup
+    std::shared_ptr<ConfigurationCache> cache(new ConfigurationCache);
+    shortener.setConfigurationCache(cache);
+    shortener.segmentCollisionFree(points, start, goal);
+    EXPECT_EQ(0u, cache->getNumHits());
+    EXPECT_EQ(32u, cache->getSize());
+    EXPECT_EQ(1u, cache->getNumSegments());
+    shortener.numChecks = 0;
+    points.clear();
+    EXPECT_TRUE(shortener.segmentCollisionFree(points, start, goal));
+    EXPECT_EQ(1u, cache->getNumHits());
+    EXPECT_EQ(0, shortener.numChecks);
+    EXPECT_EQ(32u, points.size());
+
+    // The segment is checked again at a finer resolution
+    CountingPathShortener fineShortener(planningWorld.world, planningWorld.robot,
+                                        planningWorld.dofs, 0.025);
+    fineShortener.setConfigurationCache(cache);
+    fineShortener.segmentCollisionFree(points, start, goal);
+    EXPECT_EQ(2u, cache->getNumSegments());
+    EXPECT_EQ(64u, points.size());
+}
+
+/* ********************************************************************************************* */
+TEST(PLANNING, SHORTEN_PATH_CACHE) {
+
+    PlanningWorld planningWorld;
+    CountingPathShortener shortener(planningWorld.world, planningWorld.robot, planningWorld.dofs,
+                                    0.05);
+    std::shared_ptr<ConfigurationCache> cache(new ConfigurationCache);
+    shortener.setConfigurationCache(cache);
+
+    // The only shortcut of the path goes through the obstacle
+    Eigen::VectorXd start(2), via(2), goal(2);
+    start << -0.8, 0.0;
+    via << 0.0, 0.8;
+    goal << 0.8, 0.0;
+    std::list<Eigen::VectorXd> path;
+    path.push_back(start);
+    path.push_back(via);
+    path.push_back(goal);
+    shortener.shortenPath(path);
+    EXPECT_EQ(3u, path.size());
+
+    // The shortcut is checked once and every other attempt is a cache hit
+    EXPECT_EQ(1, shortener.numChecks);
+    EXPECT_EQ(1u, cache->getNumSegments());
+    EXPECT_EQ(14u, cache->getNumHits());
+}
+
+/* ********************************************************************************************* */
+TEST(PLANNING, LAZY_RRT) {
+
+    PlanningWorld planningWorld;
+    Eigen::VectorXd start(2), goal(2);
+    start << -0.8, 0.0;
+    goal << 0.8, 0.0;
+
+    RRT rrt(planningWorld.world, planningWorld.robot, planningWorld.dofs, start, 0.05);
+    rrt.setLazyCollisionChecking(true);
+    std::shared_ptr<ConfigurationCache> cache(new ConfigurationCache);
+    rrt.setConfigurationCache(cache);
+
+    // Without collision checks the tree goes straight through the obstacle
+    EXPECT_TRUE(rrt.connect(goal));
+    EXPECT_EQ(RRT::NODE_UNCHECKED, rrt.statusVector[rrt.activeNode]);
+    const int straightNode = rrt.activeNode;
+
+    // Validating the path prunes the nodes in the obstacle together with their subtrees
+    EXPECT_FALSE(rrt.validatePath(straightNode));
+    EXPECT_EQ(RRT::NODE_INVALID, rrt.statusVector[straightNode]);
+    EXPECT_FALSE(rrt.validatePath(straightNode));
+    for (size_t i = 0; i < rrt.getSize(); i++) {
+        if (rrt.statusVector[i] == RRT::NODE_VALID) {
+            EXPECT_FALSE(planningWorld.isColliding(rrt.getConfig(i)));
+        }
+    }
+
+    // Pruned nodes are not returned by the nearest neighbor search anymore
+    EXPECT_NE(straightNode, rrt.getNearestNeighborIndex().getNearestNeighbor(goal));
+
+    // Keep growing the tree until a path around the obstacle is validated
+    bool found = false;
+    for (size_t i = 0; i < 10000u && !found; i++) {
+        const Eigen::VectorXd target = (i % 3 == 0) ? goal : rrt.getRandomConfig();
+        rrt.connect(target);
+        found = rrt.getGap(goal) < rrt.stepSize && rrt.validatePath(rrt.activeNode);
+    }
+    ASSERT_TRUE(found);
+
+    std::list<Eigen::VectorXd> path;
+    rrt.tracePath(rrt.activeNode, path);
+    EXPECT_TRUE(path.front().isApprox(start));
+    for (std::list<Eigen::VectorXd>::const_iterator it = path.begin(); it != path.end(); ++it)
+        EXPECT_FALSE(planningWorld.isColliding(*it));
+
+    // Only the nodes on candidate paths were checked
+    EXPECT_LT(cache->getSize(), rrt.getSize());
+}
+
+/* ********************************************************************************************* */
+TEST(PLANNING, CYCLIC_DOFS) {
+
+    // A single revolute joint without limits
+    WorldPtr world(new World);
+    SkeletonPtr robot = Skeleton::create();
+    robot->createJointAndBodyNodePair<RevoluteJoint>();
+    world->addSkeleton(robot);
+    ASSERT_TRUE(robot->getDof(0)->isCyclic());
+
+    // The shortest way to the target crosses pi
+    std::vector<size_t> dofs(1, 0);
+    Eigen::VectorXd root(1), target(1);
+    root << 3.0;
+    target << -3.0;
+    RRT rrt(world, robot, dofs, root, 0.05);
+    EXPECT_TRUE(rrt.connect(target));
+    EXPECT_LT(rrt.getSize(), 8u);
+    for (size_t i = 0; i < rrt.getSize(); i++) {
+        EXPECT_LE(std::abs(rrt.getConfig(i)[0]), M_PI);
+    }
+
+    // The nodes beyond pi are found as the nearest neighbors of configurations close to -pi
+    Eigen::VectorXd query(1);
+    query << -M_PI + 0.01;
+    const int nearest = rrt.getNearestNeighborIndex().getNearestNeighbor(query);
+    EXPECT_LT(rrt.getConfig(nearest)[0], 0.0);
+
+    // The roots are wrapped as well
+    root << 3.0 * M_PI;
+    RRT wrapped(world, robot, dofs, root, 0.05);
+    EXPECT_NEAR(M_PI, std::abs(wrapped.getConfig(0)[0]), 1e-12);
+}
+
+int main(int argc, char* argv[]) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
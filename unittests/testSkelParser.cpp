@@ -34,16 +34,25 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <atomic>
+#include <cstdio>
 #include <iostream>
+#include <thread>
 #include <gtest/gtest.h>
 #include "TestHelpers.h"
 
+#include "dart/common/LocalResource.h"
+#include "dart/common/MemoryMappedResource.h"
 #include "dart/dynamics/SoftBodyNode.h"
+#include "dart/dynamics/BinaryMesh.h"
+#include "dart/dynamics/MeshCache.h"
+#include "dart/dynamics/MeshShape.h"
 #include "dart/dynamics/RevoluteJoint.h"
 #include "dart/dynamics/PlanarJoint.h"
 #include "dart/dynamics/Skeleton.h"
 #include "dart/simulation/World.h"
 #include "dart/simulation/World.h"
+#include "dart/utils/MeshPrefetcher.h"
 #include "dart/utils/XmlHelpers.h"
 #include "dart/utils/SkelParser.h"
 
@@ -438,6 +447,287 @@ TEST(SkelParser, JointDynamicsElements)
   EXPECT_EQ(joint1->getSpringStiffness   (2), 1.0);
 }
 
+//==============================================================================
+static std::vector<std::shared_ptr<MeshShape>> getMeshShapes(const WorldPtr& world)
+{
+  std::vector<std::shared_ptr<MeshShape>> meshes;
+  for(size_t i = 0; i < world->getNumSkeletons(); ++i)
+  {
+    const SkeletonPtr skel = world->getSkeleton(i);
+    for(size_t j = 0; j < skel->getNumBodyNodes(); ++j)
+    {
+      BodyNode* bn = skel->getBodyNode(j);
+      for(size_t k = 0; k < bn->getNumShapeNodes(); ++k)
+      {
+        std::shared_ptr<MeshShape> mesh = std::dynamic_pointer_cast<MeshShape>(
+              bn->getShapeNode(k)->getShape());
+        if(mesh)
+          meshes.push_back(mesh);
+      }
+    }
+  }
+
+  return meshes;
+}
+
+//==============================================================================
+TEST(SkelParser, SharedMeshes)
+{
+  MeshCache& cache = MeshCache::getDefault();
+  cache.clear();
+
+  WorldPtr world1 = SkelParser::readWorld(DART_DATA_PATH"skel/shapes.skel");
+  WorldPtr world2 = SkelParser::readWorld(DART_DATA_PATH"skel/shapes.skel");
+  ASSERT_TRUE(world1 != nullptr);
+  ASSERT_TRUE(world2 != nullptr);
+
+  std::vector<std::shared_ptr<MeshShape>> meshes = getMeshShapes(world1);
+  const std::vector<std::shared_ptr<MeshShape>> meshes2 = getMeshShapes(world2);
+  meshes.insert(meshes.end(), meshes2.begin(), meshes2.end());
+
+  // The visual and collision shapes of both worlds refer to the same file,
+  // which is imported only once
+  ASSERT_EQ(meshes.size(), 4u);
+  for(const std::shared_ptr<MeshShape>& mesh : meshes)
+    EXPECT_EQ(mesh->getMesh(), meshes[0]->getMesh());
+  EXPECT_EQ(cache.getNumMisses(), 1u);
+  EXPECT_EQ(cache.getNumHits(), 3u);
+  EXPECT_EQ(cache.getNumMeshes(), 1u);
+
+  // Changing the alpha of a shared mesh must not affect the others
+  meshes[0]->notifyAlphaUpdate(0.5);
+  EXPECT_NE(meshes[0]->getMesh(), meshes[1]->getMesh());
+  EXPECT_EQ(meshes[1]->getMesh(), meshes[2]->getMesh());
+
+  // The mesh is released along with the last shape that uses it
+  meshes.clear();
+  world1.reset();
+  world2.reset();
+  EXPECT_EQ(cache.getNumMeshes(), 0u);
+}
+
+//==============================================================================
+TEST(SkelParser, MeshPrefetcher)
+{
+  MeshCache& cache = MeshCache::getDefault();
+  cache.clear();
+
+  const size_t numThreads = MeshPrefetcher::getNumThreads();
+  MeshPrefetcher::setNumThreads(4u);
+
+  {
+    MeshPrefetcher prefetcher(
+          std::make_shared<dart::common::LocalResourceRetriever>());
+    prefetcher.add("file://" DART_DATA_PATH "obj/foot.obj");
+    prefetcher.add("file://" DART_DATA_PATH "obj/BoxSmall.obj");
+    prefetcher.add("file://" DART_DATA_PATH "obj/foot.obj");
+    prefetcher.add("file://" DART_DATA_PATH "obj/Body_Hip.obj");
+    EXPECT_EQ(prefetcher.getNumMeshes(), 3u);
+
+    prefetcher.load();
+    EXPECT_EQ(cache.getNumMisses(), 3u);
+    EXPECT_EQ(cache.getNumMeshes(), 3u);
+
+    // Parsing a file afterwards is served by the cache
+    WorldPtr world = SkelParser::readWorld(DART_DATA_PATH"skel/shapes.skel");
+    ASSERT_TRUE(world != nullptr);
+    EXPECT_EQ(cache.getNumMisses(), 3u);
+    EXPECT_EQ(getMeshShapes(world).size(), 2u);
+  }
+
+  // The prefetched meshes are released along with the prefetcher
+  EXPECT_EQ(cache.getNumMeshes(), 0u);
+
+  MeshPrefetcher::setNumThreads(numThreads);
+}
+
+//==============================================================================
+class ThrowingRetriever : public dart::common::ResourceRetriever
+{
+public:
+  bool exists(const dart::common::Uri&) override
+  {
+    return true;
+  }
+
+  dart::common::ResourcePtr retrieve(const dart::common::Uri&) override
+  {
+    throw std::runtime_error("retrieve failed");
+  }
+};
+
+//==============================================================================
+TEST(SkelParser, MeshCacheException)
+{
+  MeshCache cache;
+  const std::string uri = "file://" DART_DATA_PATH "obj/foot.obj"
+      + BinaryMesh::Extension;
+
+  // A failed import is not left pending, so the next request imports again
+  EXPECT_THROW(cache.getMesh(uri, std::make_shared<ThrowingRetriever>()),
+               std::runtime_error);
+  EXPECT_THROW(cache.getMesh(uri, std::make_shared<ThrowingRetriever>()),
+               std::runtime_error);
+  EXPECT_EQ(cache.getNumMisses(), 2u);
+  EXPECT_EQ(cache.getNumMeshes(), 0u);
+}
+
+//==============================================================================
+/// Resolves every URI to the same local file, like a package:// retriever
+/// that is set up with a different package directory
+class RedirectingRetriever : public dart::common::ResourceRetriever
+{
+public:
+  explicit RedirectingRetriever(const std::string& _path)
+    : mUri(dart::common::Uri::createFromPath(_path))
+  {
+    // Do nothing
+  }
+
+  bool exists(const dart::common::Uri&) override
+  {
+    return mLocal.exists(mUri);
+  }
+
+  dart::common::ResourcePtr retrieve(const dart::common::Uri&) override
+  {
+    return mLocal.retrieve(mUri);
+  }
+
+private:
+  dart::common::Uri mUri;
+  dart::common::LocalResourceRetriever mLocal;
+};
+
+//==============================================================================
+TEST(SkelParser, MeshCacheRetrievers)
+{
+  MeshCache cache;
+
+  // A package:// URI may refer to different files for different retrievers
+  const std::string packageUri = "package://robot/mesh.obj";
+  const auto retriever1 = std::make_shared<RedirectingRetriever>(
+        DART_DATA_PATH "obj/foot.obj");
+  const auto retriever2 = std::make_shared<RedirectingRetriever>(
+        DART_DATA_PATH "obj/BoxSmall.obj");
+  const std::shared_ptr<const aiScene> mesh1
+      = cache.getMesh(packageUri, retriever1);
+  const std::shared_ptr<const aiScene> mesh2
+      = cache.getMesh(packageUri, retriever2);
+  ASSERT_TRUE(mesh1 != nullptr);
+  ASSERT_TRUE(mesh2 != nullptr);
+  EXPECT_NE(mesh1, mesh2);
+  EXPECT_EQ(cache.getMesh(packageUri, retriever1), mesh1);
+  EXPECT_EQ(cache.getNumMisses(), 2u);
+
+  // A file:// URI is shared between the retrievers
+  const std::string fileUri = "file://" DART_DATA_PATH "obj/foot.obj";
+  const std::shared_ptr<const aiScene> local1 = cache.getMesh(
+        fileUri, std::make_shared<dart::common::LocalResourceRetriever>());
+  const std::shared_ptr<const aiScene> local2 = cache.getMesh(
+        fileUri, std::make_shared<dart::common::LocalResourceRetriever>());
+  ASSERT_TRUE(local1 != nullptr);
+  EXPECT_EQ(local1, local2);
+  EXPECT_EQ(cache.getNumMisses(), 3u);
+  EXPECT_EQ(cache.getNumMeshes(), 3u);
+}
+
+//==============================================================================
+TEST(SkelParser, MeshPrefetcherException)
+{
+  MeshCache::getDefault().clear();
+
+  const size_t numThreads = MeshPrefetcher::getNumThreads();
+  MeshPrefetcher::setNumThreads(4u);
+
+  // The errors are left to the parser, which imports the meshes again
+  MeshPrefetcher prefetcher(std::make_shared<ThrowingRetriever>());
+  for(size_t i = 0; i < 8; ++i)
+    prefetcher.add("mesh" + std::to_string(i) + BinaryMesh::Extension);
+  EXPECT_NO_THROW(prefetcher.load());
+  EXPECT_EQ(MeshCache::getDefault().getNumMeshes(), 0u);
+
+  MeshPrefetcher::setNumThreads(numThreads);
+}
+
+//==============================================================================
+TEST(SkelParser, BinaryMesh)
+{
+  const aiScene* original = MeshShape::loadMesh(DART_DATA_PATH"obj/foot.obj");
+  ASSERT_TRUE(original != nullptr);
+
+  const std::string fileName = "foot" + BinaryMesh::Extension;
+  ASSERT_TRUE(BinaryMesh::write(original, fileName));
+
+  const std::shared_ptr<const aiScene> baked = BinaryMesh::read(
+        std::make_shared<common::LocalResource>(fileName));
+  ASSERT_TRUE(baked != nullptr);
+
+  ASSERT_EQ(baked->mNumMeshes, original->mNumMeshes);
+  for(size_t i = 0; i < original->mNumMeshes; ++i)
+  {
+    const aiMesh* mesh1 = original->mMeshes[i];
+    const aiMesh* mesh2 = baked->mMeshes[i];
+    ASSERT_EQ(mesh2->mNumVertices, mesh1->mNumVertices);
+    ASSERT_EQ(mesh2->mNumFaces, mesh1->mNumFaces);
+    EXPECT_EQ(mesh2->mMaterialIndex, mesh1->mMaterialIndex);
+
+    for(size_t j = 0; j < mesh1->mNumVertices; ++j)
+    {
+      EXPECT_EQ(mesh2->mVertices[j].x, mesh1->mVertices[j].x);
+      EXPECT_EQ(mesh2->mVertices[j].y, mesh1->mVertices[j].y);
+      EXPECT_EQ(mesh2->mVertices[j].z, mesh1->mVertices[j].z);
+      EXPECT_EQ(mesh2->mNormals[j].z, mesh1->mNormals[j].z);
+    }
+
+    for(size_t j = 0; j < mesh1->mNumFaces; ++j)
+    {
+      ASSERT_EQ(mesh2->mFaces[j].mNumIndices, 3u);
+      for(size_t k = 0; k < 3; ++k)
+        EXPECT_EQ(mesh2->mFaces[j].mIndices[k], mesh1->mFaces[j].mIndices[k]);
+    }
+  }
+
+  // A memory-mapped file is used in place instead of being copied
+  {
+    const auto resource
+        = std::make_shared<common::MemoryMappedResource>(fileName);
+    const std::shared_ptr<const aiScene> mapped = BinaryMesh::read(resource);
+    ASSERT_TRUE(mapped != nullptr);
+    ASSERT_EQ(mapped->mNumMeshes, original->mNumMeshes);
+
+    const char* begin = static_cast<const char*>(resource->getData());
+    const char* vertices
+        = reinterpret_cast<const char*>(mapped->mMeshes[0]->mVertices);
+    EXPECT_TRUE(vertices >= begin && vertices < begin + resource->getSize());
+    EXPECT_EQ(mapped->mMeshes[0]->mVertices[0].x,
+              original->mMeshes[0]->mVertices[0].x);
+  }
+
+  // Concurrent writers of the same file use separate temporary files
+  {
+    std::atomic<size_t> numWritten(0u);
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < 4; ++i)
+    {
+      threads.emplace_back([&]()
+      {
+        if(BinaryMesh::write(original, fileName))
+          ++numWritten;
+      });
+    }
+    for(std::thread& thread : threads)
+      thread.join();
+
+    EXPECT_EQ(numWritten, 4u);
+    EXPECT_TRUE(BinaryMesh::read(
+        std::make_shared<common::LocalResource>(fileName)) != nullptr);
+  }
+
+  delete original;
+  std::remove(fileName.c_str());
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
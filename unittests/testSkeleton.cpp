@@ -43,6 +43,8 @@
 #include "dart/utils/SkelParser.h"
 #include "dart/dynamics/BodyNode.h"
 #include "dart/dynamics/RevoluteJoint.h"
+#include "dart/dynamics/BoxShape.h"
+#include "dart/dynamics/SimpleFrame.h"
 #include "dart/dynamics/Skeleton.h"
 #include "dart/simulation/World.h"
 
@@ -1217,6 +1219,47 @@ TEST(Skeleton, LinearJacobianDerivOverload)
   linkage->getLinearJacobianDeriv(linkage->getBodyNode(0));
 }
 
+TEST(Skeleton, StructuralVersion)
+{
+  // Renderers rely on the versions to find out what needs to be updated
+  SkeletonPtr skel = Skeleton::create();
+  BodyNode* bn =
+      skel->createJointAndBodyNodePair<RevoluteJoint>().second;
+
+  size_t version = skel->getVersion();
+  std::shared_ptr<BoxShape> box =
+      std::make_shared<BoxShape>(Eigen::Vector3d::Ones());
+  ShapeNode* shapeNode =
+      bn->createShapeNodeWith<VisualAddon>(box);
+  EXPECT_LT(version, skel->getVersion());
+
+  // Moving the Skeleton does not change its structure
+  version = skel->getVersion();
+  skel->setPosition(0, 0.5);
+  skel->computeForwardKinematics();
+  EXPECT_EQ(version, skel->getVersion());
+
+  SimpleFrame frame(bn, "frame");
+  EXPECT_LT(version, skel->getVersion());
+
+  version = skel->getVersion();
+  BodyNode* child =
+      skel->createJointAndBodyNodePair<RevoluteJoint>(bn).second;
+  EXPECT_LT(version, skel->getVersion());
+
+  version = skel->getVersion();
+  child->remove();
+  EXPECT_LT(version, skel->getVersion());
+
+  version = skel->getVersion();
+  shapeNode->remove();
+  EXPECT_LT(version, skel->getVersion());
+
+  const size_t shapeVersion = box->getVersion();
+  box->setSize(Eigen::Vector3d::Constant(2.0));
+  EXPECT_LT(shapeVersion, box->getVersion());
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
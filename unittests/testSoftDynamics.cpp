@@ -44,6 +44,7 @@
 #include "dart/common/Console.h"
 #include "dart/math/Helpers.h"
 #include "dart/dynamics/Joint.h"
+#include "dart/dynamics/RevoluteJoint.h"
 
 #include "dart/dynamics/Skeleton.h"
 #include "dart/dynamics/SoftBodyNode.h"
@@ -462,6 +463,98 @@ TEST_F(SoftDynamicsTest, compareEquationsOfMotion)
 //  }
 }
 
+//==============================================================================
+simulation::WorldPtr createSoftPendulum(double _edgeStiffness,
+                                        double _timeStep, bool _implicit)
+{
+  simulation::WorldPtr world(new simulation::World);
+  world->setTimeStep(_timeStep);
+  world->setImplicitSpringIntegration(_implicit);
+
+  dynamics::SkeletonPtr skel = dynamics::Skeleton::create("pendulum");
+
+  dynamics::RevoluteJoint::Properties joint;
+  joint.mAxis = Vector3d::UnitY();
+  joint.mT_ChildBodyToJoint.translation() = Vector3d(0.0, 0.0, 0.5);
+
+  dynamics::SoftBodyNode::Properties soft(
+        dynamics::BodyNode::Properties(dynamics::Entity::Properties("soft")),
+        dynamics::SoftBodyNodeHelper::makeEllipsoidProperties(
+          Vector3d::Constant(0.3), 6, 6, 1.0, 100.0, _edgeStiffness, 0.01));
+
+  dynamics::SoftBodyNode* bn = skel->createJointAndBodyNodePair<
+      dynamics::RevoluteJoint, dynamics::SoftBodyNode>(
+        nullptr, joint, soft).second;
+
+  skel->setPosition(0, 0.5);
+  for (size_t i = 0; i < bn->getNumPointMasses(); ++i)
+  {
+    bn->getPointMass(i)->setPositions(
+          0.01 * Vector3d(std::sin(i), std::cos(i), std::sin(2.0 * i)));
+  }
+
+  world->addSkeleton(skel);
+
+  return world;
+}
+
+//==============================================================================
+VectorXd getPointMassPositions(const simulation::WorldPtr& _world)
+{
+  const dynamics::SoftBodyNode* bn
+      = _world->getSkeleton(0)->getSoftBodyNode(0);
+
+  VectorXd positions(3 * bn->getNumPointMasses());
+  for (size_t i = 0; i < bn->getNumPointMasses(); ++i)
+    positions.segment<3>(3 * i) = bn->getPointMass(i)->getPositions();
+
+  return positions;
+}
+
+//==============================================================================
+TEST_F(SoftDynamicsTest, implicitSpringIntegration)
+{
+  // The option is propagated to the skeletons of the world
+  simulation::WorldPtr world = createSoftPendulum(0.0, 1e-3, true);
+  EXPECT_TRUE(world->isImplicitSpringIntegration());
+  EXPECT_TRUE(world->getSkeleton(0)->isImplicitSpringIntegration());
+  world->setImplicitSpringIntegration(false);
+  EXPECT_FALSE(world->getSkeleton(0)->isImplicitSpringIntegration());
+
+  // Without edge springs the point masses are decoupled, so the coupled solve
+  // must reproduce the decoupled one
+  simulation::WorldPtr semi = createSoftPendulum(0.0, 1e-3, false);
+  simulation::WorldPtr implicit = createSoftPendulum(0.0, 1e-3, true);
+  for (size_t i = 0; i < 200; ++i)
+  {
+    semi->step();
+    implicit->step();
+  }
+  EXPECT_TRUE(equals(getPointMassPositions(semi),
+                     getPointMassPositions(implicit), 1e-10));
+  EXPECT_NEAR(semi->getSkeleton(0)->getPosition(0),
+              implicit->getSkeleton(0)->getPosition(0), 1e-10);
+
+  // The explicit edge springs diverge at this stiffness and time step, while
+  // the implicit ones stay bounded. The explicit simulation is stopped once it
+  // has blown up and before it produces NaNs.
+  simulation::WorldPtr explicitStiff = createSoftPendulum(1000.0, 1e-2, false);
+  for (size_t i = 0; i < 100; ++i)
+  {
+    explicitStiff->step();
+    if (getPointMassPositions(explicitStiff).cwiseAbs().maxCoeff() > 1.0)
+      break;
+  }
+  EXPECT_GT(getPointMassPositions(explicitStiff).cwiseAbs().maxCoeff(), 1.0);
+
+  simulation::WorldPtr implicitStiff = createSoftPendulum(1000.0, 1e-2, true);
+  for (size_t i = 0; i < 100; ++i)
+    implicitStiff->step();
+  const VectorXd positions = getPointMassPositions(implicitStiff);
+  EXPECT_FALSE(math::isNan(positions));
+  EXPECT_LT(positions.cwiseAbs().maxCoeff(), 0.1);
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
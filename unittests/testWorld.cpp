@@ -35,16 +35,21 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <chrono>
 #include <iostream>
+#include <thread>
 #include <gtest/gtest.h>
 #include "TestHelpers.h"
 
 #include "dart/math/Geometry.h"
+#include "dart/collision/dart/DARTCollisionDetector.h"
+#include "dart/constraint/ConstraintSolver.h"
 #include "dart/utils/SkelParser.h"
 #include "dart/dynamics/BodyNode.h"
 #include "dart/dynamics/RevoluteJoint.h"
 #include "dart/dynamics/Skeleton.h"
 #include "dart/simulation/World.h"
+#include "dart/simulation/RealTimeStepper.h"
 
 using namespace dart;
 using namespace math;
@@ -259,6 +264,390 @@ TEST(World, Cloning)
   }
 }
 
+//==============================================================================
+TEST(World, AsyncBaking)
+{
+  const size_t numFrames = 200;
+
+  WorldPtr syncWorld = utils::SkelParser::readWorld(
+      DART_DATA_PATH"/skel/test/file_info_world_test.skel");
+  WorldPtr asyncWorld = utils::SkelParser::readWorld(
+      DART_DATA_PATH"/skel/test/file_info_world_test.skel");
+  ASSERT_TRUE(syncWorld != nullptr);
+  ASSERT_TRUE(asyncWorld != nullptr);
+
+  // Blocking on overflow makes sure that no frame is lost
+  asyncWorld->setAsyncBaking(true, 16, AsyncRecorder::BLOCK);
+  EXPECT_TRUE(asyncWorld->isAsyncBaking());
+
+  for (size_t i = 0; i < numFrames; ++i)
+  {
+    syncWorld->step();
+    syncWorld->bake();
+    asyncWorld->step();
+    asyncWorld->bake();
+  }
+
+  Recording* syncRecording = syncWorld->getRecording();
+  Recording* asyncRecording = asyncWorld->getRecording();
+  ASSERT_EQ(syncRecording->getNumFrames(), static_cast<int>(numFrames));
+  ASSERT_EQ(asyncRecording->getNumFrames(), static_cast<int>(numFrames));
+  for (size_t i = 0; i < numFrames; ++i)
+    EXPECT_TRUE(syncRecording->getState(i) == asyncRecording->getState(i));
+
+  AsyncRecorder* recorder = asyncWorld->getAsyncRecorder();
+  EXPECT_EQ(recorder->getNumRecordedFrames(), numFrames);
+  EXPECT_EQ(recorder->getNumDroppedFrames(), 0u);
+  EXPECT_LE(recorder->getMaxNumPendingFrames(), recorder->getCapacity());
+
+  // Dropped frames are reported
+  asyncWorld->reset();
+  asyncWorld->setAsyncBaking(true, 1, AsyncRecorder::DROP_FRAMES);
+  recorder = asyncWorld->getAsyncRecorder();
+  for (size_t i = 0; i < numFrames; ++i)
+    asyncWorld->bake();
+  asyncRecording = asyncWorld->getRecording();
+  EXPECT_EQ(recorder->getNumRecordedFrames()
+            + recorder->getNumDroppedFrames(), numFrames);
+  EXPECT_EQ(asyncRecording->getNumFrames(),
+            static_cast<int>(recorder->getNumRecordedFrames()));
+
+  // Decimation
+  asyncWorld->setAsyncBaking(false);
+  EXPECT_FALSE(asyncWorld->isAsyncBaking());
+  asyncWorld->reset();
+  asyncWorld->setBakeDecimation(3);
+  for (size_t i = 0; i < numFrames; ++i)
+    asyncWorld->bake();
+  EXPECT_EQ(asyncWorld->getRecording()->getNumFrames(),
+            static_cast<int>((numFrames + 2) / 3));
+}
+
+//==============================================================================
+TEST(World, RealTimeStepper)
+{
+  WorldPtr world(new World);
+  world->setTimeStep(0.001);
+  SkeletonPtr skel = Skeleton::create("falling");
+  BodyNode* bn = skel->createJointAndBodyNodePair<FreeJoint>().second;
+  bn->createShapeNodeWith<VisualAddon>(
+        std::make_shared<BoxShape>(Eigen::Vector3d::Ones()));
+  world->addSkeleton(skel);
+  world->addSimpleFrame(std::make_shared<SimpleFrame>(
+        Frame::World(), "frame"));
+
+  RealTimeStepper stepper(world);
+  size_t numPreSteps = 0u;
+  size_t numPostSteps = 0u;
+  stepper.setStepCallbacks([&]() { ++numPreSteps; },
+                           [&]() { ++numPostSteps; });
+
+  // As fast as possible, while the renderer keeps reading snapshots
+  stepper.setRealTimeFactor(0.0);
+  stepper.start();
+  EXPECT_TRUE(stepper.isRunning());
+
+  size_t lastNumSteps = 0u;
+  while (stepper.getNumSteps() < 2000u)
+  {
+    const RealTimeStepper::Snapshot* snapshot = stepper.getLatestSnapshot();
+    ASSERT_TRUE(snapshot != nullptr);
+    ASSERT_EQ(snapshot->mShapeFrames.size(), snapshot->mTransforms.size());
+    EXPECT_EQ(2u, snapshot->mShapeFrames.size());
+    EXPECT_GE(snapshot->mNumSteps, lastNumSteps);
+    EXPECT_NEAR(snapshot->mTime, snapshot->mNumSteps * 0.001, 1e-9);
+    lastNumSteps = snapshot->mNumSteps;
+  }
+
+  stepper.stop();
+  EXPECT_FALSE(stepper.isRunning());
+  EXPECT_EQ(stepper.getNumSteps(), numPreSteps);
+  EXPECT_EQ(stepper.getNumSteps(), numPostSteps);
+
+  // The latest snapshot matches the final state
+  const RealTimeStepper::Snapshot* snapshot = stepper.getLatestSnapshot();
+  ASSERT_TRUE(snapshot != nullptr);
+  EXPECT_EQ(stepper.getNumSteps(), snapshot->mNumSteps);
+  EXPECT_EQ(world->getTime(), snapshot->mTime);
+  EXPECT_EQ(bn->getShapeNode(0), snapshot->mShapeFrames[0]);
+  EXPECT_TRUE(bn->getShapeNode(0)->getWorldTransform().matrix()
+              == snapshot->mTransforms[0].matrix());
+
+  // In real time, a quarter of a second of wall-clock time takes roughly 250
+  // steps
+  world->setTime(0.0);
+  stepper.setRealTimeFactor(1.0);
+  stepper.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(250));
+  stepper.stop();
+  EXPECT_GT(stepper.getNumSteps(), 50u);
+  EXPECT_LT(stepper.getNumSteps(), 400u);
+}
+
+//==============================================================================
+TEST(World, Sleeping)
+{
+  WorldPtr world(new World);
+  world->setTimeStep(0.001);
+
+  constraint::ConstraintSolver* solver = world->getConstraintSolver();
+  solver->setCollisionDetector(std::unique_ptr<collision::CollisionDetector>(
+        new collision::DARTCollisionDetector));
+  solver->setSleepingEnabled(true);
+  solver->setNumStepsToSleep(50u);
+
+  SkeletonPtr ground = createGround(Eigen::Vector3d(10.0, 10.0, 0.1),
+                                    Eigen::Vector3d(0.0, 0.0, -0.05));
+  ground->setMobile(false);
+  world->addSkeleton(ground);
+
+  const Eigen::Vector3d size = Eigen::Vector3d::Constant(0.1);
+  SkeletonPtr box1 = createBox(size, Eigen::Vector3d(0.0, 0.0, 0.06));
+  SkeletonPtr box2 = createBox(size, Eigen::Vector3d(1.0, 0.0, 0.06));
+  world->addSkeleton(box1);
+  world->addSkeleton(box2);
+
+  // Both boxes come to rest on the ground and fall asleep
+  for (size_t i = 0; i < 2000u && solver->getNumSleepingSkeletons() < 2u; ++i)
+    world->step();
+  EXPECT_TRUE(box1->isSleeping());
+  EXPECT_TRUE(box2->isSleeping());
+  EXPECT_FALSE(ground->isSleeping());
+
+  // Sleeping skeletons are not moved
+  const Eigen::VectorXd positions = box1->getPositions();
+  for (size_t i = 0; i < 100u; ++i)
+    world->step();
+  EXPECT_TRUE(box1->getPositions() == positions);
+  EXPECT_TRUE(box1->getVelocities().isZero());
+
+  // An external force wakes up the box it is applied to, and only that box
+  box1->getBodyNode(0)->addExtForce(Eigen::Vector3d(10.0, 0.0, 0.0));
+  world->step();
+  EXPECT_FALSE(box1->isSleeping());
+  EXPECT_TRUE(box2->isSleeping());
+  EXPECT_GT(box1->getVelocities().norm(), 0.0);
+
+  // A box that falls onto a sleeping box wakes it up
+  SkeletonPtr box3 = createBox(size, Eigen::Vector3d(1.0, 0.0, 0.2));
+  world->addSkeleton(box3);
+  for (size_t i = 0; i < 1000u && box2->isSleeping(); ++i)
+    world->step();
+  EXPECT_FALSE(box2->isSleeping());
+
+  // The stack of the two boxes falls asleep as a whole
+  for (size_t i = 0; i < 2000u && !box3->isSleeping(); ++i)
+    world->step();
+  EXPECT_TRUE(box2->isSleeping());
+  EXPECT_TRUE(box3->isSleeping());
+
+  // Waking up one box of the stack wakes up the other one as well
+  solver->wakeUp(box3);
+  EXPECT_FALSE(box2->isSleeping());
+  EXPECT_FALSE(box3->isSleeping());
+
+  // Disabling sleeping wakes up all the skeletons
+  for (size_t i = 0; i < 2000u && solver->getNumSleepingSkeletons() < 3u; ++i)
+    world->step();
+  EXPECT_EQ(3u, solver->getNumSleepingSkeletons());
+
+  // A box that is dropped onto the sleeping stack does not push it into the
+  // ground in the step that wakes it up
+  auto getStackPenetration = [&]()
+  {
+    const double z2 = box2->getCOM()[2];
+    const double z3 = box3->getCOM()[2];
+    return std::max(0.5 * size[2] - z2, size[2] - (z3 - z2));
+  };
+  const double restingPenetration = getStackPenetration();
+  SkeletonPtr box4 = createBox(size, Eigen::Vector3d(1.0, 0.0, 0.5));
+  world->addSkeleton(box4);
+  for (size_t i = 0; i < 1000u && box3->isSleeping(); ++i)
+    world->step();
+  EXPECT_FALSE(box3->isSleeping());
+  EXPECT_FALSE(box2->isSleeping());
+  EXPECT_LE(getStackPenetration(), restingPenetration + 1e-6);
+
+  solver->setSleepingEnabled(false);
+  EXPECT_EQ(0u, solver->getNumSleepingSkeletons());
+}
+
+//==============================================================================
+WorldPtr createFallingBox(double _timeStep, bool _adaptive)
+{
+  WorldPtr world(new World);
+  world->setTimeStep(_timeStep);
+  world->setAdaptiveTimeStepping(_adaptive);
+  world->getConstraintSolver()->setCollisionDetector(
+        std::unique_ptr<collision::CollisionDetector>(
+          new collision::DARTCollisionDetector));
+
+  SkeletonPtr ground = createGround(Eigen::Vector3d(10.0, 10.0, 1.0),
+                                    Eigen::Vector3d(0.0, 0.0, -0.5));
+  ground->setMobile(false);
+  world->addSkeleton(ground);
+
+  SkeletonPtr box = createBox(Eigen::Vector3d::Constant(0.1),
+                              Eigen::Vector3d(0.0, 0.0, 0.3));
+  box->setVelocity(5, -10.0);
+  world->addSkeleton(box);
+
+  return world;
+}
+
+//==============================================================================
+double getMaxPenetrationDepth(const WorldPtr& _world)
+{
+  collision::CollisionDetector* detector
+      = _world->getConstraintSolver()->getCollisionDetector();
+  detector->detectCollision(true, true);
+
+  double depth = 0.0;
+  for (size_t i = 0; i < detector->getNumContacts(); ++i)
+    depth = std::max(depth, detector->getContactRecord(i).penetrationDepth);
+
+  return depth;
+}
+
+//==============================================================================
+TEST(World, AdaptiveTimeStepping)
+{
+  const double timeStep = 0.01;
+  const size_t numSteps = 30u;
+
+  WorldPtr fixed = createFallingBox(timeStep, false);
+  WorldPtr adaptive = createFallingBox(timeStep, true);
+  double fixedDepth = 0.0;
+  double adaptiveDepth = 0.0;
+  for (size_t i = 0; i < numSteps; ++i)
+  {
+    fixed->step();
+    adaptive->step();
+    fixedDepth = std::max(fixedDepth, getMaxPenetrationDepth(fixed));
+    adaptiveDepth = std::max(adaptiveDepth, getMaxPenetrationDepth(adaptive));
+  }
+
+  // Only the steps around the impact are subdivided, which keeps the box from
+  // sinking into the ground as deep as with the fixed step
+  const World::SubSteppingStatistics& stats
+      = adaptive->getSubSteppingStatistics();
+  EXPECT_EQ(numSteps, stats.mNumSteps);
+  EXPECT_GT(stats.mNumSubSteps, numSteps);
+  EXPECT_LT(stats.mNumSubSteps, numSteps * adaptive->getMaxNumSubSteps());
+  EXPECT_GT(stats.mNumRejectedSubSteps, 0u);
+  EXPECT_LE(stats.mMaxNumSubStepsPerStep, adaptive->getMaxNumSubSteps());
+  EXPECT_NEAR(numSteps * timeStep, adaptive->getTime(), 1e-12);
+  EXPECT_DOUBLE_EQ(timeStep, adaptive->getTimeStep());
+  EXPECT_LT(adaptiveDepth, 0.5 * fixedDepth);
+
+  // The contacts left in the collision detector are the ones the last
+  // sub-step was solved with, so they carry the contact forces
+  collision::CollisionDetector* detector
+      = adaptive->getConstraintSolver()->getCollisionDetector();
+  adaptive->step();
+  ASSERT_GT(detector->getNumContacts(), 0u);
+  EXPECT_GT(detector->getContactRecord(0).force.norm(), 0.0);
+
+  // Steps without impacts are not subdivided
+  WorldPtr flying = createFallingBox(timeStep, true);
+  flying->setGravity(Eigen::Vector3d::Zero());
+  flying->getSkeleton(1)->setVelocity(5, 1.0);
+  for (size_t i = 0; i < numSteps; ++i)
+    flying->step();
+  EXPECT_EQ(numSteps, flying->getSubSteppingStatistics().mNumSubSteps);
+  EXPECT_EQ(0u, flying->getSubSteppingStatistics().mNumRejectedSubSteps);
+
+  adaptive->reset();
+  EXPECT_EQ(0u, adaptive->getSubSteppingStatistics().mNumSteps);
+}
+
+//==============================================================================
+WorldPtr createFastBox(bool _continuous)
+{
+  WorldPtr world(new World);
+  world->setTimeStep(0.01);
+  world->setGravity(Eigen::Vector3d::Zero());
+  world->getConstraintSolver()->setCollisionDetector(
+        std::unique_ptr<collision::CollisionDetector>(
+          new collision::DARTCollisionDetector));
+
+  SkeletonPtr wall = createGround(Eigen::Vector3d(1.0, 1.0, 0.02),
+                                  Eigen::Vector3d::Zero());
+  wall->setMobile(false);
+  world->addSkeleton(wall);
+
+  // The box moves farther than its own size and the thickness of the wall in
+  // every step
+  SkeletonPtr box = createBox(Eigen::Vector3d::Constant(0.1),
+                              Eigen::Vector3d(0.0, 0.0, 0.3));
+  box->setVelocity(5, -50.0);
+  box->getBodyNode(0)->setContinuousCollision(_continuous);
+  world->addSkeleton(box);
+
+  return world;
+}
+
+//==============================================================================
+TEST(World, ContinuousCollision)
+{
+  // Without continuous collision detection the box passes through the wall
+  WorldPtr discrete = createFastBox(false);
+  for (size_t i = 0; i < 10u; ++i)
+    discrete->step();
+  EXPECT_LT(discrete->getSkeleton(1)->getBodyNode(0)->getTransform()
+            .translation()[2], 0.0);
+
+  // With continuous collision detection the box stops on the wall without
+  // sinking into it
+  WorldPtr continuous = createFastBox(true);
+  EXPECT_TRUE(continuous->getSkeleton(1)->getBodyNode(0)
+              ->isContinuousCollision());
+  collision::CollisionDetector* detector
+      = continuous->getConstraintSolver()->getCollisionDetector();
+  size_t numPredictedContacts = 0u;
+  for (size_t i = 0; i < 10u; ++i)
+  {
+    continuous->step();
+    int numExistingContacts = 0;
+    for (size_t j = 0; j < detector->getNumContacts(); ++j)
+    {
+      const collision::ContactRecord& contact = detector->getContactRecord(j);
+      if (contact.timeOfImpact > 0.0)
+      {
+        EXPECT_LT(contact.timeOfImpact, continuous->getTimeStep());
+        EXPECT_EQ(contact.penetrationDepth, 0.0);
+        EXPECT_GE(contact.gap, 0.0);
+        ++numPredictedContacts;
+      }
+      else
+      {
+        ++numExistingContacts;
+      }
+    }
+
+    // Only the existing contacts are recorded
+    continuous->bake();
+    EXPECT_EQ(continuous->getRecording()->getNumContacts(i),
+              numExistingContacts);
+  }
+  EXPECT_GT(numPredictedContacts, 0u);
+
+  const BodyNode* box = continuous->getSkeleton(1)->getBodyNode(0);
+  EXPECT_GT(box->getTransform().translation()[2], 0.06 - 1e-3);
+  EXPECT_LT(box->getLinearVelocity().norm(), 1e-3);
+
+  // An elastic box bounces off the wall in the step of the predicted impact
+  // instead of being stopped on it
+  WorldPtr bouncing = createFastBox(true);
+  bouncing->getSkeleton(0)->getBodyNode(0)->setRestitutionCoeff(1.0);
+  bouncing->getSkeleton(1)->getBodyNode(0)->setRestitutionCoeff(1.0);
+  BodyNode* elasticBox = bouncing->getSkeleton(1)->getBodyNode(0);
+  for (size_t i = 0; i < 10u && elasticBox->getLinearVelocity()[2] < 0.0; ++i)
+    bouncing->step();
+  EXPECT_NEAR(elasticBox->getLinearVelocity()[2], 50.0, 1e-3);
+  EXPECT_GT(elasticBox->getTransform().translation()[2], 0.06 - 1e-3);
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {